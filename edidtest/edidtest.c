@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "edid.h"
+
+// Splits a dump and decodes every EDID in it, the same way NW_Edid does.
+static size_t
+DecodeDump(const uint8_t* data, size_t size, int verbose)
+{
+	NWL_EDID edid;
+	size_t offset = 0;
+	size_t length = 0;
+	size_t count = 0;
+
+	if (!NWL_EdidFind(data, size, &offset, &length))
+	{
+		offset = 0;
+		length = size;
+	}
+	do
+	{
+		int valid = NWL_EdidParse(data + offset, length, &edid);
+		if (verbose)
+		{
+			printf("Offset %zu: %s", offset, valid ? "valid" : "invalid");
+			if (valid)
+				printf(", %s%04X \"%s\" %llux%llu@%.2f, %u extension(s)",
+					edid.Vendor, edid.ProductCode, edid.Name,
+					(unsigned long long)edid.XRes, (unsigned long long)edid.YRes,
+					edid.Freq, edid.ExtCount);
+			printf(", errors 0x%02X\n", edid.Errors);
+		}
+		NWL_EdidFree(&edid);
+		count++;
+		offset += length;
+	} while (NWL_EdidFind(data, size, &offset, &length));
+	return count;
+}
+
+#ifdef EDID_FUZZER
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	DecodeDump(data, size, 0);
+	return 0;
+}
+#else
+static uint8_t*
+LoadFile(const char* path, size_t* size)
+{
+	uint8_t* data = NULL;
+	long len;
+	FILE* fp = fopen(path, "rb");
+	if (!fp)
+		return NULL;
+	if (fseek(fp, 0, SEEK_END) != 0 || (len = ftell(fp)) <= 0 || fseek(fp, 0, SEEK_SET) != 0)
+		goto out;
+	data = malloc((size_t)len);
+	if (!data)
+		goto out;
+	if (fread(data, 1, (size_t)len, fp) != (size_t)len)
+	{
+		free(data);
+		data = NULL;
+		goto out;
+	}
+	*size = (size_t)len;
+out:
+	fclose(fp);
+	return data;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t size = 0;
+	long iterations = 100000;
+	uint8_t* data;
+	struct timespec t0, t1;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: %s EDID_FILE [ITERATIONS]\n", argv[0]);
+		return 1;
+	}
+	if (argc > 2)
+		iterations = strtol(argv[2], NULL, 0);
+	if (iterations <= 0)
+		iterations = 1;
+
+	data = LoadFile(argv[1], &size);
+	if (!data)
+	{
+		fprintf(stderr, "Failed to load %s\n", argv[1]);
+		return 1;
+	}
+
+	size_t count = DecodeDump(data, size, 1);
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (long i = 0; i < iterations; i++)
+		DecodeDump(data, size, 0);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+	printf("%zu bytes, %zu EDID(s), %ld iterations: %.1f ns/dump, %.1f MB/s\n",
+		size, count, iterations, ns / iterations, (double)size * iterations / ns * 1e3);
+
+	free(data);
+	return 0;
+}
+#endif
@@ -40,76 +40,210 @@ gnwinfo_ctx_error_callback(LPCSTR lpszText)
 	MessageBoxA(g_ctx.wnd, lpszText, "Error", MB_ICONERROR);
 }
 
+typedef enum
+{
+	GNW_RETIRE_NODE,
+	GNW_RETIRE_MEM,
+	GNW_RETIRE_GPU,
+} GNW_RETIRE_TYPE;
+
+typedef struct
+{
+	LONG64 epoch;
+	GNW_RETIRE_TYPE type;
+	void* ptr;
+} GNW_RETIRED;
+
+// Updater-owned. Objects replaced by the snapshot under construction wait
+// in m_pending until it is published, then move to m_retired tagged with
+// the epoch that stopped referencing them.
+static GNW_RETIRED* m_retired;
+static size_t m_retired_count;
+static size_t m_retired_cap;
+static GNW_RETIRED* m_pending;
+static size_t m_pending_count;
+static size_t m_pending_cap;
+
+static UINT64 m_net_generation;
+static UINT64 m_net_flags;
+
+static void
+snap_push(GNW_RETIRED** list, size_t* count, size_t* cap, GNW_RETIRE_TYPE type, void* ptr, LONG64 epoch)
+{
+	if (ptr == NULL)
+		return;
+	if (*count >= *cap)
+	{
+		size_t new_cap = *cap ? *cap * 2 : 16;
+		GNW_RETIRED* p = realloc(*list, new_cap * sizeof(GNW_RETIRED));
+		if (!p)
+			NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to retire snapshot");
+		*list = p;
+		*cap = new_cap;
+	}
+	(*list)[*count].epoch = epoch;
+	(*list)[*count].type = type;
+	(*list)[*count].ptr = ptr;
+	(*count)++;
+}
+
+static void
+snap_free(GNW_RETIRED* r)
+{
+	switch (r->type)
+	{
+	case GNW_RETIRE_NODE:
+		NWL_NodeFree(r->ptr, 1);
+		break;
+	case GNW_RETIRE_GPU:
+		NWL_FreeGpu(r->ptr);
+		break;
+	case GNW_RETIRE_MEM:
+	default:
+		free(r->ptr);
+		break;
+	}
+}
+
+static void
+snap_reclaim(BOOL force)
+{
+	LONG64 reader = InterlockedCompareExchange64(&g_ctx.read_epoch, 0, 0);
+	size_t kept = 0;
+	for (size_t i = 0; i < m_retired_count; i++)
+	{
+		// A reader pinned at epoch E only sees snapshots >= E,
+		// which no longer reference anything retired at or before E.
+		if (force || reader == 0 || reader >= m_retired[i].epoch)
+			snap_free(&m_retired[i]);
+		else
+			m_retired[kept++] = m_retired[i];
+	}
+	m_retired_count = kept;
+}
+
+static GNW_SNAPSHOT*
+snap_begin(void)
+{
+	GNW_SNAPSHOT* s = malloc(sizeof(GNW_SNAPSHOT));
+	if (!s)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate snapshot");
+	*s = *g_ctx.snap;
+	return s;
+}
+
+static void
+snap_replace(void* field, void* value, GNW_RETIRE_TYPE type)
+{
+	void** p = (void**)field;
+	if (*p == value)
+		return;
+	snap_push(&m_pending, &m_pending_count, &m_pending_cap, type, *p, 0);
+	*p = value;
+}
+
+static void
+snap_publish(GNW_SNAPSHOT* s)
+{
+	GNW_SNAPSHOT* old = g_ctx.snap;
+	LONG64 epoch = g_ctx.snap_epoch + 1;
+
+	// Pointer first: a reader that sees the new epoch must also see the new snapshot.
+	InterlockedExchangePointer((PVOID volatile*)&g_ctx.snap, s);
+	InterlockedExchange64(&g_ctx.snap_epoch, epoch);
+
+	snap_push(&m_retired, &m_retired_count, &m_retired_cap, GNW_RETIRE_MEM, old, epoch);
+	for (size_t i = 0; i < m_pending_count; i++)
+		snap_push(&m_retired, &m_retired_count, &m_retired_cap, m_pending[i].type, m_pending[i].ptr, epoch);
+	m_pending_count = 0;
+	snap_reclaim(FALSE);
+}
+
+static void
+snap_copy_gpu(GNW_SNAPSHOT* s)
+{
+	PNWLIB_GPU_INFO gpu = g_ctx.lib.NwGpu;
+	s->gpu_count = 0;
+	s->gpu_pci = NULL;
+	if (!gpu)
+		return;
+	s->gpu_count = gpu->DeviceCount;
+	if (s->gpu_count > NWL_GPU_MAX_COUNT)
+		s->gpu_count = NWL_GPU_MAX_COUNT;
+	memcpy(s->gpu, gpu->Device, s->gpu_count * sizeof(NWLIB_GPU_DEV));
+	s->gpu_pci = gpu->PciList;
+}
+
+const GNW_SNAPSHOT*
+gnwinfo_ctx_read_begin(void)
+{
+	if (g_ctx.read_depth++ == 0)
+	{
+		LONG64 epoch;
+		do
+		{
+			epoch = InterlockedCompareExchange64(&g_ctx.snap_epoch, 0, 0);
+			InterlockedExchange64(&g_ctx.read_epoch, epoch);
+		} while (epoch != InterlockedCompareExchange64(&g_ctx.snap_epoch, 0, 0));
+		g_ctx.frame = g_ctx.snap;
+	}
+	return g_ctx.frame;
+}
+
+void
+gnwinfo_ctx_read_end(void)
+{
+	if (--g_ctx.read_depth == 0)
+		InterlockedExchange64(&g_ctx.read_epoch, 0);
+}
+
 static void
 gnwinfo_ctx_update_1s(void)
 {
-	PNODE network = NULL;
-	NWLIB_MEM_INFO mem_status = { 0 };
-	NWLIB_NET_TRAFFIC net_traffic = { 0 };
-	double cpu_usage = 0.0;
-	DWORD cpu_freq = 0;
 	NWLIB_CPU_INFO* cpu_info = NULL;
-	NWLIB_CUR_DISPLAY cur_display = { 0 };
-	UINT audio_count = 0;
 	NWLIB_AUDIO_DEV* audio = NULL;
-	CHAR sys_uptime[NWL_STR_SIZE] = { 0 };
-	DWORD main_flag = 0;
-	GNWINFO_MAIN_VIEW display_view = GNWINFO_MAIN_VIEW_SUMMARY;
-	NWLIB_MEM_SENSORS mem_sensors = { 0 };
-
-	AcquireSRWLockShared(&g_ctx.lock);
-	display_view = g_ctx.display_view;
-	ReleaseSRWLockShared(&g_ctx.lock);
-	if (display_view == GNWINFO_MAIN_VIEW_SENSOR)
+	UINT audio_count = 0;
+	DWORD main_flag = g_ctx.main_flag;
+	GNW_SNAPSHOT* s;
+
+	if (g_ctx.display_view == GNWINFO_MAIN_VIEW_SENSOR)
 	{
-		PNODE sensors = NW_Sensors(FALSE);
-		AcquireSRWLockExclusive(&g_ctx.lock);
-		PNODE old_sensors = g_ctx.sensors;
-		g_ctx.sensors = sensors;
-		ReleaseSRWLockExclusive(&g_ctx.lock);
-		NWL_NodeFree(old_sensors, 1);
+		s = snap_begin();
+		snap_replace(&s->sensors, NW_Sensors(FALSE), GNW_RETIRE_NODE);
+		gnwinfo_history_feed(s->sensors);
+		snap_publish(s);
 		return;
 	}
 
-	AcquireSRWLockShared(&g_ctx.lock);
-	main_flag = g_ctx.main_flag;
-	mem_sensors = g_ctx.mem_sensors;
-	ReleaseSRWLockShared(&g_ctx.lock);
-
+	s = snap_begin();
 	g_ctx.lib.NetFlags = NW_NET_PHYS | ((main_flag & MAIN_NET_INACTIVE) ? 0 : NW_NET_ACTIVE);
-	NWL_GetUptime(sys_uptime, NWL_STR_SIZE);
-	NWL_GetMemInfo(&mem_status);
-	network = NW_Network(FALSE);
-	NWL_GetNetTraffic(&net_traffic, !(main_flag & MAIN_NET_UNIT_B), NWLC->NwNetAdapters);
-	cpu_usage = NWL_GetCpuUsage();
-	cpu_freq = NWL_GetCpuFreq();
+	NWL_GetUptime(s->sys_uptime, NWL_STR_SIZE);
+	NWL_GetMemInfo(&s->mem_status);
+	// The adapter map is only re-read on change notifications, most ticks
+	// just update the counters and keep the previous node.
+	NWLC->NwNetAdapters = NWL_GetNetAdapters(NWLC->NwNetAdapters);
+	if (s->network == NULL || m_net_generation != NWLC->NwNetGeneration || m_net_flags != g_ctx.lib.NetFlags)
+	{
+		m_net_generation = NWLC->NwNetGeneration;
+		m_net_flags = g_ctx.lib.NetFlags;
+		snap_replace(&s->network, NWL_NetAdaptersToNode(NWLC->NwNetAdapters), GNW_RETIRE_NODE);
+		snap_replace(&s->vm_network, gnwinfo_view_network(s->network), GNW_RETIRE_MEM);
+	}
+	NWL_GetNetTraffic(&s->net_traffic, !(main_flag & MAIN_NET_UNIT_B), NWLC->NwNetAdapters);
+	s->cpu_usage = NWL_GetCpuUsage();
+	s->cpu_freq = NWL_GetCpuFreq();
 	cpu_info = NWL_GetCpuMsr();
-	NWL_GetCurDisplay(g_ctx.wnd, &cur_display);
+	snap_replace(&s->cpu_info, cpu_info, GNW_RETIRE_MEM);
+	NWL_GetCurDisplay(g_ctx.wnd, &s->cur_display);
+	NWL_GetGpuInfo(g_ctx.lib.NwGpu);
+	snap_copy_gpu(s);
 	if (main_flag & MAIN_INFO_AUDIO)
 		audio = NWL_GetAudio(&audio_count);
-	NWL_GetMemSensors(g_ctx.lib.NwSmbus, &mem_sensors);
-
-	AcquireSRWLockExclusive(&g_ctx.lock);
-	PNODE old_network = g_ctx.network;
-	g_ctx.network = network;
-	memcpy(g_ctx.sys_uptime, sys_uptime, sizeof(g_ctx.sys_uptime));
-	g_ctx.mem_status = mem_status;
-	g_ctx.net_traffic = net_traffic;
-	g_ctx.cpu_usage = cpu_usage;
-	g_ctx.cpu_freq = cpu_freq;
-	NWLIB_CPU_INFO* old_cpu = g_ctx.cpu_info;
-	g_ctx.cpu_info = cpu_info;
-	g_ctx.cur_display = cur_display;
-	NWL_GetGpuInfo(g_ctx.lib.NwGpu);
-	NWLIB_AUDIO_DEV* old_audio = g_ctx.audio;
-	g_ctx.audio = audio;
-	g_ctx.audio_count = audio_count;
-	g_ctx.mem_sensors = mem_sensors;
-	ReleaseSRWLockExclusive(&g_ctx.lock);
-
-	NWL_NodeFree(old_network, 1);
-	free(old_audio);
-	free(old_cpu);
+	snap_replace(&s->audio, audio, GNW_RETIRE_MEM);
+	s->audio_count = audio_count;
+	NWL_GetMemSensors(g_ctx.lib.NwSmbus, &s->mem_sensors);
+	snap_replace(&s->vm_audio, gnwinfo_view_audio(s->audio, s->audio_count), GNW_RETIRE_MEM);
+	snap_publish(s);
 
 	gnwinfo_update_systray(g_ctx.wnd, g_window_icon);
 }
@@ -117,85 +251,84 @@ gnwinfo_ctx_update_1s(void)
 static void
 gnwinfo_ctx_update_battery(void)
 {
-	PNODE battery = NW_Battery(FALSE);
-
-	AcquireSRWLockExclusive(&g_ctx.lock);
-	PNODE old_battery = g_ctx.battery;
-	g_ctx.battery = battery;
-	ReleaseSRWLockExclusive(&g_ctx.lock);
-
-	NWL_NodeFree(old_battery, 1);
+	GNW_SNAPSHOT* s = snap_begin();
+	snap_replace(&s->battery, NW_Battery(FALSE), GNW_RETIRE_NODE);
+	snap_replace(&s->vm_power, gnwinfo_view_power(s->battery), GNW_RETIRE_MEM);
+	snap_publish(s);
 }
 
 static void
 gnwinfo_ctx_update_disk(void)
 {
-	DWORD main_flag = 0;
 	InterlockedExchange(&g_ctx.init_done, 0);
-	AcquireSRWLockShared(&g_ctx.lock);
-	main_flag = g_ctx.main_flag;
-	ReleaseSRWLockShared(&g_ctx.lock);
 
 	g_ctx.lib.NwSmartInit = FALSE;
-	g_ctx.lib.DiskFlags = (main_flag & MAIN_DISK_SMART) ? 0 : NW_DISK_NO_SMART;
+	g_ctx.lib.DiskFlags = (g_ctx.main_flag & MAIN_DISK_SMART) ? 0 : NW_DISK_NO_SMART;
 
-	PNODE disk = NW_Disk(FALSE);
-
-	AcquireSRWLockExclusive(&g_ctx.lock);
-	PNODE old_disk = g_ctx.disk;
-	g_ctx.disk = disk;
-	ReleaseSRWLockExclusive(&g_ctx.lock);
-
-	NWL_NodeFree(old_disk, 1);
+	GNW_SNAPSHOT* s = snap_begin();
+	snap_replace(&s->disk, NW_Disk(FALSE), GNW_RETIRE_NODE);
+	snap_replace(&s->vm_disk, gnwinfo_view_disk(s->disk), GNW_RETIRE_MEM);
+	snap_publish(s);
 }
 
 static void
 gnwinfo_ctx_update_smb(void)
 {
-	PNODE smb = NW_NetShare(FALSE);
-
-	AcquireSRWLockExclusive(&g_ctx.lock);
-	PNODE old_smb = g_ctx.smb;
-	g_ctx.smb = smb;
-	ReleaseSRWLockExclusive(&g_ctx.lock);
-
-	NWL_NodeFree(old_smb, 1);
+	GNW_SNAPSHOT* s = snap_begin();
+	snap_replace(&s->smb, NW_NetShare(FALSE), GNW_RETIRE_NODE);
+	snap_replace(&s->vm_smb, gnwinfo_view_smb(s->smb), GNW_RETIRE_MEM);
+	snap_publish(s);
 }
 
 static void
 gnwinfo_ctx_update_display(void)
 {
-	PNODE edid = NW_Edid(FALSE);
 	InterlockedExchange(&g_ctx.init_done, 0);
-	AcquireSRWLockExclusive(&g_ctx.lock);
-	PNWLIB_GPU_INFO gpu = g_ctx.lib.NwGpu;
-	g_ctx.lib.NwGpu = NULL;
-	NWL_FreeGpu(gpu);
-	PNODE old_edid = g_ctx.edid;
-	g_ctx.edid = edid;
-	ReleaseSRWLockExclusive(&g_ctx.lock);
 
+	GNW_SNAPSHOT* s = snap_begin();
+	snap_replace(&s->edid, NW_Edid(FALSE), GNW_RETIRE_NODE);
+	// The old GPU list stays alive until readers drop its PCI nodes.
+	snap_push(&m_pending, &m_pending_count, &m_pending_cap, GNW_RETIRE_GPU, g_ctx.lib.NwGpu, 0);
 	g_ctx.lib.NwGpu = NWL_InitGpu();
-	NWL_NodeFree(old_edid, 1);
+	snap_copy_gpu(s);
+	snap_replace(&s->vm_gpu, gnwinfo_view_gpu(s->gpu_pci), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_edid, gnwinfo_view_edid(s->edid), GNW_RETIRE_MEM);
+	snap_publish(s);
 }
 
 static void
 gnwinfo_ctx_update_spd(void)
 {
-	DWORD main_flag = 0;
 	InterlockedExchange(&g_ctx.init_done, 0);
-	AcquireSRWLockShared(&g_ctx.lock);
-	main_flag = g_ctx.main_flag;
-	ReleaseSRWLockShared(&g_ctx.lock);
 
-	PNODE spd = (main_flag & MAIN_SMBUS_SPD) ? NULL : NW_Spd(FALSE);
+	PNODE spd = (g_ctx.main_flag & MAIN_SMBUS_SPD) ? NULL : NW_Spd(FALSE);
 
-	AcquireSRWLockExclusive(&g_ctx.lock);
-	PNODE old_spd = g_ctx.spd;
-	g_ctx.spd = spd;
-	ReleaseSRWLockExclusive(&g_ctx.lock);
+	GNW_SNAPSHOT* s = snap_begin();
+	snap_replace(&s->spd, spd, GNW_RETIRE_NODE);
+	snap_replace(&s->vm_spd, gnwinfo_view_spd(s->spd), GNW_RETIRE_MEM);
+	snap_publish(s);
+}
 
-	NWL_NodeFree(old_spd, 1);
+// Rebuild every summary string, after startup or a language or flag change.
+static void
+gnwinfo_ctx_update_view(void)
+{
+	GNW_SNAPSHOT* s = snap_begin();
+	s->vm_lang = g_lang_id;
+	s->vm_flag = g_ctx.main_flag;
+	snap_replace(&s->vm_system, gnwinfo_view_system(), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_cpu, gnwinfo_view_cpu(), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_dmi, gnwinfo_view_dmi(), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_sdc, gnwinfo_view_sdc(), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_power, gnwinfo_view_power(s->battery), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_spd, gnwinfo_view_spd(s->spd), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_gpu, gnwinfo_view_gpu(s->gpu_pci), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_edid, gnwinfo_view_edid(s->edid), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_disk, gnwinfo_view_disk(s->disk), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_smb, gnwinfo_view_smb(s->smb), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_network, gnwinfo_view_network(s->network), GNW_RETIRE_MEM);
+	snap_replace(&s->vm_audio, gnwinfo_view_audio(s->audio, s->audio_count), GNW_RETIRE_MEM);
+	snap_publish(s);
 }
 
 static const struct
@@ -211,6 +344,7 @@ static const struct
 	{ IDT_TIMER_POWER, gnwinfo_ctx_update_battery },
 	{ IDT_TIMER_SMB, gnwinfo_ctx_update_smb },
 	{ IDT_TIMER_SPD, gnwinfo_ctx_update_spd },
+	{ IDT_TIMER_VIEW, gnwinfo_ctx_update_view },
 };
 
 static void
@@ -277,7 +411,11 @@ gnwinfo_ctx_init(HINSTANCE inst, HWND wnd, struct nk_context* ctx, float width,
 		exit(1);
 	}
 
-	InitializeSRWLock(&g_ctx.lock);
+	g_ctx.snap = calloc(1, sizeof(GNW_SNAPSHOT));
+	if (!g_ctx.snap)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate snapshot");
+	g_ctx.snap_epoch = 1;
+	g_ctx.read_epoch = 0;
 	g_ctx.init_done = 0;
 	g_ctx.update_mask = 0;
 	g_ctx.exit_pending = 0;
@@ -377,7 +515,7 @@ gnwinfo_ctx_init(HINSTANCE inst, HWND wnd, struct nk_context* ctx, float width,
 	g_ctx.sys_disk = NWL_NodeAttrGet(g_ctx.system, "System Device");
 
 	g_ctx.cpu_count = (int)g_ctx.lib.NwCpuid->num_cpu_types;
-	g_ctx.cpu_info = NWL_GetCpuMsr();
+	g_ctx.snap->cpu_info = NWL_GetCpuMsr();
 
 	NWL_GetHostname(g_ctx.sys_hostname);
 
@@ -387,6 +525,7 @@ gnwinfo_ctx_init(HINSTANCE inst, HWND wnd, struct nk_context* ctx, float width,
 	gnwinfo_ctx_update(IDT_TIMER_DISK);
 	gnwinfo_ctx_update(IDT_TIMER_SMB);
 	gnwinfo_ctx_update(IDT_TIMER_SPD);
+	gnwinfo_ctx_update(IDT_TIMER_VIEW);
 	if (!g_ctx.update_event || !g_ctx.update_thread)
 		InterlockedExchange(&g_ctx.init_done, 1);
 
@@ -423,21 +562,45 @@ gnwinfo_ctx_exit(void)
 		g_ctx.stop_event = NULL;
 	}
 
-	if (g_ctx.cpu_info)
-		free(g_ctx.cpu_info);
-
-	if (g_ctx.audio)
-		free(g_ctx.audio);
+	gnwinfo_history_free();
+	snap_reclaim(TRUE);
+	free(m_retired);
+	m_retired = NULL;
+	m_retired_cap = 0;
+	for (size_t i = 0; i < m_pending_count; i++)
+		snap_free(&m_pending[i]);
+	free(m_pending);
+	m_pending = NULL;
+	m_pending_count = m_pending_cap = 0;
+
+	GNW_SNAPSHOT* s = g_ctx.snap;
+	g_ctx.snap = NULL;
+	g_ctx.frame = NULL;
+	free(s->cpu_info);
+	free(s->audio);
+	NWL_NodeFree(s->network, 1);
+	NWL_NodeFree(s->disk, 1);
+	NWL_NodeFree(s->smb, 1);
+	NWL_NodeFree(s->spd, 1);
+	NWL_NodeFree(s->battery, 1);
+	NWL_NodeFree(s->edid, 1);
+	NWL_NodeFree(s->sensors, 1);
+	free(s->vm_system);
+	free(s->vm_cpu);
+	free(s->vm_dmi);
+	free(s->vm_sdc);
+	free(s->vm_power);
+	free(s->vm_spd);
+	free(s->vm_gpu);
+	free(s->vm_edid);
+	free(s->vm_disk);
+	free(s->vm_smb);
+	free(s->vm_network);
+	free(s->vm_audio);
+	free(s);
 
 	ReleaseMutex(g_ctx.mutex);
 	CloseHandle(g_ctx.mutex);
-	NWL_NodeFree(g_ctx.network, 1);
-	NWL_NodeFree(g_ctx.disk, 1);
-	NWL_NodeFree(g_ctx.smb, 1);
-	NWL_NodeFree(g_ctx.spd, 1);
-	NWL_NodeFree(g_ctx.battery, 1);
-	NWL_NodeFree(g_ctx.edid, 1);
-	NWL_NodeFree(g_ctx.sensors, 1);
 	NW_Fini();
 	for (WORD i = 0; i < sizeof(g_ctx.image) / sizeof(g_ctx.image[0]); i++)
 		nk_gdip_image_free(g_ctx.image[i]);
@@ -33,8 +33,8 @@ gnwinfo_draw_cpuid_window(struct nk_context* ctx, float width, float height)
 		return;
 	NWLIB_CPU_INFO empty = { 0 };
 	NWLIB_CPU_INFO* msr = &empty;
-	if (g_ctx.cpu_info)
-		msr = &g_ctx.cpu_info[cpu_index];
+	if (g_ctx.frame->cpu_info)
+		msr = &g_ctx.frame->cpu_info[cpu_index];
 
 	nk_layout_row(ctx, NK_DYNAMIC, g_col_height, 2, (float[2]) { 0.2f, 0.8f });
 
@@ -55,7 +55,7 @@ gnwinfo_draw_cpuid_window(struct nk_context* ctx, float width, float height)
 	snprintf(buf, MAX_PATH, "%s %d, %s %s, %lu MHz",
 		N_(N__TOTAL), g_ctx.cpu_count,
 		NWL_NodeAttrGet(g_ctx.cpuid, "Total CPUs"), N_(N__THREADS),
-		g_ctx.cpu_freq);
+		g_ctx.frame->cpu_freq);
 	nk_l(ctx, buf, NK_TEXT_CENTERED);
 
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.2f, 0.8f });
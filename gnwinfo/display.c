@@ -15,10 +15,10 @@ draw_key_value(struct nk_context* ctx, PNODE node, LPCSTR key)
 static VOID
 draw_monitors(struct nk_context* ctx)
 {
-	INT count = NWL_NodeChildCount(g_ctx.edid);
+	INT count = NWL_NodeChildCount(g_ctx.frame->edid);
 	for (INT i = 0; i < count; i++)
 	{
-		PNODE mon = NWL_NodeEnumChild(g_ctx.edid, i);
+		PNODE mon = NWL_NodeEnumChild(g_ctx.frame->edid, i);
 		LPCSTR id = NWL_NodeAttrGet(mon, "ID");
 		if (id[0] == '-')
 			continue;
@@ -47,9 +47,7 @@ draw_monitors(struct nk_context* ctx)
 static VOID
 draw_gpu(struct nk_context* ctx)
 {
-	if (!g_ctx.lib.NwGpu)
-		return;
-	PNODE pci03 = g_ctx.lib.NwGpu->PciList;
+	PNODE pci03 = g_ctx.frame->gpu_pci;
 	INT pci03_count = NWL_NodeChildCount(pci03);
 	for (INT i = 0; i < pci03_count; i++)
 	{
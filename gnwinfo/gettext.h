@@ -171,6 +171,11 @@ typedef enum _GETTEXT_STR_ID
 	N__FREE,
 	N__CLOSE,
 	N__INSTALL_PAWNIO,
+	N__MINIMUM,
+	N__AVERAGE,
+	N__MAXIMUM,
+	N__5_MINUTES,
+	N__1_HOUR,
 	N__MAX_,
 } GETTEXT_STR_ID;
 
@@ -432,7 +432,7 @@ wWinMain(_In_ HINSTANCE hInstance,
 		nk_input_end(ctx);
 
 		/* GUI */
-		AcquireSRWLockExclusive(&g_ctx.lock);
+		gnwinfo_ctx_read_begin();
 		if (g_ctx.window_flag & GUI_WINDOW_SETTINGS)
 			gnwinfo_set_style(ctx);
 		gnwinfo_draw_main_window(ctx, g_ctx.gui_width, g_ctx.gui_height);
@@ -442,7 +442,7 @@ wWinMain(_In_ HINSTANCE hInstance,
 		gnwinfo_draw_display_window(ctx, g_ctx.gui_width, g_ctx.gui_height);
 		gnwinfo_draw_mm_window(ctx, g_ctx.gui_width, g_ctx.gui_height);
 		gnwinfo_draw_hostname_window(ctx, g_ctx.gui_width, g_ctx.gui_height);
-		ReleaseSRWLockExclusive(&g_ctx.lock);
+		gnwinfo_ctx_read_end();
 		if (g_ctx.exit_pending)
 			running = 0;
 
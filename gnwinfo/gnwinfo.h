@@ -141,6 +141,129 @@ typedef enum _GNWINFO_MAIN_VIEW
 	GNWINFO_MAIN_VIEW_BOARD,
 } GNWINFO_MAIN_VIEW;
 
+// One ready-to-draw summary line, composed by the updater (view.c).
+typedef struct _GNW_VM_ROW
+{
+	UINT32 flags;
+	UINT32 level;
+	double value;
+	PNODE node;
+	CHAR label[MAX_PATH];
+	CHAR text[MAX_PATH];
+	CHAR detail[MAX_PATH];
+	CHAR extra[MAX_PATH];
+	CHAR key[NWL_STR_SIZE];
+} GNW_VM_ROW;
+
+typedef struct _GNW_VM_LIST
+{
+	size_t count;
+	GNW_VM_ROW* rows;
+} GNW_VM_LIST;
+
+#define GNW_VM_COUNT(list) ((list) ? (list)->count : 0)
+
+// Row flags
+#define GNW_VM_DISK          (1U << 0)
+#define GNW_VM_VOLUME        (1U << 1)
+#define GNW_VM_LISTED        (1U << 2)
+#define GNW_VM_CDROM         (1U << 3)
+#define GNW_VM_SYSTEM_VOL    (1U << 4)
+#define GNW_VM_SMART         (1U << 5)
+#define GNW_VM_ACTIVE        (1U << 6)
+#define GNW_VM_WLAN          (1U << 7)
+#define GNW_VM_WLAN_INFO     (1U << 8)
+#define GNW_VM_DEFAULT       (1U << 9)
+#define GNW_VM_VOLUMES       (1U << 10)
+
+// Row levels
+#define GNW_VM_LEVEL_UNKNOWN 0
+#define GNW_VM_LEVEL_GOOD    1
+#define GNW_VM_LEVEL_WARNING 2
+#define GNW_VM_LEVEL_ERROR   3
+
+// Sensor history (history.c), fixed size per sensor.
+#define GNW_HIST_RAW_COUNT    300 // 1s samples, 5 minutes
+#define GNW_HIST_MINUTE_COUNT 60  // 1min averages, 1 hour
+
+#define GNW_HIST_TIER_RAW     0
+#define GNW_HIST_TIER_MINUTE  1
+
+typedef struct _GNW_HIST_VIEW
+{
+	int tier;
+	UINT32 count;
+	float last;
+	float min;
+	float max;
+	float avg;
+	float data[GNW_HIST_RAW_COUNT]; // oldest first
+} GNW_HIST_VIEW;
+
+// Fixed rows of GNW_SNAPSHOT.vm_system
+enum
+{
+	GNW_VM_ROW_OS = 0,
+	GNW_VM_ROW_LOGIN,
+	GNW_VM_ROW_FIRMWARE,
+	GNW_VM_ROW_BIOS_VENDOR,
+	GNW_VM_ROW_BIOS_VERSION,
+	GNW_VM_ROW_SYSTEM,
+	GNW_VM_ROW_BOARD,
+	GNW_VM_ROW_MEM_CAPACITY,
+	GNW_VM_ROW_MAX,
+};
+
+// Everything the updater refreshes after startup. A published snapshot is
+// never modified; the updater copies it, replaces what changed and swaps
+// the pointer. Replaced objects are freed once no reader can see them.
+typedef struct _GNW_SNAPSHOT
+{
+	PNODE network;
+	PNODE disk;
+	PNODE edid;
+	PNODE battery;
+	PNODE smb;
+	PNODE spd;
+	PNODE sensors;
+
+	NWLIB_NET_TRAFFIC net_traffic;
+	DWORD cpu_freq;
+	double cpu_usage;
+	NWLIB_CPU_INFO* cpu_info;
+
+	CHAR sys_uptime[NWL_STR_SIZE];
+	NWLIB_MEM_INFO mem_status;
+
+	NWLIB_CUR_DISPLAY cur_display;
+
+	UINT audio_count;
+	NWLIB_AUDIO_DEV* audio;
+
+	NWLIB_MEM_SENSORS mem_sensors;
+
+	uint32_t gpu_count;
+	NWLIB_GPU_DEV gpu[NWL_GPU_MAX_COUNT];
+	PNODE gpu_pci;
+
+	// Summary view-model, rebuilt together with its source.
+	// vm_lang and vm_flag record the settings the strings were built for.
+	LANGID vm_lang;
+	UINT32 vm_flag;
+	GNW_VM_LIST* vm_system;
+	GNW_VM_LIST* vm_cpu;
+	GNW_VM_LIST* vm_dmi;
+	GNW_VM_LIST* vm_sdc;
+	GNW_VM_LIST* vm_power;
+	GNW_VM_LIST* vm_spd;
+	GNW_VM_LIST* vm_gpu;
+	GNW_VM_LIST* vm_edid;
+	GNW_VM_LIST* vm_disk;
+	GNW_VM_LIST* vm_smb;
+	GNW_VM_LIST* vm_network;
+	GNW_VM_LIST* vm_audio;
+} GNW_SNAPSHOT;
+
 typedef struct _GNW_CONTEXT
 {
 	HINSTANCE inst;
@@ -170,37 +293,24 @@ typedef struct _GNW_CONTEXT
 	PNODE smbios;
 	PNODE board;
 	PNODE sdc;
-	PNODE network;
-	PNODE disk;
-	PNODE edid;
 	PNODE pci;
 	PNODE uefi;
-	PNODE battery;
-	PNODE smb;
-	PNODE spd;
-	PNODE sensors;
 
 	LPCSTR sys_boot;
 	LPCSTR sys_disk;
 
-	NWLIB_NET_TRAFFIC net_traffic;
-	DWORD cpu_freq;
-	double cpu_usage;
 	int cpu_count;
-	NWLIB_CPU_INFO* cpu_info;
 
 	CHAR sys_hostname[MAX_COMPUTERNAME_LENGTH + 1];
-	CHAR sys_uptime[NWL_STR_SIZE];
-	NWLIB_MEM_INFO mem_status;
-
-	NWLIB_CUR_DISPLAY cur_display;
-
-	UINT audio_count;
-	NWLIB_AUDIO_DEV* audio;
 
-	NWLIB_MEM_SENSORS mem_sensors;
+	// Written only by the updater, published with InterlockedExchangePointer.
+	GNW_SNAPSHOT* volatile snap;
+	volatile LONG64 snap_epoch;
+	// Epoch pinned by the UI thread while drawing, 0 when idle.
+	volatile LONG64 read_epoch;
+	const GNW_SNAPSHOT* frame;
+	int read_depth;
 
-	SRWLOCK lock;
 	HANDLE update_event;
 	HANDLE stop_event;
 	HANDLE update_thread;
@@ -250,6 +360,8 @@ extern struct nk_color g_color_back;
 void gnwinfo_ctx_update(WPARAM wparam);
 void gnwinfo_ctx_init(HINSTANCE inst, HWND wnd, struct nk_context* ctx, float width, float height);
 void gnwinfo_ctx_exit(void);
+const GNW_SNAPSHOT* gnwinfo_ctx_read_begin(void);
+void gnwinfo_ctx_read_end(void);
 VOID gnwinfo_draw_main_window(struct nk_context* ctx, float width, float height);
 VOID gnwinfo_draw_cpuid_window(struct nk_context* ctx, float width, float height);
 VOID gnwinfo_draw_about_window(struct nk_context* ctx, float width, float height);
@@ -277,6 +389,25 @@ void gnwinfo_draw_percent_prog(struct nk_context* ctx, double percent);
 
 UINT64 gnwinfo_clean_memory(VOID);
 
+GNW_VM_LIST* gnwinfo_view_system(void);
+GNW_VM_LIST* gnwinfo_view_cpu(void);
+GNW_VM_LIST* gnwinfo_view_dmi(void);
+GNW_VM_LIST* gnwinfo_view_sdc(void);
+GNW_VM_LIST* gnwinfo_view_power(PNODE battery);
+GNW_VM_LIST* gnwinfo_view_spd(PNODE spd);
+GNW_VM_LIST* gnwinfo_view_gpu(PNODE pci);
+GNW_VM_LIST* gnwinfo_view_edid(PNODE edid);
+GNW_VM_LIST* gnwinfo_view_disk(PNODE disk);
+GNW_VM_LIST* gnwinfo_view_smb(PNODE smb);
+GNW_VM_LIST* gnwinfo_view_network(PNODE network);
+GNW_VM_LIST* gnwinfo_view_audio(const NWLIB_AUDIO_DEV* audio, UINT count);
+
+UINT32 gnwinfo_history_key(UINT32 seed, LPCSTR str);
+void gnwinfo_history_feed(PNODE sensors);
+BOOL gnwinfo_history_read(UINT32 key, GNW_HIST_VIEW* view);
+void gnwinfo_history_toggle(UINT32 key);
+void gnwinfo_history_free(void);
+
 void gnwinfo_add_systray(HWND wnd, HICON icon);
 void gnwinfo_remove_systray(HWND wnd);
 void gnwinfo_update_systray(HWND wnd, HICON icon);
@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <windows.h>
+#include <stdlib.h>
+#include "gnwinfo.h"
+
+#define HIST_SERIES_MAX 512
+#define HIST_SLOT_COUNT 1024 // power of two, twice HIST_SERIES_MAX
+#define HIST_READ_RETRY 4
+
+// One numeric sensor reading. Written only by the updater; the renderer
+// copies it out under the sequence counter and retries on a torn read.
+// The tier shown by the sparkline belongs to the renderer alone.
+typedef struct
+{
+	volatile LONG seq;
+	UINT32 key;
+	int tier;
+	UINT32 raw_head;
+	UINT32 raw_count;
+	UINT32 minute_head;
+	UINT32 minute_count;
+	UINT32 acc_count;
+	float acc_sum;
+	float last;
+	float raw[GNW_HIST_RAW_COUNT];
+	float minute[GNW_HIST_MINUTE_COUNT];
+} HIST_SERIES;
+
+typedef struct
+{
+	// Index + 1 into series, 0 for an empty slot.
+	volatile LONG slot[HIST_SLOT_COUNT];
+	volatile LONG count;
+	HIST_SERIES series[HIST_SERIES_MAX];
+} HIST_STORE;
+
+// Allocated once by the updater on the first sample, never resized.
+static HIST_STORE* volatile m_hist;
+
+UINT32
+gnwinfo_history_key(UINT32 seed, LPCSTR str)
+{
+	// FNV-1a, with a separator so "a/bc" and "ab/c" differ.
+	UINT32 h = seed ? seed : 2166136261U;
+	for (; *str; str++)
+	{
+		h ^= (UCHAR)*str;
+		h *= 16777619U;
+	}
+	h ^= 0x1F;
+	h *= 16777619U;
+	return h;
+}
+
+static HIST_SERIES*
+hist_find(HIST_STORE* store, UINT32 key, BOOL insert)
+{
+	for (UINT32 i = 0; i < HIST_SLOT_COUNT; i++)
+	{
+		UINT32 pos = (key + i) & (HIST_SLOT_COUNT - 1);
+		LONG idx = store->slot[pos];
+		if (idx == 0)
+		{
+			if (!insert || store->count >= HIST_SERIES_MAX)
+				return NULL;
+			HIST_SERIES* s = &store->series[store->count];
+			s->key = key;
+			// Publish the slot after the series is ready.
+			InterlockedExchange(&store->slot[pos], store->count + 1);
+			InterlockedIncrement(&store->count);
+			return s;
+		}
+		if (store->series[idx - 1].key == key)
+			return &store->series[idx - 1];
+	}
+	return NULL;
+}
+
+static void
+hist_push(HIST_SERIES* s, float value)
+{
+	InterlockedIncrement(&s->seq);
+
+	s->raw[s->raw_head] = value;
+	s->raw_head = (s->raw_head + 1) % GNW_HIST_RAW_COUNT;
+	if (s->raw_count < GNW_HIST_RAW_COUNT)
+		s->raw_count++;
+
+	s->acc_sum += value;
+	if (++s->acc_count >= 60)
+	{
+		s->minute[s->minute_head] = s->acc_sum / s->acc_count;
+		s->minute_head = (s->minute_head + 1) % GNW_HIST_MINUTE_COUNT;
+		if (s->minute_count < GNW_HIST_MINUTE_COUNT)
+			s->minute_count++;
+		s->acc_sum = 0.0f;
+		s->acc_count = 0;
+	}
+
+	s->last = value;
+
+	InterlockedIncrement(&s->seq);
+}
+
+static void
+hist_feed_node(HIST_STORE* store, PNODE node, UINT32 seed)
+{
+	int count = NWL_NodeAttrCount(node);
+	for (int i = 0; i < count; i++)
+	{
+		PNODE_ATT att = NWL_NodeAttrEnum(node, i);
+		if (!att || !(att->flags & NAFLG_FMT_NUMERIC))
+			continue;
+		char* end;
+		double value = strtod(att->value, &end);
+		if (end == att->value)
+			continue;
+		HIST_SERIES* s = hist_find(store, gnwinfo_history_key(seed, att->key), TRUE);
+		if (s)
+			hist_push(s, (float)value);
+	}
+
+	count = NWL_NodeChildCount(node);
+	for (int i = 0; i < count; i++)
+	{
+		PNODE child = NWL_NodeEnumChild(node, i);
+		hist_feed_node(store, child, gnwinfo_history_key(seed, child->name));
+	}
+}
+
+void
+gnwinfo_history_feed(PNODE sensors)
+{
+	HIST_STORE* store = m_hist;
+	if (sensors == NULL)
+		return;
+	if (store == NULL)
+	{
+		store = calloc(1, sizeof(HIST_STORE));
+		if (!store)
+			NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate sensor history");
+		InterlockedExchangePointer((PVOID volatile*)&m_hist, store);
+	}
+	int count = NWL_NodeChildCount(sensors);
+	for (int i = 0; i < count; i++)
+	{
+		PNODE child = NWL_NodeEnumChild(sensors, i);
+		hist_feed_node(store, child, gnwinfo_history_key(0, child->name));
+	}
+}
+
+static void
+hist_copy_ring(float* dst, const float* ring, UINT32 head, UINT32 count, UINT32 size)
+{
+	UINT32 start = (head + size - count) % size;
+	UINT32 first = size - start;
+	if (first > count)
+		first = count;
+	memcpy(dst, ring + start, first * sizeof(float));
+	memcpy(dst + first, ring, (count - first) * sizeof(float));
+}
+
+static void
+hist_view_stats(GNW_HIST_VIEW* view)
+{
+	float sum = 0.0f;
+	view->min = view->max = view->avg = 0.0f;
+	if (view->count == 0)
+		return;
+	view->min = view->max = view->data[0];
+	for (UINT32 i = 0; i < view->count; i++)
+	{
+		if (view->data[i] < view->min)
+			view->min = view->data[i];
+		if (view->data[i] > view->max)
+			view->max = view->data[i];
+		sum += view->data[i];
+	}
+	view->avg = sum / view->count;
+}
+
+void
+gnwinfo_history_toggle(UINT32 key)
+{
+	HIST_STORE* store = m_hist;
+	if (store == NULL)
+		return;
+	HIST_SERIES* s = hist_find(store, key, FALSE);
+	if (s)
+		s->tier = (s->tier == GNW_HIST_TIER_RAW) ? GNW_HIST_TIER_MINUTE : GNW_HIST_TIER_RAW;
+}
+
+BOOL
+gnwinfo_history_read(UINT32 key, GNW_HIST_VIEW* view)
+{
+	HIST_STORE* store = m_hist;
+	if (store == NULL)
+		return FALSE;
+	HIST_SERIES* s = hist_find(store, key, FALSE);
+	if (s == NULL)
+		return FALSE;
+	int tier = s->tier;
+
+	for (int retry = 0; retry < HIST_READ_RETRY; retry++)
+	{
+		LONG seq = s->seq;
+		if (seq & 1)
+		{
+			YieldProcessor();
+			continue;
+		}
+		MemoryBarrier();
+		if (tier == GNW_HIST_TIER_MINUTE)
+		{
+			view->count = s->minute_count;
+			hist_copy_ring(view->data, s->minute, s->minute_head, view->count, GNW_HIST_MINUTE_COUNT);
+		}
+		else
+		{
+			view->count = s->raw_count;
+			hist_copy_ring(view->data, s->raw, s->raw_head, view->count, GNW_HIST_RAW_COUNT);
+		}
+		view->last = s->last;
+		MemoryBarrier();
+		if (s->seq == seq)
+		{
+			// Min, max and average cover the tier being shown.
+			view->tier = tier;
+			hist_view_stats(view);
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+void
+gnwinfo_history_free(void)
+{
+	HIST_STORE* store = InterlockedExchangePointer((PVOID volatile*)&m_hist, NULL);
+	free(store);
+}
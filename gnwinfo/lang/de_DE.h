@@ -158,4 +158,9 @@ lang_de_de[N__MAX_] =
 	[N__FREE] = u8"Frei",
 	[N__CLOSE] = u8"Schließen",
 	[N__INSTALL_PAWNIO] = u8"PawnIO installieren", // install the PawnIO driver
+	[N__MINIMUM] = u8"Min",
+	[N__AVERAGE] = u8"Mittel",
+	[N__MAXIMUM] = u8"Max",
+	[N__5_MINUTES] = u8"5 Min.",
+	[N__1_HOUR] = u8"1 Std.",
 };
@@ -157,4 +157,9 @@ lang_el_gr[N__MAX_] =
 	[N__FREE] = u8"Ελεύθερο",
 	[N__CLOSE] = u8"Κλείσιμο",
 	[N__INSTALL_PAWNIO] = u8"Εγκατάσταση PawnIO", // install the PawnIO driver
+	[N__MINIMUM] = u8"Ελάχ.",
+	[N__AVERAGE] = u8"Μ.Ο.",
+	[N__MAXIMUM] = u8"Μέγ.",
+	[N__5_MINUTES] = u8"5 λεπτά",
+	[N__1_HOUR] = u8"1 ώρα",
 };
@@ -174,4 +174,9 @@ lang_en_us[N__MAX_] =
 	[N__FREE] = u8"Free",
 	[N__CLOSE] = u8"Close",
 	[N__INSTALL_PAWNIO] = u8"Install PawnIO", // install the PawnIO driver
+	[N__MINIMUM] = u8"Min",
+	[N__AVERAGE] = u8"Avg",
+	[N__MAXIMUM] = u8"Max",
+	[N__5_MINUTES] = u8"5 min",
+	[N__1_HOUR] = u8"1 h",
 };
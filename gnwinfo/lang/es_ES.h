@@ -158,4 +158,9 @@ lang_es_es[N__MAX_] =
 	[N__FREE] = u8"Libre",
 	[N__CLOSE] = u8"Cerrar",
 	[N__INSTALL_PAWNIO] = u8"Instalar PawnIO", // install the PawnIO driver
+	[N__MINIMUM] = u8"Mín",
+	[N__AVERAGE] = u8"Media",
+	[N__MAXIMUM] = u8"Máx",
+	[N__5_MINUTES] = u8"5 min",
+	[N__1_HOUR] = u8"1 h",
 };
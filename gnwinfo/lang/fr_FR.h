@@ -174,4 +174,9 @@ lang_fr_fr[N__MAX_] =
 	[N__FREE] = u8"Libre",
 	[N__CLOSE] = u8"Fermer",
 	[N__INSTALL_PAWNIO] = u8"Installer PawnIO",
+	[N__MINIMUM] = u8"Min",
+	[N__AVERAGE] = u8"Moy",
+	[N__MAXIMUM] = u8"Max",
+	[N__5_MINUTES] = u8"5 min",
+	[N__1_HOUR] = u8"1 h",
 };
@@ -174,4 +174,9 @@ lang_it_it[N__MAX_] =
 	[N__FREE] = u8"Liberi",
 	[N__CLOSE] = u8"Chiudi",
 	[N__INSTALL_PAWNIO] = u8"Installa PawnIO",
+	[N__MINIMUM] = u8"Min",
+	[N__AVERAGE] = u8"Media",
+	[N__MAXIMUM] = u8"Max",
+	[N__5_MINUTES] = u8"5 min",
+	[N__1_HOUR] = u8"1 h",
 };
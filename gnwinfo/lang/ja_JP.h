@@ -174,4 +174,9 @@ lang_ja_jp[N__MAX_] =
 	[N__FREE] = u8"空き容量",
 	[N__CLOSE] = u8"閉じる",
 	[N__INSTALL_PAWNIO] = u8"PawnIOをインストール",
+	[N__MINIMUM] = u8"最小",
+	[N__AVERAGE] = u8"平均",
+	[N__MAXIMUM] = u8"最大",
+	[N__5_MINUTES] = u8"5 分",
+	[N__1_HOUR] = u8"1 時間",
 };
@@ -174,4 +174,9 @@ lang_ko_kr[N__MAX_] =
 	[N__FREE] = u8"여유",
 	[N__CLOSE] = u8"닫기",
 	[N__INSTALL_PAWNIO] = u8"PawnIO 설치", // install the PawnIO driver
+	[N__MINIMUM] = u8"최소",
+	[N__AVERAGE] = u8"평균",
+	[N__MAXIMUM] = u8"최대",
+	[N__5_MINUTES] = u8"5분",
+	[N__1_HOUR] = u8"1시간",
 };
@@ -174,4 +174,9 @@ lang_pl_pl[N__MAX_] =
 	[N__FREE] = u8"Wolne",
 	[N__CLOSE] = u8"Zamknij",
 	[N__INSTALL_PAWNIO] = u8"Zainstaluj PawnIO",
+	[N__MINIMUM] = u8"Min",
+	[N__AVERAGE] = u8"Śr.",
+	[N__MAXIMUM] = u8"Maks",
+	[N__5_MINUTES] = u8"5 min",
+	[N__1_HOUR] = u8"1 godz.",
 };
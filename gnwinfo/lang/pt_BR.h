@@ -174,4 +174,9 @@ lang_pt_br[N__MAX_] =
 	[N__FREE] = u8"Livre",
 	[N__CLOSE] = u8"Fechar",
 	[N__INSTALL_PAWNIO] = u8"Instalar PawnIO",
+	[N__MINIMUM] = u8"Mín",
+	[N__AVERAGE] = u8"Méd",
+	[N__MAXIMUM] = u8"Máx",
+	[N__5_MINUTES] = u8"5 min",
+	[N__1_HOUR] = u8"1 h",
 };
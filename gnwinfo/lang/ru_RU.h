@@ -174,4 +174,9 @@ lang_ru_ru[N__MAX_] =
     [N__FREE] = u8"Свободно",
     [N__CLOSE] = u8"Закрыть",
     [N__INSTALL_PAWNIO] = u8"Установить PawnIO", // install the PawnIO driver
+	[N__MINIMUM] = u8"Мин",
+	[N__AVERAGE] = u8"Сред",
+	[N__MAXIMUM] = u8"Макс",
+	[N__5_MINUTES] = u8"5 мин",
+	[N__1_HOUR] = u8"1 ч",
 };
@@ -174,4 +174,9 @@ lang_sl_si[N__MAX_] =
 	[N__FREE] = u8"Nezasedeno",
 	[N__CLOSE] = u8"Zapri",
 	[N__INSTALL_PAWNIO] = u8"Namesti PawnIO", // install the PawnIO driver
+	[N__MINIMUM] = u8"Min",
+	[N__AVERAGE] = u8"Povp.",
+	[N__MAXIMUM] = u8"Maks",
+	[N__5_MINUTES] = u8"5 min",
+	[N__1_HOUR] = u8"1 h",
 };
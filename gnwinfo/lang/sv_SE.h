@@ -170,4 +170,9 @@ lang_sv_se[N__MAX_] =
 	[N__FREE] = u8"Ledigt",
 	[N__CLOSE] = u8"Stäng",
 	[N__INSTALL_PAWNIO] = u8"Installera PawnIO",
+	[N__MINIMUM] = u8"Min",
+	[N__AVERAGE] = u8"Medel",
+	[N__MAXIMUM] = u8"Max",
+	[N__5_MINUTES] = u8"5 min",
+	[N__1_HOUR] = u8"1 h",
 };
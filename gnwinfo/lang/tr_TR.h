@@ -170,4 +170,9 @@ lang_tr_tr[N__MAX_] =
 	[N__FREE] = u8"Ücretsiz sürüm",
 	[N__CLOSE] = u8"Çıkış",
 	[N__INSTALL_PAWNIO] = u8"PawnIO'yu Yükle",
+	[N__MINIMUM] = u8"Min",
+	[N__AVERAGE] = u8"Ort",
+	[N__MAXIMUM] = u8"Maks",
+	[N__5_MINUTES] = u8"5 dk",
+	[N__1_HOUR] = u8"1 sa",
 };
@@ -169,4 +169,9 @@ lang_zh_cn[N__MAX_] =
 	[N__FREE] = u8"空闲",
 	[N__CLOSE] = u8"关闭",
 	[N__INSTALL_PAWNIO] = u8"安装 PawnIO",
+	[N__MINIMUM] = u8"最小",
+	[N__AVERAGE] = u8"平均",
+	[N__MAXIMUM] = u8"最大",
+	[N__5_MINUTES] = u8"5 分钟",
+	[N__1_HOUR] = u8"1 小时",
 };
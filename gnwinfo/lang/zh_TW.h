@@ -170,4 +170,9 @@ lang_zh_tw[N__MAX_] =
 	[N__FREE] = u8"空閒",
 	[N__CLOSE] = u8"關閉",
 	[N__INSTALL_PAWNIO] = u8"安裝 PawnIO",
+	[N__MINIMUM] = u8"最小",
+	[N__AVERAGE] = u8"平均",
+	[N__MAXIMUM] = u8"最大",
+	[N__5_MINUTES] = u8"5 分鐘",
+	[N__1_HOUR] = u8"1 小時",
 };
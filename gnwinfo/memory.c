@@ -41,12 +41,15 @@ gnwinfo_init_mm_window(struct nk_context* ctx)
 UINT64
 gnwinfo_clean_memory(VOID)
 {
-	UINT64 old_size = g_ctx.mem_status.PhysInUse;
+	NWLIB_MEM_INFO mem_status = { 0 };
+	UINT64 old_size;
 	UINT64 new_size = 0;
 	SYSTEM_MEMORY_LIST_COMMAND cmd;
 	MEMORY_COMBINE_INFORMATION_EX combine_info = { 0 };
 	SYSTEM_FILECACHE_INFORMATION sfci = { 0 };
 
+	NWL_GetMemInfo(&mem_status);
+	old_size = mem_status.PhysInUse;
 	NWL_ObtainPrivileges(SE_INCREASE_QUOTA_NAME);
 	NWL_ObtainPrivileges(SE_PROF_SINGLE_PROCESS_NAME);
 
@@ -80,8 +83,8 @@ gnwinfo_clean_memory(VOID)
 	{
 		NWL_NtSetSystemInformation(SystemCombinePhysicalMemoryInformation, &combine_info, sizeof(combine_info));
 	}
-	NWL_GetMemInfo(&g_ctx.mem_status);
-	new_size = g_ctx.mem_status.PhysInUse;
+	NWL_GetMemInfo(&mem_status);
+	new_size = mem_status.PhysInUse;
 	if (new_size < old_size)
 		return old_size - new_size;
 	return 0;
@@ -268,22 +271,22 @@ gnwinfo_draw_mm_window(struct nk_context* ctx, float width, float height)
 	nk_layout_row_dynamic(ctx, 0, 2);
 
 	nk_l(ctx, N_(N__PHYSICAL_MEMORY), NK_TEXT_LEFT);
-	gnwinfo_draw_percent_prog(ctx, (double)g_ctx.mem_status.PhysUsage);
+	gnwinfo_draw_percent_prog(ctx, (double)g_ctx.frame->mem_status.PhysUsage);
 	nk_spacer(ctx);
 	nk_lf(ctx, NK_TEXT_LEFT, "%3lu%% %s / %s",
-		g_ctx.mem_status.PhysUsage, g_ctx.mem_status.StrPhysAvail, g_ctx.mem_status.StrPhysTotal);
+		g_ctx.frame->mem_status.PhysUsage, g_ctx.frame->mem_status.StrPhysAvail, g_ctx.frame->mem_status.StrPhysTotal);
 
 	nk_l(ctx, N_(N__PAGE_FILE), NK_TEXT_LEFT);
-	gnwinfo_draw_percent_prog(ctx, (double)g_ctx.mem_status.PageUsage);
+	gnwinfo_draw_percent_prog(ctx, (double)g_ctx.frame->mem_status.PageUsage);
 	nk_spacer(ctx);
 	nk_lf(ctx, NK_TEXT_LEFT, "%3lu%% %s / %s",
-		g_ctx.mem_status.PageUsage, g_ctx.mem_status.StrPageAvail, g_ctx.mem_status.StrPageTotal);
+		g_ctx.frame->mem_status.PageUsage, g_ctx.frame->mem_status.StrPageAvail, g_ctx.frame->mem_status.StrPageTotal);
 
 	nk_l(ctx, N_(N__SYSTEM_WORKING_SET), NK_TEXT_LEFT);
-	gnwinfo_draw_percent_prog(ctx, (double)g_ctx.mem_status.SfciUsage);
+	gnwinfo_draw_percent_prog(ctx, (double)g_ctx.frame->mem_status.SfciUsage);
 	nk_spacer(ctx);
 	nk_lf(ctx, NK_TEXT_LEFT, "%3lu%% %s / %s",
-		g_ctx.mem_status.SfciUsage, g_ctx.mem_status.StrSfciAvail, g_ctx.mem_status.StrSfciTotal);
+		g_ctx.frame->mem_status.SfciUsage, g_ctx.frame->mem_status.StrSfciAvail, g_ctx.frame->mem_status.StrSfciTotal);
 
 	nk_layout_row_dynamic(ctx, 8, 1);
 	nk_spacer(ctx);
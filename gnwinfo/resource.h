@@ -47,6 +47,7 @@
 #define IDT_TIMER_POWER                 (1u << 4)
 #define IDT_TIMER_SMB                   (1u << 5)
 #define IDT_TIMER_SPD                   (1u << 6)
+#define IDT_TIMER_VIEW                  (1u << 7)
 
 #define IDM_EXIT              1001
 #define IDM_CLEAN_MEM         1002
@@ -5,12 +5,64 @@
 #include "gettext.h"
 #include "utils.h"
 
+#define SPARK_POINTS_MAX 150
+
+static void
+draw_sparkline(struct nk_context* ctx, UINT32 key)
+{
+	static GNW_HIST_VIEW view;
+	float points[2 * SPARK_POINTS_MAX];
+	struct nk_rect r;
+
+	nk_bool hovered = nk_widget_is_hovered(ctx);
+	if (nk_widget_is_mouse_clicked(ctx, NK_BUTTON_LEFT))
+		gnwinfo_history_toggle(key);
+	if (nk_widget(&r, ctx) == NK_WIDGET_INVALID)
+		return;
+	if (!gnwinfo_history_read(key, &view))
+		return;
+	if (hovered)
+		nk_tooltipf(ctx, "%s %.2f / %s %.2f / %s %.2f (%s)",
+			N_(N__MINIMUM), view.min, N_(N__AVERAGE), view.avg, N_(N__MAXIMUM), view.max,
+			N_(view.tier == GNW_HIST_TIER_RAW ? N__5_MINUTES : N__1_HOUR));
+	if (view.count < 2)
+		return;
+
+	// One point per two pixels, each the mean of the samples it covers.
+	UINT32 n = (UINT32)(r.w / 2.0f);
+	if (n > SPARK_POINTS_MAX)
+		n = SPARK_POINTS_MAX;
+	if (n > view.count)
+		n = view.count;
+	if (n < 2)
+		return;
+
+	float lo = view.min;
+	float range = view.max - view.min;
+	float pad = r.h * 0.15f;
+	float h = r.h - 2 * pad;
+
+	for (UINT32 i = 0; i < n; i++)
+	{
+		UINT32 begin = i * view.count / n;
+		UINT32 end = (i + 1) * view.count / n;
+		float sum = 0.0f;
+		for (UINT32 j = begin; j < end; j++)
+			sum += view.data[j];
+		float v = sum / (end - begin);
+		points[2 * i] = r.x + r.w * i / (n - 1);
+		points[2 * i + 1] = r.y + pad + (range > 0.0f ? h * (1.0f - (v - lo) / range) : h / 2);
+	}
+	nk_stroke_polyline(nk_window_get_canvas(ctx), points, (int)n, 1.0f, g_color_good);
+}
+
 static void
-draw_node(struct nk_context* ctx, int* id, PNODE node, nk_bool visible)
+draw_node(struct nk_context* ctx, int* id, PNODE node, UINT32 key, nk_bool visible)
 {
 	if (node == NULL)
 		return;
 	(*id)++;
+	key = gnwinfo_history_key(key, node->name);
 	nk_bool expanded = nk_false;
 	if (visible)
 		expanded = nk_tree_image_push_ex(ctx, NK_TREE_TAB, GET_PNG(IDR_PNG_SENSOR), node->name, NK_MAXIMIZED, *id);
@@ -22,6 +74,14 @@ draw_node(struct nk_context* ctx, int* id, PNODE node, nk_bool visible)
 			PNODE_ATT att = NWL_NodeAttrEnum(node, i);
 			if (!att)
 				continue;
+			if (att->flags & NAFLG_FMT_NUMERIC)
+			{
+				nk_layout_row(ctx, NK_DYNAMIC, 0, 3, (float[3]) { 0.45f, 0.3f, 0.25f });
+				nk_l(ctx, att->key, NK_TEXT_LEFT);
+				draw_sparkline(ctx, gnwinfo_history_key(key, att->key));
+				nk_lhc(ctx, att->value, NK_TEXT_RIGHT, g_color_text_l);
+				continue;
+			}
 			nk_layout_row_dynamic(ctx, 0, 2);
 			nk_l(ctx, att->key, NK_TEXT_LEFT);
 			nk_lhc(ctx, att->value, NK_TEXT_RIGHT, g_color_text_l);
@@ -30,7 +90,7 @@ draw_node(struct nk_context* ctx, int* id, PNODE node, nk_bool visible)
 
 	int child_count = NWL_NodeChildCount(node);
 	for (int i = 0; i < child_count; i++)
-		draw_node(ctx, id, NWL_NodeEnumChild(node, i), expanded);
+		draw_node(ctx, id, NWL_NodeEnumChild(node, i), key, expanded);
 
 	if (expanded)
 		nk_tree_pop(ctx);
@@ -40,9 +100,9 @@ VOID
 gnwinfo_draw_sensor_window(struct nk_context* ctx, float width, float height)
 {
 	int id = 0;
-	int count = NWL_NodeChildCount(g_ctx.sensors);
+	int count = NWL_NodeChildCount(g_ctx.frame->sensors);
 	for (int i = 0; i < count; i++)
 	{
-		draw_node(ctx, &id, NWL_NodeEnumChild(g_ctx.sensors, i), nk_true);
+		draw_node(ctx, &id, NWL_NodeEnumChild(g_ctx.frame->sensors, i), 0, nk_true);
 	}
 }
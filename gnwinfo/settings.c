@@ -1,5 +1,6 @@
 ﻿// SPDX-License-Identifier: Unlicense
 
+#include <stdlib.h>
 #include "gnwinfo.h"
 #include "gettext.h"
 #include "../libcdi/libcdi.h"
@@ -71,6 +72,13 @@ draw_color_picker(struct nk_context* ctx, struct nk_color* color)
 	}
 }
 
+static int
+font_name_cmp(const void* a, const void* b)
+{
+	return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+// GDI+ loads fonts by family, so list each TrueType family once.
 static inline void
 nk_font_list(struct nk_context* ctx, float item_height)
 {
@@ -78,18 +86,31 @@ nk_font_list(struct nk_context* ctx, float item_height)
 	{
 		PNODE node = NW_Font(FALSE);
 		INT count = NWL_NodeChildCount(node);
-		nk_layout_row_dynamic(ctx, item_height, 1);
+		INT total = 0;
+		const char** names = calloc(count > 0 ? count : 1, sizeof(const char*));
+		if (!names)
+			goto out;
 		for (INT i = 0; i < count; i++)
 		{
 			PNODE item = NWL_NodeEnumChild(node, i);
 			if (!item)
 				continue;
-			const char* name = NWL_NodeAttrGet(item, "Name");
-			if (name[0] == '@')
+			const char* name = NWL_NodeAttrGet(item, "Family");
+			if (name[0] == '\0' || name[0] == '@' || strcmp(name, "-") == 0)
 				continue;
-			if (nk_combo_item_label(ctx, name, NK_TEXT_LEFT))
-				strncpy_s(g_font_name, NWL_STR_SIZE, name, _TRUNCATE);
+			names[total++] = name;
 		}
+		qsort(names, total, sizeof(const char*), font_name_cmp);
+		nk_layout_row_dynamic(ctx, item_height, 1);
+		for (INT i = 0; i < total; i++)
+		{
+			if (i > 0 && strcmp(names[i], names[i - 1]) == 0)
+				continue;
+			if (nk_combo_item_label(ctx, names[i], NK_TEXT_LEFT))
+				strncpy_s(g_font_name, NWL_STR_SIZE, names[i], _TRUNCATE);
+		}
+		free(names);
+out:
 		nk_combo_end(ctx);
 		NWL_NodeFree(node, 1);
 	}
@@ -285,7 +285,7 @@ gnwinfo_draw_smart_window(struct nk_context* ctx, float width, float height)
 		NK_TEXT_CENTERED, g_color_text_l);
 	
 	if (nk_button_image_label(ctx, GET_PNG(IDR_PNG_REFRESH), N_(N__REFRESH), NK_TEXT_CENTERED))
-		cdi_update_smart(NWLC->NwSmart, cur_disk);
+		cdi_refresh_disk(NWLC->NwSmart, cur_disk, 0, TRUE);
 	g_ctx.smart_hex = !nk_check_label(ctx, N_(N__HEX), !g_ctx.smart_hex);
 	
 	nk_layout_row(ctx, NK_DYNAMIC, g_col_height * 9.0f, 2, (float[2]) {0.2f, 0.8f});
@@ -49,23 +49,37 @@ quick_access_button(struct nk_context* ctx, struct nk_image img, const char* str
 	return nk_false;
 }
 
+static inline const GNW_VM_ROW*
+vm_row(const GNW_VM_LIST* list, size_t index)
+{
+	static const GNW_VM_ROW empty = { 0 };
+	if (!list || index >= list->count)
+		return &empty;
+	return &list->rows[index];
+}
+
+static struct nk_color
+vm_color(UINT32 level)
+{
+	switch (level)
+	{
+	case GNW_VM_LEVEL_GOOD:
+		return g_color_good;
+	case GNW_VM_LEVEL_WARNING:
+		return g_color_warning;
+	case GNW_VM_LEVEL_ERROR:
+		return g_color_error;
+	}
+	return g_color_unknown;
+}
+
 static VOID
 draw_os(struct nk_context* ctx)
 {
+	const GNW_VM_LIST* vm = g_ctx.frame->vm_system;
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 3, (float[3]) { 0.3f, 0.7f - g_ctx.gui_ratio, g_ctx.gui_ratio });
 	nk_image_label(ctx, GET_PNG(IDR_PNG_OS), N_(N__OS), NK_TEXT_LEFT, g_color_text_d);
-	int len = snprintf(m_buf, MAX_PATH, "%s %s",
-		NWL_NodeAttrGet(g_ctx.system, "OS"),
-		NWL_NodeAttrGet(g_ctx.system, "Processor Architecture"));
-	if (g_ctx.main_flag & MAIN_OS_EDITIONID)
-	{
-		LPCSTR edition = NWL_NodeAttrGet(g_ctx.system, "Edition");
-		if (edition[0] != '-' && len >= 0 && len < MAX_PATH)
-			len += snprintf(m_buf + len, MAX_PATH - len, " %s", edition);
-	}
-	if ((g_ctx.main_flag & MAIN_OS_BUILD) && len >= 0 && len < MAX_PATH)
-		snprintf(m_buf + len, MAX_PATH - len, " (%s)", NWL_NodeAttrGet(g_ctx.system, "Build Number"));
-	nk_lhc(ctx, m_buf, NK_TEXT_LEFT, g_color_text_l);
+	nk_lhc(ctx, vm_row(vm, GNW_VM_ROW_OS)->text, NK_TEXT_LEFT, g_color_text_l);
 	if (quick_access_button(ctx, GET_PNG(IDR_PNG_INFO), NULL))
 		ShellExecuteW(GetDesktopWindow(), NULL,
 			L"::{26EE0668-A00A-44D7-9371-BEB064C98683}\\5\\::{BB06C0E4-D293-4F75-8A90-CB05B6477EEE}",
@@ -73,19 +87,10 @@ draw_os(struct nk_context* ctx)
 
 	if (g_ctx.main_flag & MAIN_OS_DETAIL)
 	{
+		const GNW_VM_ROW* login = vm_row(vm, GNW_VM_ROW_LOGIN);
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 3, (float[3]) { 0.3f, 0.7f - g_ctx.gui_ratio, g_ctx.gui_ratio });
 		nk_lhsc(ctx, N_(N__LOGIN), NK_TEXT_LEFT, g_color_text_d, nk_false, nk_true);
-		nk_lhcf(ctx, NK_TEXT_LEFT,
-			g_color_text_l,
-			"%s@%s%s%s%s%s%s%s",
-			NWL_NodeAttrGet(g_ctx.system, "Username"),
-			g_ctx.sys_hostname,
-			g_ctx.lib.NwIsWoW64 ? " WoW64" : "",
-			strcmp(NWL_NodeAttrGet(g_ctx.system, "Safe Mode"), NA_BOOL_TRUE) == 0 ? " SafeMode" : "",
-			strcmp(NWL_NodeAttrGet(g_ctx.system, "BitLocker Boot"), NA_BOOL_TRUE) == 0 ? " BitLocker" : "",
-			strcmp(NWL_NodeAttrGet(g_ctx.system, "VHD Boot"), NA_BOOL_TRUE) == 0 ? " VHD" : "",
-			strcmp(NWL_NodeAttrGet(g_ctx.system, "Fast Startup"), NA_BOOL_TRUE) == 0 ? " FastStartup" : "",
-			strcmp(NWL_NodeAttrGet(g_ctx.system, "HVCI KMCI"), NA_BOOL_TRUE) == 0 ? " HVCI" : "");
+		nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l, "%s@%s%s", login->text, g_ctx.sys_hostname, login->detail);
 		if (quick_access_button(ctx, GET_PNG(IDR_PNG_EDIT), N_(N__HOSTNAME)))
 			gnwinfo_init_hostname_window(ctx);
 	}
@@ -94,29 +99,17 @@ draw_os(struct nk_context* ctx)
 	{
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.3f, 0.7f });
 		nk_lhsc(ctx, N_(N__UPTIME), NK_TEXT_LEFT, g_color_text_d, nk_false, nk_true);
-		nk_lhc(ctx, g_ctx.sys_uptime, NK_TEXT_LEFT, g_color_text_l);
+		nk_lhc(ctx, g_ctx.frame->sys_uptime, NK_TEXT_LEFT, g_color_text_l);
 	}
 }
 
 static VOID
 draw_bios(struct nk_context* ctx)
 {
-	LPCSTR tpm = NWL_NodeAttrGet(g_ctx.system, "TPM");
-	LPCSTR sb = NWL_NodeAttrGet(g_ctx.uefi, "Secure Boot");
-
+	const GNW_VM_LIST* vm = g_ctx.frame->vm_system;
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 3, (float[3]) { 0.3f, 0.7f - g_ctx.gui_ratio, g_ctx.gui_ratio });
 	nk_image_label(ctx, GET_PNG(IDR_PNG_FIRMWARE), N_(N__BIOS), NK_TEXT_LEFT, g_color_text_d);
-
-	int len = snprintf(m_buf, MAX_PATH, "%s", NWL_NodeAttrGet(g_ctx.system, "Firmware"));
-	if (sb[0] == 'E' && len >= 0 && len < MAX_PATH)
-		len += snprintf(m_buf + len, MAX_PATH - len, " %s", N_(N__SB));
-	else if (sb[0] == 'D' && len >= 0 && len < MAX_PATH)
-		len += snprintf(m_buf + len, MAX_PATH - len, " %s", N_(N__SB_OFF));
-
-	if (tpm[0] == 'v' && len >= 0 && len < MAX_PATH)
-		snprintf(m_buf + len, MAX_PATH - len, " TPM%s", tpm);
-
-	nk_lhc(ctx, m_buf, NK_TEXT_LEFT, g_color_text_l);
+	nk_lhc(ctx, vm_row(vm, GNW_VM_ROW_FIRMWARE)->text, NK_TEXT_LEFT, g_color_text_l);
 
 	nk_spacer(ctx);
 
@@ -124,27 +117,21 @@ draw_bios(struct nk_context* ctx)
 	{
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.3f, 0.7f });
 		nk_lhsc(ctx, N_(N__VENDOR), NK_TEXT_LEFT, g_color_text_d, nk_false, nk_true);
-		nk_lhc(ctx, NWL_NodeAttrGet(g_ctx.board, "BIOS Vendor"), NK_TEXT_LEFT, g_color_text_l);
+		nk_lhc(ctx, vm_row(vm, GNW_VM_ROW_BIOS_VENDOR)->text, NK_TEXT_LEFT, g_color_text_l);
 	}
 	if (g_ctx.main_flag & MAIN_B_VERSION)
 	{
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.3f, 0.7f });
 		nk_lhsc(ctx, N_(N__VERSION), NK_TEXT_LEFT, g_color_text_d, nk_false, nk_true);
-		nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l,
-			"%s %s",
-			NWL_NodeAttrGet(g_ctx.board, "BIOS Version"),
-			NWL_NodeAttrGet(g_ctx.board, "BIOS Date"));
+		nk_lhc(ctx, vm_row(vm, GNW_VM_ROW_BIOS_VERSION)->text, NK_TEXT_LEFT, g_color_text_l);
 	}
 }
 
 static VOID
 draw_computer(struct nk_context* ctx)
 {
-	struct nk_color color = g_color_unknown;
-	BOOL has_battery = TRUE;
-	LPCSTR time = "";
-	LPCSTR bat = NWL_NodeAttrGet(g_ctx.battery, "Battery Status");
-	LPCSTR ac = "";
+	const GNW_VM_ROW* sys = vm_row(g_ctx.frame->vm_system, GNW_VM_ROW_SYSTEM);
+	const GNW_VM_ROW* board = vm_row(g_ctx.frame->vm_system, GNW_VM_ROW_BOARD);
 
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 1.0f - g_ctx.gui_ratio, g_ctx.gui_ratio });
 	nk_image_label(ctx, GET_PNG(IDR_PNG_PC), N_(N__PC), NK_TEXT_LEFT, g_color_text_d);
@@ -152,47 +139,15 @@ draw_computer(struct nk_context* ctx)
 		g_ctx.window_flag |= GUI_WINDOW_PCI;
 
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.3f, 0.7f });
-	nk_lhsc(ctx, NWL_NodeAttrGet(g_ctx.board, "System Manufacturer"), NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
-	nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l,
-		"%s %s %s",
-		NWL_NodeAttrGet(g_ctx.board, "Enclosure Type"),
-		NWL_NodeAttrGet(g_ctx.board, "System Product"),
-		NWL_NodeAttrGet(g_ctx.board, "System Serial Number"));
-
-	nk_lhsc(ctx, NWL_NodeAttrGet(g_ctx.board, "Manufacturer"), NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
-	nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l,
-		"%s %s",
-		NWL_NodeAttrGet(g_ctx.board, "Board Name"),
-		NWL_NodeAttrGet(g_ctx.board, "Serial Number"));
-
-	if (strcmp(bat, "Charging") == 0)
-	{
-		color = g_color_good;
-		time = NWL_NodeAttrGet(g_ctx.battery, "Battery Life Full");
-	}
-	else if (strcmp(bat, "Not Charging") == 0)
-	{
-		color = g_color_warning;
-		time = NWL_NodeAttrGet(g_ctx.battery, "Battery Life Remaining");
-	}
-	else
-		has_battery = FALSE;
-
-	if (strcmp(time, "UNKNOWN") == 0)
-		time = "";
+	nk_lhsc(ctx, sys->label, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+	nk_lhc(ctx, sys->text, NK_TEXT_LEFT, g_color_text_l);
 
-	if (strcmp(NWL_NodeAttrGet(g_ctx.battery, "AC Power"), "Online") == 0)
-		ac = u8"AC ";
+	nk_lhsc(ctx, board->label, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+	nk_lhc(ctx, board->text, NK_TEXT_LEFT, g_color_text_l);
 
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 3, (float[3]) { 0.3f, 0.7f - g_ctx.gui_ratio, g_ctx.gui_ratio });
 	nk_lhsc(ctx, N_(N__POWER_STAT), NK_TEXT_LEFT, g_color_text_d, nk_false, nk_true);
-	int len = snprintf(m_buf, MAX_PATH, "%s %s",
-		ac, NWL_NodeAttrGet(g_ctx.battery, "Active Power Scheme Name"));
-	if (has_battery && len >= 0 && len < MAX_PATH)
-		snprintf(m_buf + len, MAX_PATH - len, " %s %s",
-			NWL_NodeAttrGet(g_ctx.battery, "Battery Life Percentage"),
-			time);
-	nk_lhc(ctx, m_buf, NK_TEXT_LEFT, g_color_text_l);
+	nk_lhc(ctx, vm_row(g_ctx.frame->vm_power, 0)->text, NK_TEXT_LEFT, g_color_text_l);
 	if (quick_access_button(ctx, GET_PNG(IDR_PNG_BATTERY), N_(N__POWER_OPTIONS)))
 		ShellExecuteW(GetDesktopWindow(), NULL,
 			L"shell:::{025A5937-A6BE-4686-A844-36FE4BEC8B6D}",
@@ -204,44 +159,37 @@ draw_processor(struct nk_context* ctx)
 {
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 4, (float[4]) { 0.3f, 0.4f, 0.3f - g_ctx.gui_ratio, g_ctx.gui_ratio });
 	nk_image_label(ctx, GET_PNG(IDR_PNG_CPU), N_(N__CPU), NK_TEXT_LEFT, g_color_text_d);
-	nk_lhcf(ctx, NK_TEXT_LEFT, gnwinfo_get_color(g_ctx.cpu_usage, 70.0, 90.0),
+	nk_lhcf(ctx, NK_TEXT_LEFT, gnwinfo_get_color(g_ctx.frame->cpu_usage, 70.0, 90.0),
 		"%.2f%% %lu MHz",
-		g_ctx.cpu_usage,
-		g_ctx.cpu_freq);
-	gnwinfo_draw_percent_prog(ctx, g_ctx.cpu_usage);
+		g_ctx.frame->cpu_usage,
+		g_ctx.frame->cpu_freq);
+	gnwinfo_draw_percent_prog(ctx, g_ctx.frame->cpu_usage);
 	if (quick_access_button(ctx, GET_PNG(IDR_PNG_SENSOR), "PerfMon"))
 		ShellExecuteW(GetDesktopWindow(), NULL,
 			L"perfmon.exe",
 			NULL, NULL, SW_NORMAL);
 
-	for (INT i = 0; i < g_ctx.cpu_count; i++)
+	const GNW_VM_LIST* vm = g_ctx.frame->vm_cpu;
+	for (size_t i = 0; i < GNW_VM_COUNT(vm); i++)
 	{
-		PNODE cpu = NWL_NodeEnumChild(g_ctx.cpuid, i);
-		LPCSTR brand = NWL_NodeAttrGet(cpu, "Brand");
-		if (cpu == NULL)
-			break;
+		const GNW_VM_ROW* cpu = &vm->rows[i];
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.3f, 0.7f });
-		nk_lhsc(ctx, cpu->name, NK_TEXT_LEFT, g_color_text_d, nk_false, nk_true);
-		nk_lhc(ctx, brand, NK_TEXT_LEFT, g_color_text_l);
+		nk_lhsc(ctx, cpu->label, NK_TEXT_LEFT, g_color_text_d, nk_false, nk_true);
+		nk_lhc(ctx, cpu->text, NK_TEXT_LEFT, g_color_text_l);
 
 		if (!(g_ctx.main_flag & MAIN_CPU_DETAIL))
 			continue;
 
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 3, (float[3]) { 0.3f, 0.4f, 0.3f });
 		nk_spacer(ctx);
-		int len = snprintf(m_buf, MAX_PATH, "%s %s", NWL_NodeAttrGet(cpu, "Cores"), N_(N__CORES));
-		if (len >= 0 && len < MAX_PATH)
-			len += snprintf(m_buf + len, MAX_PATH - len, " %s %s",
-				NWL_NodeAttrGet(cpu, "Logical CPUs"),
-				N_(N__THREADS));
-		if (g_ctx.cpu_info && g_ctx.cpu_info[i].MsrPower > 0.0 && len >= 0 && len < MAX_PATH)
-			snprintf(m_buf + len, MAX_PATH - len, " %.2fW", g_ctx.cpu_info[i].MsrPower);
-
-		nk_lhc(ctx, m_buf, NK_TEXT_LEFT, g_color_text_l);
-		if (g_ctx.cpu_info && g_ctx.cpu_info[i].MsrTemp > 0)
+		if (g_ctx.frame->cpu_info && g_ctx.frame->cpu_info[i].MsrPower > 0.0)
+			nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l, "%s %.2fW", cpu->detail, g_ctx.frame->cpu_info[i].MsrPower);
+		else
+			nk_lhc(ctx, cpu->detail, NK_TEXT_LEFT, g_color_text_l);
+		if (g_ctx.frame->cpu_info && g_ctx.frame->cpu_info[i].MsrTemp > 0)
 			nk_lhcf(ctx, NK_TEXT_LEFT,
-				gnwinfo_get_color((double)g_ctx.cpu_info[i].MsrTemp, 65.0, 85.0),
-				u8"%.0f%s", NWL_GetTemperature((float)g_ctx.cpu_info[i].MsrTemp), g_ctx.temp_unit);
+				gnwinfo_get_color((double)g_ctx.frame->cpu_info[i].MsrTemp, 65.0, 85.0),
+				u8"%.0f%s", NWL_GetTemperature((float)g_ctx.frame->cpu_info[i].MsrTemp), g_ctx.temp_unit);
 		else
 			nk_spacer(ctx);
 
@@ -249,19 +197,7 @@ draw_processor(struct nk_context* ctx)
 			continue;
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.3f, 0.7f });
 		nk_spacer(ctx);
-		PNODE cache = NWL_NodeGetChild(cpu, "Cache");
-		LPCSTR l1 = NWL_NodeAttrGet(cache, "L1 Cache Size");
-		LPCSTR l2 = NWL_NodeAttrGet(cache, "L2 Cache Size");
-		LPCSTR l3 = NWL_NodeAttrGet(cache, "L3 Cache Size");
-		LPCSTR l4 = NWL_NodeAttrGet(cache, "L4 Cache Size");
-		len = snprintf(m_buf, MAX_PATH, "L1 %s", l1);
-		if (l2[0] != '-' && len >= 0 && len < MAX_PATH)
-			len += snprintf(m_buf + len, MAX_PATH - len, " L2 %s", l2);
-		if (l3[0] != '-' && len >= 0 && len < MAX_PATH)
-			len += snprintf(m_buf + len, MAX_PATH - len, " L3 %s", l3);
-		if (l4[0] != '-' && len >= 0 && len < MAX_PATH)
-			snprintf(m_buf + len, MAX_PATH - len, " L4 %s", l4);
-		nk_lhc(ctx, m_buf, NK_TEXT_LEFT, g_color_text_l);
+		nk_lhc(ctx, cpu->extra, NK_TEXT_LEFT, g_color_text_l);
 	}
 }
 
@@ -270,77 +206,41 @@ draw_mem_capacity(struct nk_context* ctx)
 {
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.3f, 0.7f });
 	nk_lhsc(ctx, N_(N__MAX_CAPACITY), NK_TEXT_LEFT, g_color_text_d, nk_false, nk_true);
-	LPCSTR id = "16";
-	LPCSTR capacity = gnwinfo_get_smbios_attr(id, "Max Capacity", NULL, NULL);
-	if (capacity[0] == '-')
-	{
-		id = "5";
-		capacity = gnwinfo_get_smbios_attr(id, "Max Memory Module Size (MB)", NULL, NULL);
-	}
-	snprintf(m_buf, MAX_PATH, "%s %s %s%s",
-		gnwinfo_get_smbios_attr(id, "Number of Slots", NULL, NULL),
-		N_(N__SLOTS),
-		capacity,
-		id[0] == '5' ? " MB" : "");
-	nk_lhc(ctx, m_buf, NK_TEXT_LEFT, g_color_text_l);
+	nk_lhc(ctx, vm_row(g_ctx.frame->vm_system, GNW_VM_ROW_MEM_CAPACITY)->text, NK_TEXT_LEFT, g_color_text_l);
 }
 
 static VOID
 draw_mem_dmi(struct nk_context* ctx)
 {
+	const GNW_VM_LIST* vm = g_ctx.frame->vm_dmi;
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.3f, 0.7f });
-	INT count = NWL_NodeChildCount(g_ctx.smbios);
-	for (INT i = 0; i < count; i++)
+	for (size_t i = 0; i < GNW_VM_COUNT(vm); i++)
 	{
-		PNODE tab = NWL_NodeEnumChild(g_ctx.smbios, i);
-		LPCSTR attr = NWL_NodeAttrGet(tab, "Table Type");
-		if (strcmp(attr, "17") != 0)
-			continue;
-		LPCSTR sz = NWL_NodeAttrGet(tab, "Device Size");
-		if (sz[0] == '-')
-			continue;
-		nk_lhsc(ctx, NWL_NodeAttrGet(tab, "Bank Locator"), NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
-		nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l,
-			"%s-%s %s %s %s",
-			NWL_NodeAttrGet(tab, "Device Type"),
-			NWL_NodeAttrGet(tab, "Speed (MT/s)"),
-			sz,
-			NWL_NodeAttrGet(tab, "Manufacturer"),
-			NWL_NodeAttrGet(tab, "Serial Number"));
+		nk_lhsc(ctx, vm->rows[i].label, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+		nk_lhc(ctx, vm->rows[i].text, NK_TEXT_LEFT, g_color_text_l);
 	}
 }
 
 static VOID
 draw_mem_spd(struct nk_context* ctx)
 {
-	INT count = NWL_NodeChildCount(g_ctx.spd);
-	if (count <= 0)
+	const GNW_VM_LIST* vm = g_ctx.frame->vm_spd;
+	size_t count = GNW_VM_COUNT(vm);
+	if (count == 0)
 	{
 		draw_mem_dmi(ctx);
 		return;
 	}
-	for (INT i = 0; i < count; i++)
+	for (size_t i = 0; i < count; i++)
 	{
-		PNODE tab = NWL_NodeEnumChild(g_ctx.spd, i);
+		const GNW_VM_ROW* row = &vm->rows[i];
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.3f, 0.7f });
-		nk_lhscf(ctx, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true, "BANK %s", NWL_NodeAttrGet(tab, "ID"));
-		nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l,
-			"%s-%s %s %s %s",
-			NWL_NodeAttrGet(tab, "Memory Type"),
-			NWL_NodeAttrGet(tab, "Speed (MHz)"),
-			NWL_NodeAttrGet(tab, "Capacity"),
-			NWL_NodeAttrGet(tab, "Manufacturer"),
-			NWL_NodeAttrGet(tab, "Serial Number"));
+		nk_lhsc(ctx, row->label, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+		nk_lhc(ctx, row->text, NK_TEXT_LEFT, g_color_text_l);
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 3, (float[3]) { 0.3f, 0.4f, 0.3f });
 		nk_spacer(ctx);
-		nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l,
-			"%s CL%s-%s-%s-%s",
-			NWL_NodeAttrGet(tab, "Module Type"),
-			NWL_NodeAttrGet(tab, "tCL"),
-			NWL_NodeAttrGet(tab, "tRCD"),
-			NWL_NodeAttrGet(tab, "tRP"),
-			NWL_NodeAttrGet(tab, "tRAS"));
-		double temp = g_ctx.mem_sensors.Sensor[i].Temp;
+		nk_lhc(ctx, row->detail, NK_TEXT_LEFT, g_color_text_l);
+		double temp = i < ARRAYSIZE(g_ctx.frame->mem_sensors.Sensor) ? g_ctx.frame->mem_sensors.Sensor[i].Temp : 0.0;
 		if (temp > 0.0)
 			nk_lhcf(ctx, NK_TEXT_LEFT, gnwinfo_get_color(temp, 55.0, 85.0), u8"%.1f%s", NWL_GetTemperature((float)temp), g_ctx.temp_unit);
 		else
@@ -354,17 +254,17 @@ draw_memory(struct nk_context* ctx)
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 4, (float[4]) { 0.3f, 0.4f, 0.3f - g_ctx.gui_ratio, g_ctx.gui_ratio });
 	nk_image_label(ctx, GET_PNG(IDR_PNG_MEMORY), N_(N__MEMORY), NK_TEXT_LEFT, g_color_text_d);
 	nk_lhcf(ctx, NK_TEXT_LEFT,
-		gnwinfo_get_color((double)g_ctx.mem_status.PhysUsage, 70.0, 90.0),
+		gnwinfo_get_color((double)g_ctx.frame->mem_status.PhysUsage, 70.0, 90.0),
 		"%lu%% %s / %s",
-		g_ctx.mem_status.PhysUsage, g_ctx.mem_status.StrPhysAvail, g_ctx.mem_status.StrPhysTotal);
-	gnwinfo_draw_percent_prog(ctx, (double)g_ctx.mem_status.PhysUsage);
+		g_ctx.frame->mem_status.PhysUsage, g_ctx.frame->mem_status.StrPhysAvail, g_ctx.frame->mem_status.StrPhysTotal);
+	gnwinfo_draw_percent_prog(ctx, (double)g_ctx.frame->mem_status.PhysUsage);
 	if (quick_access_button(ctx, GET_PNG(IDR_PNG_ROCKET), N_(N__CLEAN_MEMORY)))
 		gnwinfo_init_mm_window(ctx);
 
 	if (g_ctx.main_flag & MAIN_MEM_DETAIL)
 	{
 		draw_mem_capacity(ctx);
-		if (g_ctx.spd)
+		if (g_ctx.frame->spd)
 			draw_mem_spd(ctx);
 		else
 			draw_mem_dmi(ctx);
@@ -380,17 +280,17 @@ draw_display(struct nk_context* ctx)
 	nk_image_label(ctx, GET_PNG(IDR_PNG_DISPLAY), N_(N__DISPLAY), NK_TEXT_LEFT, g_color_text_d);
 	nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l,
 		"%ldx%ld %u DPI (%u%%)",
-		g_ctx.cur_display.Width, g_ctx.cur_display.Height, g_ctx.cur_display.Dpi, g_ctx.cur_display.Scale);
+		g_ctx.frame->cur_display.Width, g_ctx.frame->cur_display.Height, g_ctx.frame->cur_display.Dpi, g_ctx.frame->cur_display.Scale);
 	if (quick_access_button(ctx, GET_PNG(IDR_PNG_MONITOR), N_(N__DISPLAY)))
 		g_ctx.window_flag |= GUI_WINDOW_DISPLAY;
 
-	if (g_ctx.lib.NwGpu)
+	if (g_ctx.frame->gpu_count > 0 || g_ctx.frame->gpu_pci)
 	{
-		if ((g_ctx.main_flag2 & MAIN2_GPU_DRIVER) && g_ctx.lib.NwGpu->DeviceCount > 0)
+		if ((g_ctx.main_flag2 & MAIN2_GPU_DRIVER) && g_ctx.frame->gpu_count > 0)
 		{
-			for (i = 0; i < (INT)g_ctx.lib.NwGpu->DeviceCount; i++)
+			for (i = 0; i < (INT)g_ctx.frame->gpu_count; i++)
 			{
-				NWLIB_GPU_DEV* gpu = &g_ctx.lib.NwGpu->Device[i];
+				const NWLIB_GPU_DEV* gpu = &g_ctx.frame->gpu[i];
 				LPCSTR prefix = "GPU";
 				if (gpu->Flags & NWLIB_GPU_FLAG_INTEGRATED)
 					prefix = "iGPU";
@@ -421,54 +321,25 @@ draw_display(struct nk_context* ctx)
 		}
 		else
 		{
-			INT count = NWL_NodeChildCount(g_ctx.lib.NwGpu->PciList);
-			for (i = 0; i < count; i++)
+			const GNW_VM_LIST* vm = g_ctx.frame->vm_gpu;
+			for (size_t j = 0; j < GNW_VM_COUNT(vm); j++)
 			{
-				PNODE gpu = NWL_NodeEnumChild(g_ctx.lib.NwGpu->PciList, i);
 				nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.3f, 0.7f });
-				nk_lhsc(ctx, NWL_NodeAttrGet(gpu, "Vendor"), NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
-				nk_lhc(ctx, NWL_NodeAttrGet(gpu, "Device"), NK_TEXT_LEFT, g_color_text_l);
+				nk_lhsc(ctx, vm->rows[j].label, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+				nk_lhc(ctx, vm->rows[j].text, NK_TEXT_LEFT, g_color_text_l);
 			}
 		}
 	}
 
-	INT count = NWL_NodeChildCount(g_ctx.edid);
-	for (i = 0; i < count; i++)
+	const GNW_VM_LIST* edid = g_ctx.frame->vm_edid;
+	for (size_t j = 0; j < GNW_VM_COUNT(edid); j++)
 	{
-		PNODE mon = NWL_NodeEnumChild(g_ctx.edid, i);
-		LPCSTR id = NWL_NodeAttrGet(mon, "ID");
-		if (id[0] == '-')
-			continue;
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.3f, 0.7f });
-		nk_lhsc(ctx, NWL_NodeAttrGet(mon, "Manufacturer"), NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
-		nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l,
-			"%s %s@%sHz %s\" %s",
-			id,
-			NWL_NodeAttrGet(mon, "Max Resolution"),
-			NWL_NodeAttrGet(mon, "Max Refresh Rate (Hz)"),
-			NWL_NodeAttrGet(mon, "Diagonal (in)"),
-			NWL_NodeAttrGet(mon, "Display Name"));
+		nk_lhsc(ctx, edid->rows[j].label, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+		nk_lhc(ctx, edid->rows[j].text, NK_TEXT_LEFT, g_color_text_l);
 	}
 }
 
-static LPCSTR
-get_drive_letter(PNODE volume)
-{
-	PNODE vol_path_name = NWL_NodeGetChild(volume, "Volume Path Names");
-	if (!vol_path_name)
-		goto fail;
-	INT count = NWL_NodeChildCount(vol_path_name);
-	for (INT i = 0; i < count; i++)
-	{
-		PNODE mnt = NWL_NodeEnumChild(vol_path_name, i);
-		LPCSTR attr = NWL_NodeAttrGet(mnt, "Drive Letter");
-		if (attr[0] != '-')
-			return attr;
-	}
-fail:
-	return NULL;
-}
-
 static VOID
 open_folder(LPCSTR drive_letter, LPCSTR volume_guid)
 {
@@ -480,80 +351,52 @@ open_folder(LPCSTR drive_letter, LPCSTR volume_guid)
 	ShellExecuteW(NULL, L"open", path, NULL, NULL, SW_NORMAL);
 }
 
+// Volume rows follow their disk row, draw those of the disk at rows[index].
 static VOID
-draw_volume(struct nk_context* ctx, PNODE disk, BOOL cdrom)
+draw_volume(struct nk_context* ctx, const GNW_VM_LIST* vm, size_t index)
 {
-	PNODE vol = NWL_NodeGetChild(disk, "Volumes");
-	if (!vol)
-		return;
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 5, (float[5]) { 0.12f, 0.18f, 0.4f, 0.3f - g_ctx.gui_ratio, g_ctx.gui_ratio });
-	INT count = NWL_NodeChildCount(vol);
-	for (INT i = 0; i < count; i++)
+	for (size_t i = index + 1; i < vm->count && (vm->rows[i].flags & GNW_VM_VOLUME); i++)
 	{
+		const GNW_VM_ROW* tab = &vm->rows[i];
 		struct nk_image img = GET_PNG(IDR_PNG_DIR);
-		PNODE tab = NWL_NodeEnumChild(vol, i);
-		LPCSTR path = NWL_NodeAttrGet(tab, "Path");
-		LPCSTR drive = get_drive_letter(tab);
-		LPCSTR volume_guid = NWL_NodeAttrGet(tab, "Volume GUID");
-		double percent = strtod(NWL_NodeAttrGet(tab, "Usage"), NULL);
-		if (strcmp(path, g_ctx.sys_disk) == 0)
+		if (!(tab->flags & GNW_VM_LISTED))
+			continue;
+		if (tab->flags & GNW_VM_SYSTEM_VOL)
 			img = GET_PNG(IDR_PNG_OS);
-		if (cdrom)
+		if (tab->flags & GNW_VM_CDROM)
 			img = GET_PNG(IDR_PNG_CD);
-		if (volume_guid[0] == '\\')
-		{
-			nk_spacer(ctx);
-			nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_d, "[%s]",
-				drive ? drive : NWL_NodeAttrGet(tab, "Partition Flag"));
-			nk_lhcf(ctx, NK_TEXT_LEFT,
-				g_color_text_l,
-				"%s %s %s",
-				NWL_NodeAttrGet(tab, "Total Space"),
-				NWL_NodeAttrGet(tab, "Filesystem"),
-				NWL_NodeAttrGet(tab, "Label"));
-			if (g_ctx.main_flag & MAIN_VOLUME_PROG)
-				gnwinfo_draw_percent_prog(ctx, percent);
-			else
-				nk_lhcf(ctx, NK_TEXT_LEFT,
-					gnwinfo_get_color(percent, 70.0, 90.0),
-					"%.0f%% %s: %s",
-					percent,
-					N_(N__FREE),
-					NWL_NodeAttrGet(tab, "Free Space"));
-
-			if (quick_access_button(ctx, img, volume_guid))
-				open_folder(drive, volume_guid);
-		}
+		nk_spacer(ctx);
+		nk_lhc(ctx, tab->label, NK_TEXT_LEFT, g_color_text_d);
+		nk_lhc(ctx, tab->text, NK_TEXT_LEFT, g_color_text_l);
+		if (g_ctx.main_flag & MAIN_VOLUME_PROG)
+			gnwinfo_draw_percent_prog(ctx, tab->value);
+		else
+			nk_lhc(ctx, tab->detail, NK_TEXT_LEFT, gnwinfo_get_color(tab->value, 70.0, 90.0));
+
+		if (quick_access_button(ctx, img, tab->extra))
+			open_folder(tab->key[0] ? tab->key : NULL, tab->extra);
 	}
 }
 
 static VOID
-draw_volume_compact(struct nk_context* ctx, PNODE disk)
+draw_volume_compact(struct nk_context* ctx, const GNW_VM_LIST* vm, size_t index)
 {
-	INT i;
-	INT count;
+	size_t i;
+	INT count = 0;
 	CHAR buf[] = "A";
-	PNODE vol = NWL_NodeGetChild(disk, "Volumes");
-	if (!vol)
-		return;
-	for (i = 0, count = 0; ; i++)
+	for (i = index + 1; i < vm->count && (vm->rows[i].flags & GNW_VM_VOLUME); i++)
 	{
-		PNODE node = NWL_NodeEnumChild(vol, i);
-		if (!node)
-			break;
-		LPCSTR drive = get_drive_letter(node);
-		if (drive)
+		if (vm->rows[i].key[0])
 			count++;
 	}
 	nk_layout_row_begin(ctx, NK_STATIC, 0, count + 1);
 	nk_layout_row_push(ctx, 0.3f * g_ctx.gui_width);
 	nk_spacer(ctx);
-	count = NWL_NodeChildCount(vol);
-	for (i = 0; i < count; i++)
+	for (i = index + 1; i < vm->count && (vm->rows[i].flags & GNW_VM_VOLUME); i++)
 	{
-		PNODE tab = NWL_NodeEnumChild(vol, i);
-		LPCSTR drive = get_drive_letter(tab);
-		if (!drive)
+		LPCSTR drive = vm->rows[i].key;
+		if (!drive[0])
 			continue;
 		buf[0] = drive[0];
 		nk_layout_row_push(ctx, g_ctx.gui_ratio * g_ctx.gui_width);
@@ -566,49 +409,32 @@ draw_volume_compact(struct nk_context* ctx, PNODE disk)
 static VOID
 draw_net_drive(struct nk_context* ctx)
 {
-	INT count = NWL_NodeChildCount(g_ctx.smb);
-	for (INT i = 0; i < count; i++)
+	const GNW_VM_LIST* vm = g_ctx.frame->vm_smb;
+	for (size_t i = 0; i < GNW_VM_COUNT(vm); i++)
 	{
-		PNODE nd = NWL_NodeEnumChild(g_ctx.smb, i);
-		if (!nd || strcmp(nd->name, "Drive") != 0)
-			continue;
-		LPCSTR local = NWL_NodeAttrGet(nd, "Local Name");
-		LPCSTR remote = NWL_NodeAttrGet(nd, "Remote Name");
+		const GNW_VM_ROW* nd = &vm->rows[i];
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 3, (float[3]) { 0.3f, 0.7f - g_ctx.gui_ratio, g_ctx.gui_ratio });
 		nk_lhsc(ctx, N_(N__NETWORK_DRIVES), NK_TEXT_LEFT, g_color_text_d, nk_false, nk_true);
-		nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l, "[%s] %s", local, remote);
+		nk_lhc(ctx, nd->text, NK_TEXT_LEFT, g_color_text_l);
 		if (quick_access_button(ctx, GET_PNG(IDR_PNG_DIR), NULL))
-			open_folder(NULL, remote);
+			open_folder(NULL, nd->extra);
 	}
 }
 
 static VOID
 draw_net_drive_compact(struct nk_context* ctx)
 {
-	INT i;
-	INT count = 0;
+	const GNW_VM_LIST* vm = g_ctx.frame->vm_smb;
+	INT count = (INT)GNW_VM_COUNT(vm);
 	CHAR buf[] = "A";
-	for (i = 0; ; i++)
-	{
-		PNODE node = NWL_NodeEnumChild(g_ctx.smb, i);
-		if (!node)
-			break;
-		if (strcmp(node->name, "Drive") != 0)
-			continue;
-		count++;
-	}
 	if (count < 1)
 		return;
 	nk_layout_row_begin(ctx, NK_STATIC, 0, count + 1);
 	nk_layout_row_push(ctx, 0.3f * g_ctx.gui_width);
 	nk_lhsc(ctx, N_(N__NETWORK_DRIVES), NK_TEXT_LEFT, g_color_text_d, nk_false, nk_true);
-	count = NWL_NodeChildCount(g_ctx.smb);
-	for (i = 0; i < count; i++)
+	for (INT i = 0; i < count; i++)
 	{
-		PNODE tab = NWL_NodeEnumChild(g_ctx.smb, i);
-		if (strcmp(tab->name, "Drive") != 0)
-			continue;
-		LPCSTR drive = NWL_NodeAttrGet(tab, "Local Name");
+		LPCSTR drive = vm->rows[i].key;
 		buf[0] = drive[0];
 		nk_layout_row_push(ctx, g_ctx.gui_ratio * g_ctx.gui_width);
 		if (nk_button_label(ctx, buf))
@@ -625,63 +451,27 @@ draw_storage(struct nk_context* ctx)
 	if (quick_access_button(ctx, GET_PNG(IDR_PNG_SETTINGS), N_(N__DISKMGMT)))
 		ShellExecuteW(NULL, NULL, L"diskmgmt.msc", NULL, NULL, SW_NORMAL);
 
-	INT count = NWL_NodeChildCount(g_ctx.disk);
-	for (INT i = 0; i < count; i++)
+	const GNW_VM_LIST* vm = g_ctx.frame->vm_disk;
+	for (size_t i = 0; i < GNW_VM_COUNT(vm); i++)
 	{
-		PNODE disk = NWL_NodeEnumChild(g_ctx.disk, i);
-		if (!disk)
+		const GNW_VM_ROW* disk = &vm->rows[i];
+		if (!(disk->flags & GNW_VM_DISK))
 			continue;
-		LPCSTR prefix = NWL_NodeAttrGet(disk, "Short Name");
-		BOOL cdrom = (prefix[0] == 'C') ? TRUE : FALSE;
-		LPCSTR ssd = (strcmp(NWL_NodeAttrGet(disk, "SSD"), NA_BOOL_TRUE) == 0) ? " SSD" : "";
 
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 3, (float[3]) { 0.3f, 0.4f, 0.23f });
-		snprintf(m_buf, MAX_PATH, "%s %s%s",
-			prefix,
-			NWL_NodeAttrGet(disk, "Type"),
-			ssd);
-		nk_lhsc(ctx, m_buf, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
-		nk_lhcf(ctx, NK_TEXT_LEFT,
-			g_color_text_l,
-			"%s %s %s",
-			NWL_NodeAttrGet(disk, "Size"),
-			NWL_NodeAttrGet(disk, "Partition Table"),
-			NWL_NodeAttrGet(disk, "Product ID"));
-
-		LPCSTR health = NWL_NodeAttrGet(disk, "Health Status");
-		if ((g_ctx.main_flag & MAIN_DISK_SMART) && strcmp(health, "-") != 0)
-		{
-			LPCSTR life = strchr(health, '(');
-			GETTEXT_STR_ID health_str = N__UNKNOWN;
-			struct nk_color color = g_color_unknown;
-			LPCSTR temp = NWL_NodeAttrGet(disk, NWL_GetTemperatureLabel());
-			switch (health[0])
-			{
-			case 'G': // Good
-				color = g_color_good;
-				health_str = N__GOOD;
-				break;
-			case 'C': // Caution
-				color = g_color_warning;
-				health_str = N__CAUTION;
-				break;
-			case 'B': // Bad
-				color = g_color_error;
-				health_str = N__BAD;
-				break;
-			}
-			if (life == NULL)
-				life = "";
+		nk_lhsc(ctx, disk->label, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+		nk_lhc(ctx, disk->text, NK_TEXT_LEFT, g_color_text_l);
 
-			nk_lhcf(ctx, NK_TEXT_LEFT, color,
-				u8"%s %s %s%s", N_(health_str), life, temp, g_ctx.temp_unit);
-		}
+		if ((g_ctx.main_flag & MAIN_DISK_SMART) && (disk->flags & GNW_VM_SMART))
+			nk_lhc(ctx, disk->detail, NK_TEXT_LEFT, vm_color(disk->level));
 		else
 			nk_spacer(ctx);
+		if (!(disk->flags & GNW_VM_VOLUMES))
+			continue;
 		if (g_ctx.main_flag & MAIN_DISK_COMPACT)
-			draw_volume(ctx, disk, cdrom);
+			draw_volume(ctx, vm, i);
 		else
-			draw_volume_compact(ctx, disk);
+			draw_volume_compact(ctx, vm, i);
 	}
 	if (g_ctx.main_flag & MAIN_DISK_COMPACT)
 		draw_net_drive(ctx);
@@ -689,80 +479,46 @@ draw_storage(struct nk_context* ctx)
 		draw_net_drive_compact(ctx);
 }
 
-static LPCSTR
-get_first_ipv4(PNODE node)
-{
-	PNODE unicasts = NWL_NodeGetChild(node, "Unicasts");
-	if (!unicasts)
-		return "";
-	INT count = NWL_NodeChildCount(unicasts);
-	for (INT i = 0; i < count; i++)
-	{
-		PNODE ip = NWL_NodeEnumChild(unicasts, i);
-		LPCSTR addr = NWL_NodeAttrGet(ip, "IPv4");
-		if (strcmp(addr, "-") != 0)
-			return addr;
-	}
-	return "";
-}
-
 static VOID
 draw_network(struct nk_context* ctx)
 {
 	nk_layout_row(ctx, NK_DYNAMIC, 0, 4, (float[4]) { 0.64f, 0.18f - g_ctx.gui_ratio, 0.18f, g_ctx.gui_ratio });
 	nk_image_label(ctx, GET_PNG(IDR_PNG_NETWORK), N_(N__NETWORK), NK_TEXT_LEFT, g_color_text_d);
-	nk_lhcf(ctx, NK_TEXT_LEFT, g_color_warning, u8"\u2191 %s", g_ctx.net_traffic.StrSend);
-	nk_lhcf(ctx, NK_TEXT_LEFT, g_color_unknown, u8"\u2193 %s", g_ctx.net_traffic.StrRecv);
+	nk_lhcf(ctx, NK_TEXT_LEFT, g_color_warning, u8"\u2191 %s", g_ctx.frame->net_traffic.StrSend);
+	nk_lhcf(ctx, NK_TEXT_LEFT, g_color_unknown, u8"\u2193 %s", g_ctx.frame->net_traffic.StrRecv);
 	if (quick_access_button(ctx, GET_PNG(IDR_PNG_EDIT), NULL))
 		ShellExecuteW(NULL, NULL, L"::{7007ACC7-3202-11D1-AAD2-00805FC1270E}", NULL, NULL, SW_NORMAL);
 
-	INT count = NWL_NodeChildCount(g_ctx.network);
-	for (INT i = 0; i < count; i++)
+	const GNW_VM_LIST* vm = g_ctx.frame->vm_network;
+	for (size_t i = 0; i < GNW_VM_COUNT(vm); i++)
 	{
-		BOOL is_active = FALSE;
-		PNODE nw = NWL_NodeEnumChild(g_ctx.network, i);
-		struct nk_color color = g_color_error;
-		if (!nw)
-			continue;
-		if (strcmp(NWL_NodeAttrGet(nw, "Status"), "Active") == 0)
+		const GNW_VM_ROW* nw = &vm->rows[i];
+		if (nw->flags & GNW_VM_WLAN_INFO)
 		{
-			color = g_color_good;
-			is_active = TRUE;
+			if (!(g_ctx.main_flag & MAIN_NET_DETAIL))
+				continue;
+			nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.64f, 0.36f });
+			nk_lhsc(ctx, nw->label, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+			nk_lhsc(ctx, nw->text, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_false);
+			continue;
 		}
 
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 3, (float[3]) { 0.64f, 0.36f - g_ctx.gui_ratio, g_ctx.gui_ratio });
-		nk_lhsc(ctx, NWL_NodeAttrGet(nw, "Description"), NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
-		nk_lhc(ctx, get_first_ipv4(nw), NK_TEXT_LEFT, color);
+		nk_lhsc(ctx, nw->label, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+		nk_lhc(ctx, nw->text, NK_TEXT_LEFT, vm_color(nw->level));
 		if (quick_access_button(ctx,
-			strcmp(NWL_NodeAttrGet(nw, "Type"), "IEEE 802.11 Wireless") == 0 ? GET_PNG(IDR_PNG_WLAN) : GET_PNG(IDR_PNG_ETH), NULL))
+			(nw->flags & GNW_VM_WLAN) ? GET_PNG(IDR_PNG_WLAN) : GET_PNG(IDR_PNG_ETH), NULL))
 		{
 			swprintf((WCHAR*)m_buf, MAX_PATH / sizeof(WCHAR),
-				L"::{7007ACC7-3202-11D1-AAD2-00805FC1270E}\\::%s", NWL_Utf8ToUcs2(NWL_NodeAttrGet(nw, "Network Adapter")));
+				L"::{7007ACC7-3202-11D1-AAD2-00805FC1270E}\\::%s", NWL_Utf8ToUcs2(NWL_NodeAttrGet(nw->node, "Network Adapter")));
 			ShellExecuteW(NULL, NULL, (WCHAR*)m_buf, NULL, NULL, SW_NORMAL);
 		}
 
 		if (g_ctx.main_flag & MAIN_NET_DETAIL)
 		{
 			nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.64f, 0.36f });
-			int len = snprintf(m_buf, MAX_PATH, "%s", strcmp(NWL_NodeAttrGet(nw, "DHCP Enabled"), NA_BOOL_TRUE) == 0 ? " DHCP" : "");
-			if (is_active && len >= 0 && len < MAX_PATH)
-				snprintf(m_buf + len, MAX_PATH - len, u8" \u21c5 %s / %s",
-					NWL_NodeAttrGet(nw, "Transmit Link Speed"),
-					NWL_NodeAttrGet(nw, "Receive Link Speed"));
-			nk_lhsc(ctx, m_buf, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
-			nk_lhc(ctx,
-				NWL_NodeAttrGet(nw, "MAC Address"), NK_TEXT_LEFT, g_color_text_l);
-
-			if (strcmp(NWL_NodeAttrGet(nw, "WLAN State"), "Connected") == 0)
-			{
-				nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.64f, 0.36f });
-				nk_lhscf(ctx, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true, " %s%% %s",
-					NWL_NodeAttrGet(nw, "WLAN Signal Quality"),
-					NWL_NodeAttrGet(nw, "WLAN Profile"));
-				nk_lhscf(ctx, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_false, "%s %s",
-					NWL_NodeAttrGet(nw, "WLAN Auth"),
-					NWL_NodeAttrGet(nw, "WLAN Cipher"));
-			}
+			nk_lhsc(ctx, nw->detail, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+			nk_lhc(ctx, nw->extra, NK_TEXT_LEFT, g_color_text_l);
 		}
 	}
 }
@@ -775,31 +531,25 @@ draw_audio(struct nk_context* ctx)
 	if (quick_access_button(ctx, GET_PNG(IDR_PNG_SETTINGS), NULL))
 		ShellExecuteW(NULL, NULL, L"::{26EE0668-A00A-44D7-9371-BEB064C98683}\\2\\::{F2DDFC82-8F12-4CDD-B7DC-D4FE1425AA4D}", NULL, NULL, SW_NORMAL);
 
-	if (g_ctx.sdc)
+	const GNW_VM_LIST* sdc = g_ctx.frame->vm_sdc;
+	if (GNW_VM_COUNT(sdc) > 0)
 	{
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.7f, 0.3f });
-		INT count = NWL_NodeChildCount(g_ctx.sdc);
-		for (INT i = 0; i < count; i++)
+		for (size_t i = 0; i < sdc->count; i++)
 		{
-			PNODE sdc = NWL_NodeEnumChild(g_ctx.sdc, i);
-			if (!sdc)
-				continue;
-			nk_lhscf(ctx, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true, "%s %s", NWL_NodeAttrGet(sdc, "Vendor"), NWL_NodeAttrGet(sdc, "Device"));
-			nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l, "%s %s", NWL_NodeAttrGet(sdc, "Codec Vendor"), NWL_NodeAttrGet(sdc, "Codec Device"));
+			nk_lhsc(ctx, sdc->rows[i].label, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+			nk_lhc(ctx, sdc->rows[i].text, NK_TEXT_LEFT, g_color_text_l);
 		}
 	}
 
-
-	if (g_ctx.audio)
+	const GNW_VM_LIST* audio = g_ctx.frame->vm_audio;
+	if (GNW_VM_COUNT(audio) > 0)
 	{
 		nk_layout_row(ctx, NK_DYNAMIC, 0, 2, (float[2]) { 0.7f, 0.3f });
-		for (UINT i = 0; i < g_ctx.audio_count; i++)
+		for (size_t i = 0; i < audio->count; i++)
 		{
-			nk_lhsc(ctx, NWL_Ucs2ToUtf8(g_ctx.audio[i].name), NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
-			nk_lhcf(ctx, NK_TEXT_LEFT, g_color_text_l,
-				"%s %.0f%%",
-				g_ctx.audio[i].is_default ? "*" : " ",
-				100.0f * g_ctx.audio[i].volume);
+			nk_lhsc(ctx, audio->rows[i].label, NK_TEXT_LEFT, g_color_text_d, nk_true, nk_true);
+			nk_lhc(ctx, audio->rows[i].text, NK_TEXT_LEFT, g_color_text_l);
 		}
 	}
 }
@@ -825,6 +575,9 @@ gnwinfo_draw_main_window(struct nk_context* ctx, float width, float height)
 	struct nk_rect rect = nk_layout_widget_bounds(ctx);
 	g_ctx.gui_ratio = rect.h / rect.w;
 
+	if (g_ctx.init_done && (g_ctx.frame->vm_lang != g_lang_id || g_ctx.frame->vm_flag != g_ctx.main_flag))
+		gnwinfo_ctx_update(IDT_TIMER_VIEW);
+
 	if (!g_ctx.init_done)
 	{
 		nk_layout_row_push(ctx, 1.0f);
@@ -54,21 +54,23 @@ void gnwinfo_update_systray(HWND wnd, HICON icon)
 	nid.uID = 1;
 	nid.uFlags = NIF_ICON | NIF_TIP;
 	nid.hIcon = icon;
+	// Called by the updater right after publishing, so the snapshot is stable.
+	const GNW_SNAPSHOT* s = g_ctx.snap;
 	swprintf(nid.szTip, ARRAYSIZE(nid.szTip),
 		L"CPU: %.0f%%\nRAM: %u%%\n\u2191 %hs\n\u2193 %hs",
-		g_ctx.cpu_usage,
-		g_ctx.mem_status.PhysUsage,
-		g_ctx.net_traffic.StrSend,
-		g_ctx.net_traffic.StrRecv);
+		s->cpu_usage,
+		s->mem_status.PhysUsage,
+		s->net_traffic.StrSend,
+		s->net_traffic.StrRecv);
 	Shell_NotifyIconW(NIM_MODIFY, &nid);
 }
 
 #define MAX_POWER_SCHEMES 64
 
 static inline void
-show_power_schemes_menu(HMENU menu)
+append_power_schemes(HMENU menu, PNODE battery)
 {
-	PNODE table = NWL_NodeGetChild(g_ctx.battery, "Power Schemes");
+	PNODE table = NWL_NodeGetChild(battery, "Power Schemes");
 	if (!table)
 		return;
 	INT count = NWL_NodeChildCount(table);
@@ -91,6 +93,14 @@ show_power_schemes_menu(HMENU menu)
 	}
 }
 
+static inline void
+show_power_schemes_menu(HMENU menu)
+{
+	const GNW_SNAPSHOT* s = gnwinfo_ctx_read_begin();
+	append_power_schemes(menu, s->battery);
+	gnwinfo_ctx_read_end();
+}
+
 void gnwinfo_show_systray_menu(HWND wnd)
 {
 	POINT pt;
@@ -149,15 +159,14 @@ void gnwinfo_handle_systray_cmd(HWND wnd, WORD wmid)
 	{
 		DWORD (WINAPI *set_active_scheme)(HKEY, const GUID *) = NULL;
 		INT index = wmid - IDM_POWER_SCHEME_BASE;
-		PNODE table = NWL_NodeGetChild(g_ctx.battery, "Power Schemes");
-		if (!table)
-			return;
-		PNODE scheme = NWL_NodeEnumChild(table, index);
-		if (!scheme)
-			return;
-		LPCSTR attr = NWL_NodeAttrGet(scheme, "GUID");
 		GUID guid = { 0 };
-		if (!NWL_StrToGuid(attr, &guid))
+		BOOL found = FALSE;
+		const GNW_SNAPSHOT* s = gnwinfo_ctx_read_begin();
+		PNODE scheme = NWL_NodeEnumChild(NWL_NodeGetChild(s->battery, "Power Schemes"), index);
+		if (scheme)
+			found = NWL_StrToGuid(NWL_NodeAttrGet(scheme, "GUID"), &guid);
+		gnwinfo_ctx_read_end();
+		if (!found)
 			return;
 		HMODULE dll = LoadLibraryW(L"powrprof.dll");
 		if (!dll)
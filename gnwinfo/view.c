@@ -0,0 +1,512 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <windows.h>
+#include "gnwinfo.h"
+#include "gettext.h"
+#include "utils.h"
+
+static GNW_VM_LIST*
+vm_alloc(size_t count)
+{
+	GNW_VM_LIST* list = calloc(1, sizeof(GNW_VM_LIST) + count * sizeof(GNW_VM_ROW));
+	if (!list)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate view model");
+	list->rows = (GNW_VM_ROW*)(list + 1);
+	return list;
+}
+
+static inline GNW_VM_ROW*
+vm_add(GNW_VM_LIST* list)
+{
+	return &list->rows[list->count++];
+}
+
+static inline BOOL
+attr_is_true(PNODE node, LPCSTR key)
+{
+	return strcmp(NWL_NodeAttrGet(node, key), NA_BOOL_TRUE) == 0;
+}
+
+GNW_VM_LIST*
+gnwinfo_view_system(void)
+{
+	GNW_VM_LIST* list = vm_alloc(GNW_VM_ROW_MAX);
+	GNW_VM_ROW* row;
+	int len;
+
+	list->count = GNW_VM_ROW_MAX;
+
+	row = &list->rows[GNW_VM_ROW_OS];
+	len = snprintf(row->text, MAX_PATH, "%s %s",
+		NWL_NodeAttrGet(g_ctx.system, "OS"),
+		NWL_NodeAttrGet(g_ctx.system, "Processor Architecture"));
+	if (g_ctx.main_flag & MAIN_OS_EDITIONID)
+	{
+		LPCSTR edition = NWL_NodeAttrGet(g_ctx.system, "Edition");
+		if (edition[0] != '-' && len >= 0 && len < MAX_PATH)
+			len += snprintf(row->text + len, MAX_PATH - len, " %s", edition);
+	}
+	if ((g_ctx.main_flag & MAIN_OS_BUILD) && len >= 0 && len < MAX_PATH)
+		snprintf(row->text + len, MAX_PATH - len, " (%s)", NWL_NodeAttrGet(g_ctx.system, "Build Number"));
+
+	// The hostname can be changed at runtime, it is joined when drawing.
+	row = &list->rows[GNW_VM_ROW_LOGIN];
+	snprintf(row->text, MAX_PATH, "%s", NWL_NodeAttrGet(g_ctx.system, "Username"));
+	snprintf(row->detail, MAX_PATH, "%s%s%s%s%s%s",
+		g_ctx.lib.NwIsWoW64 ? " WoW64" : "",
+		attr_is_true(g_ctx.system, "Safe Mode") ? " SafeMode" : "",
+		attr_is_true(g_ctx.system, "BitLocker Boot") ? " BitLocker" : "",
+		attr_is_true(g_ctx.system, "VHD Boot") ? " VHD" : "",
+		attr_is_true(g_ctx.system, "Fast Startup") ? " FastStartup" : "",
+		attr_is_true(g_ctx.system, "HVCI KMCI") ? " HVCI" : "");
+
+	row = &list->rows[GNW_VM_ROW_FIRMWARE];
+	LPCSTR tpm = NWL_NodeAttrGet(g_ctx.system, "TPM");
+	LPCSTR sb = NWL_NodeAttrGet(g_ctx.uefi, "Secure Boot");
+	len = snprintf(row->text, MAX_PATH, "%s", NWL_NodeAttrGet(g_ctx.system, "Firmware"));
+	if (sb[0] == 'E' && len >= 0 && len < MAX_PATH)
+		len += snprintf(row->text + len, MAX_PATH - len, " %s", N_(N__SB));
+	else if (sb[0] == 'D' && len >= 0 && len < MAX_PATH)
+		len += snprintf(row->text + len, MAX_PATH - len, " %s", N_(N__SB_OFF));
+	if (tpm[0] == 'v' && len >= 0 && len < MAX_PATH)
+		snprintf(row->text + len, MAX_PATH - len, " TPM%s", tpm);
+
+	row = &list->rows[GNW_VM_ROW_BIOS_VENDOR];
+	snprintf(row->text, MAX_PATH, "%s", NWL_NodeAttrGet(g_ctx.board, "BIOS Vendor"));
+
+	row = &list->rows[GNW_VM_ROW_BIOS_VERSION];
+	snprintf(row->text, MAX_PATH, "%s %s",
+		NWL_NodeAttrGet(g_ctx.board, "BIOS Version"),
+		NWL_NodeAttrGet(g_ctx.board, "BIOS Date"));
+
+	row = &list->rows[GNW_VM_ROW_SYSTEM];
+	snprintf(row->label, MAX_PATH, "%s", NWL_NodeAttrGet(g_ctx.board, "System Manufacturer"));
+	snprintf(row->text, MAX_PATH, "%s %s %s",
+		NWL_NodeAttrGet(g_ctx.board, "Enclosure Type"),
+		NWL_NodeAttrGet(g_ctx.board, "System Product"),
+		NWL_NodeAttrGet(g_ctx.board, "System Serial Number"));
+
+	row = &list->rows[GNW_VM_ROW_BOARD];
+	snprintf(row->label, MAX_PATH, "%s", NWL_NodeAttrGet(g_ctx.board, "Manufacturer"));
+	snprintf(row->text, MAX_PATH, "%s %s",
+		NWL_NodeAttrGet(g_ctx.board, "Board Name"),
+		NWL_NodeAttrGet(g_ctx.board, "Serial Number"));
+
+	row = &list->rows[GNW_VM_ROW_MEM_CAPACITY];
+	LPCSTR id = "16";
+	LPCSTR capacity = gnwinfo_get_smbios_attr(id, "Max Capacity", NULL, NULL);
+	if (capacity[0] == '-')
+	{
+		id = "5";
+		capacity = gnwinfo_get_smbios_attr(id, "Max Memory Module Size (MB)", NULL, NULL);
+	}
+	snprintf(row->text, MAX_PATH, "%s %s %s%s",
+		gnwinfo_get_smbios_attr(id, "Number of Slots", NULL, NULL),
+		N_(N__SLOTS),
+		capacity,
+		id[0] == '5' ? " MB" : "");
+
+	return list;
+}
+
+GNW_VM_LIST*
+gnwinfo_view_cpu(void)
+{
+	INT count = g_ctx.cpu_count;
+	GNW_VM_LIST* list = vm_alloc(count > 0 ? count : 0);
+
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE cpu = NWL_NodeEnumChild(g_ctx.cpuid, i);
+		if (cpu == NULL)
+			break;
+		GNW_VM_ROW* row = vm_add(list);
+		row->node = cpu;
+		snprintf(row->label, MAX_PATH, "%s", cpu->name);
+		snprintf(row->text, MAX_PATH, "%s", NWL_NodeAttrGet(cpu, "Brand"));
+		snprintf(row->detail, MAX_PATH, "%s %s %s %s",
+			NWL_NodeAttrGet(cpu, "Cores"), N_(N__CORES),
+			NWL_NodeAttrGet(cpu, "Logical CPUs"), N_(N__THREADS));
+
+		PNODE cache = NWL_NodeGetChild(cpu, "Cache");
+		LPCSTR l1 = NWL_NodeAttrGet(cache, "L1 Cache Size");
+		LPCSTR l2 = NWL_NodeAttrGet(cache, "L2 Cache Size");
+		LPCSTR l3 = NWL_NodeAttrGet(cache, "L3 Cache Size");
+		LPCSTR l4 = NWL_NodeAttrGet(cache, "L4 Cache Size");
+		int len = snprintf(row->extra, MAX_PATH, "L1 %s", l1);
+		if (l2[0] != '-' && len >= 0 && len < MAX_PATH)
+			len += snprintf(row->extra + len, MAX_PATH - len, " L2 %s", l2);
+		if (l3[0] != '-' && len >= 0 && len < MAX_PATH)
+			len += snprintf(row->extra + len, MAX_PATH - len, " L3 %s", l3);
+		if (l4[0] != '-' && len >= 0 && len < MAX_PATH)
+			snprintf(row->extra + len, MAX_PATH - len, " L4 %s", l4);
+	}
+	return list;
+}
+
+GNW_VM_LIST*
+gnwinfo_view_dmi(void)
+{
+	INT count = NWL_NodeChildCount(g_ctx.smbios);
+	GNW_VM_LIST* list = vm_alloc(count);
+
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE tab = NWL_NodeEnumChild(g_ctx.smbios, i);
+		LPCSTR attr = NWL_NodeAttrGet(tab, "Table Type");
+		if (strcmp(attr, "17") != 0)
+			continue;
+		LPCSTR sz = NWL_NodeAttrGet(tab, "Device Size");
+		if (sz[0] == '-')
+			continue;
+		GNW_VM_ROW* row = vm_add(list);
+		snprintf(row->label, MAX_PATH, "%s", NWL_NodeAttrGet(tab, "Bank Locator"));
+		snprintf(row->text, MAX_PATH, "%s-%s %s %s %s",
+			NWL_NodeAttrGet(tab, "Device Type"),
+			NWL_NodeAttrGet(tab, "Speed (MT/s)"),
+			sz,
+			NWL_NodeAttrGet(tab, "Manufacturer"),
+			NWL_NodeAttrGet(tab, "Serial Number"));
+	}
+	return list;
+}
+
+GNW_VM_LIST*
+gnwinfo_view_sdc(void)
+{
+	INT count = NWL_NodeChildCount(g_ctx.sdc);
+	GNW_VM_LIST* list = vm_alloc(count);
+
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE sdc = NWL_NodeEnumChild(g_ctx.sdc, i);
+		if (!sdc)
+			continue;
+		GNW_VM_ROW* row = vm_add(list);
+		snprintf(row->label, MAX_PATH, "%s %s",
+			NWL_NodeAttrGet(sdc, "Vendor"), NWL_NodeAttrGet(sdc, "Device"));
+		snprintf(row->text, MAX_PATH, "%s %s",
+			NWL_NodeAttrGet(sdc, "Codec Vendor"), NWL_NodeAttrGet(sdc, "Codec Device"));
+	}
+	return list;
+}
+
+GNW_VM_LIST*
+gnwinfo_view_power(PNODE battery)
+{
+	GNW_VM_LIST* list = vm_alloc(1);
+	GNW_VM_ROW* row = vm_add(list);
+	BOOL has_battery = TRUE;
+	LPCSTR time = "";
+	LPCSTR bat = NWL_NodeAttrGet(battery, "Battery Status");
+	LPCSTR ac = "";
+
+	if (strcmp(bat, "Charging") == 0)
+	{
+		row->level = GNW_VM_LEVEL_GOOD;
+		time = NWL_NodeAttrGet(battery, "Battery Life Full");
+	}
+	else if (strcmp(bat, "Not Charging") == 0)
+	{
+		row->level = GNW_VM_LEVEL_WARNING;
+		time = NWL_NodeAttrGet(battery, "Battery Life Remaining");
+	}
+	else
+		has_battery = FALSE;
+
+	if (strcmp(time, "UNKNOWN") == 0)
+		time = "";
+
+	if (strcmp(NWL_NodeAttrGet(battery, "AC Power"), "Online") == 0)
+		ac = u8"AC ";
+
+	int len = snprintf(row->text, MAX_PATH, "%s %s",
+		ac, NWL_NodeAttrGet(battery, "Active Power Scheme Name"));
+	if (has_battery && len >= 0 && len < MAX_PATH)
+		snprintf(row->text + len, MAX_PATH - len, " %s %s",
+			NWL_NodeAttrGet(battery, "Battery Life Percentage"),
+			time);
+	return list;
+}
+
+GNW_VM_LIST*
+gnwinfo_view_spd(PNODE spd)
+{
+	INT count = NWL_NodeChildCount(spd);
+	GNW_VM_LIST* list = vm_alloc(count);
+
+	// One row per module, in SPD order, so row i matches mem_sensors.Sensor[i].
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE tab = NWL_NodeEnumChild(spd, i);
+		GNW_VM_ROW* row = vm_add(list);
+		snprintf(row->label, MAX_PATH, "BANK %s", NWL_NodeAttrGet(tab, "ID"));
+		snprintf(row->text, MAX_PATH, "%s-%s %s %s %s",
+			NWL_NodeAttrGet(tab, "Memory Type"),
+			NWL_NodeAttrGet(tab, "Speed (MHz)"),
+			NWL_NodeAttrGet(tab, "Capacity"),
+			NWL_NodeAttrGet(tab, "Manufacturer"),
+			NWL_NodeAttrGet(tab, "Serial Number"));
+		snprintf(row->detail, MAX_PATH, "%s CL%s-%s-%s-%s",
+			NWL_NodeAttrGet(tab, "Module Type"),
+			NWL_NodeAttrGet(tab, "tCL"),
+			NWL_NodeAttrGet(tab, "tRCD"),
+			NWL_NodeAttrGet(tab, "tRP"),
+			NWL_NodeAttrGet(tab, "tRAS"));
+	}
+	return list;
+}
+
+GNW_VM_LIST*
+gnwinfo_view_gpu(PNODE pci)
+{
+	INT count = NWL_NodeChildCount(pci);
+	GNW_VM_LIST* list = vm_alloc(count);
+
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE gpu = NWL_NodeEnumChild(pci, i);
+		GNW_VM_ROW* row = vm_add(list);
+		snprintf(row->label, MAX_PATH, "%s", NWL_NodeAttrGet(gpu, "Vendor"));
+		snprintf(row->text, MAX_PATH, "%s", NWL_NodeAttrGet(gpu, "Device"));
+	}
+	return list;
+}
+
+GNW_VM_LIST*
+gnwinfo_view_edid(PNODE edid)
+{
+	INT count = NWL_NodeChildCount(edid);
+	GNW_VM_LIST* list = vm_alloc(count);
+
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE mon = NWL_NodeEnumChild(edid, i);
+		LPCSTR id = NWL_NodeAttrGet(mon, "ID");
+		if (id[0] == '-')
+			continue;
+		GNW_VM_ROW* row = vm_add(list);
+		snprintf(row->label, MAX_PATH, "%s", NWL_NodeAttrGet(mon, "Manufacturer"));
+		snprintf(row->text, MAX_PATH, "%s %s@%sHz %s\" %s",
+			id,
+			NWL_NodeAttrGet(mon, "Max Resolution"),
+			NWL_NodeAttrGet(mon, "Max Refresh Rate (Hz)"),
+			NWL_NodeAttrGet(mon, "Diagonal (in)"),
+			NWL_NodeAttrGet(mon, "Display Name"));
+	}
+	return list;
+}
+
+static LPCSTR
+get_drive_letter(PNODE volume)
+{
+	PNODE vol_path_name = NWL_NodeGetChild(volume, "Volume Path Names");
+	if (!vol_path_name)
+		goto fail;
+	INT count = NWL_NodeChildCount(vol_path_name);
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE mnt = NWL_NodeEnumChild(vol_path_name, i);
+		LPCSTR attr = NWL_NodeAttrGet(mnt, "Drive Letter");
+		if (attr[0] != '-')
+			return attr;
+	}
+fail:
+	return NULL;
+}
+
+static void
+add_disk(GNW_VM_LIST* list, PNODE disk)
+{
+	GNW_VM_ROW* row = vm_add(list);
+	LPCSTR prefix = NWL_NodeAttrGet(disk, "Short Name");
+	BOOL cdrom = (prefix[0] == 'C') ? TRUE : FALSE;
+
+	row->flags = GNW_VM_DISK | (cdrom ? GNW_VM_CDROM : 0);
+	row->node = disk;
+	snprintf(row->label, MAX_PATH, "%s %s%s",
+		prefix,
+		NWL_NodeAttrGet(disk, "Type"),
+		attr_is_true(disk, "SSD") ? " SSD" : "");
+	snprintf(row->text, MAX_PATH, "%s %s %s",
+		NWL_NodeAttrGet(disk, "Size"),
+		NWL_NodeAttrGet(disk, "Partition Table"),
+		NWL_NodeAttrGet(disk, "Product ID"));
+
+	LPCSTR health = NWL_NodeAttrGet(disk, "Health Status");
+	if (strcmp(health, "-") != 0)
+	{
+		LPCSTR life = strchr(health, '(');
+		GETTEXT_STR_ID health_str = N__UNKNOWN;
+		row->flags |= GNW_VM_SMART;
+		switch (health[0])
+		{
+		case 'G': // Good
+			row->level = GNW_VM_LEVEL_GOOD;
+			health_str = N__GOOD;
+			break;
+		case 'C': // Caution
+			row->level = GNW_VM_LEVEL_WARNING;
+			health_str = N__CAUTION;
+			break;
+		case 'B': // Bad
+			row->level = GNW_VM_LEVEL_ERROR;
+			health_str = N__BAD;
+			break;
+		}
+		if (life == NULL)
+			life = "";
+		snprintf(row->detail, MAX_PATH, u8"%s %s %s%s",
+			N_(health_str), life, NWL_NodeAttrGet(disk, NWL_GetTemperatureLabel()), g_ctx.temp_unit);
+	}
+
+	PNODE vol = NWL_NodeGetChild(disk, "Volumes");
+	if (vol)
+		row->flags |= GNW_VM_VOLUMES;
+	INT count = NWL_NodeChildCount(vol);
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE tab = NWL_NodeEnumChild(vol, i);
+		LPCSTR drive = get_drive_letter(tab);
+		LPCSTR volume_guid = NWL_NodeAttrGet(tab, "Volume GUID");
+		row = vm_add(list);
+		row->flags = GNW_VM_VOLUME | (cdrom ? GNW_VM_CDROM : 0);
+		row->node = tab;
+		row->value = strtod(NWL_NodeAttrGet(tab, "Usage"), NULL);
+		if (strcmp(NWL_NodeAttrGet(tab, "Path"), g_ctx.sys_disk) == 0)
+			row->flags |= GNW_VM_SYSTEM_VOL;
+		if (volume_guid[0] == '\\')
+			row->flags |= GNW_VM_LISTED;
+		if (drive)
+			snprintf(row->key, NWL_STR_SIZE, "%s", drive);
+		snprintf(row->extra, MAX_PATH, "%s", volume_guid);
+		snprintf(row->label, MAX_PATH, "[%s]",
+			drive ? drive : NWL_NodeAttrGet(tab, "Partition Flag"));
+		snprintf(row->text, MAX_PATH, "%s %s %s",
+			NWL_NodeAttrGet(tab, "Total Space"),
+			NWL_NodeAttrGet(tab, "Filesystem"),
+			NWL_NodeAttrGet(tab, "Label"));
+		snprintf(row->detail, MAX_PATH, "%.0f%% %s: %s",
+			row->value,
+			N_(N__FREE),
+			NWL_NodeAttrGet(tab, "Free Space"));
+	}
+}
+
+GNW_VM_LIST*
+gnwinfo_view_disk(PNODE disk)
+{
+	INT count = NWL_NodeChildCount(disk);
+	size_t rows = 0;
+	GNW_VM_LIST* list;
+
+	for (INT i = 0; i < count; i++)
+		rows += 1 + NWL_NodeChildCount(NWL_NodeGetChild(NWL_NodeEnumChild(disk, i), "Volumes"));
+	list = vm_alloc(rows);
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE node = NWL_NodeEnumChild(disk, i);
+		if (node)
+			add_disk(list, node);
+	}
+	return list;
+}
+
+GNW_VM_LIST*
+gnwinfo_view_smb(PNODE smb)
+{
+	INT count = NWL_NodeChildCount(smb);
+	GNW_VM_LIST* list = vm_alloc(count);
+
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE nd = NWL_NodeEnumChild(smb, i);
+		if (!nd || strcmp(nd->name, "Drive") != 0)
+			continue;
+		GNW_VM_ROW* row = vm_add(list);
+		LPCSTR local = NWL_NodeAttrGet(nd, "Local Name");
+		LPCSTR remote = NWL_NodeAttrGet(nd, "Remote Name");
+		snprintf(row->key, NWL_STR_SIZE, "%s", local);
+		snprintf(row->extra, MAX_PATH, "%s", remote);
+		snprintf(row->text, MAX_PATH, "[%s] %s", local, remote);
+	}
+	return list;
+}
+
+static LPCSTR
+get_first_ipv4(PNODE node)
+{
+	PNODE unicasts = NWL_NodeGetChild(node, "Unicasts");
+	if (!unicasts)
+		return "";
+	INT count = NWL_NodeChildCount(unicasts);
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE ip = NWL_NodeEnumChild(unicasts, i);
+		LPCSTR addr = NWL_NodeAttrGet(ip, "IPv4");
+		if (strcmp(addr, "-") != 0)
+			return addr;
+	}
+	return "";
+}
+
+GNW_VM_LIST*
+gnwinfo_view_network(PNODE network)
+{
+	INT count = NWL_NodeChildCount(network);
+	GNW_VM_LIST* list = vm_alloc(2 * (size_t)count);
+
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE nw = NWL_NodeEnumChild(network, i);
+		if (!nw)
+			continue;
+		GNW_VM_ROW* row = vm_add(list);
+		BOOL is_active = strcmp(NWL_NodeAttrGet(nw, "Status"), "Active") == 0;
+		row->node = nw;
+		row->level = is_active ? GNW_VM_LEVEL_GOOD : GNW_VM_LEVEL_ERROR;
+		if (is_active)
+			row->flags |= GNW_VM_ACTIVE;
+		if (strcmp(NWL_NodeAttrGet(nw, "Type"), "IEEE 802.11 Wireless") == 0)
+			row->flags |= GNW_VM_WLAN;
+		snprintf(row->label, MAX_PATH, "%s", NWL_NodeAttrGet(nw, "Description"));
+		snprintf(row->text, MAX_PATH, "%s", get_first_ipv4(nw));
+		snprintf(row->extra, MAX_PATH, "%s", NWL_NodeAttrGet(nw, "MAC Address"));
+		int len = snprintf(row->detail, MAX_PATH, "%s", attr_is_true(nw, "DHCP Enabled") ? " DHCP" : "");
+		if (is_active && len >= 0 && len < MAX_PATH)
+			snprintf(row->detail + len, MAX_PATH - len, u8" \u21c5 %s / %s",
+				NWL_NodeAttrGet(nw, "Transmit Link Speed"),
+				NWL_NodeAttrGet(nw, "Receive Link Speed"));
+
+		if (strcmp(NWL_NodeAttrGet(nw, "WLAN State"), "Connected") != 0)
+			continue;
+		row = vm_add(list);
+		row->flags = GNW_VM_WLAN_INFO;
+		row->node = nw;
+		snprintf(row->label, MAX_PATH, " %s%% %s",
+			NWL_NodeAttrGet(nw, "WLAN Signal Quality"),
+			NWL_NodeAttrGet(nw, "WLAN Profile"));
+		snprintf(row->text, MAX_PATH, "%s %s",
+			NWL_NodeAttrGet(nw, "WLAN Auth"),
+			NWL_NodeAttrGet(nw, "WLAN Cipher"));
+	}
+	return list;
+}
+
+GNW_VM_LIST*
+gnwinfo_view_audio(const NWLIB_AUDIO_DEV* audio, UINT count)
+{
+	GNW_VM_LIST* list = vm_alloc(audio ? count : 0);
+
+	for (UINT i = 0; audio && i < count; i++)
+	{
+		GNW_VM_ROW* row = vm_add(list);
+		row->value = 100.0 * audio[i].volume;
+		if (audio[i].is_default)
+			row->flags |= GNW_VM_DEFAULT;
+		snprintf(row->label, MAX_PATH, "%s", NWL_Ucs2ToUtf8(audio[i].name));
+		snprintf(row->text, MAX_PATH, "%s %.0f%%",
+			audio[i].is_default ? "*" : " ", row->value);
+	}
+	return list;
+}
@@ -151,7 +151,7 @@ static struct wr0_drv_t drv_winring0 =
 };
 #endif
 
-static int load_pio_mod(struct pio_mod_t* mod, LPCWSTR name)
+static int load_pio_mod(struct wr0_drv_t* drv, struct pio_mod_t* mod, LPCWSTR name)
 {
 	WCHAR path[MAX_PATH] = { 0 };
 	HANDLE hFile = INVALID_HANDLE_VALUE;
@@ -183,7 +183,7 @@ static int load_pio_mod(struct pio_mod_t* mod, LPCWSTR name)
 		NULL, OPEN_EXISTING, 0, NULL);
 	if (mod->hd == INVALID_HANDLE_VALUE)
 		goto fail;
-	if (!DeviceIoControl(mod->hd, IOCTL_PIO_LOAD_BINARY, mod->blob, mod->size, NULL, 0, NULL, NULL))
+	if (!WR0_IoControl(drv, mod->hd, IOCTL_PIO_LOAD_BINARY, mod->blob, mod->size, NULL, 0, NULL))
 		goto fail;
 
 	CloseHandle(hFile);
@@ -222,16 +222,16 @@ static BOOL load_pio(struct wr0_drv_t* drv)
 	drv->handle = CreateFileW(drv->obj, GENERIC_WRITE | GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
 	if (drv->handle == INVALID_HANDLE_VALUE)
 		return FALSE;
-	load_pio_mod(&drv->pio_amd0f, L"AMDFamily0F.bin");
-	load_pio_mod(&drv->pio_amd10, L"AMDFamily10.bin");
-	load_pio_mod(&drv->pio_amd17, L"AMDFamily17.bin");
-	load_pio_mod(&drv->pio_intel, L"IntelMSR.bin");
-	load_pio_mod(&drv->pio_zhaoxin, L"ZhaoxinMSR.bin");
-	load_pio_mod(&drv->pio_rysmu, L"RyzenSMU.bin");
-	load_pio_mod(&drv->pio_smi801, L"SmbusI801.bin");
-	load_pio_mod(&drv->pio_smpiix4, L"SmbusPIIX4.bin");
-	load_pio_mod(&drv->pio_lpcio, L"LpcIO.bin");
-	load_pio_mod(&drv->pio_mchbar, L"IntelMCHBAR.bin");
+	load_pio_mod(drv, &drv->pio_amd0f, L"AMDFamily0F.bin");
+	load_pio_mod(drv, &drv->pio_amd10, L"AMDFamily10.bin");
+	load_pio_mod(drv, &drv->pio_amd17, L"AMDFamily17.bin");
+	load_pio_mod(drv, &drv->pio_intel, L"IntelMSR.bin");
+	load_pio_mod(drv, &drv->pio_zhaoxin, L"ZhaoxinMSR.bin");
+	load_pio_mod(drv, &drv->pio_rysmu, L"RyzenSMU.bin");
+	load_pio_mod(drv, &drv->pio_smi801, L"SmbusI801.bin");
+	load_pio_mod(drv, &drv->pio_smpiix4, L"SmbusPIIX4.bin");
+	load_pio_mod(drv, &drv->pio_lpcio, L"LpcIO.bin");
+	load_pio_mod(drv, &drv->pio_mchbar, L"IntelMCHBAR.bin");
 	return TRUE;
 #else
 	return FALSE;
@@ -323,6 +323,9 @@ static struct wr0_drv_t* drv_list[] =
 
 struct wr0_drv_t* WR0_OpenDriver(void)
 {
+	struct wr0_drv_t* drv;
+	if (NWLC->DriverReplay)
+		return WR0_OpenReplay(NWLC->DriverReplay, NWLC->DriverTiming);
 	if (WR0_GetWineVersion())
 		return NULL;
 	if (WR0_IsWoW64())
@@ -331,18 +334,21 @@ struct wr0_drv_t* WR0_OpenDriver(void)
 		return NULL;
 	for (size_t i = 0; i < ARRAYSIZE(drv_list); i++)
 	{
-		struct wr0_drv_t* drv = drv_list[i];
+		drv = drv_list[i];
 		ZeroMemory(drv->path, MAX_PATH);
 		if (NWLC->DriverName != NULL && _stricmp(NWLC->DriverName, NWL_Ucs2ToUtf8(drv->id)) != 0)
 			continue;
+		if (NWLC->DriverRecord && !WR0_StartRecord(drv, NWLC->DriverRecord))
+			NWL_Debug("DRV", "cannot record to %s.", NWLC->DriverRecord);
 		if (drv->load(drv))
 		{
 			NWL_Debug("DRV", "%s loaded.", NWL_Ucs2ToUtf8(drv->name));
-			return drv;
+			goto out;
 		}
 		if (!drv->install(drv))
 		{
 			NWL_Debug("DRV", "cannot install %s.", NWL_Ucs2ToUtf8(drv->name));
+			WR0_StopTrace(drv);
 			ZeroMemory(drv->path, MAX_PATH);
 			continue;
 		}
@@ -350,18 +356,24 @@ struct wr0_drv_t* WR0_OpenDriver(void)
 		if (drv->load(drv))
 		{
 			NWL_Debug("DRV", "%s loaded.", NWL_Ucs2ToUtf8(drv->name));
-			return drv;
+			goto out;
 		}
 		NWL_Debug("DRV", "cannot load %s.", NWL_Ucs2ToUtf8(drv->name));
+		WR0_StopTrace(drv);
 		ZeroMemory(drv->path, MAX_PATH);
 	}
 	return NULL;
+out:
+	return drv;
 }
 
 void WR0_CloseDriver(struct wr0_drv_t* drv)
 {
 	if (drv)
+	{
+		WR0_StopTrace(drv);
 		drv->uninstall(drv);
+	}
 }
 
 int WR0_RdMsr(struct wr0_drv_t* drv, uint32_t msr_index, uint64_t* result)
@@ -389,8 +401,8 @@ int WR0_RdMsr(struct wr0_drv_t* drv, uint32_t msr_index, uint64_t* result)
 		return -1;
 	}
 
-	bRes = DeviceIoControl(drv->handle, ctlCode,
-		&msr_index, sizeof(msr_index), &msrData, sizeof(msrData), &dwBytesReturned, NULL);
+	bRes = WR0_IoControl(drv, drv->handle, ctlCode,
+		&msr_index, sizeof(msr_index), &msrData, sizeof(msrData), &dwBytesReturned);
 	if (bRes == FALSE)
 		return -1;
 	*result = msrData;
@@ -427,8 +439,8 @@ int WR0_WrMsr(struct wr0_drv_t* drv, uint32_t msr_index, uint64_t value)
 	inBuf.Register = msr_index;
 	inBuf.Value.QuadPart = value;
 
-	bRes = DeviceIoControl(drv->handle, ctlCode,
-		&inBuf, sizeof(inBuf), &outBuf, sizeof(outBuf), &dwBytesReturned, NULL);
+	bRes = WR0_IoControl(drv, drv->handle, ctlCode,
+		&inBuf, sizeof(inBuf), &outBuf, sizeof(outBuf), &dwBytesReturned);
 	if (bRes == FALSE)
 		return -1;
 	return 0;
@@ -489,8 +501,8 @@ int WR0_SendOcMailbox(struct wr0_drv_t* drv, const OC_MAILBOX_FULL* in, OC_MAILB
 		ULARGE_INTEGER buf;
 		buf.LowPart = in->Interface.InterfaceData;
 		buf.HighPart = in->Data;
-		if (DeviceIoControl(drv->handle, IOCTL_CPUZ_OC_MAILBOX,
-			&buf, sizeof(buf), &buf, sizeof(buf), &dwBytesReturned, NULL) == FALSE)
+		if (WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_OC_MAILBOX,
+			&buf, sizeof(buf), &buf, sizeof(buf), &dwBytesReturned) == FALSE)
 			return -1;
 		out->Interface.InterfaceData = buf.LowPart;
 		out->Data = buf.HighPart;
@@ -522,8 +534,8 @@ uint8_t WR0_RdIo8(struct wr0_drv_t* drv, uint16_t port)
 	case WR0_DRIVER_WINRING0:
 	{
 		WORD outBuf = 0;
-		result = DeviceIoControl(drv->handle, IOCTL_OLS_READ_IO_PORT_BYTE,
-			&port, sizeof(port), &outBuf, sizeof(outBuf), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_OLS_READ_IO_PORT_BYTE,
+			&port, sizeof(port), &outBuf, sizeof(outBuf), &returnedLength);
 		value = (uint8_t)outBuf;
 	}
 		break;
@@ -531,16 +543,16 @@ uint8_t WR0_RdIo8(struct wr0_drv_t* drv, uint16_t port)
 	{
 		UINT64 inBuf = port;
 		DWORD outBuf[2] = { 0 };
-		result = DeviceIoControl(drv->handle, IOCTL_CPUZ_READ_IO_PORT_BYTE,
-			&inBuf, sizeof(inBuf), outBuf, sizeof(outBuf), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_READ_IO_PORT_BYTE,
+			&inBuf, sizeof(inBuf), outBuf, sizeof(outBuf), &returnedLength);
 		value = (uint8_t)outBuf[0];
 	}
 		break;
 	case WR0_DRIVER_HWIO:
 	{
 		WORD outBuf = 0;
-		result = DeviceIoControl(drv->handle, IOCTL_HIO_READ_IO_PORT,
-			&port, sizeof(port), &outBuf, sizeof(outBuf), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_HIO_READ_IO_PORT,
+			&port, sizeof(port), &outBuf, sizeof(outBuf), &returnedLength);
 		value = (uint8_t)outBuf;
 	}
 		break;
@@ -565,23 +577,23 @@ uint16_t WR0_RdIo16(struct wr0_drv_t* drv, uint16_t port)
 	{
 	case WR0_DRIVER_WINRING0:
 	{
-		result = DeviceIoControl(drv->handle, IOCTL_OLS_READ_IO_PORT_WORD,
-			&port, sizeof(port), &value, sizeof(value), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_OLS_READ_IO_PORT_WORD,
+			&port, sizeof(port), &value, sizeof(value), &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_CPUZ162:
 	{
 		UINT64 inBuf = port;
 		DWORD outBuf[2] = { 0 };
-		result = DeviceIoControl(drv->handle, IOCTL_CPUZ_READ_IO_PORT_WORD,
-			&inBuf, sizeof(inBuf), outBuf, sizeof(outBuf), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_READ_IO_PORT_WORD,
+			&inBuf, sizeof(inBuf), outBuf, sizeof(outBuf), &returnedLength);
 		value = (uint16_t)outBuf[0];
 	}
 		break;
 	case WR0_DRIVER_HWIO:
 	{
-		result = DeviceIoControl(drv->handle, IOCTL_HIO_READ_IO_PORT,
-			&port, sizeof(port), &value, sizeof(value), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_HIO_READ_IO_PORT,
+			&port, sizeof(port), &value, sizeof(value), &returnedLength);
 	}
 		break;
 	default:
@@ -606,24 +618,24 @@ uint32_t WR0_RdIo32(struct wr0_drv_t* drv, uint16_t port)
 	case WR0_DRIVER_WINRING0:
 	{
 		DWORD inBuf = port;
-		result = DeviceIoControl(drv->handle, IOCTL_OLS_READ_IO_PORT_DWORD,
-			&inBuf, sizeof(inBuf), &value, sizeof(value), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_OLS_READ_IO_PORT_DWORD,
+			&inBuf, sizeof(inBuf), &value, sizeof(value), &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_CPUZ162:
 	{
 		UINT64 inBuf = port;
 		DWORD outBuf[2] = { 0 };
-		result = DeviceIoControl(drv->handle, IOCTL_CPUZ_READ_IO_PORT_DWORD,
-			&inBuf, sizeof(inBuf), outBuf, sizeof(outBuf), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_READ_IO_PORT_DWORD,
+			&inBuf, sizeof(inBuf), outBuf, sizeof(outBuf), &returnedLength);
 		value = (uint32_t)outBuf[0];
 	}
 		break;
 	case WR0_DRIVER_HWIO:
 	{
 		DWORD inBuf = port;
-		result = DeviceIoControl(drv->handle, IOCTL_HIO_READ_IO_PORT,
-			&inBuf, sizeof(inBuf), &value, sizeof(value), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_HIO_READ_IO_PORT,
+			&inBuf, sizeof(inBuf), &value, sizeof(value), &returnedLength);
 	}
 		break;
 	default:
@@ -651,8 +663,8 @@ void WR0_WrIo8(struct wr0_drv_t* drv, uint16_t port, uint8_t value)
 		inBuf.CharData = value;
 		inBuf.PortNumber = port;
 		length = offsetof(OLS_WRITE_IO_PORT_INPUT, CharData) + sizeof(inBuf.CharData);
-		result = DeviceIoControl(drv->handle, IOCTL_OLS_WRITE_IO_PORT_BYTE,
-			&inBuf, length, NULL, 0, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_OLS_WRITE_IO_PORT_BYTE,
+			&inBuf, length, NULL, 0, &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_CPUZ162:
@@ -662,8 +674,8 @@ void WR0_WrIo8(struct wr0_drv_t* drv, uint16_t port, uint8_t value)
 		inBuf.CharData = value;
 		inBuf.PortNumber = port;
 		length = sizeof(inBuf);
-		result = DeviceIoControl(drv->handle, IOCTL_CPUZ_WRITE_IO_PORT_BYTE,
-			&inBuf, length, &outBuf, sizeof(outBuf), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_WRITE_IO_PORT_BYTE,
+			&inBuf, length, &outBuf, sizeof(outBuf), &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_HWIO:
@@ -672,8 +684,8 @@ void WR0_WrIo8(struct wr0_drv_t* drv, uint16_t port, uint8_t value)
 		inBuf.CharData = value;
 		inBuf.PortNumber = port;
 		length = offsetof(OLS_WRITE_IO_PORT_INPUT, CharData) + sizeof(inBuf.CharData);
-		result = DeviceIoControl(drv->handle, IOCTL_HIO_WRITE_IO_PORT,
-			&inBuf, length, NULL, 0, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_HIO_WRITE_IO_PORT,
+			&inBuf, length, NULL, 0, &returnedLength);
 	}
 		break;
 	default:
@@ -700,8 +712,8 @@ void WR0_WrIo16(struct wr0_drv_t* drv, uint16_t port, uint16_t value)
 		inBuf.ShortData = value;
 		inBuf.PortNumber = port;
 		length = offsetof(OLS_WRITE_IO_PORT_INPUT, ShortData) + sizeof(inBuf.ShortData);
-		result = DeviceIoControl(drv->handle, IOCTL_OLS_WRITE_IO_PORT_WORD,
-			&inBuf, length, NULL, 0, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_OLS_WRITE_IO_PORT_WORD,
+			&inBuf, length, NULL, 0, &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_CPUZ162:
@@ -711,8 +723,8 @@ void WR0_WrIo16(struct wr0_drv_t* drv, uint16_t port, uint16_t value)
 		inBuf.ShortData = value;
 		inBuf.PortNumber = port;
 		length = sizeof(inBuf);
-		result = DeviceIoControl(drv->handle, IOCTL_CPUZ_WRITE_IO_PORT_WORD,
-			&inBuf, length, &outBuf, sizeof(outBuf), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_WRITE_IO_PORT_WORD,
+			&inBuf, length, &outBuf, sizeof(outBuf), &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_HWIO:
@@ -721,8 +733,8 @@ void WR0_WrIo16(struct wr0_drv_t* drv, uint16_t port, uint16_t value)
 		inBuf.ShortData = value;
 		inBuf.PortNumber = port;
 		length = offsetof(OLS_WRITE_IO_PORT_INPUT, ShortData) + sizeof(inBuf.ShortData);
-		result = DeviceIoControl(drv->handle, IOCTL_HIO_WRITE_IO_PORT,
-			&inBuf, length, NULL, 0, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_HIO_WRITE_IO_PORT,
+			&inBuf, length, NULL, 0, &returnedLength);
 	}
 		break;
 	default:
@@ -749,8 +761,8 @@ void WR0_WrIo32(struct wr0_drv_t* drv, uint16_t port, uint32_t value)
 		inBuf.LongData = value;
 		inBuf.PortNumber = port;
 		length = offsetof(OLS_WRITE_IO_PORT_INPUT, LongData) + sizeof(inBuf.LongData);
-		result = DeviceIoControl(drv->handle, IOCTL_OLS_WRITE_IO_PORT_DWORD,
-			&inBuf, length, NULL, 0, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_OLS_WRITE_IO_PORT_DWORD,
+			&inBuf, length, NULL, 0, &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_CPUZ162:
@@ -760,8 +772,8 @@ void WR0_WrIo32(struct wr0_drv_t* drv, uint16_t port, uint32_t value)
 		inBuf.LongData = value;
 		inBuf.PortNumber = port;
 		length = sizeof(inBuf);
-		result = DeviceIoControl(drv->handle, IOCTL_CPUZ_WRITE_IO_PORT_DWORD,
-			&inBuf, length, &outBuf, sizeof(outBuf), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_WRITE_IO_PORT_DWORD,
+			&inBuf, length, &outBuf, sizeof(outBuf), &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_HWIO:
@@ -770,8 +782,8 @@ void WR0_WrIo32(struct wr0_drv_t* drv, uint16_t port, uint32_t value)
 		inBuf.LongData = value;
 		inBuf.PortNumber = port;
 		length = offsetof(OLS_WRITE_IO_PORT_INPUT, LongData) + sizeof(inBuf.LongData);
-		result = DeviceIoControl(drv->handle, IOCTL_HIO_WRITE_IO_PORT,
-			&inBuf, length, NULL, 0, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_HIO_WRITE_IO_PORT,
+			&inBuf, length, NULL, 0, &returnedLength);
 	}
 		break;
 	default:
@@ -797,8 +809,8 @@ int WR0_RdPciConf(struct wr0_drv_t* drv, uint32_t addr, uint32_t reg, void* valu
 		OLS_READ_PCI_CONFIG_INPUT inBuf = { 0 };
 		inBuf.PciAddress = (PciGetBus(addr)) | (PciGetDev(addr) << 8) | (PciGetFunc(addr) << 16);
 		inBuf.PciOffset = reg;
-		result = DeviceIoControl(drv->handle, IOCTL_HIO_READ_PCI_CONFIG,
-			&inBuf, sizeof(inBuf), value, size, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_HIO_READ_PCI_CONFIG,
+			&inBuf, sizeof(inBuf), value, size, &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_WINRING0:
@@ -806,8 +818,8 @@ int WR0_RdPciConf(struct wr0_drv_t* drv, uint32_t addr, uint32_t reg, void* valu
 		OLS_READ_PCI_CONFIG_INPUT inBuf = { 0 };
 		inBuf.PciAddress = addr;
 		inBuf.PciOffset = reg;
-		result = DeviceIoControl(drv->handle, IOCTL_OLS_READ_PCI_CONFIG,
-			&inBuf, sizeof(inBuf), value, size, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_OLS_READ_PCI_CONFIG,
+			&inBuf, sizeof(inBuf), value, size, &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_CPUZ162:
@@ -818,8 +830,8 @@ int WR0_RdPciConf(struct wr0_drv_t* drv, uint32_t addr, uint32_t reg, void* valu
 		inBuf.Function = PciGetFunc(addr);
 		inBuf.Offset = reg;
 		inBuf.Length = size;
-		result = DeviceIoControl(drv->handle, IOCTL_CPUZ_READ_PCI_CONFIG,
-			&inBuf, sizeof(inBuf), &inBuf, sizeof(DWORD) + size, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_READ_PCI_CONFIG,
+			&inBuf, sizeof(inBuf), &inBuf, sizeof(DWORD) + size, &returnedLength);
 		memcpy(value, inBuf.RetData, size);
 	}
 		break;
@@ -876,8 +888,8 @@ int WR0_WrPciConf(struct wr0_drv_t* drv, uint32_t addr, uint32_t reg, void* valu
 		inBuf.PciAddress = addr;
 		inBuf.PciOffset = reg;
 		memcpy(inBuf.Data, value, size);
-		result = DeviceIoControl(drv->handle, IOCTL_OLS_WRITE_PCI_CONFIG,
-			&inBuf, inSize, NULL, 0, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_OLS_WRITE_PCI_CONFIG,
+			&inBuf, inSize, NULL, 0, &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_HWIO:
@@ -887,8 +899,8 @@ int WR0_WrPciConf(struct wr0_drv_t* drv, uint32_t addr, uint32_t reg, void* valu
 		inBuf.PciAddress = (PciGetBus(addr)) | (PciGetDev(addr) << 8) | (PciGetFunc(addr) << 16);
 		inBuf.PciOffset = reg;
 		memcpy(inBuf.Data, value, size);
-		result = DeviceIoControl(drv->handle, IOCTL_HIO_WRITE_PCI_CONFIG,
-			&inBuf, inSize, NULL, 0, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_HIO_WRITE_PCI_CONFIG,
+			&inBuf, inSize, NULL, 0, &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_CPUZ162:
@@ -902,8 +914,8 @@ int WR0_WrPciConf(struct wr0_drv_t* drv, uint32_t addr, uint32_t reg, void* valu
 		if (size == sizeof(DWORD))
 		{
 			memcpy(&inBuf.Value, value, sizeof(DWORD));
-			result = DeviceIoControl(drv->handle, IOCTL_CPUZ_WRITE_PCI_CONFIG,
-				&inBuf, sizeof(inBuf), &inBuf, sizeof(inBuf), &returnedLength, NULL);
+			result = WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_WRITE_PCI_CONFIG,
+				&inBuf, sizeof(inBuf), &inBuf, sizeof(inBuf), &returnedLength);
 		}
 		else if (size == sizeof(uint16_t))
 		{
@@ -1052,8 +1064,8 @@ int WR0_RdMmIo(struct wr0_drv_t* drv, uint64_t addr, void* value, uint32_t size)
 	switch (drv->type)
 	{
 	case WR0_DRIVER_HWIO:
-		result = DeviceIoControl(drv->handle, IOCTL_HIO_READ_MMIO,
-			&addr, sizeof(uint64_t), value, size, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_HIO_READ_MMIO,
+			&addr, sizeof(uint64_t), value, size, &returnedLength);
 		break;
 	case WR0_DRIVER_WINRING0:
 	default:
@@ -1085,8 +1097,8 @@ DWORD WR0_RdMem(struct wr0_drv_t* drv,
 		inBuf.Address.QuadPart = address;
 		inBuf.UnitSize = unitSize;
 		inBuf.Count = count;
-		result = DeviceIoControl(drv->handle, IOCTL_OLS_READ_MEMORY,
-			&inBuf, sizeof(OLS_READ_MEMORY_INPUT), buffer, size, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_OLS_READ_MEMORY,
+			&inBuf, sizeof(OLS_READ_MEMORY_INPUT), buffer, size, &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_CPUZ162:
@@ -1102,8 +1114,8 @@ DWORD WR0_RdMem(struct wr0_drv_t* drv,
 #endif
 		inBuf[1] = (DWORD)(address & 0xFFFFFFFF);
 		inBuf[2] = size;
-		result = DeviceIoControl(drv->handle, IOCTL_CPUZ_READ_MEMORY,
-			inBuf, sizeof(inBuf), outBuf, sizeof(CPUZ_READ_MEMORY_OUTPUT) + size, &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_READ_MEMORY,
+			inBuf, sizeof(inBuf), outBuf, sizeof(CPUZ_READ_MEMORY_OUTPUT) + size, &returnedLength);
 		memcpy(buffer, outBuf->Data, size);
 		free(outBuf);
 		returnedLength = size;
@@ -1193,8 +1205,8 @@ DWORD WR0_RdAmdSmn(struct wr0_drv_t* drv, enum wr0_smn_type smn, DWORD reg)
 		inBuf[0] = 0; // BDF, (bus << 16) | (dev << 11) | (fn << 8)
 		inBuf[1] = smn;
 		inBuf[2] = reg;
-		result = DeviceIoControl(drv->handle, IOCTL_CPUZ_READ_AMD_SMN,
-			inBuf, sizeof(inBuf), &value, sizeof(value), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_READ_AMD_SMN,
+			inBuf, sizeof(inBuf), &value, sizeof(value), &returnedLength);
 	}
 		break;
 	case WR0_DRIVER_HWIO:
@@ -1257,8 +1269,8 @@ WR0_SendSmuCmd(struct wr0_drv_t* drv, uint32_t cmd, uint32_t rsp, uint32_t arg,
 			inBuf[5 + i] = arg + i * 4;
 			inBuf[11 + i] = args[i];
 		}
-		result = DeviceIoControl(drv->handle, IOCTL_CPUZ_SEND_SMN_CMD,
-			inBuf, sizeof(inBuf), outBuf, sizeof(outBuf), &returnedLength, NULL);
+		result = WR0_IoControl(drv, drv->handle, IOCTL_CPUZ_SEND_SMN_CMD,
+			inBuf, sizeof(inBuf), outBuf, sizeof(outBuf), &returnedLength);
 		NWL_Debug("SMU", "Send SMU fn=%08xh %d -> %u", fn, result, outBuf[0]);
 		memcpy(args, &outBuf[1], 6 * sizeof(uint32_t));
 		if (result && outBuf[0] == 1)
@@ -50,6 +50,8 @@ struct wr0_drv_t
 	struct pio_mod_t pio_smpiix4;
 	struct pio_mod_t pio_lpcio;
 	struct pio_mod_t pio_mchbar;
+
+	struct wr0_trace_t* trace;
 };
 
 // Bus Number, Device Number and Function Number to PCI Device Address
@@ -103,6 +105,12 @@ LIBNW_API int WR0_ExecPawn(struct wr0_drv_t* drv, struct pio_mod_t* mod, LPCSTR
 LIBNW_API struct wr0_drv_t* WR0_OpenDriver(void);
 LIBNW_API void WR0_CloseDriver(struct wr0_drv_t* drv);
 
+BOOL WR0_IoControl(struct wr0_drv_t* drv, HANDLE hd, DWORD code,
+	LPVOID in, DWORD in_size, LPVOID out, DWORD out_size, LPDWORD ret_size);
+LIBNW_API BOOL WR0_StartRecord(struct wr0_drv_t* drv, LPCSTR path);
+LIBNW_API struct wr0_drv_t* WR0_OpenReplay(LPCSTR path, BOOL timing);
+LIBNW_API void WR0_StopTrace(struct wr0_drv_t* drv);
+
 LIBNW_API void WR0_MicroSleep(unsigned int usec);
 
 LIBNW_API void WR0_OpenMutexes(void);
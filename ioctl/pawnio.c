@@ -85,14 +85,13 @@ int WR0_ExecPawn(struct wr0_drv_t* drv, struct pio_mod_t* mod, LPCSTR fn,
 	if (in)
 		memcpy(inBuf->Params, in, in_size * sizeof(ULONG64));
 
-	bRes = DeviceIoControl(mod->hd,
+	bRes = WR0_IoControl(drv, mod->hd,
 		IOCTL_PIO_EXECUTE_FN,
 		inBuf,
 		inBufSize,
 		out,
 		(DWORD)(out_size * sizeof(*out)),
-		&returnedLength,
-		NULL);
+		&returnedLength);
 
 	free(inBuf);
 
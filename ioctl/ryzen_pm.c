@@ -0,0 +1,462 @@
+// SPDX-License-Identifier: Unlicense
+
+#include "ryzen_pm.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define PM_VER_ANY 0xFFFFFFFF
+#define PM_DESC_MAX_VER 28
+
+// One row per (metric, layout) pair. A metric is resolved from the first row whose
+// version list contains the PM table version, so supporting a new table only needs
+// new rows here.
+typedef struct
+{
+	ry_pm_metric_t metric;
+	uint32_t offset;
+	uint32_t count;
+	uint32_t versions[PM_DESC_MAX_VER];
+} ry_pm_desc_t;
+
+static const ry_pm_desc_t pm_desc[] =
+{
+	{ RY_PM_STAPM_LIMIT, 0x00, 1, { PM_VER_ANY } },
+	{ RY_PM_STAPM_VALUE, 0x04, 1, { PM_VER_ANY } },
+	{ RY_PM_FAST_LIMIT, 0x08, 1, { PM_VER_ANY } },
+	{ RY_PM_FAST_VALUE, 0x0C, 1, { PM_VER_ANY } },
+	{ RY_PM_SLOW_LIMIT, 0x10, 1, { PM_VER_ANY } },
+	{ RY_PM_SLOW_VALUE, 0x14, 1, { PM_VER_ANY } },
+	{ RY_PM_APU_SLOW_LIMIT, 0x18, 1,
+		{
+			0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004, 0x00370005,
+			0x003F0000, 0x00400001, 0x00400002, 0x00400003, 0x00400004, 0x00400005,
+			0x00450004, 0x00450005, 0x004C0006, 0x004C0007, 0x004C0008, 0x004C0009,
+			0x005D0008, 0x005D0009, 0x005D000B, 0x0064020C, 0x00650005, 0x00650006,
+			0x00650007,
+		} },
+	{ RY_PM_APU_SLOW_VALUE, 0x1C, 1,
+		{
+			0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004, 0x00370005,
+			0x003F0000, 0x00400001, 0x00400002, 0x00400003, 0x00400004, 0x00400005,
+			0x00450004, 0x00450005, 0x004C0006, 0x004C0009, 0x005D0008, 0x005D0009,
+			0x005D000B, 0x0064020C, 0x00650005, 0x00650006, 0x00650007,
+		} },
+	{ RY_PM_VRM_CURRENT, 0x18, 1,
+		{
+			0x001E0001, 0x001E0002, 0x001E0003, 0x001E0004, 0x001E0005, 0x001E000A,
+			0x001E0101,
+		} },
+	{ RY_PM_VRM_CURRENT, 0x20, 1,
+		{
+			0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004, 0x00370005,
+			0x00400001, 0x00400002, 0x00400003, 0x00400004, 0x00400005, 0x00450004,
+			0x00450005, 0x004C0006, 0x004C0007, 0x004C0008, 0x004C0009,
+		} },
+	{ RY_PM_VRM_CURRENT, 0x30, 1, { 0x005D0008, 0x005D0009, 0x005D000B, 0x00650005, 0x00650006, 0x00650007 } },
+	{ RY_PM_VRM_CURRENT_VALUE, 0x1C, 1,
+		{
+			0x001E0001, 0x001E0002, 0x001E0003, 0x001E0004, 0x001E0005, 0x001E000A,
+			0x001E0101,
+		} },
+	{ RY_PM_VRM_CURRENT_VALUE, 0x24, 1,
+		{
+			0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004, 0x00370005,
+			0x00400001, 0x00400002, 0x00400003, 0x00400004, 0x00400005, 0x00450004,
+			0x00450005, 0x004C0006, 0x004C0007, 0x004C0008, 0x004C0009,
+		} },
+	{ RY_PM_VRM_CURRENT_VALUE, 0x34, 1, { 0x005D0008, 0x005D0009, 0x005D000B, 0x00650005, 0x00650006, 0x00650007 } },
+	{ RY_PM_VRMSOC_CURRENT, 0x20, 1,
+		{
+			0x001E0001, 0x001E0002, 0x001E0003, 0x001E0004, 0x001E0005, 0x001E000A,
+			0x001E0101,
+		} },
+	{ RY_PM_VRMSOC_CURRENT, 0x28, 1,
+		{
+			0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004, 0x00370005,
+			0x00400001, 0x00400002, 0x00400003, 0x00400004, 0x00400005, 0x00450004,
+			0x00450005, 0x004C0006, 0x004C0007, 0x004C0008, 0x004C0009,
+		} },
+	{ RY_PM_VRMSOC_CURRENT, 0x38, 1, { 0x005D0008, 0x005D0009, 0x005D000B, 0x00650005, 0x00650006, 0x00650007 } },
+	{ RY_PM_VRMSOC_CURRENT_VALUE, 0x24, 1,
+		{
+			0x001E0001, 0x001E0002, 0x001E0003, 0x001E0004, 0x001E0005, 0x001E000A,
+			0x001E0101,
+		} },
+	{ RY_PM_VRMSOC_CURRENT_VALUE, 0x2C, 1,
+		{
+			0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004, 0x00370005,
+			0x00400001, 0x00400002, 0x00400003, 0x00400004, 0x00400005, 0x00450004,
+			0x00450005, 0x004C0006, 0x004C0007, 0x004C0008, 0x004C0009,
+		} },
+	{ RY_PM_VRMSOC_CURRENT_VALUE, 0x3C, 1, { 0x005D0008, 0x005D0009, 0x005D000B, 0x00650005, 0x00650006, 0x00650007 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x6C, 4, { 0x001E0004 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x2CC, SMU_MAX_CORE, { 0x00240803 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x28C, 8, { 0x00240903 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x340, SMU_MAX_CORE, { 0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x35C, SMU_MAX_CORE, { 0x00370005 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x324, SMU_MAX_CORE, { 0x00380804 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x330, SMU_MAX_CORE, { 0x00380805 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x2E4, 8, { 0x00380904 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x2F0, 8, { 0x00380905 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x258, 4, { 0x003F0000 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x360, SMU_MAX_CORE, { 0x00400004, 0x00400005 } },
+	{ RY_PM_CORE_TEMPERATURE, 0x840, 8, { 0x004C0006 } },
+	{ RY_PM_CORE_TEMPERATURE, 0xA38, SMU_MAX_CORE, { 0x005D0008, 0x005D0009, 0x005D000B } },
+	{ RY_PM_CORE_TEMPERATURE, 0xC10, SMU_MAX_CORE, { 0x0064020C } },
+	{ RY_PM_CORE_TEMPERATURE, 0x534, SMU_MAX_CORE, { 0x00620205 } },
+	{ RY_PM_CORE_VOLT, 0x320, SMU_MAX_CORE, { 0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004 } },
+	{ RY_PM_CORE_VOLT, 0x33C, SMU_MAX_CORE, { 0x00370005 } },
+	{ RY_PM_CORE_VOLT, 0x248, 4, { 0x003F0000 } },
+	{ RY_PM_CORE_VOLT, 0x340, SMU_MAX_CORE, { 0x00400004, 0x00400005 } },
+	{ RY_PM_CORE_VOLT, 0xA08, SMU_MAX_CORE, { 0x005D0008, 0x005D0009, 0x005D000B } },
+	{ RY_PM_CORE_VOLT, 0xBD0, SMU_MAX_CORE, { 0x0064020C } },
+	{ RY_PM_CORE_CLK, 0x3A0, SMU_MAX_CORE, { 0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004 } },
+	{ RY_PM_CORE_CLK, 0x3BC, SMU_MAX_CORE, { 0x00370005 } },
+	{ RY_PM_CORE_CLK, 0x288, 4, { 0x003F0000 } },
+	{ RY_PM_CORE_CLK, 0x3C0, SMU_MAX_CORE, { 0x00400004, 0x00400005 } },
+	{ RY_PM_CORE_CLK, 0xA68, SMU_MAX_CORE, { 0x005D0008, 0x005D0009, 0x005D000B } },
+	{ RY_PM_CORE_CLK, 0xC50, SMU_MAX_CORE, { 0x0064020C } },
+	{ RY_PM_CORE_POWER, 0x300, SMU_MAX_CORE, { 0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004 } },
+	{ RY_PM_CORE_POWER, 0x31C, SMU_MAX_CORE, { 0x00370005 } },
+	{ RY_PM_CORE_POWER, 0x238, 4, { 0x003F0000 } },
+	{ RY_PM_CORE_POWER, 0x304, SMU_MAX_CORE, { 0x00400001 } },
+	{ RY_PM_CORE_POWER, 0x320, SMU_MAX_CORE, { 0x00400004, 0x00400005 } },
+	{ RY_PM_CORE_POWER, 0x9D8, SMU_MAX_CORE, { 0x005D0008, 0x005D0009, 0x005D000B } },
+	{ RY_PM_CORE_POWER, 0xB90, SMU_MAX_CORE, { 0x0064020C } },
+	{ RY_PM_GFX_TEMPERATURE, 0x5AC, 1, { 0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004 } },
+	{ RY_PM_GFX_TEMPERATURE, 0x5C8, 1, { 0x00370005 } },
+	{ RY_PM_GFX_TEMPERATURE, 0x380, 1, { 0x003F0000 } },
+	{ RY_PM_GFX_TEMPERATURE, 0x604, 1, { 0x00400001 } },
+	{ RY_PM_GFX_TEMPERATURE, 0x61C, 1, { 0x00400002 } },
+	{ RY_PM_GFX_TEMPERATURE, 0x63C, 1, { 0x00400003 } },
+	{ RY_PM_GFX_TEMPERATURE, 0x640, 1, { 0x00400004, 0x00400005 } },
+	{ RY_PM_GFX_TEMPERATURE, 0x358, 1, { 0x004C0006 } },
+	{ RY_PM_GFX_TEMPERATURE, 0x4C8, 1, { 0x005D0008, 0x005D0009, 0x005D000B } },
+	{ RY_PM_GFX_TEMPERATURE, 0x550, 1, { 0x0064020C } },
+	{ RY_PM_GFX_VOLT, 0x5A8, 1, { 0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004 } },
+	{ RY_PM_GFX_VOLT, 0x5C4, 1, { 0x00370005 } },
+	{ RY_PM_GFX_VOLT, 0x600, 1, { 0x00400001 } },
+	{ RY_PM_GFX_VOLT, 0x618, 1, { 0x00400002 } },
+	{ RY_PM_GFX_VOLT, 0x638, 1, { 0x00400003 } },
+	{ RY_PM_GFX_VOLT, 0x63C, 1, { 0x00400004, 0x00400005 } },
+	{ RY_PM_GFX_VOLT, 0x37C, 1, { 0x003F0000 } },
+	{ RY_PM_GFX_VOLT, 0x4B8, 1, { 0x005D0008, 0x005D0009, 0x005D000B } },
+	{ RY_PM_GFX_VOLT, 0x54C, 1, { 0x0064020C } },
+	{ RY_PM_GFX_CLK, 0x5B4, 1, { 0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004 } },
+	{ RY_PM_GFX_CLK, 0x5D0, 1, { 0x00370005 } },
+	{ RY_PM_GFX_CLK, 0x60C, 1, { 0x00400001 } },
+	{ RY_PM_GFX_CLK, 0x624, 1, { 0x00400002 } },
+	{ RY_PM_GFX_CLK, 0x644, 1, { 0x00400003 } },
+	{ RY_PM_GFX_CLK, 0x648, 1, { 0x00400004, 0x00400005 } },
+	{ RY_PM_GFX_CLK, 0x388, 1, { 0x003F0000 } },
+	{ RY_PM_GFX_CLK, 0x4C0, 1, { 0x005D0008, 0x005D0009, 0x005D000B } },
+	{ RY_PM_GFX_CLK, 0x588, 1, { 0x0064020C } },
+	{ RY_PM_FCLK, 0x460, 1, { 0x001E0001 } },
+	{ RY_PM_FCLK, 0x474, 1, { 0x001E0002 } },
+	{ RY_PM_FCLK, 0x298, 1, { 0x001E0003, 0x001E0004, 0x001E0005, 0x001E000A, 0x001E0101 } },
+	{ RY_PM_FCLK, 0xB0, 1, { 0x00240003 } },
+	{ RY_PM_FCLK, 0xC0, 1, { 0x00240503, 0x00240603, 0x00240703 } },
+	{ RY_PM_FCLK, 0xBC, 1, { 0x00240802 } },
+	{ RY_PM_FCLK, 0xC0, 1, { 0x00240803 } },
+	{ RY_PM_FCLK, 0xBC, 1, { 0x00240902 } },
+	{ RY_PM_FCLK, 0xC0, 1, { 0x00240903 } },
+	{ RY_PM_FCLK, 0x28, 1, { 0x00260001 } },
+	{ RY_PM_FCLK, 0xBC, 1, { 0x002D0008, 0x002D0803, 0x002D0903 } },
+	{ RY_PM_FCLK, 0x4B4, 1, { 0x00370000 } },
+	{ RY_PM_FCLK, 0x5A4, 1, { 0x00370001 } },
+	{ RY_PM_FCLK, 0x5AC, 1, { 0x00370002 } },
+	{ RY_PM_FCLK, 0x5CC, 1, { 0x00370003, 0x00370004 } },
+	{ RY_PM_FCLK, 0x5E8, 1, { 0x00370005 } },
+	{ RY_PM_FCLK, 0xC0, 1,
+		{
+			0x00380005, 0x00380505, 0x00380605, 0x00380705, 0x00380804, 0x00380805,
+			0x00380904, 0x00380905,
+		} },
+	{ RY_PM_FCLK, 0x3C5, 1, { 0x003F0000 } },
+	{ RY_PM_FCLK, 0x624, 1, { 0x00400001 } },
+	{ RY_PM_FCLK, 0x63C, 1, { 0x00400002 } },
+	{ RY_PM_FCLK, 0x660, 1, { 0x00400003 } },
+	{ RY_PM_FCLK, 0x664, 1, { 0x00400004, 0x00400005 } },
+	{ RY_PM_FCLK, 0x664, 1, { 0x00450004 } },
+	{ RY_PM_FCLK, 0x6B0, 1, { 0x00450005 } },
+	{ RY_PM_FCLK, 0x174, 1, { 0x004C0003, 0x004C0004, 0x004C0005, 0x004C0006, 0x004C0007 } },
+	{ RY_PM_FCLK, 0x164, 1, { 0x004C0008, 0x004C0009 } },
+	{ RY_PM_FCLK, 0x118, 1,
+		{
+			0x00540000, 0x00540001, 0x00540002, 0x00540003, 0x00540004, 0x00540005,
+			0x00540100, 0x00540101, 0x00540102, 0x00540103, 0x00540104, 0x00540105,
+			0x00540108,
+		} },
+	{ RY_PM_FCLK, 0x11C, 1, { 0x00540208 } },
+	{ RY_PM_FCLK, 0x194, 1,
+		{
+			0x005C0002, 0x005C0003, 0x005C0102, 0x005C0103, 0x005C0202, 0x005C0203,
+			0x005C0302,
+		} },
+	{ RY_PM_FCLK, 0x19C, 1, { 0x005C0303, 0x005C0402, 0x005C0403 } },
+	{ RY_PM_FCLK, 0x4E0, 1, { 0x005D0008, 0x005D0009, 0x005D000B } },
+	{ RY_PM_FCLK, 0x11C, 1, { 0x00620105, 0x00620205, 0x00621101, 0x00621102, 0x00621201, 0x00621202 } },
+	{ RY_PM_FCLK, 0x20C, 1,
+		{
+			0x00730204, 0x00730404, 0x00730604, 0x00730804, 0x00730A04, 0x00730C04,
+			0x00730E04, 0x00731004,
+		} },
+	{ RY_PM_UCLK, 0x464, 1, { 0x001E0001 } },
+	{ RY_PM_UCLK, 0x478, 1, { 0x001E0002 } },
+	{ RY_PM_UCLK, 0x29C, 1, { 0x001E0003, 0x001E0004 } },
+	{ RY_PM_UCLK, 0xB8, 1, { 0x00240003 } },
+	{ RY_PM_UCLK, 0xC8, 1, { 0x00240503, 0x00240603, 0x00240703 } },
+	{ RY_PM_UCLK, 0xC4, 1, { 0x00240802 } },
+	{ RY_PM_UCLK, 0xC8, 1, { 0x00240803 } },
+	{ RY_PM_UCLK, 0xC4, 1, { 0x00240902 } },
+	{ RY_PM_UCLK, 0xC8, 1, { 0x00240903 } },
+	{ RY_PM_UCLK, 0x2C, 1, { 0x00260001 } },
+	{ RY_PM_UCLK, 0xC4, 1, { 0x002D0008, 0x002D0803, 0x002D0903 } },
+	{ RY_PM_UCLK, 0x4B8, 1, { 0x00370000 } },
+	{ RY_PM_UCLK, 0x5A8, 1, { 0x00370001 } },
+	{ RY_PM_UCLK, 0x5B0, 1, { 0x00370002 } },
+	{ RY_PM_UCLK, 0x5D0, 1, { 0x00370003, 0x00370004 } },
+	{ RY_PM_UCLK, 0x5EC, 1, { 0x00370005 } },
+	{ RY_PM_UCLK, 0xC8, 1,
+		{
+			0x00380005, 0x00380505, 0x00380605, 0x00380705, 0x00380804, 0x00380805,
+			0x00380904, 0x00380905,
+		} },
+	{ RY_PM_UCLK, 0x628, 1, { 0x00400001 } },
+	{ RY_PM_UCLK, 0x640, 1, { 0x00400002 } },
+	{ RY_PM_UCLK, 0x664, 1, { 0x00400003 } },
+	{ RY_PM_UCLK, 0x668, 1, { 0x00400004, 0x00400005, 0x00450004 } },
+	{ RY_PM_UCLK, 0x6B4, 1, { 0x00450005 } },
+	{ RY_PM_UCLK, 0x184, 1, { 0x004C0003, 0x004C0004, 0x004C0005, 0x004C0006, 0x004C0007 } },
+	{ RY_PM_UCLK, 0x174, 1, { 0x004C0008, 0x004C0009 } },
+	{ RY_PM_UCLK, 0x128, 1,
+		{
+			0x00540000, 0x00540001, 0x00540002, 0x00540003, 0x00540004, 0x00540005,
+			0x00540100, 0x00540101, 0x00540102, 0x00540103, 0x00540104, 0x00540105,
+			0x00540108,
+		} },
+	{ RY_PM_UCLK, 0x12C, 1, { 0x00540208 } },
+	{ RY_PM_UCLK, 0x1A8, 1,
+		{
+			0x005C0002, 0x005C0003, 0x005C0102, 0x005C0103, 0x005C0202, 0x005C0203,
+			0x005C0302,
+		} },
+	{ RY_PM_UCLK, 0x1B0, 1, { 0x005C0303, 0x005C0402, 0x005C0403 } },
+	{ RY_PM_UCLK, 0x12C, 1, { 0x00620105, 0x00620205, 0x00621102, 0x00621202 } },
+	{ RY_PM_UCLK, 0x21C, 1,
+		{
+			0x00730204, 0x00730404, 0x00730604, 0x00730804, 0x00730A04, 0x00730C04,
+			0x00730E04, 0x00731004,
+		} },
+	{ RY_PM_MCLK, 0x468, 1, { 0x001E0001 } },
+	{ RY_PM_MCLK, 0x47C, 1, { 0x001E0002 } },
+	{ RY_PM_MCLK, 0x2A0, 1, { 0x001E0003, 0x001E0004 } },
+	{ RY_PM_MCLK, 0xBC, 1, { 0x00240003 } },
+	{ RY_PM_MCLK, 0xCC, 1, { 0x00240503, 0x00240603, 0x00240703 } },
+	{ RY_PM_MCLK, 0xC8, 1, { 0x00240802 } },
+	{ RY_PM_MCLK, 0xCC, 1, { 0x00240803 } },
+	{ RY_PM_MCLK, 0xC8, 1, { 0x00240902 } },
+	{ RY_PM_MCLK, 0xCC, 1, { 0x00240903 } },
+	{ RY_PM_MCLK, 0x30, 1, { 0x00260001 } },
+	{ RY_PM_MCLK, 0xC8, 1, { 0x002D0008, 0x002D0803, 0x002D0903 } },
+	{ RY_PM_MCLK, 0x4BC, 1, { 0x00370000 } },
+	{ RY_PM_MCLK, 0x5AC, 1, { 0x00370001 } },
+	{ RY_PM_MCLK, 0x5B4, 1, { 0x00370002 } },
+	{ RY_PM_MCLK, 0x5D4, 1, { 0x00370003, 0x00370004 } },
+	{ RY_PM_MCLK, 0x5F0, 1, { 0x00370005 } },
+	{ RY_PM_MCLK, 0xCC, 1,
+		{
+			0x00380005, 0x00380505, 0x00380605, 0x00380705, 0x00380804, 0x00380805,
+			0x00380904, 0x00380905,
+		} },
+	{ RY_PM_MCLK, 0x62C, 1, { 0x00400001 } },
+	{ RY_PM_MCLK, 0x644, 1, { 0x00400002 } },
+	{ RY_PM_MCLK, 0x668, 1, { 0x00400003 } },
+	{ RY_PM_MCLK, 0x66C, 1, { 0x00400004, 0x00400005, 0x00450004 } },
+	{ RY_PM_MCLK, 0x6B8, 1, { 0x00450005 } },
+	{ RY_PM_MCLK, 0x194, 1, { 0x004C0003, 0x004C0004, 0x004C0005, 0x004C0006, 0x004C0007 } },
+	{ RY_PM_MCLK, 0x184, 1, { 0x004C0008, 0x004C0009 } },
+	{ RY_PM_MCLK, 0x138, 1,
+		{
+			0x00540000, 0x00540001, 0x00540002, 0x00540003, 0x00540004, 0x00540005,
+			0x00540100, 0x00540101, 0x00540102, 0x00540103, 0x00540104, 0x00540105,
+			0x00540108,
+		} },
+	{ RY_PM_MCLK, 0x13C, 1, { 0x00540208 } },
+	{ RY_PM_MCLK, 0x1BC, 1,
+		{
+			0x005C0002, 0x005C0003, 0x005C0102, 0x005C0103, 0x005C0202, 0x005C0203,
+			0x005C0302,
+		} },
+	{ RY_PM_MCLK, 0x1C4, 1, { 0x005C0303, 0x005C0402, 0x005C0403 } },
+	{ RY_PM_MCLK, 0x13C, 1, { 0x00620105, 0x00620205, 0x00621102, 0x00621202 } },
+	{ RY_PM_MCLK, 0x22C, 1,
+		{
+			0x00730204, 0x00730404, 0x00730604, 0x00730804, 0x00730A04, 0x00730C04,
+			0x00730E04, 0x00731004,
+		} },
+	{ RY_PM_SOC_VOLT, 0x10C, 1, { 0x001E0001, 0x001E0002 } },
+	{ RY_PM_SOC_VOLT, 0x104, 1, { 0x001E0003, 0x001E0004 } },
+	{ RY_PM_SOC_VOLT, 0xA4, 1, { 0x00240003 } },
+	{ RY_PM_SOC_VOLT, 0xB4, 1, { 0x00240503, 0x00240603, 0x00240703 } },
+	{ RY_PM_SOC_VOLT, 0xB0, 1, { 0x00240802 } },
+	{ RY_PM_SOC_VOLT, 0xB4, 1, { 0x00240803 } },
+	{ RY_PM_SOC_VOLT, 0xB0, 1, { 0x00240902 } },
+	{ RY_PM_SOC_VOLT, 0xB4, 1, { 0x00240903 } },
+	{ RY_PM_SOC_VOLT, 0x10, 1, { 0x00260001 } },
+	{ RY_PM_SOC_VOLT, 0xB0, 1, { 0x002D0008, 0x002D0803, 0x002D0903 } },
+	{ RY_PM_SOC_VOLT, 0x190, 1, { 0x00370000, 0x00370001 } },
+	{ RY_PM_SOC_VOLT, 0x198, 1, { 0x00370002, 0x00370003, 0x00370004, 0x00370005 } },
+	{ RY_PM_SOC_VOLT, 0xB4, 1,
+		{
+			0x00380005, 0x00380505, 0x00380605, 0x00380705, 0x00380804, 0x00380805,
+			0x00380904, 0x00380905,
+		} },
+	{ RY_PM_SOC_VOLT, 0x19C, 1, { 0x00400001, 0x00400002, 0x00400003, 0x00400004, 0x00400005, 0x00450004 } },
+	{ RY_PM_SOC_VOLT, 0x1C8, 1, { 0x00450005 } },
+	{ RY_PM_SOC_VOLT, 0x74, 1, { 0x004C0003, 0x004C0004, 0x004C0005, 0x004C0006, 0x004C0007 } },
+	{ RY_PM_SOC_VOLT, 0x194, 1, { 0x004C0008, 0x004C0009 } },
+	{ RY_PM_SOC_VOLT, 0xD0, 1,
+		{
+			0x00540000, 0x00540001, 0x00540002, 0x00540003, 0x00540004, 0x00540005,
+			0x00540100, 0x00540101, 0x00540102, 0x00540103, 0x00540104, 0x00540105,
+			0x00540108,
+		} },
+	{ RY_PM_SOC_VOLT, 0xD4, 1, { 0x00540208 } },
+	{ RY_PM_SOC_VOLT, 0x11C, 1,
+		{
+			0x005C0002, 0x005C0003, 0x005C0102, 0x005C0103, 0x005C0202, 0x005C0203,
+			0x005C0302,
+		} },
+	{ RY_PM_SOC_VOLT, 0x124, 1, { 0x005C0303, 0x005C0402, 0x005C0403 } },
+	{ RY_PM_SOC_VOLT, 0x14C, 1, { 0x00620105, 0x00620205, 0x00621102, 0x00621202 } },
+	{ RY_PM_SOC_VOLT, 0x23C, 1,
+		{
+			0x00730204, 0x00730404, 0x00730604, 0x00730804, 0x00730A04, 0x00730C04,
+			0x00730E04, 0x00731004,
+		} },
+	{ RY_PM_CLDO_VDDP, 0xF8, 1, { 0x001E0001, 0x001E0002 } },
+	{ RY_PM_CLDO_VDDP, 0xF0, 1, { 0x001E0003, 0x001E0004 } },
+	{ RY_PM_CLDO_VDDP, 0x1E4, 1, { 0x00240003 } },
+	{ RY_PM_CLDO_VDDP, 0x1F4, 1, { 0x00240503, 0x00240603, 0x00240703, 0x00240803, 0x00240903 } },
+	{ RY_PM_CLDO_VDDP, 0x1F0, 1, { 0x00240802, 0x00240902 } },
+	{ RY_PM_CLDO_VDDP, 0x220, 1, { 0x002D0008, 0x002D0803, 0x002D0903 } },
+	{ RY_PM_CLDO_VDDP, 0x72C, 1, { 0x00370000 } },
+	{ RY_PM_CLDO_VDDP, 0x81C, 1, { 0x00370001 } },
+	{ RY_PM_CLDO_VDDP, 0x824, 1, { 0x00370002 } },
+	{ RY_PM_CLDO_VDDP, 0x844, 1, { 0x00370003, 0x00370004 } },
+	{ RY_PM_CLDO_VDDP, 0x86C, 1, { 0x00370005 } },
+	{ RY_PM_CLDO_VDDP, 0x224, 1,
+		{
+			0x00380005, 0x00380505, 0x00380605, 0x00380705, 0x00380804, 0x00380805,
+			0x00380904, 0x00380905,
+		} },
+	{ RY_PM_CLDO_VDDP, 0x89C, 1, { 0x00400001 } },
+	{ RY_PM_CLDO_VDDP, 0x8B4, 1, { 0x00400002 } },
+	{ RY_PM_CLDO_VDDP, 0x8D0, 1, { 0x00400003 } },
+	{ RY_PM_CLDO_VDDP, 0x8D4, 1, { 0x00400004, 0x00400005, 0x00450004, 0x00450005 } },
+	{ RY_PM_CLDO_VDDP, 0x768, 1, { 0x004C0003, 0x004C0004, 0x004C0005, 0x004C0006, 0x004C0007, 0x004C0008 } },
+	{ RY_PM_CLDO_VDDP, 0x774, 1, { 0x004C0009 } },
+	{ RY_PM_CLDO_VDDP, 0x430, 1,
+		{
+			0x00540000, 0x00540001, 0x00540002, 0x00540003, 0x00540004, 0x00540005,
+			0x00540100, 0x00540101, 0x00540102, 0x00540103, 0x00540104, 0x00540105,
+			0x00540108,
+		} },
+	{ RY_PM_CLDO_VDDP, 0x434, 1, { 0x00540208 } },
+	{ RY_PM_CLDO_VDDP, 0x434, 1, { 0x00620105, 0x00620205, 0x00621102, 0x00621202 } },
+	{ RY_PM_CLDO_VDDP, 0x5CC, 1,
+		{
+			0x00730204, 0x00730404, 0x00730604, 0x00730804, 0x00730A04, 0x00730C04,
+			0x00730E04, 0x00731004,
+		} },
+	{ RY_PM_PSI0_CURRENT, 0x40, 1,
+		{
+			0x001E0001, 0x001E0002, 0x001E0003, 0x001E0004, 0x001E0005, 0x001E000A,
+			0x001E0101,
+		} },
+	{ RY_PM_PSI0_CURRENT, 0x78, 1,
+		{
+			0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004, 0x00370005,
+			0x00400001, 0x00400002, 0x00400003, 0x00400004, 0x00400005, 0x004C0006,
+			0x004C0007, 0x004C0008, 0x004C0009,
+		} },
+	{ RY_PM_PSI0SOC_CURRENT, 0x48, 1,
+		{
+			0x001E0001, 0x001E0002, 0x001E0003, 0x001E0004, 0x001E0005, 0x001E000A,
+			0x001E0101,
+		} },
+	{ RY_PM_PSI0SOC_CURRENT, 0x80, 1,
+		{
+			0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004, 0x00370005,
+			0x00400001, 0x00400002, 0x00400003, 0x00400004, 0x00400005, 0x004C0006,
+			0x004C0007, 0x004C0008, 0x004C0009,
+		} },
+	{ RY_PM_L3_CLK, 0x568, 1, { 0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004 } },
+	{ RY_PM_L3_CLK, 0x584, 1, { 0x00370005 } },
+	{ RY_PM_L3_CLK, 0x35C, 1, { 0x003F0000 } },
+	{ RY_PM_L3_CLK, 0x614, 1, { 0x00400004, 0x00400005 } },
+	{ RY_PM_L3_VDDM, 0x548, 1, { 0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004 } },
+	{ RY_PM_L3_VDDM, 0x564, 1, { 0x00370005 } },
+	{ RY_PM_L3_VDDM, 0x34C, 1, { 0x003F0000 } },
+	{ RY_PM_L3_VDDM, 0x604, 1, { 0x00400004, 0x00400005 } },
+	{ RY_PM_L3_TEMPERATURE, 0x550, 1, { 0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004 } },
+	{ RY_PM_L3_TEMPERATURE, 0x56C, 1, { 0x00370005 } },
+	{ RY_PM_L3_TEMPERATURE, 0x350, 1, { 0x003F0000 } },
+	{ RY_PM_L3_TEMPERATURE, 0x608, 1, { 0x00400004, 0x00400005 } },
+	{ RY_PM_SOCKET_POWER, 0x98, 1,
+		{
+			0x00370000, 0x00370001, 0x00370002, 0x00370003, 0x00370004, 0x00370005,
+			0x00400001, 0x00400002, 0x00400003, 0x00400004, 0x00400005,
+		} },
+	{ RY_PM_SOCKET_POWER, 0xA8, 1, { 0x003F0000 } },
+	{ RY_PM_SOCKET_POWER, 0xD0, 1, { 0x005D0008, 0x005D0009, 0x005D000B } },
+};
+
+static bool pm_desc_match(const ry_pm_desc_t* desc, uint32_t version)
+{
+	for (size_t i = 0; i < PM_DESC_MAX_VER && desc->versions[i]; i++)
+	{
+		if (desc->versions[i] == PM_VER_ANY || desc->versions[i] == version)
+			return true;
+	}
+	return false;
+}
+
+void ry_resolve_pm_layout(ry_pm_layout_t* layout, uint32_t version, size_t table_size)
+{
+	size_t i;
+	layout->used = 0;
+	for (i = 0; i < RY_PM_COUNT; i++)
+	{
+		layout->offset[i] = RY_PM_OFFSET_INVALID;
+		layout->count[i] = 0;
+	}
+	for (i = 0; i < sizeof(pm_desc) / sizeof(pm_desc[0]); i++)
+	{
+		const ry_pm_desc_t* desc = &pm_desc[i];
+		if (layout->count[desc->metric])
+			continue;
+		if (!pm_desc_match(desc, version))
+			continue;
+		size_t end = desc->offset + desc->count * sizeof(float);
+		if (end > table_size)
+			continue;
+		layout->offset[desc->metric] = desc->offset;
+		layout->count[desc->metric] = (uint8_t)desc->count;
+		if (end > layout->used)
+			layout->used = end;
+	}
+	// Round up so the table can be fetched in dwords
+	layout->used = (layout->used + 3) & ~(size_t)3;
+}
+
+void ry_extract_pm_values(const ry_pm_layout_t* layout, const uint8_t* table,
+	float values[RY_PM_COUNT][SMU_MAX_CORE])
+{
+	for (size_t i = 0; i < RY_PM_COUNT; i++)
+	{
+		if (layout->count[i])
+			memcpy(values[i], table + layout->offset[i], layout->count[i] * sizeof(float));
+	}
+}
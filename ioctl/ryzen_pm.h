@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Unlicense
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// PM table layout descriptors for AMD Ryzen SMU.
+// Works on a memory image of the PM table and has no OS dependency, so captured
+// tables can be replayed anywhere (see pmtest/).
+
+#define SMU_TABLE_MAX_SIZE 0x1000
+#define SMU_MAX_CORE 16
+
+#define RY_PM_OFFSET_INVALID 0xFFFFFFFF
+
+typedef enum
+{
+	RY_PM_STAPM_LIMIT = 0,
+	RY_PM_STAPM_VALUE,
+	RY_PM_FAST_LIMIT,
+	RY_PM_FAST_VALUE,
+	RY_PM_SLOW_LIMIT,
+	RY_PM_SLOW_VALUE,
+	RY_PM_APU_SLOW_LIMIT,
+	RY_PM_APU_SLOW_VALUE,
+	RY_PM_VRM_CURRENT,
+	RY_PM_VRM_CURRENT_VALUE,
+	RY_PM_VRMSOC_CURRENT,
+	RY_PM_VRMSOC_CURRENT_VALUE,
+	RY_PM_CORE_TEMPERATURE,
+	RY_PM_CORE_VOLT,
+	RY_PM_CORE_CLK,
+	RY_PM_CORE_POWER,
+	RY_PM_GFX_TEMPERATURE,
+	RY_PM_GFX_VOLT,
+	RY_PM_GFX_CLK,
+	RY_PM_FCLK,
+	RY_PM_UCLK,
+	RY_PM_MCLK,
+	RY_PM_SOC_VOLT,
+	RY_PM_CLDO_VDDP,
+	RY_PM_PSI0_CURRENT,
+	RY_PM_PSI0SOC_CURRENT,
+	RY_PM_L3_CLK,
+	RY_PM_L3_VDDM,
+	RY_PM_L3_TEMPERATURE,
+	RY_PM_SOCKET_POWER,
+	RY_PM_COUNT,
+} ry_pm_metric_t;
+
+typedef struct
+{
+	uint32_t offset[RY_PM_COUNT];
+	uint8_t count[RY_PM_COUNT];
+	// Bytes of the table covered by resolved metrics, rounded up to a dword
+	size_t used;
+} ry_pm_layout_t;
+
+void ry_resolve_pm_layout(ry_pm_layout_t* layout, uint32_t version, size_t table_size);
+
+void ry_extract_pm_values(const ry_pm_layout_t* layout, const uint8_t* table,
+	float values[RY_PM_COUNT][SMU_MAX_CORE]);
@@ -1,8 +1,10 @@
 // SPDX-License-Identifier: Unlicense
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include "ryzen_pm.h"
 
 typedef enum
 {
@@ -83,8 +85,6 @@ typedef union
 
 struct wr0_drv_t;
 
-#define SMU_TABLE_MAX_SIZE 0x1000
-
 typedef struct
 {
 	ry_codename_t codename;
@@ -100,6 +100,13 @@ typedef struct
 		uint64_t pm_table_buffer_u64[SMU_TABLE_MAX_SIZE / 8];
 	};
 
+	// Resolved once per PM table version in ryzen_smu_init
+	ry_pm_layout_t pm_layout;
+	// Set when the last refresh only fetched the metric dwords
+	bool pm_table_partial;
+	// Extracted by ryzen_smu_update_pm_table
+	float pm_value[RY_PM_COUNT][SMU_MAX_CORE];
+
 	struct wr0_drv_t* drv_handle;
 
 	uint32_t rsmu_cmd_addr;
@@ -117,7 +124,7 @@ ry_err_t ryzen_smu_update_pm_table(ry_handle_t* handle);
 
 ry_err_t ryzen_smu_get_pm_table_float(ry_handle_t* handle, size_t offset, float* value);
 
-#define SMU_MAX_CORE 16
+ry_err_t ryzen_smu_get_pm_metric(ry_handle_t* handle, ry_pm_metric_t metric, uint32_t index, float* data);
 
 ry_err_t ryzen_smu_get_stapm_limit(ry_handle_t* handle, float* data);
 
@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: Unlicense
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ioctl.h"
+#include "tracefmt.h"
+#include "libnw.h"
+
+// Win32 capture and replay front end of the WR0 trace.
+// The file format, reader and matcher live in tracefmt.c.
+
+struct wr0_trace_t
+{
+	BOOL replay;
+	BOOL timing;
+	CRITICAL_SECTION lock;
+	// Record
+	FILE* fp;
+	LARGE_INTEGER freq;
+	// Replay
+	wr0_trace_log_t log;
+};
+
+static struct pio_mod_t* get_pio_mod(struct wr0_drv_t* drv, uint32_t i)
+{
+	struct pio_mod_t* mods[] =
+	{
+		&drv->pio_amd0f, &drv->pio_amd10, &drv->pio_amd17, &drv->pio_intel, &drv->pio_zhaoxin,
+		&drv->pio_rysmu, &drv->pio_smi801, &drv->pio_smpiix4, &drv->pio_lpcio, &drv->pio_mchbar,
+	};
+	if (i >= ARRAYSIZE(mods))
+		return NULL;
+	return mods[i];
+}
+
+static uint32_t get_chan(struct wr0_drv_t* drv, HANDLE hd)
+{
+	struct pio_mod_t* mod;
+	for (uint32_t i = 0; (mod = get_pio_mod(drv, i)) != NULL; i++)
+	{
+		if (mod->hd == hd)
+			return WR0_CHAN_PIO + i;
+	}
+	return WR0_CHAN_DRV;
+}
+
+static void emulate_delay(uint64_t ns)
+{
+	LARGE_INTEGER freq, start, now;
+	if (ns >= 2000000)
+	{
+		Sleep((DWORD)(ns / 1000000));
+		return;
+	}
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&start);
+	do
+	{
+		YieldProcessor();
+		QueryPerformanceCounter(&now);
+	} while ((uint64_t)(now.QuadPart - start.QuadPart) * 1000000000ULL / (uint64_t)freq.QuadPart < ns);
+}
+
+static BOOL replay_ioctl(struct wr0_trace_t* trace, uint32_t chan, DWORD code,
+	LPVOID in, DWORD in_size, LPVOID out, DWORD out_size, LPDWORD ret_size)
+{
+	const wr0_trace_entry_t* e;
+
+	EnterCriticalSection(&trace->lock);
+	e = wr0_trace_find(&trace->log, chan, code, in, in_size, out_size);
+	LeaveCriticalSection(&trace->lock);
+
+	if (!e)
+	{
+		NWL_Debug("DRV", "Replay miss chan=%u code=%08lX in@%lu out@%lu", chan, code, in_size, out_size);
+		if (ret_size)
+			*ret_size = 0;
+		SetLastError(ERROR_NOT_FOUND);
+		return FALSE;
+	}
+	if (out && out_size)
+		memcpy(out, e->out, out_size);
+	if (ret_size)
+		*ret_size = e->rec->ret_size;
+	if (trace->timing)
+		emulate_delay(e->rec->elapsed_ns);
+	return e->rec->result ? TRUE : FALSE;
+}
+
+static void record_ioctl(struct wr0_trace_t* trace, uint32_t chan, DWORD code,
+	LPVOID in, DWORD in_size, LPVOID out, DWORD out_size, DWORD ret_size, BOOL result, uint64_t elapsed_ns)
+{
+	wr0_trace_rec_t rec =
+	{
+		.chan = chan,
+		.code = code,
+		.in_size = in ? in_size : 0,
+		.out_size = out ? out_size : 0,
+		.ret_size = ret_size,
+		.result = result ? 1 : 0,
+		.elapsed_ns = elapsed_ns,
+	};
+
+	EnterCriticalSection(&trace->lock);
+	wr0_trace_write_rec(trace->fp, &rec, in, out);
+	LeaveCriticalSection(&trace->lock);
+}
+
+static uint32_t get_pio_mask(struct wr0_drv_t* drv)
+{
+	struct pio_mod_t* mod;
+	uint32_t mask = 0;
+	for (uint32_t i = 0; (mod = get_pio_mod(drv, i)) != NULL; i++)
+	{
+		if (mod->hd && mod->hd != INVALID_HANDLE_VALUE)
+			mask |= 1U << i;
+	}
+	return mask;
+}
+
+BOOL WR0_IoControl(struct wr0_drv_t* drv, HANDLE hd, DWORD code,
+	LPVOID in, DWORD in_size, LPVOID out, DWORD out_size, LPDWORD ret_size)
+{
+	struct wr0_trace_t* trace = drv->trace;
+	DWORD ret = 0;
+	BOOL result;
+	LARGE_INTEGER start, end;
+
+	if (!trace)
+		return DeviceIoControl(hd, code, in, in_size, out, out_size, ret_size ? ret_size : &ret, NULL);
+
+	if (trace->replay)
+		return replay_ioctl(trace, get_chan(drv, hd), code, in, in_size, out, out_size, ret_size);
+
+	QueryPerformanceCounter(&start);
+	result = DeviceIoControl(hd, code, in, in_size, out, out_size, &ret, NULL);
+	QueryPerformanceCounter(&end);
+	if (ret_size)
+		*ret_size = ret;
+	record_ioctl(trace, get_chan(drv, hd), code, in, in_size, out, out_size, ret, result,
+		(uint64_t)(end.QuadPart - start.QuadPart) * 1000000000ULL / (uint64_t)trace->freq.QuadPart);
+	return result;
+}
+
+// Started before the driver loads so module uploads are captured too,
+// the loaded module mask is filled into the header when the trace stops.
+BOOL WR0_StartRecord(struct wr0_drv_t* drv, LPCSTR path)
+{
+	struct wr0_trace_t* trace;
+	wr0_trace_hdr_t hdr = { .magic = WR0_TRACE_MAGIC, .version = WR0_TRACE_VERSION };
+
+	if (!drv || drv->trace)
+		return FALSE;
+	trace = calloc(1, sizeof(struct wr0_trace_t));
+	if (!trace)
+		return FALSE;
+	if (fopen_s(&trace->fp, path, "wb") != 0 || !trace->fp)
+	{
+		free(trace);
+		return FALSE;
+	}
+	hdr.type = drv->type;
+	hdr.pio_mask = get_pio_mask(drv);
+	wr0_trace_write_hdr(trace->fp, &hdr);
+	QueryPerformanceFrequency(&trace->freq);
+	InitializeCriticalSection(&trace->lock);
+	drv->trace = trace;
+	NWL_Debug("DRV", "Recording to %s", path);
+	return TRUE;
+}
+
+static BOOL load_replay(struct wr0_drv_t* drv)
+{
+	UNREFERENCED_PARAMETER(drv);
+	return TRUE;
+}
+
+static BOOL install_replay(struct wr0_drv_t* drv)
+{
+	UNREFERENCED_PARAMETER(drv);
+	return TRUE;
+}
+
+static void uninstall_replay(struct wr0_drv_t* drv)
+{
+	struct pio_mod_t* mod;
+	for (uint32_t i = 0; (mod = get_pio_mod(drv, i)) != NULL; i++)
+		mod->hd = INVALID_HANDLE_VALUE;
+	drv->handle = INVALID_HANDLE_VALUE;
+}
+
+static struct wr0_drv_t drv_replay =
+{
+	.name = L"Replay",
+	.type = WR0_DRIVER_NONE,
+	.id = L"Replay",
+	.obj = L"",
+	.handle = INVALID_HANDLE_VALUE,
+
+	.load = load_replay,
+	.install = install_replay,
+	.uninstall = uninstall_replay,
+};
+
+struct wr0_drv_t* WR0_OpenReplay(LPCSTR path, BOOL timing)
+{
+	FILE* fp = NULL;
+	struct pio_mod_t* mod;
+	struct wr0_trace_t* trace;
+
+	if (fopen_s(&fp, path, "rb") != 0 || !fp)
+		return NULL;
+	trace = calloc(1, sizeof(struct wr0_trace_t));
+	if (!trace)
+		goto fail;
+	if (wr0_trace_load(&trace->log, fp) != 0
+		|| trace->log.hdr.type == WR0_DRIVER_NONE || trace->log.hdr.type >= WR0_DRIVER_MAX)
+		goto fail;
+	fclose(fp);
+	fp = NULL;
+
+	trace->replay = TRUE;
+	trace->timing = timing;
+	InitializeCriticalSection(&trace->lock);
+
+	// Handles only need to be distinct and valid-looking, nothing is opened.
+	drv_replay.type = trace->log.hdr.type;
+	drv_replay.handle = (HANDLE)(ULONG_PTR)0x10;
+	for (uint32_t i = 0; (mod = get_pio_mod(&drv_replay, i)) != NULL; i++)
+		mod->hd = (trace->log.hdr.pio_mask & (1U << i)) ? (HANDLE)(ULONG_PTR)(0x20 + i * 4) : INVALID_HANDLE_VALUE;
+	drv_replay.trace = trace;
+	NWL_Debug("DRV", "Replaying %s, type %u, %zu records", path, trace->log.hdr.type, trace->log.count);
+	return &drv_replay;
+
+fail:
+	if (fp)
+		fclose(fp);
+	if (trace)
+	{
+		wr0_trace_free(&trace->log);
+		free(trace);
+	}
+	NWL_Debug("DRV", "Cannot load trace %s", path);
+	return NULL;
+}
+
+void WR0_StopTrace(struct wr0_drv_t* drv)
+{
+	struct wr0_trace_t* trace;
+	if (!drv || !drv->trace)
+		return;
+	trace = drv->trace;
+	drv->trace = NULL;
+	if (trace->fp)
+	{
+		wr0_trace_hdr_t hdr = { .magic = WR0_TRACE_MAGIC, .version = WR0_TRACE_VERSION };
+		hdr.type = drv->type;
+		hdr.pio_mask = get_pio_mask(drv);
+		wr0_trace_write_hdr(trace->fp, &hdr);
+		fclose(trace->fp);
+	}
+	if (trace->replay)
+		NWL_Debug("DRV", "Replay done, %zu misses", trace->log.misses);
+	wr0_trace_free(&trace->log);
+	DeleteCriticalSection(&trace->lock);
+	free(trace);
+}
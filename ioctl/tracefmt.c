@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdlib.h>
+#include <string.h>
+#include "tracefmt.h"
+
+int wr0_trace_parse(wr0_trace_log_t* log, uint8_t* data, size_t size)
+{
+	size_t pos = sizeof(wr0_trace_hdr_t);
+	size_t cap = 0;
+
+	memset(log, 0, sizeof(wr0_trace_log_t));
+	log->data = data;
+	log->size = size;
+	if (size < sizeof(wr0_trace_hdr_t))
+		return -1;
+	memcpy(&log->hdr, data, sizeof(wr0_trace_hdr_t));
+	if (memcmp(log->hdr.magic, WR0_TRACE_MAGIC, sizeof(log->hdr.magic)) != 0
+		|| log->hdr.version != WR0_TRACE_VERSION)
+		return -1;
+
+	while (pos + sizeof(wr0_trace_rec_t) <= size)
+	{
+		const wr0_trace_rec_t* rec = (const wr0_trace_rec_t*)(data + pos);
+		size_t len = sizeof(wr0_trace_rec_t) + (size_t)rec->in_size + rec->out_size;
+		if (len > size - pos)
+			break; // truncated tail, keep what we have
+		if (log->count >= cap)
+		{
+			size_t new_cap = cap ? cap * 2 : 256;
+			wr0_trace_entry_t* p = realloc(log->entries, new_cap * sizeof(wr0_trace_entry_t));
+			if (!p)
+				return -1;
+			log->entries = p;
+			cap = new_cap;
+		}
+		log->entries[log->count].rec = rec;
+		log->entries[log->count].in = data + pos + sizeof(wr0_trace_rec_t);
+		log->entries[log->count].out = log->entries[log->count].in + rec->in_size;
+		log->count++;
+		pos += len;
+	}
+	return 0;
+}
+
+int wr0_trace_load(wr0_trace_log_t* log, FILE* fp)
+{
+	long len;
+	uint8_t* data;
+
+	memset(log, 0, sizeof(wr0_trace_log_t));
+	if (fseek(fp, 0, SEEK_END) != 0)
+		return -1;
+	len = ftell(fp);
+	if (len <= 0 || fseek(fp, 0, SEEK_SET) != 0)
+		return -1;
+	data = malloc((size_t)len);
+	if (!data)
+		return -1;
+	if (fread(data, 1, (size_t)len, fp) != (size_t)len)
+	{
+		free(data);
+		return -1;
+	}
+	return wr0_trace_parse(log, data, (size_t)len);
+}
+
+void wr0_trace_free(wr0_trace_log_t* log)
+{
+	free(log->entries);
+	free(log->data);
+	memset(log, 0, sizeof(wr0_trace_log_t));
+}
+
+static int match_entry(const wr0_trace_entry_t* e, uint32_t chan, uint32_t code,
+	const void* in, uint32_t in_size, uint32_t out_size)
+{
+	if (e->rec->chan != chan || e->rec->code != code
+		|| e->rec->in_size != in_size || e->rec->out_size != out_size)
+		return 0;
+	return in_size == 0 || memcmp(e->in, in, in_size) == 0;
+}
+
+const wr0_trace_entry_t* wr0_trace_find(wr0_trace_log_t* log, uint32_t chan, uint32_t code,
+	const void* in, uint32_t in_size, uint32_t out_size)
+{
+	// Requests normally come back in recorded order; fall back to a wrapped
+	// search so polling loops with a different iteration count still resolve.
+	for (size_t i = 0; i < log->count; i++)
+	{
+		size_t idx = (log->cursor + i) % log->count;
+		if (match_entry(&log->entries[idx], chan, code, in, in_size, out_size))
+		{
+			log->cursor = idx + 1;
+			return &log->entries[idx];
+		}
+	}
+	log->misses++;
+	return NULL;
+}
+
+int wr0_trace_write_hdr(FILE* fp, const wr0_trace_hdr_t* hdr)
+{
+	if (fseek(fp, 0, SEEK_SET) != 0)
+		return -1;
+	if (fwrite(hdr, sizeof(wr0_trace_hdr_t), 1, fp) != 1)
+		return -1;
+	return fseek(fp, 0, SEEK_END);
+}
+
+int wr0_trace_write_rec(FILE* fp, const wr0_trace_rec_t* rec, const void* in, const void* out)
+{
+	if (fwrite(rec, sizeof(wr0_trace_rec_t), 1, fp) != 1)
+		return -1;
+	if (rec->in_size && fwrite(in, 1, rec->in_size, fp) != rec->in_size)
+		return -1;
+	if (rec->out_size && fwrite(out, 1, rec->out_size, fp) != rec->out_size)
+		return -1;
+	return 0;
+}
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Unlicense
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// WR0 driver trace file format, reader and replay matcher.
+// Plain C with no OS headers, so traces can be inspected and replayed anywhere.
+//
+// Layout (little endian):
+//   wr0_trace_hdr_t
+//   { wr0_trace_rec_t, in[in_size], out[out_size] } ...
+
+#define WR0_TRACE_MAGIC   "NWDRVTRC"
+#define WR0_TRACE_VERSION 1
+
+#define WR0_CHAN_DRV      0
+#define WR0_CHAN_PIO      1
+
+#pragma pack(push, 1)
+typedef struct
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t type;
+	uint32_t pio_mask;
+	uint32_t reserved;
+} wr0_trace_hdr_t;
+
+typedef struct
+{
+	uint32_t chan;
+	uint32_t code;
+	uint32_t in_size;
+	uint32_t out_size;
+	uint32_t ret_size;
+	uint32_t result;
+	uint64_t elapsed_ns;
+} wr0_trace_rec_t;
+#pragma pack(pop)
+
+typedef struct
+{
+	const wr0_trace_rec_t* rec;
+	const uint8_t* in;
+	const uint8_t* out;
+} wr0_trace_entry_t;
+
+typedef struct
+{
+	wr0_trace_hdr_t hdr;
+	uint8_t* data;
+	size_t size;
+	wr0_trace_entry_t* entries;
+	size_t count;
+	size_t cursor;
+	size_t misses;
+} wr0_trace_log_t;
+
+// Reads a whole trace from fp. Returns 0 on success.
+int wr0_trace_load(wr0_trace_log_t* log, FILE* fp);
+// Takes ownership of data (malloc'd). Returns 0 on success.
+int wr0_trace_parse(wr0_trace_log_t* log, uint8_t* data, size_t size);
+void wr0_trace_free(wr0_trace_log_t* log);
+
+// Next record matching the request, NULL on a miss. Not thread safe.
+const wr0_trace_entry_t* wr0_trace_find(wr0_trace_log_t* log, uint32_t chan, uint32_t code,
+	const void* in, uint32_t in_size, uint32_t out_size);
+
+int wr0_trace_write_hdr(FILE* fp, const wr0_trace_hdr_t* hdr);
+int wr0_trace_write_rec(FILE* fp, const wr0_trace_rec_t* rec, const void* in, const void* out);
@@ -13,6 +13,11 @@ static struct
 	VOID (WINAPI* cdi_init_smart)(CDI_SMART* ptr, UINT64 flags);
 	DWORD (WINAPI* cdi_update_smart)(CDI_SMART* ptr, INT index);
 	INT (WINAPI* cdi_get_disk_count)(CDI_SMART* ptr);
+	INT (WINAPI* cdi_refresh_smart)(CDI_SMART* ptr, DWORD interval, BOOL force);
+	INT (WINAPI* cdi_refresh_disk)(CDI_SMART* ptr, INT index, DWORD interval, BOOL force);
+	INT (WINAPI* cdi_get_refresh_status)(CDI_SMART* ptr, INT index);
+	DWORD (WINAPI* cdi_get_changed_attrs)(CDI_SMART* ptr, INT index);
+	ULONGLONG (WINAPI* cdi_get_last_refresh)(CDI_SMART* ptr, INT index);
 	BOOL (WINAPI* cdi_get_bool)(CDI_SMART* ptr, INT index, enum CDI_ATA_BOOL attr);
 	INT (WINAPI* cdi_get_int)(CDI_SMART* ptr, INT index, enum CDI_ATA_INT attr);
 	DWORD (WINAPI* cdi_get_dword)(CDI_SMART* ptr, INT index, enum CDI_ATA_DWORD attr);
@@ -55,6 +60,11 @@ CDI_SMART* WINAPI cdi_create_smart(VOID)
 	*(FARPROC*)&m_cdi.cdi_init_smart = GetProcAddress(m_cdi.dll, "cdi_init_smart");
 	*(FARPROC*)&m_cdi.cdi_update_smart = GetProcAddress(m_cdi.dll, "cdi_update_smart");
 	*(FARPROC*)&m_cdi.cdi_get_disk_count = GetProcAddress(m_cdi.dll, "cdi_get_disk_count");
+	*(FARPROC*)&m_cdi.cdi_refresh_smart = GetProcAddress(m_cdi.dll, "cdi_refresh_smart");
+	*(FARPROC*)&m_cdi.cdi_refresh_disk = GetProcAddress(m_cdi.dll, "cdi_refresh_disk");
+	*(FARPROC*)&m_cdi.cdi_get_refresh_status = GetProcAddress(m_cdi.dll, "cdi_get_refresh_status");
+	*(FARPROC*)&m_cdi.cdi_get_changed_attrs = GetProcAddress(m_cdi.dll, "cdi_get_changed_attrs");
+	*(FARPROC*)&m_cdi.cdi_get_last_refresh = GetProcAddress(m_cdi.dll, "cdi_get_last_refresh");
 	*(FARPROC*)&m_cdi.cdi_get_bool = GetProcAddress(m_cdi.dll, "cdi_get_bool");
 	*(FARPROC*)&m_cdi.cdi_get_int = GetProcAddress(m_cdi.dll, "cdi_get_int");
 	*(FARPROC*)&m_cdi.cdi_get_dword = GetProcAddress(m_cdi.dll, "cdi_get_dword");
@@ -121,6 +131,43 @@ INT WINAPI cdi_get_disk_count(CDI_SMART* ptr)
 	return m_cdi.cdi_get_disk_count(ptr);
 }
 
+INT WINAPI cdi_refresh_smart(CDI_SMART* ptr, DWORD interval, BOOL force)
+{
+	if (m_cdi.cdi_refresh_smart == NULL)
+		return 0;
+	NWL_Debug("SMART", "[%llu] Refresh%s", GetTickCount64(), force ? " (forced)" : "");
+	return m_cdi.cdi_refresh_smart(ptr, interval, force);
+}
+
+INT WINAPI cdi_refresh_disk(CDI_SMART* ptr, INT index, DWORD interval, BOOL force)
+{
+	if (m_cdi.cdi_refresh_disk == NULL)
+		return CDI_REFRESH_NONE;
+	NWL_Debug("SMART", "[%llu] Refresh %d%s", GetTickCount64(), index, force ? " (forced)" : "");
+	return m_cdi.cdi_refresh_disk(ptr, index, interval, force);
+}
+
+INT WINAPI cdi_get_refresh_status(CDI_SMART* ptr, INT index)
+{
+	if (m_cdi.cdi_get_refresh_status == NULL)
+		return CDI_REFRESH_NONE;
+	return m_cdi.cdi_get_refresh_status(ptr, index);
+}
+
+DWORD WINAPI cdi_get_changed_attrs(CDI_SMART* ptr, INT index)
+{
+	if (m_cdi.cdi_get_changed_attrs == NULL)
+		return 0;
+	return m_cdi.cdi_get_changed_attrs(ptr, index);
+}
+
+ULONGLONG WINAPI cdi_get_last_refresh(CDI_SMART* ptr, INT index)
+{
+	if (m_cdi.cdi_get_last_refresh == NULL)
+		return 0;
+	return m_cdi.cdi_get_last_refresh(ptr, index);
+}
+
 BOOL WINAPI cdi_get_bool(CDI_SMART* ptr, INT index, enum CDI_ATA_BOOL attr)
 {
 	if (m_cdi.cdi_get_bool == NULL)
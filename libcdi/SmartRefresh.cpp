@@ -0,0 +1,109 @@
+﻿// SPDX-License-Identifier: MIT
+
+#include "stdafx.h"
+#include "SmartRefresh.h"
+#include "Priscilla/UtilityFx.h"
+
+CSmartRefresh::CSmartRefresh()
+{
+	InitializeCriticalSection(&m_Lock);
+	ResetRefresh();
+}
+
+CSmartRefresh::~CSmartRefresh()
+{
+	DeleteCriticalSection(&m_Lock);
+}
+
+VOID CSmartRefresh::ResetRefresh()
+{
+	ZeroMemory(refresh, sizeof(refresh));
+}
+
+// Querying the power state through a handle opened without access rights
+// does not touch the medium, so sleeping drives stay asleep.
+BOOL CSmartRefresh::IsStandby(INT index)
+{
+	BOOL on = TRUE;
+	CString path;
+	if (vars[index].PhysicalDriveId < 0)
+		return FALSE;
+	path.Format(_T("\\\\.\\PhysicalDrive%d"), vars[index].PhysicalDriveId);
+	HANDLE hd = CreateFile(path, 0, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+	if (hd == INVALID_HANDLE_VALUE)
+		return FALSE;
+	if (!GetDevicePowerState(hd, &on))
+		on = TRUE;
+	CloseHandle(hd);
+	return on ? FALSE : TRUE;
+}
+
+// The interval belongs to the caller, a drive read by any caller within
+// that interval is not read again. Status and ChangedMask describe the
+// last read, callers that track LastRefresh know whether they saw it.
+DWORD CSmartRefresh::RefreshDisk(INT index, ULONGLONG now, DWORD interval, BOOL force)
+{
+	REFRESH_INFO* info = &refresh[index];
+
+	if (!force && info->LastRefresh && now < info->LastRefresh + interval)
+		return REFRESH_SKIPPED;
+	if (!force && IsStandby(index))
+		return REFRESH_STANDBY;
+
+	info->LastRefresh = now;
+	info->ChangedMask = 0;
+	// UpdateSmartInfo runs CheckSmartAttributeUpdate against its own copy,
+	// so only diff attributes when it reports a change.
+	if (UpdateSmartInfo(index) == SMART_STATUS_NO_CHANGE)
+	{
+		info->Status = REFRESH_NO_CHANGE;
+		return info->Status;
+	}
+	for (INT j = 0; j < MAX_ATTRIBUTE; j++)
+	{
+		if (memcmp(&info->Previous[j], &vars[index].Attribute[j], sizeof(SMART_ATTRIBUTE)) != 0)
+			info->ChangedMask |= 1UL << j;
+	}
+	memcpy(info->Previous, vars[index].Attribute, sizeof(info->Previous));
+	info->Status = info->ChangedMask ? REFRESH_CHANGED : REFRESH_NO_CHANGE;
+	return info->Status;
+}
+
+INT CSmartRefresh::Refresh(DWORD interval, BOOL force)
+{
+	INT count = (INT)vars.GetCount();
+	INT changed = 0;
+	ULONGLONG now = GetTickCountFx();
+
+	if (count > MAX_DISK)
+		count = MAX_DISK;
+
+	EnterCriticalSection(&m_Lock);
+	for (INT i = 0; i < count; i++)
+	{
+		if (RefreshDisk(i, now, interval, force) == REFRESH_CHANGED)
+			changed++;
+	}
+	LeaveCriticalSection(&m_Lock);
+	return changed;
+}
+
+INT CSmartRefresh::RefreshOne(INT index, DWORD interval, BOOL force)
+{
+	INT status;
+	if (index < 0 || index >= MAX_DISK || index >= (INT)vars.GetCount())
+		return REFRESH_NONE;
+	EnterCriticalSection(&m_Lock);
+	status = (INT)RefreshDisk(index, GetTickCountFx(), interval, force);
+	LeaveCriticalSection(&m_Lock);
+	return status;
+}
+
+DWORD CSmartRefresh::Update(INT index)
+{
+	DWORD status;
+	EnterCriticalSection(&m_Lock);
+	status = UpdateSmartInfo(index);
+	LeaveCriticalSection(&m_Lock);
+	return status;
+}
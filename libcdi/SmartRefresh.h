@@ -0,0 +1,44 @@
+﻿// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "AtaSmart.h"
+
+class CSmartRefresh : public CAtaSmart
+{
+public:
+	enum REFRESH_STATUS
+	{
+		REFRESH_NONE = 0,
+		REFRESH_SKIPPED,
+		REFRESH_STANDBY,
+		REFRESH_NO_CHANGE,
+		REFRESH_CHANGED,
+	};
+
+	struct REFRESH_INFO
+	{
+		ULONGLONG			LastRefresh;
+		DWORD				Status;
+		DWORD				ChangedMask;	// of the read at LastRefresh
+		SMART_ATTRIBUTE		Previous[MAX_ATTRIBUTE];
+	};
+
+	CSmartRefresh();
+	virtual ~CSmartRefresh();
+
+	VOID ResetRefresh();
+	INT Refresh(DWORD interval, BOOL force);
+	INT RefreshOne(INT index, DWORD interval, BOOL force);
+	DWORD Update(INT index);
+
+	REFRESH_INFO refresh[MAX_DISK];
+
+protected:
+	// UpdateSmartInfo shares a static attribute buffer and the pass-through
+	// flags, so every read of the drives goes through this lock.
+	CRITICAL_SECTION m_Lock;
+
+	BOOL IsStandby(INT index);
+	DWORD RefreshDisk(INT index, ULONGLONG now, DWORD interval, BOOL force);
+};
@@ -2,6 +2,7 @@
 
 #include "stdafx.h"
 #include "AtaSmart.h"
+#include "SmartRefresh.h"
 #include "NVMeInterpreter.h"
 #include "smartids.h"
 
@@ -100,12 +101,57 @@ cdi_init_smart(CDI_SMART * ptr, UINT64 flags)
 
 		ptr->vars[i].DiskStatus = ptr->CheckDiskStatus(i);
 	}
+
+	// Init already read every drive, use it as the first snapshot.
+	ULONGLONG now = GetTickCountFx();
+	ptr->ResetRefresh();
+	for (INT i = 0; i < ptr->vars.GetCount() && i < CAtaSmart::MAX_DISK; i++)
+	{
+		ptr->refresh[i].LastRefresh = now;
+		memcpy(ptr->refresh[i].Previous, ptr->vars[i].Attribute, sizeof(ptr->refresh[i].Previous));
+	}
 }
 
 extern "C" DWORD WINAPI
 cdi_update_smart(CDI_SMART * ptr, INT index)
 {
-	return ptr->UpdateSmartInfo(index);
+	return ptr->Update(index);
+}
+
+extern "C" INT WINAPI
+cdi_refresh_smart(CDI_SMART * ptr, DWORD interval, BOOL force)
+{
+	return ptr->Refresh(interval, force);
+}
+
+extern "C" INT WINAPI
+cdi_refresh_disk(CDI_SMART * ptr, INT index, DWORD interval, BOOL force)
+{
+	return ptr->RefreshOne(index, interval, force);
+}
+
+extern "C" INT WINAPI
+cdi_get_refresh_status(CDI_SMART * ptr, INT index)
+{
+	if (index < 0 || index >= CAtaSmart::MAX_DISK)
+		return CDI_REFRESH_NONE;
+	return (INT)ptr->refresh[index].Status;
+}
+
+extern "C" DWORD WINAPI
+cdi_get_changed_attrs(CDI_SMART * ptr, INT index)
+{
+	if (index < 0 || index >= CAtaSmart::MAX_DISK)
+		return 0;
+	return ptr->refresh[index].ChangedMask;
+}
+
+extern "C" ULONGLONG WINAPI
+cdi_get_last_refresh(CDI_SMART * ptr, INT index)
+{
+	if (index < 0 || index >= CAtaSmart::MAX_DISK)
+		return 0;
+	return ptr->refresh[index].LastRefresh;
 }
 
 inline WCHAR* cs_to_wcs(const CString& str)
@@ -81,6 +81,18 @@ enum CDI_DISK_STATUS
 	CDI_DISK_STATUS_BAD
 };
 
+enum CDI_REFRESH_STATUS
+{
+	CDI_REFRESH_NONE = 0,
+	CDI_REFRESH_SKIPPED,	// Minimum interval not reached
+	CDI_REFRESH_STANDBY,	// Drive is spun down, not woken up
+	CDI_REFRESH_NO_CHANGE,
+	CDI_REFRESH_CHANGED,
+};
+
+// Suggested minimum interval between two reads of a drive, in milliseconds.
+#define CDI_REFRESH_INTERVAL			(60 * 1000)
+
 // CDiskInfoDlg::CDiskInfoDlg
 // UseWMI
 #define CDI_FLAG_USE_WMI				(1ULL << 0) // TRUE
@@ -177,7 +189,7 @@ enum CDI_DISK_STATUS
 	)
 
 #ifdef LIBCDI_IMPLEMENTATION
-typedef CAtaSmart CDI_SMART;
+typedef CSmartRefresh CDI_SMART;
 #else
 typedef struct _CDI_SMART CDI_SMART;
 #endif
@@ -194,6 +206,12 @@ VOID		WINAPI cdi_init_smart(CDI_SMART* ptr, UINT64 flags);
 DWORD		WINAPI cdi_update_smart(CDI_SMART* ptr, INT index);
 INT			WINAPI cdi_get_disk_count(CDI_SMART* ptr);
 
+INT			WINAPI cdi_refresh_smart(CDI_SMART* ptr, DWORD interval, BOOL force);
+INT			WINAPI cdi_refresh_disk(CDI_SMART* ptr, INT index, DWORD interval, BOOL force);
+INT			WINAPI cdi_get_refresh_status(CDI_SMART* ptr, INT index);
+DWORD		WINAPI cdi_get_changed_attrs(CDI_SMART* ptr, INT index);
+ULONGLONG	WINAPI cdi_get_last_refresh(CDI_SMART* ptr, INT index);
+
 BOOL		WINAPI cdi_get_bool(CDI_SMART* ptr, INT index, enum CDI_ATA_BOOL attr);
 INT			WINAPI cdi_get_int(CDI_SMART* ptr, INT index, enum CDI_ATA_INT attr);
 DWORD		WINAPI cdi_get_dword(CDI_SMART* ptr, INT index, enum CDI_ATA_DWORD attr);
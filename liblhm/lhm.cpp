@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 #include <cwchar>
+#include <limits>
 
 using namespace System;
 using namespace System::Collections;
@@ -22,6 +23,17 @@ namespace
 	std::wstring last_error;
 	std::vector<LhmSensorInfo> sensor_cache;
 
+	// Sensor table for LhmGetSensorTable / LhmReadValues. The managed objects
+	// and accessors are resolved once so a poll is only Update() and Value.
+	std::vector<LhmSensorMeta> meta_cache;
+	msclr::auto_gcroot<ArrayList^> hardware_objects;
+	msclr::auto_gcroot<ArrayList^> sensor_objects;
+	msclr::auto_gcroot<MethodInfo^> update_method;
+	msclr::auto_gcroot<PropertyInfo^> value_property;
+	uint32_t table_generation = 1;
+	int table_hardware_count = 0;
+	bool table_valid = false;
+
 	struct ToggleSetting
 	{
 		const wchar_t* name;
@@ -118,6 +130,84 @@ static void CopyToBuffer(const std::wstring& src, wchar_t* dest)
 	wcsncpy_s(dest, LHM_STR_MAX, src.c_str(), _TRUNCATE);
 }
 
+static void CollectTable(Object^ hardware, const std::wstring& hardware_name)
+{
+	hardware_objects->Add(hardware);
+
+	auto sensors = safe_cast<IEnumerable^>(GetProperty(hardware, "Sensors"));
+	for each (Object ^ sensor in sensors)
+	{
+		LhmSensorMeta meta{};
+		CopyToBuffer(hardware_name, meta.hardware);
+		CopyToBuffer(ToStdWString(GetProperty(sensor, "Identifier")->ToString()), meta.id);
+		CopyToBuffer(ToStdWString(safe_cast<String^>(GetProperty(sensor, "Name"))), meta.name);
+		CopyToBuffer(ToStdWString(GetProperty(sensor, "SensorType")->ToString()), meta.type);
+		meta_cache.push_back(meta);
+		sensor_objects->Add(sensor);
+	}
+
+	auto sub_hardware = safe_cast<IEnumerable^>(GetProperty(hardware, "SubHardware"));
+	for each (Object ^ child in sub_hardware)
+	{
+		std::wstring child_name = ToStdWString(safe_cast<String^>(GetProperty(child, "Name")));
+		CollectTable(child, child_name);
+	}
+}
+
+static void ResetTable(void)
+{
+	meta_cache.clear();
+	hardware_objects.reset();
+	sensor_objects.reset();
+	update_method.reset();
+	value_property.reset();
+	table_hardware_count = 0;
+	table_valid = false;
+}
+
+// Drops the table and tells the caller that its slots no longer match.
+static void InvalidateTable(void)
+{
+	ResetTable();
+	if (++table_generation == LHM_GENERATION_NONE)
+		++table_generation;
+}
+
+static int GetHardwareCount(void)
+{
+	return safe_cast<ICollection^>(GetProperty(computer_handle.get(), "Hardware"))->Count;
+}
+
+static void BuildTable(void)
+{
+	ResetTable();
+	hardware_objects = gcnew ArrayList();
+	sensor_objects = gcnew ArrayList();
+
+	auto hardware_list = safe_cast<ICollection^>(GetProperty(computer_handle.get(), "Hardware"));
+	table_hardware_count = hardware_list->Count;
+	for each (Object ^ hardware in hardware_list)
+	{
+		// Populate sensors that only appear after the first update.
+		UpdateHardware(hardware);
+		std::wstring hardware_name = ToStdWString(safe_cast<String^>(GetProperty(hardware, "Name")));
+		CollectTable(hardware, hardware_name);
+	}
+
+	// Resolve through the interfaces so every implementation shares one accessor.
+	if (hardware_objects->Count > 0)
+	{
+		Type^ type = hardware_objects.get()[0]->GetType()->GetInterface("LibreHardwareMonitor.Hardware.IHardware");
+		update_method = type->GetMethod("Update", Type::EmptyTypes);
+	}
+	if (sensor_objects->Count > 0)
+	{
+		Type^ type = sensor_objects.get()[0]->GetType()->GetInterface("LibreHardwareMonitor.Hardware.ISensor");
+		value_property = type->GetProperty("Value");
+	}
+	table_valid = true;
+}
+
 static void CollectSensors(Object^ hardware, const std::wstring& hardware_name, std::vector<LhmSensorInfo>& output)
 {
 	UpdateHardware(hardware);
@@ -231,6 +321,8 @@ bool __stdcall LhmSetToggleEnabled(size_t index, bool enabled)
 		}
 	}
 
+	// Toggling a group adds or removes hardware, so the slots are stale.
+	InvalidateTable();
 	last_error.clear();
 	return true;
 }
@@ -279,10 +371,112 @@ bool __stdcall LhmEnumerateSensors(const LhmSensorInfo** sensors, size_t* out_co
 	}
 }
 
+bool __stdcall LhmGetSensorTable(const LhmSensorMeta** sensors, size_t* out_count, uint32_t* out_generation)
+{
+	if (sensors == nullptr || out_count == nullptr || out_generation == nullptr)
+	{
+		SetError(L"sensors, outCount and outGeneration must not be null");
+		return false;
+	}
+
+	*sensors = nullptr;
+	*out_count = 0;
+	*out_generation = table_generation;
+
+	if (computer_handle.get() == nullptr)
+	{
+		SetError(L"LhmInitialize must be called before enumerating sensors.");
+		return false;
+	}
+
+	try
+	{
+		if (table_valid && GetHardwareCount() != table_hardware_count)
+			InvalidateTable();
+		if (!table_valid)
+			BuildTable();
+
+		*out_count = meta_cache.size();
+		*sensors = meta_cache.empty() ? nullptr : meta_cache.data();
+		*out_generation = table_generation;
+
+		last_error.clear();
+		return true;
+	}
+	catch (Exception^ ex)
+	{
+		InvalidateTable();
+		*out_generation = LHM_GENERATION_NONE;
+		SetError(ex->Message);
+		return false;
+	}
+}
+
+bool __stdcall LhmReadValues(float* values, size_t count, uint32_t* out_generation)
+{
+	if ((values == nullptr && count != 0) || out_generation == nullptr)
+	{
+		SetError(L"values and outGeneration must not be null");
+		return false;
+	}
+
+	*out_generation = table_valid ? table_generation : LHM_GENERATION_NONE;
+
+	if (computer_handle.get() == nullptr)
+	{
+		SetError(L"LhmInitialize must be called before reading sensors.");
+		return false;
+	}
+
+	try
+	{
+		// Hardware came or went, drop the table before reading.
+		if (table_valid && GetHardwareCount() != table_hardware_count)
+			InvalidateTable();
+
+		// The caller must fetch a new table before the slots mean anything.
+		// Until one is built no generation can match, so a failed build is
+		// retried on the next poll.
+		if (!table_valid)
+		{
+			*out_generation = LHM_GENERATION_NONE;
+			last_error.clear();
+			return true;
+		}
+
+		if (update_method.get() != nullptr)
+		{
+			for each (Object ^ hardware in hardware_objects.get())
+			{
+				update_method->Invoke(hardware, nullptr);
+			}
+		}
+
+		ArrayList^ sensors = sensor_objects.get();
+		size_t n = meta_cache.size() < count ? meta_cache.size() : count;
+		for (size_t i = 0; i < n; i++)
+		{
+			Object^ sensor = sensors[static_cast<int>(i)];
+			Nullable<float> value_opt = ToNullableFloat(value_property->GetValue(sensor, nullptr));
+			values[i] = value_opt.HasValue ? value_opt.Value : std::numeric_limits<float>::quiet_NaN();
+		}
+
+		last_error.clear();
+		return true;
+	}
+	catch (Exception^ ex)
+	{
+		SetError(ex->Message);
+		return false;
+	}
+}
+
 void __stdcall LhmShutdown(void)
 {
 	sensor_cache.clear();
 	std::vector<LhmSensorInfo>().swap(sensor_cache);
+	ResetTable();
+	std::vector<LhmSensorMeta>().swap(meta_cache);
 
 	try
 	{
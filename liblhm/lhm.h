@@ -2,6 +2,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <wchar.h>
 
@@ -25,13 +26,27 @@ typedef struct
 	bool has_max;
 	float max;
 } LhmSensorInfo;
+
+// Static part of a sensor. Entry i of the table owns slot i of the value array.
+typedef struct
+{
+	wchar_t hardware[LHM_STR_MAX];
+	wchar_t id[LHM_STR_MAX];
+	wchar_t name[LHM_STR_MAX];
+	wchar_t type[LHM_STR_MAX];
+} LhmSensorMeta;
 #pragma pack(pop)
 
+// Generation reported while no table is built, it never matches a table.
+#define LHM_GENERATION_NONE 0
+
 bool __stdcall LhmInitialize(void);
 size_t __stdcall LhmGetToggleCount(void);
 bool __stdcall LhmGetToggleInfo(size_t index, const wchar_t** out_name, bool* out_enabled);
 bool __stdcall LhmSetToggleEnabled(size_t index, bool enabled);
 bool __stdcall LhmEnumerateSensors(const LhmSensorInfo** sensors, size_t* out_count);
+bool __stdcall LhmGetSensorTable(const LhmSensorMeta** sensors, size_t* out_count, uint32_t* out_generation);
+bool __stdcall LhmReadValues(float* values, size_t count, uint32_t* out_generation);
 void __stdcall LhmShutdown(void);
 const wchar_t* __stdcall LhmGetLastError(void);
 
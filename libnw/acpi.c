@@ -683,45 +683,22 @@ PrintTableInfo(PNODE pNode, DESC_HEADER* Hdr)
 // Reading from physical memory will be flagged by Windows Defender
 PNODE NW_Acpi(BOOL bAppend)
 {
-	UINT32 i, count;
+	UINT32 i, sig, instance;
 	PNODE pNode = NWL_NodeAlloc("ACPI", NFLG_TABLE);
 	if (bAppend)
 		NWL_NodeAppendChild(NWLC->NwRoot, pNode);
 
-	if (NWLC->NwRsdp == NULL)
-		NWLC->NwRsdp = NWL_GetRsdp();
-	if (NWLC->NwRsdt == NULL)
-		NWLC->NwRsdt = NWL_GetRsdt();
-	if (NWLC->NwXsdt == NULL)
-		NWLC->NwXsdt = NWL_GetXsdt();
+	// Indexing the cache also loads the RSDP, RSDT and XSDT.
+	sig = NWL_EnumAcpiTable(0, &instance);
 
 	if (NWLC->NwRsdp)
 		PrintRSDP(pNode, NWLC->NwRsdp);
-	if (NWLC->NwXsdt)
+	for (i = 0; sig != 0; sig = NWL_EnumAcpiTable(++i, &instance))
 	{
-		count = (NWLC->NwXsdt->Header.Length - sizeof(DESC_HEADER)) / sizeof(NWLC->NwXsdt->Entry[0]);
-		for (i = 0; i < count; i++)
-		{
-			DESC_HEADER* t = NWL_GetAcpiByAddr((DWORD_PTR)NWLC->NwXsdt->Entry[i], NWLC->AcpiTable);
-			if (t)
-			{
-				PrintTableInfo(pNode, t);
-				free(t);
-			}
-		}
-	}
-	else if (NWLC->NwRsdt)
-	{
-		count = (NWLC->NwRsdt->Header.Length - sizeof(DESC_HEADER)) / sizeof(NWLC->NwRsdt->Entry[0]);
-		for (i = 0; i < count; i++)
-		{
-			DESC_HEADER* t = NWL_GetAcpiByAddr((DWORD_PTR)NWLC->NwRsdt->Entry[i], NWLC->AcpiTable);
-			if (t)
-			{
-				PrintTableInfo(pNode, t);
-				free(t);
-			}
-		}
+		// Only tables that will be printed are read in full.
+		if (NWLC->AcpiTable && NWLC->AcpiTable != sig)
+			continue;
+		PrintTableInfo(pNode, NWL_GetAcpiTable(sig, instance));
 	}
 	PrintTableInfo(pNode, (DESC_HEADER*)NWLC->NwRsdt);
 	PrintTableInfo(pNode, (DESC_HEADER*)NWLC->NwXsdt);
@@ -22,11 +22,6 @@ DEFINE_GUID(IID_IAudioEndpointVolume,
 DEFINE_GUID(IID_IAudioMeterInformation,
 	0xc02216f6, 0x8c67, 0x4b5b, 0x9d, 0x00, 0xd0, 0x08, 0xe7, 0x3e, 0x00, 0x64);
 
-typedef struct _AUDIO_CODEC_ENUM_CTX
-{
-	CHAR CodecHwid[DEVTREE_MAX_STR_LEN];
-} AUDIO_CODEC_ENUM_CTX;
-
 static void
 AudioSetCodecName(PNODE node, LPCSTR hwid)
 {
@@ -60,70 +55,29 @@ AudioSetCodecName(PNODE node, LPCSTR hwid)
 	}
 }
 
-static void CALLBACK
-GetDeviceInfoAudioCodec(PNODE node, void* data, DEVINST devInst, DEVINST parentDevInst, LPCSTR hwIds)
-{
-	AUDIO_CODEC_ENUM_CTX* ctx = (AUDIO_CODEC_ENUM_CTX*)data;
-	(void)node;
-	(void)devInst;
-	(void)parentDevInst;
-
-	if (ctx->CodecHwid[0] != '\0')
-		return;
-
-	strncpy_s(ctx->CodecHwid, DEVTREE_MAX_STR_LEN, hwIds, _TRUNCATE);
-}
-
-static void CALLBACK
-GetDeviceInfoAudioController(PNODE node, void* data, DEVINST devInst, DEVINST parentDevInst, LPCSTR hwIds)
-{
-	static const CHAR prefix[] = "HDAUDIO\\FUNC_01&VEN_";
-	AUDIO_CODEC_ENUM_CTX* ctx = (AUDIO_CODEC_ENUM_CTX*)data;
-	DEVTREE_ENUM_CTX codecCtx = { 0 };
-	PNODE devTree;
-	(void)node;
-	(void)parentDevInst;
-
-	(void)hwIds;
-
-	if (ctx->CodecHwid[0] != '\0')
-		return;
-
-	strncpy_s(codecCtx.filter, DEVTREE_MAX_STR_LEN, prefix, _TRUNCATE);
-	codecCtx.filterLen = sizeof(prefix) - 1;
-	codecCtx.hub = "Devices";
-	codecCtx.data = ctx;
-	codecCtx.GetDeviceInfo = GetDeviceInfoAudioCodec;
-
-	devTree = NWL_NodeAlloc("Device Tree", NFLG_TABLE);
-	NWL_EnumerateDevices(devTree, &codecCtx, devInst, 0);
-	NWL_NodeFree(devTree, 1);
-}
-
+// First HDA function codec below any controller matching the PCI HWID.
 static void
-AudioSetCodecHwid(PNODE node, LPCSTR hwid, DEVINST devRoot)
+AudioSetCodecHwid(PNODE node, LPCSTR hwid, const DEVTREE_SNAPSHOT* tree)
 {
-	DEVTREE_ENUM_CTX ctx = { 0 };
-	AUDIO_CODEC_ENUM_CTX data = { 0 };
-	PNODE devTree;
+	static const CHAR prefix[] = "HDAUDIO\\FUNC_01&VEN_";
+	DWORD i, codec;
+	size_t len = strnlen_s(hwid, DEVTREE_MAX_STR_LEN - 1);
 
-	if (devRoot == 0)
+	if (tree == NULL)
 		return;
 
-	strncpy_s(ctx.filter, DEVTREE_MAX_STR_LEN, hwid, _TRUNCATE);
-	ctx.filterLen = strlen(ctx.filter);
-	ctx.hub = "Devices";
-	ctx.data = &data;
-	ctx.GetDeviceInfo = GetDeviceInfoAudioController;
-
-	devTree = NWL_NodeAlloc("Device Tree", NFLG_TABLE);
-	NWL_EnumerateDevices(devTree, &ctx, devRoot, 0);
-	NWL_NodeFree(devTree, 1);
-
-	if (data.CodecHwid[0] != '\0')
+	for (i = 0; i < tree->Count; i++)
 	{
-		NWL_NodeAttrSet(node, "Codec HWID", data.CodecHwid, 0);
-		AudioSetCodecName(node, data.CodecHwid);
+		i = NWL_DevTreeFind(tree, i, tree->Count, hwid, len);
+		if (i == DEVTREE_NONE)
+			return;
+		codec = NWL_DevTreeFind(tree, i + 1, tree->Entries[i].End, prefix, sizeof(prefix) - 1);
+		if (codec != DEVTREE_NONE)
+		{
+			NWL_NodeAttrSet(node, "Codec HWID", tree->Entries[codec].HwId, 0);
+			AudioSetCodecName(node, tree->Entries[codec].HwId);
+			return;
+		}
 	}
 }
 
@@ -288,7 +242,7 @@ static void PrintMMDevices(PNODE node)
 static void PrintSoundCards(PNODE node)
 {
 	PNODE sdc = NWL_NodeAppendNew(node, "Sound Cards", NFLG_TABLE);
-	DEVINST devRoot = 0;
+	DEVTREE_SNAPSHOT* tree;
 
 	PNWL_ARG_SET pciClasses = NULL;
 	NWL_ArgSetAddStr(&pciClasses, "0401"); // Multimedia audio controller
@@ -296,8 +250,7 @@ static void PrintSoundCards(PNODE node)
 	PNODE pci = NWL_EnumPci(NWL_NodeAlloc("PCI", NFLG_TABLE), pciClasses);
 	NWL_ArgSetFree(pciClasses);
 
-	if (CM_Locate_DevNodeW(&devRoot, NULL, CM_LOCATE_DEVNODE_NORMAL) != CR_SUCCESS)
-		NWL_NodeAppendMultiSz(&NWLC->ErrLog, "CM_Locate_DevNodeW failed");
+	tree = NWL_DevTreeAcquire();
 
 	INT count = NWL_NodeChildCount(pci);
 	for (INT i = 0; i < count; i++)
@@ -313,8 +266,9 @@ static void PrintSoundCards(PNODE node)
 		NWL_NodeAttrSet(t, "HWID", hwid, 0);
 		NWL_NodeAttrSet(t, "Vendor", NWL_NodeAttrGet(dev, "Vendor"), 0);
 		NWL_NodeAttrSet(t, "Device", name, 0);
-		AudioSetCodecHwid(t, hwid, devRoot);
+		AudioSetCodecHwid(t, hwid, tree);
 	}
+	NWL_DevTreeRelease(tree);
 	NWL_NodeFree(pci, 1);
 }
 
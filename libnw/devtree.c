@@ -2,6 +2,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 #include <windows.h>
 #include <initguid.h>
 #include <devpkey.h>
@@ -10,6 +12,7 @@
 #include "libnw.h"
 #include "utils.h"
 #include "devtree.h"
+#include "utf.h"
 
 #pragma comment(lib, "cfgmgr32.lib")
 
@@ -107,34 +110,21 @@ out:
 	return cr;
 }
 
-BOOL
-NWL_SetDevPropString(CHAR* strBuf, size_t strSize, DEVINST devHandle, const DEVPROPKEY* devProperty)
+static BOOL
+FormatDevProp(CHAR* strBuf, size_t strSize, DEVPROPTYPE propertyType, const BYTE* data)
 {
-	ULONG bufferSize = 0;
-	DEVPROPTYPE propertyType;
-
-	propertyType = DEVPROP_TYPE_EMPTY;
-
-	if (GetDevNodeProperty(devHandle, devProperty, &propertyType, NULL, &bufferSize) != CR_BUFFER_SMALL)
-		return FALSE;
-	if (bufferSize >= NWINFO_BUFSZ)
-		return FALSE;
-	ZeroMemory(NWLC->NwBuf, NWINFO_BUFSZ);
-	if (GetDevNodeProperty(devHandle, devProperty, &propertyType, (PBYTE)NWLC->NwBuf, &bufferSize) != CR_SUCCESS)
-		return FALSE;
-
 	ZeroMemory(strBuf, strSize);
 
 	switch (propertyType)
 	{
 	case DEVPROP_TYPE_STRING:
 	case DEVPROP_TYPE_STRING_LIST: // TODO: add multi sz support
-		strncpy_s(strBuf, strSize, NWL_Ucs2ToUtf8(NWLC->NwBufW), _TRUNCATE);
+		strncpy_s(strBuf, strSize, NWL_Ucs2ToUtf8((LPCWSTR)data), _TRUNCATE);
 		break;
 	case DEVPROP_TYPE_FILETIME:
 	{
 		SYSTEMTIME sysTime = { 0 };
-		FileTimeToSystemTime((PFILETIME)NWLC->NwBuf, &sysTime);
+		FileTimeToSystemTime((const FILETIME*)data, &sysTime);
 		snprintf(strBuf, strSize, "%5u-%02u-%02u %02u:%02u%02u",
 			sysTime.wYear, sysTime.wMonth, sysTime.wDay, sysTime.wHour, sysTime.wMinute, sysTime.wSecond);
 	}
@@ -142,14 +132,14 @@ NWL_SetDevPropString(CHAR* strBuf, size_t strSize, DEVINST devHandle, const DEVP
 	case DEVPROP_TYPE_UINT32:
 	{
 		UINT32 u;
-		memcpy(&u, NWLC->NwBuf, sizeof(UINT32));
+		memcpy(&u, data, sizeof(UINT32));
 		snprintf(strBuf, strSize, "%u", u);
 	}
 		break;
 	case DEVPROP_TYPE_UINT64:
 	{
 		UINT64 u;
-		memcpy(&u, NWLC->NwBuf, sizeof(UINT64));
+		memcpy(&u, data, sizeof(UINT64));
 		snprintf(strBuf, strSize, "%llu", u);
 	}
 		break;
@@ -159,6 +149,25 @@ NWL_SetDevPropString(CHAR* strBuf, size_t strSize, DEVINST devHandle, const DEVP
 	return TRUE;
 }
 
+BOOL
+NWL_SetDevPropString(CHAR* strBuf, size_t strSize, DEVINST devHandle, const DEVPROPKEY* devProperty)
+{
+	ULONG bufferSize = 0;
+	DEVPROPTYPE propertyType;
+
+	propertyType = DEVPROP_TYPE_EMPTY;
+
+	if (GetDevNodeProperty(devHandle, devProperty, &propertyType, NULL, &bufferSize) != CR_BUFFER_SMALL)
+		return FALSE;
+	if (bufferSize >= NWINFO_BUFSZ)
+		return FALSE;
+	ZeroMemory(NWLC->NwBuf, NWINFO_BUFSZ);
+	if (GetDevNodeProperty(devHandle, devProperty, &propertyType, (PBYTE)NWLC->NwBuf, &bufferSize) != CR_SUCCESS)
+		return FALSE;
+
+	return FormatDevProp(strBuf, strSize, propertyType, (const BYTE*)NWLC->NwBuf);
+}
+
 CONFIGRET
 NWL_CMGetDevIfProp(LPCWSTR pszDevIf, CONST DEVPROPKEY* propKey, DEVPROPTYPE* propType, PBYTE propBuf, PULONG propBufSize, ULONG ulFlags)
 {
@@ -178,37 +187,36 @@ fail:
 }
 
 static void CALLBACK
-GetDeviceInfoDefault(PNODE node, void* data, DEVINST devInst, DEVINST parentDevInst, LPCSTR hwIds)
+GetDeviceInfoDefault(PNODE node, void* data, const DEVTREE_SNAPSHOT* tree, DWORD index)
 {
+	const DEVTREE_ENTRY* dev = &tree->Entries[index];
+	LPCSTR str;
 	(void)data;
-	(void)parentDevInst;
-	NWL_NodeAttrSet(node, "HWID", hwIds, 0);
+	NWL_NodeAttrSet(node, "HWID", dev->HwId, 0);
 
-	CHAR buf[DEVTREE_MAX_STR_LEN];
+	if (dev->Name)
+		NWL_NodeAttrSet(node, "Name", dev->Name, 0);
 
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_NAME))
-		NWL_NodeAttrSet(node, "Name", buf, 0);
+	if (dev->Class)
+		NWL_NodeAttrSet(node, "Device Class", dev->Class, 0);
 
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_Class))
-		NWL_NodeAttrSet(node, "Device Class", buf, 0);
+	if ((str = NWL_DevTreeGetProp(tree, index, DEVTREE_PROP_MANUFACTURER)) != NULL)
+		NWL_NodeAttrSet(node, "Manufacturer", str, 0);
 
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_Manufacturer))
-		NWL_NodeAttrSet(node, "Manufacturer", buf, 0);
+	if ((str = NWL_DevTreeGetProp(tree, index, DEVTREE_PROP_SERVICE)) != NULL)
+		NWL_NodeAttrSet(node, "Service Name", str, 0);
 
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_Service))
-		NWL_NodeAttrSet(node, "Service Name", buf, 0);
+	if ((str = NWL_DevTreeGetProp(tree, index, DEVTREE_PROP_DRIVER_DATE)) != NULL)
+		NWL_NodeAttrSet(node, "Driver Date", str, 0);
 
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_DriverDate))
-		NWL_NodeAttrSet(node, "Driver Date", buf, 0);
+	if ((str = NWL_DevTreeGetProp(tree, index, DEVTREE_PROP_DRIVER_VERSION)) != NULL)
+		NWL_NodeAttrSet(node, "Driver Version", str, 0);
 
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_DriverVersion))
-		NWL_NodeAttrSet(node, "Driver Version", buf, 0);
+	if ((str = NWL_DevTreeGetProp(tree, index, DEVTREE_PROP_LOCATION)) != NULL)
+		NWL_NodeAttrSet(node, "Location", str, 0);
 
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_LocationInfo))
-		NWL_NodeAttrSet(node, "Location", buf, 0);
-
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_LocationPaths))
-		NWL_NodeAttrSet(node, "Location Paths", buf, 0);
+	if ((str = NWL_DevTreeGetProp(tree, index, DEVTREE_PROP_LOCATION_PATHS)) != NULL)
+		NWL_NodeAttrSet(node, "Location Paths", str, 0);
 }
 
 static PNODE AppendDevices(PNODE parent, const char* hub)
@@ -221,83 +229,363 @@ static PNODE AppendDevices(PNODE parent, const char* hub)
 	return NWL_NodeAppendNew(parent, hub, NFLG_TABLE);
 }
 
-void
-NWL_EnumerateDevices(PNODE parent, DEVTREE_ENUM_CTX* ctx, DEVINST devInst, DEVINST parentDevInst)
+static BOOL
+DevTreeGetProp(DEVTREE_PROP_BUF* buf, DEVINST devInst, const DEVPROPKEY* pKey, DEVPROPTYPE* propType)
 {
-	PNODE node = parent;
-	DEVINST childInst;
-	CHAR hwIds[DEVTREE_MAX_STR_LEN];
-	ULONG hwIdListSize = 0;
-	DEVPROPTYPE hwIdListType = DEVPROP_TYPE_EMPTY;
-	LPSTR hwIdList = NULL;
-
-	if (NWL_SetDevPropString(hwIds, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_HardwareIds))
+	for (int retry = 0; retry < 2; retry++)
 	{
-		if (ctx->filter[0] == L'\0' || _strnicmp(hwIds, ctx->filter, ctx->filterLen) == 0)
+		ULONG size = buf->size - sizeof(WCHAR) * 2;
+		CONFIGRET cr = GetDevNodeProperty(devInst, pKey, propType, buf->data, &size);
+		if (cr == CR_SUCCESS)
 		{
-			node = NWL_NodeAppendNew(AppendDevices(parent, ctx->hub), "Device", NFLG_TABLE_ROW);
-			ctx->GetDeviceInfo(node, ctx->data, devInst, parentDevInst, hwIds);
+			// Make sure string lists are double-NUL terminated
+			ZeroMemory(buf->data + size, sizeof(WCHAR) * 2);
+			return TRUE;
+		}
+		if (cr != CR_BUFFER_SMALL)
+			return FALSE;
+		PBYTE p = realloc(buf->data, size + sizeof(WCHAR) * 2);
+		if (!p)
+			return FALSE;
+		buf->data = p;
+		buf->size = size + sizeof(WCHAR) * 2;
+	}
+	return FALSE;
+}
+
+static CHAR*
+DevTreeGetString(DEVTREE_PROP_BUF* buf, DEVINST devInst, const DEVPROPKEY* pKey)
+{
+	DEVPROPTYPE propType = DEVPROP_TYPE_EMPTY;
+	if (!DevTreeGetProp(buf, devInst, pKey, &propType))
+		return NULL;
+	if (propType != DEVPROP_TYPE_STRING && propType != DEVPROP_TYPE_STRING_LIST)
+		return NULL;
+	return NWL_Utf16ToUtf8Dup((const uint16_t*)buf->data, NWL_UTF_NUL, NULL);
+}
+
+static const DEVPROPKEY* const DevTreePropKeys[DEVTREE_PROP_MAX] =
+{
+	[DEVTREE_PROP_MANUFACTURER] = &DEVPKEY_Device_Manufacturer,
+	[DEVTREE_PROP_SERVICE] = &DEVPKEY_Device_Service,
+	[DEVTREE_PROP_DRIVER_DATE] = &DEVPKEY_Device_DriverDate,
+	[DEVTREE_PROP_DRIVER_VERSION] = &DEVPKEY_Device_DriverVersion,
+	[DEVTREE_PROP_LOCATION] = &DEVPKEY_Device_LocationInfo,
+	[DEVTREE_PROP_LOCATION_PATHS] = &DEVPKEY_Device_LocationPaths,
+	[DEVTREE_PROP_COMPATIBLE_IDS] = &DEVPKEY_Device_CompatibleIds,
+};
+
+// Strings are kept whole, other types are formatted as NWL_SetDevPropString does.
+// Results are cached, so a devnode is queried at most once per snapshot
+// even when several reports print the same property.
+LPCSTR
+NWL_DevTreeGetProp(const DEVTREE_SNAPSHOT* tree, DWORD index, DEVTREE_PROP prop)
+{
+	DEVTREE_SNAPSHOT* t = (DEVTREE_SNAPSHOT*)tree;
+	DEVTREE_ENTRY* dev;
+	DEVPROPTYPE propType = DEVPROP_TYPE_EMPTY;
+	CHAR str[DEVTREE_MAX_STR_LEN];
+
+	if (!tree || index >= tree->Count || prop >= DEVTREE_PROP_MAX)
+		return NULL;
+	dev = &t->Entries[index];
+	if (dev->PropLoaded & (1U << prop))
+		return dev->Prop[prop];
+	dev->PropLoaded |= 1U << prop;
+	if (!t->Buf.data || !DevTreeGetProp(&t->Buf, dev->DevInst, DevTreePropKeys[prop], &propType))
+		return NULL;
+	if (propType == DEVPROP_TYPE_STRING || propType == DEVPROP_TYPE_STRING_LIST)
+		dev->Prop[prop] = NWL_Utf16ToUtf8Dup((const uint16_t*)t->Buf.data, NWL_UTF_NUL, NULL);
+	else if (FormatDevProp(str, sizeof(str), propType, t->Buf.data))
+		dev->Prop[prop] = _strdup(str);
+	return dev->Prop[prop];
+}
+
+static DWORD
+DevTreeAdd(DEVTREE_SNAPSHOT* tree, DEVTREE_PROP_BUF* buf, DEVINST devInst, DWORD parent)
+{
+	DEVTREE_ENTRY* dev;
+
+	if (tree->Count >= tree->Capacity)
+	{
+		DWORD cap = tree->Capacity ? tree->Capacity * 2 : 256;
+		dev = realloc(tree->Entries, cap * sizeof(DEVTREE_ENTRY));
+		if (!dev)
+			return DEVTREE_NONE;
+		tree->Entries = dev;
+		tree->Capacity = cap;
+	}
+	dev = &tree->Entries[tree->Count];
+	ZeroMemory(dev, sizeof(DEVTREE_ENTRY));
+	dev->DevInst = devInst;
+	dev->Parent = parent;
+	dev->End = tree->Count + 1;
+
+	// The buffer still holds the whole string list after this call
+	dev->HwId = DevTreeGetString(buf, devInst, &DEVPKEY_Device_HardwareIds);
+	if (dev->HwId)
+	{
+		for (LPCWSTR p = (LPCWSTR)buf->data; *p != L'\0'; p += wcslen(p) + 1)
+			NWL_NodeAppendMultiSz(&dev->HwIdList, NWL_Ucs2ToUtf8(p));
+	}
+	dev->Name = DevTreeGetString(buf, devInst, &DEVPKEY_NAME);
+	dev->Class = DevTreeGetString(buf, devInst, &DEVPKEY_Device_Class);
+
+	return tree->Count++;
+}
+
+DEVTREE_SNAPSHOT*
+NWL_DevTreeCreate(VOID)
+{
+	DEVINST devRoot;
+	DEVINST devNext;
+	DWORD cur;
+	DEVTREE_PROP_BUF* buf;
+	DEVTREE_SNAPSHOT* tree = calloc(1, sizeof(DEVTREE_SNAPSHOT));
+
+	if (!tree)
+		return NULL;
+	// Kept with the snapshot for properties read later
+	buf = &tree->Buf;
+	buf->size = 4096;
+	buf->data = malloc(buf->size);
+	if (!buf->data)
+		goto fail;
+	if (CM_Locate_DevNodeW(&devRoot, NULL, CM_LOCATE_DEVNODE_NORMAL) != CR_SUCCESS)
+	{
+		NWL_NodeAppendMultiSz(&NWLC->ErrLog, "CM_Locate_DevNodeW failed");
+		goto fail;
+	}
 
-			if (GetDevNodeProperty(devInst, &DEVPKEY_Device_HardwareIds, &hwIdListType, NULL, &hwIdListSize) == CR_BUFFER_SMALL &&
-				hwIdListSize < NWINFO_BUFSZ)
+	cur = DevTreeAdd(tree, buf, devRoot, DEVTREE_NONE);
+	if (cur == DEVTREE_NONE)
+		goto fail;
+	for (;;)
+	{
+		if (CM_Get_Child(&devNext, tree->Entries[cur].DevInst, 0) == CR_SUCCESS)
+		{
+			DWORD child = DevTreeAdd(tree, buf, devNext, cur);
+			if (child == DEVTREE_NONE)
+				goto fail;
+			cur = child;
+			continue;
+		}
+		for (;;)
+		{
+			DWORD parent = tree->Entries[cur].Parent;
+			tree->Entries[cur].End = tree->Count;
+			if (parent == DEVTREE_NONE)
+				return tree;
+			if (CM_Get_Sibling(&devNext, tree->Entries[cur].DevInst, 0) == CR_SUCCESS)
 			{
-				ZeroMemory(NWLC->NwBuf, NWINFO_BUFSZ);
-				if (GetDevNodeProperty(devInst, &DEVPKEY_Device_HardwareIds, &hwIdListType,
-					(PBYTE)NWLC->NwBuf, &hwIdListSize) == CR_SUCCESS &&
-					hwIdListType == DEVPROP_TYPE_STRING_LIST)
-				{
-					for (LPCWSTR p = NWLC->NwBufW; *p != L'\0'; p += wcslen(p) + 1)
-						NWL_NodeAppendMultiSz(&hwIdList, NWL_Ucs2ToUtf8(p));
-				}
+				cur = DevTreeAdd(tree, buf, devNext, parent);
+				if (cur == DEVTREE_NONE)
+					goto fail;
+				break;
 			}
+			cur = parent;
+		}
+	}
 
-			if (hwIdList)
+fail:
+	NWL_DevTreeFree(tree);
+	return NULL;
+}
+
+VOID
+NWL_DevTreeFree(DEVTREE_SNAPSHOT* tree)
+{
+	if (!tree)
+		return;
+	for (DWORD i = 0; i < tree->Count; i++)
+	{
+		free(tree->Entries[i].HwId);
+		free(tree->Entries[i].HwIdList);
+		free(tree->Entries[i].Name);
+		free(tree->Entries[i].Class);
+		for (int j = 0; j < DEVTREE_PROP_MAX; j++)
+			free(tree->Entries[i].Prop[j]);
+	}
+	free(tree->Entries);
+	free(tree->Buf.data);
+	free(tree);
+}
+
+DEVTREE_SNAPSHOT*
+NWL_DevTreeAcquire(VOID)
+{
+	if (NWLC->NwDevTree)
+		return NWLC->NwDevTree;
+	return NWL_DevTreeCreate();
+}
+
+VOID
+NWL_DevTreeRelease(DEVTREE_SNAPSHOT* tree)
+{
+	if (tree != NWLC->NwDevTree)
+		NWL_DevTreeFree(tree);
+}
+
+static DWORD
+TrieAddNode(DEVTREE_FILTER* filter, CHAR ch)
+{
+	if (filter->count >= filter->capacity)
+	{
+		DWORD cap = filter->capacity ? filter->capacity * 2 : 64;
+		DEVTREE_TRIE_NODE* p = realloc(filter->nodes, cap * sizeof(DEVTREE_TRIE_NODE));
+		if (!p)
+			return 0;
+		filter->nodes = p;
+		filter->capacity = cap;
+	}
+	filter->nodes[filter->count] = (DEVTREE_TRIE_NODE){ .ch = ch, .terminal = FALSE, .child = 0, .sibling = 0 };
+	return filter->count++;
+}
+
+BOOL
+NWL_DevTreeFilterCompile(DEVTREE_FILTER* filter, LPCSTR prefixes)
+{
+	ZeroMemory(filter, sizeof(DEVTREE_FILTER));
+	TrieAddNode(filter, '\0');
+	if (!filter->nodes)
+		return FALSE;
+	if (!prefixes)
+		return TRUE;
+	for (LPCSTR p = prefixes; *p; )
+	{
+		DWORD cur = 0;
+		LPCSTR start = p;
+		for (; *p && *p != ','; p++)
+		{
+			CHAR ch = (CHAR)toupper((UCHAR)*p);
+			DWORD next = filter->nodes[cur].child;
+			while (next && filter->nodes[next].ch != ch)
+				next = filter->nodes[next].sibling;
+			if (!next)
 			{
-				NWL_NodeAttrSetMulti(node, "HWID List", hwIdList, 0);
-				free(hwIdList);
+				next = TrieAddNode(filter, ch);
+				if (!next)
+					return FALSE;
+				filter->nodes[next].sibling = filter->nodes[cur].child;
+				filter->nodes[cur].child = next;
 			}
+			cur = next;
 		}
+		// Empty entries such as "A,,B" are ignored
+		if (p > start)
+			filter->nodes[cur].terminal = TRUE;
+		if (*p == ',')
+			p++;
 	}
+	return TRUE;
+}
 
-	if (CM_Get_Child(&childInst, devInst, 0) == CR_SUCCESS)
+BOOL
+NWL_DevTreeFilterMatch(const DEVTREE_FILTER* filter, LPCSTR hwid)
+{
+	DWORD cur = 0;
+	if (!filter->nodes || !filter->nodes[0].child)
+		return TRUE;
+	for (; *hwid; hwid++)
 	{
-		NWL_EnumerateDevices(node, ctx, childInst, devInst);
-		DEVINST siblingInst = childInst;
-		while (CM_Get_Sibling(&siblingInst, siblingInst, 0) == CR_SUCCESS)
-			NWL_EnumerateDevices(node, ctx, siblingInst, devInst);
+		CHAR ch = (CHAR)toupper((UCHAR)*hwid);
+		DWORD next = filter->nodes[cur].child;
+		while (next && filter->nodes[next].ch != ch)
+			next = filter->nodes[next].sibling;
+		if (!next)
+			return FALSE;
+		cur = next;
+		if (filter->nodes[cur].terminal)
+			return TRUE;
 	}
+	return FALSE;
+}
+
+VOID
+NWL_DevTreeFilterFree(DEVTREE_FILTER* filter)
+{
+	free(filter->nodes);
+	ZeroMemory(filter, sizeof(DEVTREE_FILTER));
+}
+
+DWORD
+NWL_DevTreeFind(const DEVTREE_SNAPSHOT* tree, DWORD start, DWORD end, LPCSTR prefix, size_t prefixLen)
+{
+	if (!tree)
+		return DEVTREE_NONE;
+	for (DWORD i = start; i < end && i < tree->Count; i++)
+	{
+		if (tree->Entries[i].HwId && _strnicmp(tree->Entries[i].HwId, prefix, prefixLen) == 0)
+			return i;
+	}
+	return DEVTREE_NONE;
+}
+
+void
+NWL_EnumerateDevices(PNODE parent, DEVTREE_ENUM_CTX* ctx, DWORD index)
+{
+	const DEVTREE_SNAPSHOT* tree = ctx->tree;
+	PNODE* out;
+	DWORD end;
+
+	if (!tree || index >= tree->Count)
+		return;
+	end = tree->Entries[index].End;
+	// Output parent of each entry, matched devices nest their descendants.
+	out = calloc(end - index, sizeof(PNODE));
+	if (!out)
+		return;
+	// The trie is reused by later calls with the same ctx
+	if (!ctx->trie.nodes && !NWL_DevTreeFilterCompile(&ctx->trie, ctx->filter))
+	{
+		NWL_DevTreeFilterFree(&ctx->trie);
+		free(out);
+		return;
+	}
+
+	for (DWORD i = index; i < end; i++)
+	{
+		const DEVTREE_ENTRY* dev = &tree->Entries[i];
+		PNODE node = (i == index) ? parent : out[dev->Parent - index];
+
+		if (dev->HwId && NWL_DevTreeFilterMatch(&ctx->trie, dev->HwId))
+		{
+			node = NWL_NodeAppendNew(AppendDevices(node, ctx->hub), "Device", NFLG_TABLE_ROW);
+			ctx->GetDeviceInfo(node, ctx->data, tree, i);
+			if (dev->HwIdList)
+				NWL_NodeAttrSetMulti(node, "HWID List", dev->HwIdList, 0);
+		}
+		out[i - index] = node;
+	}
+	free(out);
+}
+
+VOID
+NWL_EnumerateDevicesEnd(DEVTREE_ENUM_CTX* ctx)
+{
+	NWL_DevTreeFilterFree(&ctx->trie);
 }
 
 PNODE NW_DevTree(BOOL bAppend)
 {
 	DEVTREE_ENUM_CTX ctx =
 	{
-		.filter = "\0",
+		.filter = NULL,
 		.data = NULL,
 		.hub = "Devices",
 		.GetDeviceInfo = GetDeviceInfoDefault,
 	};
-	DEVINST devRoot;
-	CONFIGRET cr;
+	DEVTREE_SNAPSHOT* tree;
 	PNODE node = NWL_NodeAlloc("Device Tree", NFLG_TABLE);
 	if (bAppend)
 		NWL_NodeAppendChild(NWLC->NwRoot, node);
 
-	if (NWLC->DevTreeFilter)
-	{
-		strncpy_s(ctx.filter, DEVTREE_MAX_STR_LEN, NWLC->DevTreeFilter, _TRUNCATE);
-		ctx.filterLen = strlen(ctx.filter);
-	}
-
-	cr = CM_Locate_DevNodeW(&devRoot, NULL, CM_LOCATE_DEVNODE_NORMAL);
-	if (cr != CR_SUCCESS)
-	{
-		NWL_NodeAppendMultiSz(&NWLC->ErrLog, "CM_Locate_DevNodeW failed");
-		goto fail;
-	}
-
-	NWL_EnumerateDevices(node, &ctx, devRoot, 0);
+	ctx.filter = NWLC->DevTreeFilter;
+	tree = NWL_DevTreeAcquire();
+	ctx.tree = tree;
+	NWL_EnumerateDevices(node, &ctx, 0);
+	NWL_EnumerateDevicesEnd(&ctx);
+	NWL_DevTreeRelease(tree);
 
-fail:
 	return node;
 }
@@ -13,20 +13,95 @@ typedef struct _NODE* PNODE;
 
 #define DEVTREE_MAX_STR_LEN MAX_PATH
 
+#define DEVTREE_NONE ((DWORD)-1)
+
+// Properties only some reports print, read on first use and kept in the snapshot.
+typedef enum _DEVTREE_PROP
+{
+	DEVTREE_PROP_MANUFACTURER = 0,
+	DEVTREE_PROP_SERVICE,
+	DEVTREE_PROP_DRIVER_DATE,
+	DEVTREE_PROP_DRIVER_VERSION,
+	DEVTREE_PROP_LOCATION,
+	DEVTREE_PROP_LOCATION_PATHS,
+	DEVTREE_PROP_COMPATIBLE_IDS,
+	DEVTREE_PROP_MAX
+} DEVTREE_PROP;
+
+// One devnode of the snapshot. Entries are stored in preorder, so the
+// subtree of entry i is [i + 1, End).
+typedef struct _DEVTREE_ENTRY
+{
+	DEVINST DevInst;
+	DWORD Parent;
+	DWORD End;
+	CHAR* HwId; // first hardware ID
+	CHAR* HwIdList; // all hardware IDs, multi-sz
+	CHAR* Name;
+	CHAR* Class;
+	DWORD PropLoaded; // bit per DEVTREE_PROP
+	CHAR* Prop[DEVTREE_PROP_MAX];
+} DEVTREE_ENTRY;
+
+// Property buffer reused for every devnode of one snapshot.
+typedef struct _DEVTREE_PROP_BUF
+{
+	PBYTE data;
+	ULONG size;
+} DEVTREE_PROP_BUF;
+
+typedef struct _DEVTREE_SNAPSHOT
+{
+	DWORD Count;
+	DWORD Capacity;
+	DEVTREE_ENTRY* Entries;
+	DEVTREE_PROP_BUF Buf;
+} DEVTREE_SNAPSHOT;
+
+// Hardware ID prefixes compiled into a case-insensitive trie.
+typedef struct _DEVTREE_TRIE_NODE
+{
+	CHAR ch;
+	BOOL terminal;
+	DWORD child;
+	DWORD sibling;
+} DEVTREE_TRIE_NODE;
+
+typedef struct _DEVTREE_FILTER
+{
+	DWORD count;
+	DWORD capacity;
+	DEVTREE_TRIE_NODE* nodes; // nodes[0] is the root
+} DEVTREE_FILTER;
+
 typedef struct _DEVTREE_ENUM_CTX
 {
-	CHAR filter[DEVTREE_MAX_STR_LEN];
-	size_t filterLen;
+	LPCSTR filter; // comma separated prefixes, NULL or empty matches all
 	const char* hub;
 	void* data;
-	void (CALLBACK *GetDeviceInfo)(PNODE node, void* data, DEVINST devInst, DEVINST parentDevInst, LPCSTR hwIds);
+	const DEVTREE_SNAPSHOT* tree;
+	void (CALLBACK *GetDeviceInfo)(PNODE node, void* data, const DEVTREE_SNAPSHOT* tree, DWORD index);
+	DEVTREE_FILTER trie; // compiled from filter on first use, see NWL_EnumerateDevicesEnd
 } DEVTREE_ENUM_CTX;
 
 BOOL NWL_SetDevPropString(CHAR* strBuf, size_t strSize, DEVINST devHandle, const DEVPROPKEY* devProperty);
 CONFIGRET NWL_CMGetDevIfProp(LPCWSTR pszDevIf, CONST DEVPROPKEY* propKey, DEVPROPTYPE* propType, PBYTE propBuf, PULONG propBufSize, ULONG ulFlags);
 
+DEVTREE_SNAPSHOT* NWL_DevTreeCreate(VOID);
+VOID NWL_DevTreeFree(DEVTREE_SNAPSHOT* tree);
+// Returns the snapshot shared by the current report, or a private one.
+DEVTREE_SNAPSHOT* NWL_DevTreeAcquire(VOID);
+VOID NWL_DevTreeRelease(DEVTREE_SNAPSHOT* tree);
+BOOL NWL_DevTreeFilterCompile(DEVTREE_FILTER* filter, LPCSTR prefixes);
+BOOL NWL_DevTreeFilterMatch(const DEVTREE_FILTER* filter, LPCSTR hwid);
+VOID NWL_DevTreeFilterFree(DEVTREE_FILTER* filter);
+DWORD NWL_DevTreeFind(const DEVTREE_SNAPSHOT* tree, DWORD start, DWORD end, LPCSTR prefix, size_t prefixLen);
+// Cached per entry, the snapshot is only logically const.
+LPCSTR NWL_DevTreeGetProp(const DEVTREE_SNAPSHOT* tree, DWORD index, DEVTREE_PROP prop);
+
 void
-NWL_EnumerateDevices(PNODE parent, DEVTREE_ENUM_CTX* ctx, DEVINST devInst, DEVINST parentDevInst);
+NWL_EnumerateDevices(PNODE parent, DEVTREE_ENUM_CTX* ctx, DWORD index);
+VOID NWL_EnumerateDevicesEnd(DEVTREE_ENUM_CTX* ctx);
 
 #ifdef __cplusplus
 }
@@ -561,19 +561,42 @@ AppendPartitionEntry(PHY_DRIVE_INFO* pInfo, PARTITION_INFORMATION_EX* pPartInfo)
 	return TRUE;
 }
 
+static DRIVE_LAYOUT_INFORMATION_EX*
+ReadDiskLayout(HANDLE hDisk, DWORD* pdwBytes)
+{
+	DWORD dwSize = 4096;
+	DRIVE_LAYOUT_INFORMATION_EX* pLayout = NULL;
+
+	// Grow until the whole partition table fits, up to what the shared buffer used to hold.
+	for (;;)
+	{
+		DWORD dwBytes = 0;
+		DRIVE_LAYOUT_INFORMATION_EX* p = realloc(pLayout, dwSize);
+		if (!p)
+			break;
+		pLayout = p;
+		if (DeviceIoControl(hDisk, IOCTL_DISK_GET_DRIVE_LAYOUT_EX, NULL, 0,
+			pLayout, dwSize, &dwBytes, NULL))
+		{
+			*pdwBytes = dwBytes;
+			return pLayout;
+		}
+		if (GetLastError() != ERROR_INSUFFICIENT_BUFFER || dwSize >= NWINFO_BUFSZ)
+			break;
+		dwSize = min(dwSize * 2, NWINFO_BUFSZ);
+	}
+	free(pLayout);
+	*pdwBytes = 0;
+	return NULL;
+}
+
 static BOOL
-GetDiskPartMap(HANDLE hDisk, BOOL bIsCdRom, PHY_DRIVE_INFO* pInfo)
+GetDiskPartMap(DRIVE_LAYOUT_INFORMATION_EX* pLayout, DWORD dwBytes, BOOL bIsCdRom, PHY_DRIVE_INFO* pInfo)
 {
-	DRIVE_LAYOUT_INFORMATION_EX* pLayout = (VOID*)NWLC->NwBuf;
-	DWORD dwBytes = NWINFO_BUFSZ;
 	DWORD dwEntryOffset = FIELD_OFFSET(DRIVE_LAYOUT_INFORMATION_EX, PartitionEntry);
 	DWORD dwEntryCount;
 
-	if (bIsCdRom)
-		goto fail;
-
-	if (!DeviceIoControl(hDisk, IOCTL_DISK_GET_DRIVE_LAYOUT_EX, NULL, 0,
-		pLayout, dwBytes, &dwBytes, NULL))
+	if (bIsCdRom || !pLayout)
 		goto fail;
 	if (dwBytes < dwEntryOffset)
 		goto fail;
@@ -686,12 +709,256 @@ DWORD NWL_GetDriveCount(BOOL bIsCdRom)
 	return dwCount;
 }
 
+#define DISK_PROBE_WORKERS 16
+#define DISK_PROBE_TIMEOUT 10000
+#define DISK_PROBE_POLL 250
+// Polls to wait for a cancelled probe to return before its worker is abandoned.
+#define DISK_PROBE_GRACE 8
+
+enum
+{
+	PROBE_PENDING = 0,
+	PROBE_RUNNING,
+	PROBE_DONE,
+	PROBE_TIMEOUT,
+};
+
+typedef struct
+{
+	WCHAR DevicePath[512];
+	BOOL IsCdRom;
+	// Probed into a private copy, merged into Target only once the job is done.
+	PHY_DRIVE_INFO Info;
+	PHY_DRIVE_INFO* Target;
+	DRIVE_LAYOUT_INFORMATION_EX* Layout;
+	DWORD LayoutSize;
+	BOOL Probed;
+	BOOL Merged;
+	volatile LONG State;
+	ULONGLONG StartTick;
+} DRIVE_PROBE_JOB;
+
+struct _DRIVE_PROBE_POOL;
+
+typedef struct
+{
+	struct _DRIVE_PROBE_POOL* Pool;
+	// Job index + 1 while a probe is running, 0 otherwise.
+	volatile LONG Job;
+} DRIVE_PROBE_WORKER;
+
+// Shared with the workers, the last one out frees it.
+typedef struct _DRIVE_PROBE_POOL
+{
+	volatile LONG Refs;
+	DRIVE_PROBE_JOB* Jobs;
+	DWORD Count;
+	volatile LONG Next;
+	DRIVE_PROBE_WORKER Workers[DISK_PROBE_WORKERS];
+} DRIVE_PROBE_POOL;
+
+// Runs on a worker thread, so only job-local buffers may be used here.
+static VOID
+ProbeDrive(DRIVE_PROBE_JOB* pJob)
+{
+	BOOL bRet;
+	DWORD dwBytes;
+	HANDLE hIfDev;
+	HANDLE hDrive;
+	STORAGE_DEVICE_NUMBER sdn;
+	STORAGE_PROPERTY_QUERY Query = { .PropertyId = StorageDeviceProperty, .QueryType = PropertyStandardQuery };
+	STORAGE_DESCRIPTOR_HEADER DevDescHeader = { 0 };
+	STORAGE_DEVICE_DESCRIPTOR* pDevDesc = NULL;
+	PHY_DRIVE_INFO* pInfo = &pJob->Info;
+
+	hIfDev = CreateFileW(pJob->DevicePath,
+		GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+		NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hIfDev == INVALID_HANDLE_VALUE || hIfDev == NULL)
+		return;
+	bRet = DeviceIoControl(hIfDev, IOCTL_STORAGE_GET_DEVICE_NUMBER,
+		NULL, 0, &sdn, (DWORD)(sizeof(STORAGE_DEVICE_NUMBER)),
+		&dwBytes, NULL);
+	CloseHandle(hIfDev);
+	if (bRet == FALSE || pJob->State == PROBE_TIMEOUT)
+		return;
+	pInfo->Index = sdn.DeviceNumber;
+
+	hDrive = NWL_GetDiskHandleById(pJob->IsCdRom, FALSE, pInfo->Index);
+	pInfo->Handle = hDrive;
+	if (!hDrive || hDrive == INVALID_HANDLE_VALUE || pJob->State == PROBE_TIMEOUT)
+		return;
+
+	bRet = DeviceIoControl(hDrive, IOCTL_STORAGE_QUERY_PROPERTY, &Query, sizeof(Query),
+		&DevDescHeader, sizeof(STORAGE_DESCRIPTOR_HEADER), &dwBytes, NULL);
+	if (!bRet || DevDescHeader.Size < sizeof(STORAGE_DEVICE_DESCRIPTOR))
+		return;
+
+	pDevDesc = (STORAGE_DEVICE_DESCRIPTOR*)malloc(DevDescHeader.Size);
+	if (!pDevDesc)
+		return;
+
+	bRet = DeviceIoControl(hDrive, IOCTL_STORAGE_QUERY_PROPERTY, &Query, sizeof(Query),
+		pDevDesc, DevDescHeader.Size, &dwBytes, NULL);
+	if (!bRet || pJob->State == PROBE_TIMEOUT)
+		goto out;
+
+	pInfo->SizeInBytes = GetDiskSize(hDrive);
+	pInfo->DeviceType = pDevDesc->DeviceType;
+	pInfo->RemovableMedia = pDevDesc->RemovableMedia;
+	pInfo->BusType = pDevDesc->BusType;
+	if (!pJob->IsCdRom)
+		pInfo->Ssd = CheckSsd(hDrive, pInfo);
+
+	if (pDevDesc->VendorIdOffset)
+	{
+		strncpy_s(pInfo->VendorId, MAX_PATH,
+			(char*)pDevDesc + pDevDesc->VendorIdOffset, _TRUNCATE);
+		TrimString(pInfo->VendorId);
+	}
+
+	if (pDevDesc->ProductIdOffset)
+	{
+		strncpy_s(pInfo->ProductId, MAX_PATH,
+			(char*)pDevDesc + pDevDesc->ProductIdOffset, _TRUNCATE);
+		TrimString(pInfo->ProductId);
+	}
+
+	if (pDevDesc->ProductRevisionOffset)
+	{
+		strncpy_s(pInfo->ProductRev, MAX_PATH,
+			(char*)pDevDesc + pDevDesc->ProductRevisionOffset, _TRUNCATE);
+		TrimString(pInfo->ProductRev);
+	}
+
+	if (pDevDesc->SerialNumberOffset)
+	{
+		strncpy_s(pInfo->SerialNumber, MAX_PATH,
+			(char*)pDevDesc + pDevDesc->SerialNumberOffset, _TRUNCATE);
+		TrimString(pInfo->SerialNumber);
+	}
+
+	pJob->Probed = TRUE;
+	if (!pJob->IsCdRom && pJob->State != PROBE_TIMEOUT)
+		pJob->Layout = ReadDiskLayout(hDrive, &pJob->LayoutSize);
+
+out:
+	free(pDevDesc);
+}
+
+static VOID
+ReleaseProbePool(DRIVE_PROBE_POOL* pPool)
+{
+	if (InterlockedDecrement(&pPool->Refs) != 0)
+		return;
+	for (DWORD i = 0; i < pPool->Count; i++)
+	{
+		DRIVE_PROBE_JOB* pJob = &pPool->Jobs[i];
+		if (!pJob->Merged && pJob->Info.Handle && pJob->Info.Handle != INVALID_HANDLE_VALUE)
+			CloseHandle(pJob->Info.Handle);
+		free(pJob->Layout);
+	}
+	free(pPool->Jobs);
+	free(pPool);
+}
+
+static DWORD WINAPI
+ProbeWorker(LPVOID lpParameter)
+{
+	DRIVE_PROBE_WORKER* pWorker = lpParameter;
+	DRIVE_PROBE_POOL* pPool = pWorker->Pool;
+	for (;;)
+	{
+		LONG i = InterlockedIncrement(&pPool->Next) - 1;
+		if (i >= (LONG)pPool->Count)
+			break;
+		DRIVE_PROBE_JOB* pJob = &pPool->Jobs[i];
+		pJob->StartTick = GetTickCount64();
+		InterlockedExchange(&pJob->State, PROBE_RUNNING);
+		InterlockedExchange(&pWorker->Job, i + 1);
+		ProbeDrive(pJob);
+		InterlockedExchange(&pWorker->Job, 0);
+		if (InterlockedExchange(&pJob->State, PROBE_DONE) == PROBE_TIMEOUT)
+			NWL_Debug("DISK", "Probe job %ld timed out", i);
+	}
+	ReleaseProbePool(pPool);
+	return 0;
+}
+
+static VOID
+RunProbePool(DRIVE_PROBE_POOL* pPool)
+{
+	DWORD i;
+	DWORD dwThreads = 0;
+	HANDLE hThreads[DISK_PROBE_WORKERS] = { 0 };
+	DWORD dwWorkers = min(pPool->Count, DISK_PROBE_WORKERS);
+
+	for (i = 0; i < dwWorkers; i++)
+	{
+		pPool->Workers[dwThreads].Pool = pPool;
+		InterlockedIncrement(&pPool->Refs);
+		hThreads[dwThreads] = CreateThread(NULL, 0, ProbeWorker, &pPool->Workers[dwThreads], 0, NULL);
+		if (hThreads[dwThreads])
+			dwThreads++;
+		else
+			InterlockedDecrement(&pPool->Refs);
+	}
+	if (dwThreads == 0)
+	{
+		pPool->Workers[0].Pool = pPool;
+		InterlockedIncrement(&pPool->Refs);
+		ProbeWorker(&pPool->Workers[0]);
+		return;
+	}
+
+	// A hung bridge or a drive spinning up only blocks its own worker.
+	// Pending synchronous I/O of that worker is cancelled after the timeout,
+	// and a worker that still does not return is left behind.
+	while (WaitForMultipleObjects(dwThreads, hThreads, TRUE, DISK_PROBE_POLL) == WAIT_TIMEOUT)
+	{
+		ULONGLONG ullNow = GetTickCount64();
+		BOOL bStuck = TRUE;
+		for (i = 0; i < dwThreads; i++)
+		{
+			DRIVE_PROBE_WORKER* pWorker = &pPool->Workers[i];
+			LONG lJob = pWorker->Job;
+			DRIVE_PROBE_JOB* pJob;
+			if (WaitForSingleObject(hThreads[i], 0) == WAIT_OBJECT_0)
+				continue;
+			if (lJob == 0)
+			{
+				bStuck = FALSE;
+				continue;
+			}
+			pJob = &pPool->Jobs[lJob - 1];
+			if (ullNow - pJob->StartTick < DISK_PROBE_TIMEOUT + DISK_PROBE_GRACE * DISK_PROBE_POLL)
+				bStuck = FALSE;
+			if (ullNow - pJob->StartTick < DISK_PROBE_TIMEOUT)
+				continue;
+			if (InterlockedCompareExchange(&pJob->State, PROBE_TIMEOUT, PROBE_RUNNING) != PROBE_RUNNING)
+				continue;
+			// The worker may have moved on since its job was read.
+			if (pWorker->Job == lJob)
+				CancelSynchronousIo(hThreads[i]);
+		}
+		if (bStuck)
+		{
+			NWL_Debug("DISK", "Abandoning stuck probe workers");
+			InterlockedExchange(&pPool->Next, (LONG)pPool->Count);
+			break;
+		}
+	}
+	for (i = 0; i < dwThreads; i++)
+		CloseHandle(hThreads[i]);
+}
+
 DWORD NWL_GetDriveInfoList(BOOL bIsCdRom, BOOL bGetVolume, PHY_DRIVE_INFO** pDriveList)
 {
 	DWORD i;
 	BOOL bRet;
 	DWORD dwBytes;
 	PHY_DRIVE_INFO* pInfo;
+	DRIVE_PROBE_POOL* pool;
 
 	HANDLE hSearch;
 	WCHAR cchVolume[MAX_PATH];
@@ -714,39 +981,29 @@ DWORD NWL_GetDriveInfoList(BOOL bIsCdRom, BOOL bGetVolume, PHY_DRIVE_INFO** pDri
 	}
 
 	*pDriveList = calloc(dwCount, sizeof(PHY_DRIVE_INFO));
-	if (!*pDriveList)
+	pool = calloc(1, sizeof(DRIVE_PROBE_POOL));
+	if (pool)
+		pool->Jobs = calloc(dwCount, sizeof(DRIVE_PROBE_JOB));
+	if (!*pDriveList || !pool || !pool->Jobs)
 	{
+		free(*pDriveList);
+		*pDriveList = NULL;
+		if (pool)
+			free(pool->Jobs);
+		free(pool);
 		SetupDiDestroyDeviceInfoList(hDevInfo);
 		return 0;
 	}
 	pInfo = *pDriveList;
 
+	// SetupDi is cheap, collect everything it knows first.
 	for (i = 0; i < dwCount; i++)
 	{
-		HANDLE hDrive = INVALID_HANDLE_VALUE;
-		STORAGE_PROPERTY_QUERY Query = { 0 };
-		STORAGE_DESCRIPTOR_HEADER DevDescHeader = { 0 };
-		STORAGE_DEVICE_DESCRIPTOR* pDevDesc = NULL;
-		STORAGE_DEVICE_NUMBER sdn;
-		HANDLE hIfDev;
-
 		if (!SetupDiEnumDeviceInterfaces(hDevInfo, NULL, &devGuid, i, &ifData))
-			goto next_drive;
+			continue;
 		if (!SetupDiGetDeviceInterfaceDetailW(hDevInfo, &ifData, (PSP_DEVICE_INTERFACE_DETAIL_DATA_W)&detailData,
 			sizeof(MY_DEVIF_DETAIL_DATA), NULL, &infoData))
-			goto next_drive;
-		hIfDev = CreateFileW(detailData.DevicePath,
-			GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
-			NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-		if (hIfDev == INVALID_HANDLE_VALUE || hIfDev == NULL)
-			goto next_drive;
-		bRet = DeviceIoControl(hIfDev, IOCTL_STORAGE_GET_DEVICE_NUMBER,
-			NULL, 0, &sdn, (DWORD)(sizeof(STORAGE_DEVICE_NUMBER)),
-			&dwBytes, NULL);
-		CloseHandle(hIfDev);
-		if (bRet == FALSE)
-			goto next_drive;
-		pInfo[i].Index = sdn.DeviceNumber;
+			continue;
 
 		if (SetupDiGetDeviceInstanceIdW(hDevInfo, &infoData, NWLC->NwBufW, NWINFO_BUFSZB, NULL))
 			wcsncpy_s(pInfo[i].HwID, MAX_PATH, NWLC->NwBufW, _TRUNCATE);
@@ -756,70 +1013,31 @@ DWORD NWL_GetDriveInfoList(BOOL bIsCdRom, BOOL bGetVolume, PHY_DRIVE_INFO** pDri
 				NULL, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL))
 			wcsncpy_s(pInfo[i].HwName, MAX_PATH, NWLC->NwBufW, _TRUNCATE);
 
-		hDrive = NWL_GetDiskHandleById(bIsCdRom, FALSE, pInfo[i].Index);
-		pInfo[i].Handle = hDrive;
-		if (!hDrive || hDrive == INVALID_HANDLE_VALUE)
-			goto next_drive;
-
-		Query.PropertyId = StorageDeviceProperty;
-		Query.QueryType = PropertyStandardQuery;
-
-		bRet = DeviceIoControl(hDrive, IOCTL_STORAGE_QUERY_PROPERTY, &Query, sizeof(Query),
-			&DevDescHeader, sizeof(STORAGE_DESCRIPTOR_HEADER), &dwBytes, NULL);
-		if (!bRet || DevDescHeader.Size < sizeof(STORAGE_DEVICE_DESCRIPTOR))
-			goto next_drive;
-
-		pDevDesc = (STORAGE_DEVICE_DESCRIPTOR*)malloc(DevDescHeader.Size);
-		if (!pDevDesc)
-			goto next_drive;
-
-		bRet = DeviceIoControl(hDrive, IOCTL_STORAGE_QUERY_PROPERTY, &Query, sizeof(Query),
-			pDevDesc, DevDescHeader.Size, &dwBytes, NULL);
-		if (!bRet)
-			goto next_drive;
-
-		pInfo[i].SizeInBytes = GetDiskSize(hDrive);
-		pInfo[i].DeviceType = pDevDesc->DeviceType;
-		pInfo[i].RemovableMedia = pDevDesc->RemovableMedia;
-		pInfo[i].BusType = pDevDesc->BusType;
-		if (!bIsCdRom)
-			pInfo[i].Ssd = CheckSsd(hDrive, &pInfo[i]);
-
-		if (pDevDesc->VendorIdOffset)
-		{
-			strncpy_s(pInfo[i].VendorId, MAX_PATH,
-				(char*)pDevDesc + pDevDesc->VendorIdOffset, _TRUNCATE);
-			TrimString(pInfo[i].VendorId);
-		}
-
-		if (pDevDesc->ProductIdOffset)
-		{
-			strncpy_s(pInfo[i].ProductId, MAX_PATH,
-				(char*)pDevDesc + pDevDesc->ProductIdOffset, _TRUNCATE);
-			TrimString(pInfo[i].ProductId);
-		}
-
-		if (pDevDesc->ProductRevisionOffset)
-		{
-			strncpy_s(pInfo[i].ProductRev, MAX_PATH,
-				(char*)pDevDesc + pDevDesc->ProductRevisionOffset, _TRUNCATE);
-			TrimString(pInfo[i].ProductRev);
-		}
-
-		if (pDevDesc->SerialNumberOffset)
-		{
-			strncpy_s(pInfo[i].SerialNumber, MAX_PATH,
-				(char*)pDevDesc + pDevDesc->SerialNumberOffset, _TRUNCATE);
-			TrimString(pInfo[i].SerialNumber);
-		}
+		wcsncpy_s(pool->Jobs[pool->Count].DevicePath, ARRAYSIZE(pool->Jobs[pool->Count].DevicePath),
+			detailData.DevicePath, _TRUNCATE);
+		pool->Jobs[pool->Count].IsCdRom = bIsCdRom;
+		pool->Jobs[pool->Count].Info = pInfo[i];
+		pool->Jobs[pool->Count].Target = &pInfo[i];
+		pool->Count++;
+	}
+	SetupDiDestroyDeviceInfoList(hDevInfo);
 
-		GetDiskPartMap(hDrive, bIsCdRom, &pInfo[i]);
+	pool->Refs = 1;
+	RunProbePool(pool);
 
-next_drive:
-		if (pDevDesc)
-			free(pDevDesc);
+	// Partition parsing uses shared string buffers, merge in index order.
+	// Jobs still held by an abandoned worker keep only their SetupDi data.
+	for (i = 0; i < pool->Count; i++)
+	{
+		DRIVE_PROBE_JOB* pJob = &pool->Jobs[i];
+		if (pJob->State != PROBE_DONE)
+			continue;
+		*pJob->Target = pJob->Info;
+		pJob->Merged = TRUE;
+		if (pJob->Probed)
+			GetDiskPartMap(pJob->Layout, pJob->LayoutSize, bIsCdRom, pJob->Target);
 	}
-	SetupDiDestroyDeviceInfoList(hDevInfo);
+	ReleaseProbePool(pool);
 
 	if (!bGetVolume)
 		return dwCount;
@@ -896,7 +1114,8 @@ PrintSmartInfo(PNODE node, CDI_SMART* ptr, INT index)
 
 	if (index < 0)
 		return;
-	cdi_update_smart(ptr, index);
+	// Drives read within their refresh interval or sleeping are left alone.
+	cdi_refresh_disk(ptr, index, CDI_REFRESH_INTERVAL, FALSE);
 
 	n = cdi_get_int(ptr, index, CDI_INT_TEMPERATURE);
 	if (n >= -50)
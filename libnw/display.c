@@ -13,6 +13,7 @@
 
 #include "libnw.h"
 #include "utils.h"
+#include "edid.h"
 
 // We don't include ntddvdeo.h directly to avoid potential conflicts or dependencies.
 // This GUID is for the device interface class for monitors.
@@ -20,39 +21,6 @@ DEFINE_GUID(GUID_DEVINTERFACE_MONITOR,
 	0xe6f07b5f, 0xee97, 0x4a90,
 	0xb0, 0x76, 0x33, 0xf5, 0x7b, 0xf4, 0xea, 0xa7);
 
-struct MONITOR_INFO
-{
-	UINT64 XRes;
-	UINT64 YRes;
-	double Freq;
-	UINT64 Width; //mm
-	UINT64 Height; //mm
-	CHAR Name[14];
-	CHAR Serial[14];
-	UINT16 Ver;
-};
-
-/**
- * @brief Cleans a string read from EDID by removing trailing newlines and spaces.
- *
- * @param str The string to clean. The string is modified in place.
- */
-static void CleanupEdidString(char* str)
-{
-	if (!str)
-		return;
-
-	size_t len = strlen(str);
-	while (len > 0)
-	{
-		if (isspace(str[len - 1]))
-			len--;
-		else
-			break;
-	}
-	str[len] = '\0';
-}
-
 /**
  * @brief Calculates the greatest common divisor (GCD) of two integers.
  *
@@ -155,117 +123,35 @@ GetSignalLevel(BYTE signalLevel)
 	return "UNKNOWN";
 }
 
-static const char*
-GetAspectRatio(BYTE aspectRatio, UINT16 edidVer, UINT64 hRes, UINT64* vRes)
-{
-	switch (aspectRatio)
-	{
-	case 0:
-		if (edidVer < 0x0103)
-		{
-			*vRes = hRes;
-			return "1:1";
-		}
-		*vRes = (hRes * 10) / 16;
-		return "16:10";
-	case 1:
-		*vRes = (hRes * 3) / 4;
-		return "4:3";
-	case 2:
-		*vRes = (hRes * 4) / 5;
-		return "5:4";
-	case 3:
-		*vRes = (hRes * 9) / 16;
-		return "16:9";
-	}
-	// Should never happen
-	*vRes = 0;
-	return "UNKNOWN";
-}
-
-static char* DecodeAsciiDescriptor(const BYTE* block, PNODE node, const char* name)
+static void PrintAsciiDescriptor(const NWL_EDID_DESC* d, PNODE node, const char* name)
 {
 	PNODE ascii = NWL_NodeAppendNew(node, "ASCII Descriptor", NFLG_TABLE_ROW);
 	NWL_NodeAttrSet(ascii, "Type", name, 0);
-	// A string descriptor has a 5-byte header, followed by up to 13 bytes of text.
-	// We allocate 14 bytes to ensure null termination.
-	char* text = (char*)malloc(14);
-	if (!text)
-		return NULL;
-
-	// Copy the string data from the block.
-	memcpy(text, block + 5, 13);
-	text[13] = '\0'; // Ensure null termination.
-	CleanupEdidString(text);
-
-	NWL_NodeAttrSet(ascii, "Text", text, 0);
-
-	// The caller will use this string for the summary, so we return a copy.
-	// Or rather, we return the original allocation and the caller must free it.
-	return text;
+	NWL_NodeAttrSet(ascii, "Text", d->Text, 0);
 }
 
-static void DecodeDetailedTimingDescriptor(const BYTE* block, PNODE node, struct MONITOR_INFO* mi)
+static void PrintDetailedTimingDescriptor(const NWL_EDID_DTD* d, PNODE node)
 {
 	PNODE dtd = NWL_NodeAppendNew(node, "Detailed Timing Descriptor", NFLG_TABLE_ROW);
 	NWL_NodeAttrSet(dtd, "Type", "Detailed Timing Descriptor", 0);
-	// All values are calculated from the 18-byte block.
-	// Pixel clock is in units of 10 kHz.
-	int pixelClock = ((block[1] << 8) | block[0]) * 10; // in kHz
-	int hActive = block[2] + ((block[4] & 0xF0) << 4);
-	int hBlank = block[3] + ((block[4] & 0x0F) << 8);
-	int vActive = block[5] + ((block[7] & 0xF0) << 4);
-	int vBlank = block[6] + ((block[7] & 0x0F) << 8);
-
-	int hTotal = hActive + hBlank;
-	int vTotal = vActive + vBlank;
-
-	// Avoid division by zero
-	if (hTotal == 0 || vTotal == 0)
-	{
-		NWL_NodeAppendMultiSz(&NWLC->ErrLog, "Invalid timing data");
+	if (!d->Valid)
 		return;
-	}
-
-	// Refresh rate calculation using 64-bit integers to prevent overflow
-	// Refresh Rate = PixelClock / (HTotal * VTotal)
-	double refreshRate = (pixelClock * 1000.0) / ((ULONGLONG)hTotal * vTotal);
-	if (hActive * vActive > mi->XRes * mi->YRes)
-	{
-		mi->XRes = hActive;
-		mi->YRes = vActive;
-	}
-	if (mi->Freq < refreshRate)
-		mi->Freq = refreshRate;
-	NWL_NodeAttrSetf(dtd, "Pixel Clock (kHz)", NAFLG_FMT_NUMERIC, "%d", pixelClock);
-	NWL_NodeAttrSetf(dtd, "Resolution", 0, "%dx%d", hActive, vActive);
-	NWL_NodeAttrSetf(dtd, "Refresh Rate (Hz)", NAFLG_FMT_NUMERIC, "%.2f", refreshRate);
-	NWL_NodeAttrSetf(dtd, "H Active", NAFLG_FMT_NUMERIC, "%d", hActive);
-	NWL_NodeAttrSetf(dtd, "H Blank", NAFLG_FMT_NUMERIC, "%d", hBlank);
-	NWL_NodeAttrSetf(dtd, "H Total", NAFLG_FMT_NUMERIC, "%d", hTotal);
-	NWL_NodeAttrSetf(dtd, "V Active", NAFLG_FMT_NUMERIC, "%d", vActive);
-	NWL_NodeAttrSetf(dtd, "V Blank", NAFLG_FMT_NUMERIC, "%d", vBlank);
-	NWL_NodeAttrSetf(dtd, "V Total", NAFLG_FMT_NUMERIC, "%d", vTotal);
-
-	// Extract physical dimensions from DTD (bytes 12-14)
-	int hSizeMm = block[12] | ((block[14] & 0xF0) << 4);
-	int vSizeMm = block[13] | ((block[14] & 0x0F) << 8);
 
-	if (hSizeMm > 0 && vSizeMm > 0)
-	{
-		NWL_NodeAttrSetf(dtd, "Image Size (mm)", 0, "%dx%d", hSizeMm, vSizeMm);
+	NWL_NodeAttrSetf(dtd, "Pixel Clock (kHz)", NAFLG_FMT_NUMERIC, "%u", d->PixelClock);
+	NWL_NodeAttrSetf(dtd, "Resolution", 0, "%ux%u", d->HActive, d->VActive);
+	NWL_NodeAttrSetf(dtd, "Refresh Rate (Hz)", NAFLG_FMT_NUMERIC, "%.2f", d->Refresh);
+	NWL_NodeAttrSetf(dtd, "H Active", NAFLG_FMT_NUMERIC, "%u", d->HActive);
+	NWL_NodeAttrSetf(dtd, "H Blank", NAFLG_FMT_NUMERIC, "%u", d->HBlank);
+	NWL_NodeAttrSetf(dtd, "H Total", NAFLG_FMT_NUMERIC, "%u", d->HActive + d->HBlank);
+	NWL_NodeAttrSetf(dtd, "V Active", NAFLG_FMT_NUMERIC, "%u", d->VActive);
+	NWL_NodeAttrSetf(dtd, "V Blank", NAFLG_FMT_NUMERIC, "%u", d->VBlank);
+	NWL_NodeAttrSetf(dtd, "V Total", NAFLG_FMT_NUMERIC, "%u", d->VActive + d->VBlank);
 
-		// If the main size variables are not yet set, update them from this DTD.
-		// The first DTD is considered the primary one for this information.
-		if (mi->Width == 0 && mi->Height == 0)
-		{
-			mi->Width = (UINT64)hSizeMm;
-			mi->Height = (UINT64)vSizeMm;
-		}
-	}
+	if (d->HSizeMm > 0 && d->VSizeMm > 0)
+		NWL_NodeAttrSetf(dtd, "Image Size (mm)", 0, "%ux%u", d->HSizeMm, d->VSizeMm);
 
 	// Parse features bitmap in byte 17
-	BYTE features = block[17];
+	BYTE features = d->Features;
 
 	// Bit 7: Interlaced or Non-interlaced
 	NWL_NodeAttrSet(dtd, "Signal", (features & 0x80) ? "Interlaced" : "Non-interlaced", 0);
@@ -318,138 +204,84 @@ static void DecodeDetailedTimingDescriptor(const BYTE* block, PNODE node, struct
 	}
 }
 
-static void DecodeDisplayRangeLimits(const BYTE* block, PNODE node)
+static void PrintDisplayRangeLimits(const NWL_EDID_DESC* d, PNODE node)
 {
 	PNODE drl = NWL_NodeAppendNew(node, "Display Range Limits", NFLG_TABLE_ROW);
 	NWL_NodeAttrSet(drl, "Type", "Display Range Limits", 0);
-	// Offsets within the 18-byte block.
-	int minVRate = block[5];
-	int maxVRate = block[6];
-	int minHRate = block[7];
-	int maxHRate = block[8];
-	int maxPixelClock = block[9] * 10; // In MHz
-
-	NWL_NodeAttrSetf(drl, "Vertical Rate (Hz)", 0, "%d-%d", minVRate, maxVRate);
-	NWL_NodeAttrSetf(drl, "Horizontal Rate (kHz)", 0, "%d-%d", minHRate, maxHRate);
-	NWL_NodeAttrSetf(drl, "Max Pixel Clock (MHz)", NAFLG_FMT_NUMERIC, "%d", maxPixelClock);
+	NWL_NodeAttrSetf(drl, "Vertical Rate (Hz)", 0, "%u-%u", d->MinVRate, d->MaxVRate);
+	NWL_NodeAttrSetf(drl, "Horizontal Rate (kHz)", 0, "%u-%u", d->MinHRate, d->MaxHRate);
+	NWL_NodeAttrSetf(drl, "Max Pixel Clock (MHz)", NAFLG_FMT_NUMERIC, "%u", d->MaxPixelClock);
 }
 
-static void DecodeUnsuopportedDescriptor(const BYTE* block, PNODE node, const char* name)
+static void PrintUnsupportedDescriptor(PNODE node, const char* name)
 {
 	PNODE unsup = NWL_NodeAppendNew(node, name, NFLG_TABLE_ROW);
 	NWL_NodeAttrSet(unsup, "Type", name, 0);
 }
 
-static void DecodeDescriptorBlocks(const BYTE* edid, PNODE node, struct MONITOR_INFO* mi)
+static void PrintDescriptorBlocks(const NWL_EDID* edid, PNODE node)
 {
 	PNODE desc = NWL_NodeAppendNew(node, "Descriptor Blocks", NFLG_TABLE);
-	// There are four 18-byte descriptor blocks, starting at offset 54.
 	for (int i = 0; i < 4; ++i)
 	{
-		int offset = 54 + (i * 18);
-		const BYTE* block = edid + offset;
-
-		// Check if it's a Detailed Timing Descriptor (DTD).
-		// A DTD does not start with 0x00 0x00.
-		if (block[0] != 0x00 || block[1] != 0x00)
-		{
-			DecodeDetailedTimingDescriptor(block, desc, mi);
-		}
-		else
+		const NWL_EDID_DESC* d = &edid->Desc[i];
+		switch (d->Tag)
 		{
-			// It's a different type of descriptor, identified by block[3].
-			switch (block[3])
-			{
-			case 0xFF: // Serial Number
-			{
-				char* serial = DecodeAsciiDescriptor(block, desc, "Serial Number");
-				if (serial)
-				{
-					strncpy_s(mi->Serial, sizeof(mi->Serial), serial, _TRUNCATE);
-					free(serial);
-				}
-				break;
-			}
-			case 0xFE: // Unspecified Text / Dummy
-			{
-				char* text = DecodeAsciiDescriptor(block, desc, "Unspecified Text");
-				free(text);
-				break;
-			}
-			case 0xFD: // Display Range Limits
-				DecodeDisplayRangeLimits(block, desc);
-				break;
-			case 0xFC: // Display Name
-			{
-				char* name = DecodeAsciiDescriptor(block, desc, "Display Name");
-				if (name)
-				{
-					strncpy_s(mi->Name, sizeof(mi->Name), name, _TRUNCATE);
-					free(name);
-				}
-				break;
-			}
-			case 0xFB: // Additional white point data
-				DecodeUnsuopportedDescriptor(block, desc, "White Point Data");
-				break;
-			case 0xFA: // Additional standard timing identifier
-				DecodeUnsuopportedDescriptor(block, desc, "Standard Timing Identifier");
-				break;
-			case 0xF9: // Display Color Management
-				DecodeUnsuopportedDescriptor(block, desc, "Display Color Management");
-				break;
-			case 0xF8: // CVT 3_byte Timing Code
-				DecodeUnsuopportedDescriptor(block, desc, "CVT 3-byte Timing Code");
-				break;
-			case 0xF7: // Additional standard timing 3
-				DecodeUnsuopportedDescriptor(block, desc, "Additional Standard Timing 3");
-				break;
-			default:
-				DecodeUnsuopportedDescriptor(block, desc, "Vendor-defined");
-				break;
-			}
+		case 0x00:
+			PrintDetailedTimingDescriptor(&d->Dtd, desc);
+			break;
+		case 0xFF:
+			PrintAsciiDescriptor(d, desc, "Serial Number");
+			break;
+		case 0xFE:
+			PrintAsciiDescriptor(d, desc, "Unspecified Text");
+			break;
+		case 0xFD:
+			PrintDisplayRangeLimits(d, desc);
+			break;
+		case 0xFC:
+			PrintAsciiDescriptor(d, desc, "Display Name");
+			break;
+		case 0xFB:
+			PrintUnsupportedDescriptor(desc, "White Point Data");
+			break;
+		case 0xFA:
+			PrintUnsupportedDescriptor(desc, "Standard Timing Identifier");
+			break;
+		case 0xF9:
+			PrintUnsupportedDescriptor(desc, "Display Color Management");
+			break;
+		case 0xF8:
+			PrintUnsupportedDescriptor(desc, "CVT 3-byte Timing Code");
+			break;
+		case 0xF7:
+			PrintUnsupportedDescriptor(desc, "Additional Standard Timing 3");
+			break;
+		default:
+			PrintUnsupportedDescriptor(desc, "Vendor-defined");
+			break;
 		}
 	}
 }
 
 static void
-DecodeStandardTimings(const BYTE* edid, PNODE node, struct MONITOR_INFO* mi)
+PrintStandardTimings(const NWL_EDID* edid, PNODE node)
 {
 	PNODE blks = NWL_NodeAppendNew(node, "Standard Timing Blocks", NFLG_TABLE);
-	// 16 bytes for 8 standard timing blocks, starting at offset 38.
 	for (int i = 0; i < 8; ++i)
 	{
-		int offset = 38 + (i * 2);
-		BYTE b1 = edid[offset];
-		BYTE b2 = edid[offset + 1];
-
-		PNODE std = NWL_NodeAppendNew(blks, "Standard Timing Block", NFLG_TABLE_ROW);
-
-		// If the first byte is 0x01, the timing is not used.
-		if (b1 == 0x01 && b2 == 0x01)
+		const NWL_EDID_STD* std = &edid->Std[i];
+		PNODE ns = NWL_NodeAppendNew(blks, "Standard Timing Block", NFLG_TABLE_ROW);
+		if (!std->Enabled)
 		{
-			NWL_NodeAttrSet(std, "Status", "Disabled", 0);
+			NWL_NodeAttrSet(ns, "Status", "Disabled", 0);
 			continue;
 		}
-		NWL_NodeAttrSet(std, "Status", "Enabled", 0);
-
-		UINT64 hRes = (31ULL + b1) * 8;
-		UINT64 vRes;
-		const char* aspectRatio = GetAspectRatio((b2 >> 6) & 0x03, mi->Ver, hRes, &vRes);
-		int refresh = (b2 & 0x3F) + 60;
-
-		NWL_NodeAttrSet(std, "Aspect Ratio", aspectRatio, 0);
-		NWL_NodeAttrSetf(std, "Resolution", 0, "%llux%llu",
-			(unsigned long long)hRes, (unsigned long long)vRes);
-		NWL_NodeAttrSetf(std, "Refresh Rate (Hz)", NAFLG_FMT_NUMERIC, "%d", refresh);
-
-		// Update max resolution if this one is bigger
-		if (hRes * vRes > mi->XRes * mi->YRes)
-		{
-			mi->XRes = hRes;
-			mi->YRes = vRes;
-			// Note: We don't update max refresh rate from here as DTD is more precise.
-		}
+		NWL_NodeAttrSet(ns, "Status", "Enabled", 0);
+		NWL_NodeAttrSet(ns, "Aspect Ratio", std->AspectRatio, 0);
+		NWL_NodeAttrSetf(ns, "Resolution", 0, "%llux%llu",
+			(unsigned long long)std->HRes, (unsigned long long)std->VRes);
+		NWL_NodeAttrSetf(ns, "Refresh Rate (Hz)", NAFLG_FMT_NUMERIC, "%d", std->Refresh);
 	}
 }
 
@@ -486,7 +318,7 @@ static void DecodeVideoInput(const BYTE* edid, PNODE node)
 	}
 }
 
-static void DecodeSupportedFeatures(const BYTE* edid, PNODE node, struct MONITOR_INFO* mi)
+static void DecodeSupportedFeatures(const BYTE* edid, PNODE node, UINT16 ver)
 {
 	PNODE feat = NWL_NodeAppendNew(node, "Supported Features", NFLG_ATTGROUP);
 
@@ -536,7 +368,7 @@ static void DecodeSupportedFeatures(const BYTE* edid, PNODE node, struct MONITOR
 	if (features & 0x02)
 	{
 		// For EDID 1.3+, this bit has a more specific meaning.
-		NWL_NodeAttrSet(feat, "Preferred Timing Mode", (mi->Ver >= 0x0103) ?
+		NWL_NodeAttrSet(feat, "Preferred Timing Mode", (ver >= 0x0103) ?
 			"Includes native pixel format and refresh rate (DTD 1)" :
 			"Specified in Descriptor Block 1", 0);
 	}
@@ -655,100 +487,172 @@ static void DecodeEstablishedTimings(const BYTE* edid, PNODE node)
 	}
 }
 
-static void DecodeEdid(const BYTE* edidData, DWORD edidSize, PNODE nm, const WCHAR* hwId)
+static const char*
+GetExtensionName(BYTE tag)
 {
-	struct MONITOR_INFO mi = { 0 };
-	// An EDID block must be at least 128 bytes.
-	if (edidSize < 128)
-		return;
+	switch (tag)
+	{
+	case 0x02: return "CTA-861";
+	case 0x10: return "Video Timing Block";
+	case 0x20: return "EDID 2.0";
+	case 0x40: return "Display Information";
+	case 0x50: return "Localized String";
+	case 0x60: return "Digital Packet Video Link";
+	case 0x70: return "DisplayID";
+	case 0xA7:
+	case 0xAF:
+	case 0xBF: return "Display Transfer Characteristics";
+	case 0xF0: return "Block Map";
+	case 0xFF: return "Manufacturer Defined";
+	}
+	return "Unknown";
+}
+
+static const char*
+GetCtaBlockName(BYTE tag)
+{
+	switch (tag)
+	{
+	case 1: return "Audio";
+	case 2: return "Video";
+	case 3: return "Vendor-Specific";
+	case 4: return "Speaker Allocation";
+	case 5: return "VESA Display Transfer Characteristic";
+	case 7: return "Extended";
+	}
+	return "Reserved";
+}
 
-	// Verify checksum of the base block. The sum of all 128 bytes must be a multiple of 256.
-	BYTE checksum = 0;
-	for (int i = 0; i < 128; ++i)
-		checksum += edidData[i];
-	if (checksum != 0)
+static void PrintCtaExtension(const NWL_EDID_EXT* e, PNODE node)
+{
+	NWL_NodeAttrSetf(node, "Revision", NAFLG_FMT_NUMERIC, "%u", e->Revision);
+	if (e->Revision >= 2)
 	{
-		NWL_NodeAppendMultiSz(&NWLC->ErrLog, "Invalid EDID checksum");
+		NWL_NodeAttrSetBool(node, "Underscan", e->Support & 0x80, 0);
+		NWL_NodeAttrSetBool(node, "Basic Audio", e->Support & 0x40, 0);
+		NWL_NodeAttrSetBool(node, "YCbCr 4:4:4", e->Support & 0x20, 0);
+		NWL_NodeAttrSetBool(node, "YCbCr 4:2:2", e->Support & 0x10, 0);
+		NWL_NodeAttrSetf(node, "Native DTDs", NAFLG_FMT_NUMERIC, "%u", e->Support & 0x0F);
+	}
+	if (e->DtdOffset < 4 || e->DtdOffset > 127)
 		return;
+
+	if (e->Revision >= 3 && e->DtdOffset > 4)
+	{
+		PNODE blks = NWL_NodeAppendNew(node, "Data Blocks", NFLG_TABLE);
+		for (uint32_t i = 0; i < e->BlockCount; i++)
+		{
+			const NWL_EDID_CTA_BLOCK* b = &e->Blocks[i];
+			PNODE db = NWL_NodeAppendNew(blks, "Data Block", NFLG_TABLE_ROW);
+			NWL_NodeAttrSet(db, "Type", GetCtaBlockName(b->Tag), 0);
+			NWL_NodeAttrSetf(db, "Length", NAFLG_FMT_NUMERIC, "%u", b->Length);
+			if (b->Tag == 2)
+				NWL_NodeAttrSetf(db, "Video Descriptors", NAFLG_FMT_NUMERIC, "%u", b->Length);
+			else if (b->Tag == 3 && b->Length >= 3)
+				NWL_NodeAttrSetf(db, "IEEE OUI", 0, "%02X%02X%02X", b->Oui[2], b->Oui[1], b->Oui[0]);
+			else if (b->Tag == 7 && b->Length >= 1)
+				NWL_NodeAttrSetf(db, "Extended Tag", NAFLG_FMT_NUMERIC, "%u", b->ExtTag);
+		}
 	}
 
-	// Manufacturer Info
-	char vendorId[4];
-	vendorId[0] = ((edidData[8] >> 2) & 0x1F) + 'A' - 1;
-	vendorId[1] = (((edidData[8] & 0x03) << 3) | ((edidData[9] >> 5) & 0x07)) + 'A' - 1;
-	vendorId[2] = (edidData[9] & 0x1F) + 'A' - 1;
-	vendorId[3] = '\0';
-	int productCode = (edidData[11] << 8) | edidData[10];
+	PNODE desc = NWL_NodeAppendNew(node, "Descriptor Blocks", NFLG_TABLE);
+	for (uint32_t i = 0; i < e->DtdCount; i++)
+		PrintDetailedTimingDescriptor(&e->Dtds[i], desc);
+}
 
-	// Serial Number (binary)
-	DWORD serialNumber = (edidData[15] << 24) | (edidData[14] << 16) | (edidData[13] << 8) | edidData[12];
+static void PrintExtensionBlocks(const NWL_EDID* edid, PNODE nm)
+{
+	NWL_NodeAttrSetf(nm, "EDID Extension Blocks", NAFLG_FMT_NUMERIC, "%u", edid->ExtDeclared);
+	if (edid->ExtDeclared == 0)
+		return;
 
-	// Manufacture Date
-	int week = edidData[16];
-	int year = edidData[17] + 1990;
+	PNODE exts = NWL_NodeAppendNew(nm, "Extension Blocks", NFLG_TABLE);
+	for (uint32_t i = 0; i < edid->ExtCount; i++)
+	{
+		const NWL_EDID_EXT* e = &edid->Ext[i];
+		PNODE en = NWL_NodeAppendNew(exts, "Extension Block", NFLG_TABLE_ROW);
+		NWL_NodeAttrSet(en, "Type", GetExtensionName(e->Tag), 0);
+		NWL_NodeAttrSetf(en, "Tag", 0, "0x%02X", e->Tag);
+		NWL_NodeAttrSetBool(en, "Checksum Valid", e->ChecksumValid, 0);
+		if (e->ChecksumValid && e->Tag == 0x02)
+			PrintCtaExtension(e, en);
+	}
+}
 
-	// EDID Version
-	int edidMajor = edidData[18];
-	int edidMinor = edidData[19];
+// Errors stay with the Monitor row of the EDID they came from,
+// so a dump with many EDIDs does not grow the global ErrLog.
+static void SetEdidErrors(PNODE nm, UINT32 errors)
+{
+	char* list = NULL;
+	if (errors & NWL_EDID_ERR_TRUNCATED)
+		NWL_NodeAppendMultiSz(&list, "Truncated EDID data");
+	if (errors & NWL_EDID_ERR_CHECKSUM)
+		NWL_NodeAppendMultiSz(&list, "Invalid EDID checksum");
+	if (errors & NWL_EDID_ERR_TIMING)
+		NWL_NodeAppendMultiSz(&list, "Invalid timing data");
+	if (errors & NWL_EDID_ERR_CTA_OFFSET)
+		NWL_NodeAppendMultiSz(&list, "Invalid CTA-861 DTD offset");
+	if (errors & NWL_EDID_ERR_CTA_TRUNCATED)
+		NWL_NodeAppendMultiSz(&list, "Truncated CTA-861 data block");
+	if (!list)
+		return;
+	NWL_NodeAttrSetMulti(nm, "Errors", list, 0);
+	free(list);
+}
 
-	mi.Ver = (edidMajor << 8) | edidMinor;
-	mi.Width = 10ULL * edidData[21];
-	mi.Height = 10ULL * edidData[22];
-	snprintf(mi.Serial, sizeof(mi.Serial), "%08X", serialNumber);
+static BOOL DecodeEdid(const BYTE* edidData, DWORD edidSize, PNODE nm, const WCHAR* hwId)
+{
+	NWL_EDID edid;
+	BOOL valid = NWL_EdidParse(edidData, edidSize, &edid) ? TRUE : FALSE;
+	SetEdidErrors(nm, edid.Errors);
+	if (!valid)
+		goto out;
 
 	NWL_NodeAttrSet(nm, "HWID", NWL_Ucs2ToUtf8(hwId), 0);
-	NWL_NodeAttrSetf(nm, "ID", 0, "%s%04X", vendorId, productCode);
-	NWL_GetPnpManufacturer(nm, &NWLC->NwPnpIds, vendorId);
-	NWL_NodeAttrSetf(nm, "EDID Version", 0, "%d.%d", edidMajor, edidMinor);
+	NWL_NodeAttrSetf(nm, "ID", 0, "%s%04X", edid.Vendor, edid.ProductCode);
+	NWL_GetPnpManufacturer(nm, &NWLC->NwPnpIds, edid.Vendor);
+	NWL_NodeAttrSetf(nm, "EDID Version", 0, "%u.%u", edid.VerMajor, edid.VerMinor);
 
-	if (week > 0 && week <= 54)
-		NWL_NodeAttrSetf(nm, "Date", 0, "%d, Week %d", year, week);
+	if (edid.Week > 0 && edid.Week <= 54)
+		NWL_NodeAttrSetf(nm, "Date", 0, "%d, Week %d", edid.Year, edid.Week);
 
 	// Parse video input parameters
-	DecodeVideoInput(edidData, nm);
+	DecodeVideoInput(edid.Base, nm);
 
 	// Parse gamma - 0xff means gamma is defined by DI-EXT block.
-	if (edidData[23] != 0xFF)
+	if (edid.Base[23] != 0xFF)
 	{
 		// Formula: gamma = (datavalue + 100) / 100
 		// To print with two decimal places using integers:
-		int gammaTimes100 = 100 + edidData[23];
+		int gammaTimes100 = 100 + edid.Base[23];
 		NWL_NodeAttrSetf(nm, "Gamma", NAFLG_FMT_NUMERIC, "%d.%02d", gammaTimes100 / 100, gammaTimes100 % 100);
 	}
 
-	// Parse supported features bitmap
-	DecodeSupportedFeatures(edidData, nm, &mi);
-
-	// Parse chromaticity coordinates
-	DecodeChromaticity(edidData, nm);
-
-	// Parse established timings
-	DecodeEstablishedTimings(edidData, nm);
-
-	// Parse timings to find max resolution
-	DecodeStandardTimings(edidData, nm, &mi);
-
-	// Parse descriptors to find max resolution
-	DecodeDescriptorBlocks(edidData, nm, &mi);
+	DecodeSupportedFeatures(edid.Base, nm, edid.Ver);
+	DecodeChromaticity(edid.Base, nm);
+	DecodeEstablishedTimings(edid.Base, nm);
+	PrintStandardTimings(&edid, nm);
+	PrintDescriptorBlocks(&edid, nm);
+	PrintExtensionBlocks(&edid, nm);
 
-	NWL_NodeAttrSet(nm, "Display Name", mi.Name, 0);
-	NWL_NodeAttrSet(nm, "Serial Number", mi.Serial, NAFLG_FMT_SENSITIVE);
+	NWL_NodeAttrSet(nm, "Display Name", edid.Name, 0);
+	NWL_NodeAttrSet(nm, "Serial Number", edid.Serial, NAFLG_FMT_SENSITIVE);
 
-	if (mi.XRes > 0 && mi.YRes > 0)
+	if (edid.XRes > 0 && edid.YRes > 0)
 	{
 		NWL_NodeAttrSetf(nm, "Max Resolution", 0, "%llux%llu",
-			(unsigned long long)mi.XRes, (unsigned long long)mi.YRes);
-		NWL_NodeAttrSetf(nm, "Max Refresh Rate (Hz)", NAFLG_FMT_NUMERIC, "%.2f", mi.Freq);
-		UINT64 commonDivisor = GetGcd(mi.XRes, mi.YRes);
+			(unsigned long long)edid.XRes, (unsigned long long)edid.YRes);
+		NWL_NodeAttrSetf(nm, "Max Refresh Rate (Hz)", NAFLG_FMT_NUMERIC, "%.2f", edid.Freq);
+		UINT64 commonDivisor = GetGcd(edid.XRes, edid.YRes);
 		NWL_NodeAttrSetf(nm, "Aspect Ratio", 0, "%llu:%llu",
-			(unsigned long long)mi.XRes / commonDivisor, (unsigned long long)mi.YRes / commonDivisor);
+			(unsigned long long)edid.XRes / commonDivisor, (unsigned long long)edid.YRes / commonDivisor);
 	}
 
-	if (mi.Width > 0 && mi.Height > 0)
+	if (edid.Width > 0 && edid.Height > 0)
 	{
-		NWL_NodeAttrSetf(nm, "Width (cm)", NAFLG_FMT_NUMERIC, "%.1f", mi.Width / 10.0);
-		NWL_NodeAttrSetf(nm, "Height (cm)", NAFLG_FMT_NUMERIC, "%.1f", mi.Height / 10.0);
-		UINT64 diagonalSq = (mi.Width * mi.Width) + (mi.Height * mi.Height);
+		NWL_NodeAttrSetf(nm, "Width (cm)", NAFLG_FMT_NUMERIC, "%.1f", edid.Width / 10.0);
+		NWL_NodeAttrSetf(nm, "Height (cm)", NAFLG_FMT_NUMERIC, "%.1f", edid.Height / 10.0);
+		UINT64 diagonalSq = (edid.Width * edid.Width) + (edid.Height * edid.Height);
 		// Convert mm to inches (1 inch = 25.4 mm).
 #ifdef USE_MATH_SQRT
 		double diagonal = sqrt((double)diagonalSq) / 25.4;
@@ -760,13 +664,73 @@ static void DecodeEdid(const BYTE* edidData, DWORD edidSize, PNODE nm, const WCH
 			(unsigned long long)inchesTimes100 / 100, (unsigned long long)inchesTimes100 % 100);
 #endif
 	}
+out:
+	NWL_EdidFree(&edid);
+	return valid;
+}
+
+/**
+ * @brief Decodes every EDID in a dump, each into its own Monitor row.
+ *
+ * A dump without any EDID header is decoded as a single EDID.
+ */
+static void DecodeEdidDump(PNODE node, const BYTE* data, DWORD size, LPCSTR source)
+{
+	size_t offset = 0;
+	size_t length = 0;
+	DWORD index = 0;
+	if (!NWL_EdidFind(data, size, &offset, &length))
+	{
+		PNODE nm = NWL_NodeAppendNew(node, "Monitor", NFLG_TABLE_ROW);
+		NWL_NodeAttrSet(nm, "Source", source, 0);
+		NWL_NodeAttrSetf(nm, "Index", NAFLG_FMT_NUMERIC, "%lu", index);
+		NWL_NodeAttrSetBool(nm, "Valid", DecodeEdid(data, size, nm, L"FILE"), 0);
+		return;
+	}
 
-	// Check for extension blocks
-	int extensionBlocks = edidData[126];
-	NWL_NodeAttrSetf(nm, "EDID Extension Blocks", NAFLG_FMT_NUMERIC, "%d", extensionBlocks);
-	if (extensionBlocks > 0 && edidSize < (DWORD)(128 * (extensionBlocks + 1)))
-		NWL_NodeAppendMultiSz(&NWLC->ErrLog, "Truncated EDID data");
-	// Note: Parsing of extension blocks (e.g., CTA-861) is not implemented here.
+	do
+	{
+		PNODE nm = NWL_NodeAppendNew(node, "Monitor", NFLG_TABLE_ROW);
+		NWL_NodeAttrSet(nm, "Source", source, 0);
+		NWL_NodeAttrSetf(nm, "Index", NAFLG_FMT_NUMERIC, "%lu", index++);
+		NWL_NodeAttrSetf(nm, "Offset", NAFLG_FMT_NUMERIC, "%lu", (DWORD)offset);
+		NWL_NodeAttrSetBool(nm, "Valid", DecodeEdid(data + offset, (DWORD)length, nm, L"FILE"), 0);
+		offset += length;
+	} while (NWL_EdidFind(data, size, &offset, &length));
+}
+
+static void DecodeEdidFile(PNODE node, LPCSTR path, LPCSTR source)
+{
+	DWORD edidSize = 0;
+	PBYTE edidData = NWL_LoadDump(path, NWL_EDID_HEADER_SIZE, &edidSize);
+	if (edidData)
+	{
+		DecodeEdidDump(node, edidData, edidSize, source);
+		free(edidData);
+	}
+}
+
+static void DecodeEdidDir(PNODE node, LPCSTR dir)
+{
+	WIN32_FIND_DATAA fd;
+	CHAR path[MAX_PATH];
+	snprintf(path, MAX_PATH, "%s\\*", dir);
+	HANDLE hFind = FindFirstFileA(path, &fd);
+	if (hFind == INVALID_HANDLE_VALUE)
+	{
+		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s open failed", dir);
+		NWL_NodeAppendMultiSz(&NWLC->ErrLog, NWLC->NwBuf);
+		return;
+	}
+	do
+	{
+		if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			continue;
+		if (snprintf(path, MAX_PATH, "%s\\%s", dir, fd.cFileName) >= MAX_PATH)
+			continue;
+		DecodeEdidFile(node, path, fd.cFileName);
+	} while (FindNextFileA(hFind, &fd));
+	FindClose(hFind);
 }
 
 static BOOL
@@ -914,14 +878,11 @@ PNODE NW_Edid(BOOL bAppend)
 
 	if (NWLC->EdidDump)
 	{
-		DWORD edidSize = 0;
-		PBYTE edidData = NWL_LoadDump(NWLC->EdidDump, 128, &edidSize);
-		if (edidData)
-		{
-			PNODE nm = NWL_NodeAppendNew(node, "Monitor", NFLG_TABLE_ROW);
-			DecodeEdid(edidData, edidSize, nm, L"FILE");
-			free(edidData);
-		}
+		DWORD attr = GetFileAttributesA(NWLC->EdidDump);
+		if (attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY))
+			DecodeEdidDir(node, NWLC->EdidDump);
+		else
+			DecodeEdidFile(node, NWLC->EdidDump, NWLC->EdidDump);
 		return node;
 	}
 
@@ -42,6 +42,8 @@ extern const DEVPROPKEY DEVPKEY_DeviceClass_ClassName;
 #endif
 
 static HMODULE m_drvstore_dll = NULL;
+// Open handles, the DLL is unloaded when the last one is closed.
+static LONG m_drvstore_refs = 0;
 
 HDRVSTORE
 NWL_DriverStoreOpen(LPCSTR Drive, DWORD Flags)
@@ -89,10 +91,14 @@ NWL_DriverStoreOpen(LPCSTR Drive, DWORD Flags)
 	HDRVSTORE ret = pfnDriverStoreOpen(targetSystemPath, targetBootDrive, Flags, NULL);
 	if (ret == NULL || ret == INVALID_HANDLE_VALUE)
 		goto fail;
+	m_drvstore_refs++;
 	return ret;
 fail:
-	FreeLibrary(m_drvstore_dll);
-	m_drvstore_dll = NULL;
+	if (m_drvstore_refs == 0)
+	{
+		FreeLibrary(m_drvstore_dll);
+		m_drvstore_dll = NULL;
+	}
 	return NULL;
 }
 
@@ -107,8 +113,11 @@ NWL_DriverStoreClose(HDRVSTORE DriverStoreHandle)
 	if (!pfnDriverStoreClose)
 		return FALSE;
 	BOOL result = pfnDriverStoreClose(DriverStoreHandle);
-	FreeLibrary(m_drvstore_dll);
-	m_drvstore_dll = NULL;
+	if (--m_drvstore_refs == 0)
+	{
+		FreeLibrary(m_drvstore_dll);
+		m_drvstore_dll = NULL;
+	}
 	return result;
 }
 
@@ -373,102 +382,94 @@ NWL_DriverStoreCopy(HDRVSTORE DriverStoreHandle, LPCWSTR DriverPackageFilename,
 		ProcessorArchitecture, LocaleName, Flags, DestinationPath);
 }
 
-PNODE_ATT
-NWL_DrvStoreSetProperty(PNODE node, HDRVSTORE hDrvStore, DWORD objType, LPCWSTR objName, LPCSTR name, const DEVPROPKEY* propKey)
+static PNODE_ATT
+SetPropertyValue(PNODE node, LPCSTR name, const DEVPROPKEY* propKey, DEVPROPTYPE propType, const BYTE* data, DWORD size)
 {
-	DEVPROPTYPE propType = DEVPROP_TYPE_EMPTY;
-	DWORD propSize = 0;
 	PNODE_ATT ret = NULL;
 
-	NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName, propKey, &propType, NULL, 0, &propSize, 0);
-	if (propSize == 0)
-		return NULL;
-
+	// Strings are NUL padded by the caller, fixed size values are copied
+	// out first since data may live in NWLC->NwBuf.
 	switch (propType)
 	{
 	case DEVPROP_TYPE_STRING:
 	case DEVPROP_TYPE_STRING_INDIRECT:
-		ZeroMemory(NWLC->NwBuf, NWINFO_BUFSZ);
-		if (NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName,
-			propKey, &propType, (PBYTE)NWLC->NwBuf, NWINFO_BUFSZ, &propSize, 0))
-			ret = NWL_NodeAttrSet(node, name, NWL_Ucs2ToUtf8(NWLC->NwBufW), 0);
+		ret = NWL_NodeAttrSet(node, name, NWL_Ucs2ToUtf8((LPCWSTR)data), 0);
 		break;
 	case DEVPROP_TYPE_STRING_LIST:
-		ZeroMemory(NWLC->NwBuf, NWINFO_BUFSZ);
-		if (NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName,
-			propKey, &propType, (PBYTE)NWLC->NwBuf, NWINFO_BUFSZ, &propSize, 0))
+	{
+		LPSTR ms = NULL;
+		for (LPCWSTR p = (LPCWSTR)data; *p; p += wcslen(p) + 1)
+			NWL_NodeAppendMultiSz(&ms, NWL_Ucs2ToUtf8(p));
+		if (ms)
 		{
-			LPSTR ms = NULL;
-			for (LPCWSTR p = NWLC->NwBufW; *p; p += wcslen(p) + 1)
-				NWL_NodeAppendMultiSz(&ms, NWL_Ucs2ToUtf8(p));
-			if (ms)
-			{
-				ret = NWL_NodeAttrSetMulti(node, name, ms, 0);
-				free(ms);
-			}
+			ret = NWL_NodeAttrSetMulti(node, name, ms, 0);
+			free(ms);
 		}
 		break;
+	}
 	case DEVPROP_TYPE_GUID:
 	{
 		GUID guid;
-		if (NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName,
-			propKey, &propType, (PBYTE)&guid, sizeof(GUID), &propSize, 0))
-			ret = NWL_NodeAttrSet(node, name, NWL_WinGuidToStr(TRUE, &guid), NAFLG_FMT_GUID);
+		if (size < sizeof(GUID))
+			break;
+		memcpy(&guid, data, sizeof(GUID));
+		ret = NWL_NodeAttrSet(node, name, NWL_WinGuidToStr(TRUE, &guid), NAFLG_FMT_GUID);
 		break;
 	}
 	case DEVPROP_TYPE_BOOLEAN:
 	{
 		DEVPROP_BOOLEAN value;
-		if (NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName,
-			propKey, &propType, (PBYTE)&value, sizeof(DEVPROP_BOOLEAN), &propSize, 0))
-			ret = NWL_NodeAttrSetBool(node, name, value, 0);
+		if (size < sizeof(DEVPROP_BOOLEAN))
+			break;
+		memcpy(&value, data, sizeof(DEVPROP_BOOLEAN));
+		ret = NWL_NodeAttrSetBool(node, name, value, 0);
 		break;
 	}
 	case DEVPROP_TYPE_UINT16:
 	{
 		UINT16 value;
-		if (NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName,
-			propKey, &propType, (PBYTE)&value, sizeof(UINT16), &propSize, 0))
-			ret = NWL_NodeAttrSetf(node, name, NAFLG_FMT_NUMERIC, "%u", value);
+		if (size < sizeof(UINT16))
+			break;
+		memcpy(&value, data, sizeof(UINT16));
+		ret = NWL_NodeAttrSetf(node, name, NAFLG_FMT_NUMERIC, "%u", value);
 		break;
 	}
 	case DEVPROP_TYPE_UINT32:
 	{
 		UINT32 value;
-		if (NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName,
-			propKey, &propType, (PBYTE)&value, sizeof(UINT32), &propSize, 0))
-			ret = NWL_NodeAttrSetf(node, name, NAFLG_FMT_NUMERIC, "%u", value);
+		if (size < sizeof(UINT32))
+			break;
+		memcpy(&value, data, sizeof(UINT32));
+		ret = NWL_NodeAttrSetf(node, name, NAFLG_FMT_NUMERIC, "%u", value);
 		break;
 	}
 	case DEVPROP_TYPE_UINT64:
 	{
 		UINT64 value;
-		if (NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName,
-			propKey, &propType, (PBYTE)&value, sizeof(UINT64), &propSize, 0))
+		if (size < sizeof(UINT64))
+			break;
+		memcpy(&value, data, sizeof(UINT64));
+		if (memcmp(propKey, &DEVPKEY_DriverPackage_DriverVersion, sizeof(DEVPROPKEY)) == 0)
 		{
-			if (memcmp(propKey, &DEVPKEY_DriverPackage_DriverVersion, sizeof(DEVPROPKEY)) == 0)
-			{
-				ret = NWL_NodeAttrSetf(node, name, 0, "%u.%u.%u.%u",
-					(UINT)((value >> 48) & 0xffff),
-					(UINT)((value >> 32) & 0xffff),
-					(UINT)((value >> 16) & 0xffff),
-					(UINT)(value & 0xffff));
-			}
-			else
-				ret = NWL_NodeAttrSetf(node, name, NAFLG_FMT_NUMERIC, "%llu", value);
+			ret = NWL_NodeAttrSetf(node, name, 0, "%u.%u.%u.%u",
+				(UINT)((value >> 48) & 0xffff),
+				(UINT)((value >> 32) & 0xffff),
+				(UINT)((value >> 16) & 0xffff),
+				(UINT)(value & 0xffff));
 		}
+		else
+			ret = NWL_NodeAttrSetf(node, name, NAFLG_FMT_NUMERIC, "%llu", value);
 		break;
 	}
 	case DEVPROP_TYPE_FILETIME:
 	{
 		FILETIME value;
-		if (NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName,
-			propKey, &propType, (PBYTE)&value, sizeof(FILETIME), &propSize, 0))
-		{
-			SYSTEMTIME sysTime;
-			if (FileTimeToSystemTime(&value, &sysTime))
-				ret = NWL_NodeAttrSetf(node, name, 0, "%04u-%02u-%02u", sysTime.wYear, sysTime.wMonth, sysTime.wDay);
-		}
+		SYSTEMTIME sysTime;
+		if (size < sizeof(FILETIME))
+			break;
+		memcpy(&value, data, sizeof(FILETIME));
+		if (FileTimeToSystemTime(&value, &sysTime))
+			ret = NWL_NodeAttrSetf(node, name, 0, "%04u-%02u-%02u", sysTime.wYear, sysTime.wMonth, sysTime.wDay);
 		break;
 	}
 	default:
@@ -477,70 +478,332 @@ NWL_DrvStoreSetProperty(PNODE node, HDRVSTORE hDrvStore, DWORD objType, LPCWSTR
 	return ret;
 }
 
-static BOOL CALLBACK
-DrvStoreEnumPackages(HDRVSTORE hDrvStore, LPCWSTR drvStorePath,
-	PDRIVER_PACKAGE_INFO pkgInfo, LPARAM context)
+PNODE_ATT
+NWL_DrvStoreSetProperty(PNODE node, HDRVSTORE hDrvStore, DWORD objType, LPCWSTR objName, LPCSTR name, const DEVPROPKEY* propKey)
+{
+	DEVPROPTYPE propType = DEVPROP_TYPE_EMPTY;
+	DWORD propSize = 0;
+
+	NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName, propKey, &propType, NULL, 0, &propSize, 0);
+	if (propSize == 0 || propSize > NWINFO_BUFSZ - 2 * sizeof(WCHAR))
+		return NULL;
+
+	ZeroMemory(NWLC->NwBuf, NWINFO_BUFSZ);
+	if (!NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName,
+		propKey, &propType, (PBYTE)NWLC->NwBuf, propSize, &propSize, 0))
+		return NULL;
+	return SetPropertyValue(node, name, propKey, propType, (const BYTE*)NWLC->NwBuf, propSize);
+}
+
+// Package discovery runs in the DriverStoreEnum callback on the calling
+// thread. Property reads for up to DRVSTORE_WINDOW packages run on a small
+// worker pool, and finished packages are turned into nodes on the calling
+// thread in discovery order, so the output matches a serial walk.
+// A driver store handle is not safe to share between threads, so every
+// worker reads through a store of its own.
+
+#define DRVSTORE_WORKERS 4
+#define DRVSTORE_WINDOW 64
+
+enum
+{
+	DRV_PROP_PRODUCT_NAME = 0,
+	DRV_PROP_PACKAGE_ID,
+	DRV_PROP_INF_NAME,
+	DRV_PROP_ORIGINAL_INF_NAME,
+	DRV_PROP_PROVIDER,
+	DRV_PROP_VERSION,
+	DRV_PROP_DATE,
+	DRV_PROP_CLASS_GUID,
+	DRV_PROP_SIGNER,
+	DRV_PROP_CATALOG,
+	DRV_PROP_IMPORT_DATE,
+	DRV_PROP_PRIMITIVE,
+	DRV_PROP_CLASS_NAME, // from the DeviceSetupClass object
+	DRV_PROP_COUNT
+};
+
+static const DEVPROPKEY* const m_drv_prop_keys[DRV_PROP_COUNT] =
+{
+	&DEVPKEY_DriverPackage_ProductName,
+	&DEVPKEY_DriverPackage_DriverPackageId,
+	&DEVPKEY_DriverPackage_DriverInfName,
+	&DEVPKEY_DriverPackage_OriginalInfName,
+	&DEVPKEY_DriverPackage_ProviderName,
+	&DEVPKEY_DriverPackage_DriverVersion,
+	&DEVPKEY_DriverPackage_DriverDate,
+	&DEVPKEY_DriverPackage_ClassGuid,
+	&DEVPKEY_DriverPackage_SignerName,
+	&DEVPKEY_DriverPackage_CatalogFile,
+	&DEVPKEY_DriverPackage_ImportDate,
+	&DEVPKEY_DriverPackage_Primitive,
+	&DEVPKEY_DeviceClass_ClassName,
+};
+
+enum
+{
+	DRV_PKG_FREE = 0,
+	DRV_PKG_QUEUED,
+	DRV_PKG_DONE,
+};
+
+typedef struct
+{
+	DEVPROPTYPE Type;
+	DWORD Offset;
+	DWORD Size; // 0 if the property is missing
+} DRV_PROP;
+
+typedef struct
+{
+	volatile LONG State;
+	LPWSTR Path;
+	WCHAR PublishedInfName[MAX_PATH];
+	DWORD Flags;
+	DRV_PROP Props[DRV_PROP_COUNT];
+	// Raw property values, kept across packages so a slot allocates only
+	// until it has seen its largest package.
+	BYTE* Data;
+	DWORD DataSize;
+	DWORD DataUsed;
+} DRV_PKG;
+
+typedef struct
+{
+	HDRVSTORE Store;
+	PNODE Root;
+	BOOL Stream;
+	HANDLE Queued; // semaphore, one count per queued package or worker stop
+	HANDLE Done; // auto-reset, set when any package finishes
+	volatile LONG Count; // packages discovered
+	volatile LONG Taken; // packages claimed by readers
+	LONG Emitted; // packages turned into nodes
+	DRV_PKG Slots[DRVSTORE_WINDOW];
+} DRV_PIPELINE;
+
+typedef struct
+{
+	DRV_PIPELINE* Pipeline;
+	HDRVSTORE Store;
+} DRV_READER;
+
+static void
+ReadPackageProperty(HDRVSTORE hDrvStore, DWORD objType, LPCWSTR objName, DRV_PKG* pkg, int id)
+{
+	DRV_PROP* prop = &pkg->Props[id];
+	DEVPROPTYPE propType = DEVPROP_TYPE_EMPTY;
+	DWORD propSize = 0;
+	DWORD need;
+
+	prop->Size = 0;
+	NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName, m_drv_prop_keys[id], &propType, NULL, 0, &propSize, 0);
+	if (propSize == 0)
+		return;
+
+	// Two extra NULs terminate strings and string lists, offsets stay 8 byte aligned.
+	need = (propSize + 2 * sizeof(WCHAR) + 7) & ~7UL;
+	if (pkg->DataUsed + need > pkg->DataSize)
+	{
+		DWORD newSize = max(pkg->DataSize * 2, pkg->DataUsed + need);
+		BYTE* newData = realloc(pkg->Data, newSize);
+		if (newData == NULL)
+			return;
+		pkg->Data = newData;
+		pkg->DataSize = newSize;
+	}
+	ZeroMemory(pkg->Data + pkg->DataUsed, need);
+	if (!NWL_DriverStoreGetObjectProperty(hDrvStore, objType, objName, m_drv_prop_keys[id],
+		&propType, pkg->Data + pkg->DataUsed, propSize, &propSize, 0))
+		return;
+	prop->Type = propType;
+	prop->Offset = pkg->DataUsed;
+	prop->Size = propSize;
+	pkg->DataUsed += need;
+}
+
+static void
+ReadPackage(HDRVSTORE hDrvStore, DRV_PKG* pkg)
 {
-	PNODE root = (PNODE)context;
-	PNODE node = NWL_NodeAlloc("Driver", NFLG_TABLE_ROW);
+	DRV_PROP* guid = &pkg->Props[DRV_PROP_CLASS_GUID];
+
+	pkg->DataUsed = 0;
+	for (int i = 0; i < DRV_PROP_CLASS_NAME; i++)
+		ReadPackageProperty(hDrvStore, DriverPackage, pkg->Path, pkg, i);
+
+	pkg->Props[DRV_PROP_CLASS_NAME].Size = 0;
+	if (guid->Size >= sizeof(GUID) && guid->Type == DEVPROP_TYPE_GUID)
+	{
+		GUID classGuid;
+		WCHAR className[39];
+		memcpy(&classGuid, pkg->Data + guid->Offset, sizeof(GUID));
+		swprintf(className, ARRAYSIZE(className), L"{%08lX-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X}",
+			classGuid.Data1, classGuid.Data2, classGuid.Data3,
+			classGuid.Data4[0], classGuid.Data4[1], classGuid.Data4[2], classGuid.Data4[3],
+			classGuid.Data4[4], classGuid.Data4[5], classGuid.Data4[6], classGuid.Data4[7]);
+		ReadPackageProperty(hDrvStore, DeviceSetupClass, className, pkg, DRV_PROP_CLASS_NAME);
+	}
+}
+
+// Claim and read one queued package. Returns FALSE on timeout or when a
+// stop count was taken.
+static BOOL
+ReadNextPackage(DRV_PIPELINE* pipeline, HDRVSTORE hDrvStore, DWORD dwTimeout)
+{
+	LONG i;
+	DRV_PKG* pkg;
+
+	if (WaitForSingleObject(pipeline->Queued, dwTimeout) != WAIT_OBJECT_0)
+		return FALSE;
+	i = InterlockedIncrement(&pipeline->Taken) - 1;
+	if (i >= pipeline->Count)
+		return FALSE;
+	pkg = &pipeline->Slots[i % DRVSTORE_WINDOW];
+	ReadPackage(hDrvStore, pkg);
+	InterlockedExchange(&pkg->State, DRV_PKG_DONE);
+	SetEvent(pipeline->Done);
+	return TRUE;
+}
+
+static DWORD WINAPI
+ReadWorker(LPVOID lpParameter)
+{
+	DRV_READER* reader = lpParameter;
+	while (ReadNextPackage(reader->Pipeline, reader->Store, INFINITE))
+		;
+	return 0;
+}
+
+static PNODE_ATT
+SetPackageProperty(PNODE node, const DRV_PKG* pkg, LPCSTR name, int id)
+{
+	const DRV_PROP* prop = &pkg->Props[id];
+	if (prop->Size == 0)
+		return NULL;
+	return SetPropertyValue(node, name, m_drv_prop_keys[id], prop->Type, pkg->Data + prop->Offset, prop->Size);
+}
+
+static void
+EmitPackage(DRV_PIPELINE* pipeline, DRV_PKG* pkg)
+{
+	PNODE node = NWL_NodeAlloc("Driver", pipeline->Stream ? 0 : NFLG_TABLE_ROW);
 	PNODE_ATT attr;
 
-	attr = NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Name", &DEVPKEY_DriverPackage_ProductName);
+	attr = SetPackageProperty(node, pkg, "Name", DRV_PROP_PRODUCT_NAME);
 	if (attr == NULL)
-		attr = NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Name", &DEVPKEY_DriverPackage_DriverPackageId);
+		attr = SetPackageProperty(node, pkg, "Name", DRV_PROP_PACKAGE_ID);
 	if (attr == NULL)
 	{
 		WCHAR name[MAX_PATH];
-		wcsncpy_s(name, ARRAYSIZE(name), PathFindFileNameW(drvStorePath), _TRUNCATE);
+		wcsncpy_s(name, ARRAYSIZE(name), PathFindFileNameW(pkg->Path), _TRUNCATE);
 		PathCchRemoveExtension(name, MAX_PATH);
 		NWL_NodeAttrSet(node, "Name", NWL_Ucs2ToUtf8(name), 0);
 	}
 
-	attr = NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Inf Name", &DEVPKEY_DriverPackage_DriverInfName);
+	attr = SetPackageProperty(node, pkg, "Inf Name", DRV_PROP_INF_NAME);
 	if (attr == NULL)
-		NWL_NodeAttrSet(node, "Inf Name", NWL_Ucs2ToUtf8(PathFindFileNameW(drvStorePath)), 0);
+		NWL_NodeAttrSet(node, "Inf Name", NWL_Ucs2ToUtf8(PathFindFileNameW(pkg->Path)), 0);
 
-	NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Original Inf Name", &DEVPKEY_DriverPackage_OriginalInfName);
-	if (pkgInfo->PublishedInfName[0])
-		NWL_NodeAttrSet(node, "Published Inf Name", NWL_Ucs2ToUtf8(pkgInfo->PublishedInfName), 0);
+	SetPackageProperty(node, pkg, "Original Inf Name", DRV_PROP_ORIGINAL_INF_NAME);
+	if (pkg->PublishedInfName[0])
+		NWL_NodeAttrSet(node, "Published Inf Name", NWL_Ucs2ToUtf8(pkg->PublishedInfName), 0);
 
-	NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Provider", &DEVPKEY_DriverPackage_ProviderName);
-	NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Version", &DEVPKEY_DriverPackage_DriverVersion);
-	NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Date", &DEVPKEY_DriverPackage_DriverDate);
+	SetPackageProperty(node, pkg, "Provider", DRV_PROP_PROVIDER);
+	SetPackageProperty(node, pkg, "Version", DRV_PROP_VERSION);
+	SetPackageProperty(node, pkg, "Date", DRV_PROP_DATE);
 
 	LPCSTR group_name = "Unknown";
 
-	attr = NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Class GUID", &DEVPKEY_DriverPackage_ClassGuid);
+	attr = SetPackageProperty(node, pkg, "Class GUID", DRV_PROP_CLASS_GUID);
 	if (attr)
 	{
 		group_name = attr->value;
-		attr = NWL_DrvStoreSetProperty(node, hDrvStore, DeviceSetupClass, NWL_Utf8ToUcs2(attr->value), "Type", &DEVPKEY_DeviceClass_ClassName);
+		attr = SetPackageProperty(node, pkg, "Type", DRV_PROP_CLASS_NAME);
 		if (attr)
 			group_name = attr->value;
 	}
 
-	PNODE group = NWL_NodeGetChild(root, group_name);
-	if (group == NULL)
-		group = NWL_NodeAppendNew(root, group_name, NFLG_TABLE);
-	NWL_NodeAppendChild(group, node);
-
-	NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Signer", &DEVPKEY_DriverPackage_SignerName);
-	NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Package ID", &DEVPKEY_DriverPackage_DriverPackageId);
-	NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Catalog", &DEVPKEY_DriverPackage_CatalogFile);
-	NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Import Date", &DEVPKEY_DriverPackage_ImportDate);
-	NWL_NodeAttrSetBool(node, "Inbox", pkgInfo->Flags & DRIVER_PACKAGE_INBOX, 0);
-	NWL_NodeAttrSetBool(node, "OEM", pkgInfo->Flags & DRIVER_PACKAGE_OEM, 0);
-	NWL_NodeAttrSetBool(node, "Published", pkgInfo->Flags & DRIVER_PACKAGE_PUBLISHED, 0);
-	NWL_NodeAttrSetBool(node, "F6", pkgInfo->Flags & DRIVER_PACKAGE_F6, 0);
-	NWL_NodeAttrSetBool(node, "Base Version", pkgInfo->Flags & DRIVER_PACKAGE_BASEVERSION, 0);
-	NWL_DrvStoreSetProperty(node, hDrvStore, DriverPackage, drvStorePath, "Primitive", &DEVPKEY_DriverPackage_Primitive);
-	NWL_NodeAttrSet(node, "Path", NWL_Ucs2ToUtf8(drvStorePath), 0);
+	if (!pipeline->Stream)
+	{
+		PNODE group = NWL_NodeGetChild(pipeline->Root, group_name);
+		if (group == NULL)
+			group = NWL_NodeAppendNew(pipeline->Root, group_name, NFLG_TABLE);
+		NWL_NodeAppendChild(group, node);
+	}
+
+	SetPackageProperty(node, pkg, "Signer", DRV_PROP_SIGNER);
+	SetPackageProperty(node, pkg, "Package ID", DRV_PROP_PACKAGE_ID);
+	SetPackageProperty(node, pkg, "Catalog", DRV_PROP_CATALOG);
+	SetPackageProperty(node, pkg, "Import Date", DRV_PROP_IMPORT_DATE);
+	NWL_NodeAttrSetBool(node, "Inbox", pkg->Flags & DRIVER_PACKAGE_INBOX, 0);
+	NWL_NodeAttrSetBool(node, "OEM", pkg->Flags & DRIVER_PACKAGE_OEM, 0);
+	NWL_NodeAttrSetBool(node, "Published", pkg->Flags & DRIVER_PACKAGE_PUBLISHED, 0);
+	NWL_NodeAttrSetBool(node, "F6", pkg->Flags & DRIVER_PACKAGE_F6, 0);
+	NWL_NodeAttrSetBool(node, "Base Version", pkg->Flags & DRIVER_PACKAGE_BASEVERSION, 0);
+	SetPackageProperty(node, pkg, "Primitive", DRV_PROP_PRIMITIVE);
+	NWL_NodeAttrSet(node, "Path", NWL_Ucs2ToUtf8(pkg->Path), 0);
+
+	if (pipeline->Stream)
+	{
+		NW_Export(node, NWLC->NwFile);
+		NWL_NodeFree(node, 1);
+	}
+
+	free(pkg->Path);
+	pkg->Path = NULL;
+	InterlockedExchange(&pkg->State, DRV_PKG_FREE);
+}
+
+// Emit finished packages in discovery order until no more than 'pending'
+// are in flight. The calling thread reads packages itself while it waits.
+static void
+DrainPackages(DRV_PIPELINE* pipeline, LONG pending)
+{
+	while (pipeline->Emitted < pipeline->Count)
+	{
+		DRV_PKG* pkg = &pipeline->Slots[pipeline->Emitted % DRVSTORE_WINDOW];
+		if (InterlockedCompareExchange(&pkg->State, DRV_PKG_DONE, DRV_PKG_DONE) != DRV_PKG_DONE)
+		{
+			if (pipeline->Count - pipeline->Emitted <= pending)
+				break;
+			if (!ReadNextPackage(pipeline, pipeline->Store, 0))
+				WaitForSingleObject(pipeline->Done, INFINITE);
+			continue;
+		}
+		EmitPackage(pipeline, pkg);
+		pipeline->Emitted++;
+	}
+}
+
+static BOOL CALLBACK
+DrvStoreEnumPackages(HDRVSTORE hDrvStore, LPCWSTR drvStorePath,
+	PDRIVER_PACKAGE_INFO pkgInfo, LPARAM context)
+{
+	DRV_PIPELINE* pipeline = (DRV_PIPELINE*)context;
+	DRV_PKG* pkg;
+
+	DrainPackages(pipeline, DRVSTORE_WINDOW - 1);
+
+	pkg = &pipeline->Slots[pipeline->Count % DRVSTORE_WINDOW];
+	pkg->Path = _wcsdup(drvStorePath);
+	if (pkg->Path == NULL)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	wcsncpy_s(pkg->PublishedInfName, ARRAYSIZE(pkg->PublishedInfName), pkgInfo->PublishedInfName, _TRUNCATE);
+	pkg->Flags = pkgInfo->Flags;
+	pkg->State = DRV_PKG_QUEUED;
+	InterlockedIncrement(&pipeline->Count);
+	ReleaseSemaphore(pipeline->Queued, 1, NULL);
+
+	DrainPackages(pipeline, DRVSTORE_WINDOW);
 	return TRUE;
 }
 
 PNODE NW_DrvStore(BOOL bAppend)
 {
 	PNODE node = NWL_NodeAlloc("DrvStore", 0);
+	DRV_PIPELINE* pipeline = NULL;
+	DRV_READER readers[DRVSTORE_WORKERS];
+	HANDLE hThreads[DRVSTORE_WORKERS];
+	DWORD dwThreads = 0;
 
 	if (bAppend)
 		NWL_NodeAppendChild(NWLC->NwRoot, node);
@@ -552,9 +815,68 @@ PNODE NW_DrvStore(BOOL bAppend)
 		return node;
 	}
 
-	if (!NWL_DriverStoreEnum(hDrvStore, DRIVERSTORE_ENUM_NONE, DrvStoreEnumPackages, (LPARAM)node))
+	pipeline = calloc(1, sizeof(DRV_PIPELINE));
+	if (pipeline == NULL)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	pipeline->Store = hDrvStore;
+	pipeline->Root = node;
+	// Only the command line report streams, cached service sections keep the tree.
+	// Other formats cannot be split into one document per package.
+	pipeline->Stream = bAppend && NWLC->DrvStoreStream &&
+		(NWLC->NwFormat == FORMAT_YAML || NWLC->NwFormat == FORMAT_JSON);
+	pipeline->Queued = CreateSemaphoreW(NULL, 0, DRVSTORE_WINDOW + DRVSTORE_WORKERS, NULL);
+	pipeline->Done = CreateEventW(NULL, FALSE, FALSE, NULL);
+	if (pipeline->Queued == NULL || pipeline->Done == NULL)
+	{
+		NWL_NodeAppendMultiSz(&NWLC->ErrLog, "DrvStore pipeline init failed");
+		goto out;
+	}
+
+	for (DWORD i = 0; i < DRVSTORE_WORKERS; i++)
+	{
+		DRV_READER* reader = &readers[dwThreads];
+		reader->Pipeline = pipeline;
+		reader->Store = NWL_DriverStoreOpen(NWLC->DrvStoreDrive, DRIVERSTORE_OPEN_NONE);
+		if (!reader->Store)
+			break;
+		hThreads[dwThreads] = CreateThread(NULL, 0, ReadWorker, reader, 0, NULL);
+		if (hThreads[dwThreads] == NULL)
+		{
+			NWL_DriverStoreClose(reader->Store);
+			break;
+		}
+		dwThreads++;
+	}
+
+	if (!NWL_DriverStoreEnum(hDrvStore, DRIVERSTORE_ENUM_NONE, DrvStoreEnumPackages, (LPARAM)pipeline))
 		NWL_NodeAppendMultiSz(&NWLC->ErrLog, "DriverStoreEnum failed");
+	DrainPackages(pipeline, 0);
+
+	if (dwThreads)
+	{
+		ReleaseSemaphore(pipeline->Queued, (LONG)dwThreads, NULL);
+		WaitForMultipleObjects(dwThreads, hThreads, TRUE, INFINITE);
+		for (DWORD i = 0; i < dwThreads; i++)
+		{
+			CloseHandle(hThreads[i]);
+			NWL_DriverStoreClose(readers[i].Store);
+		}
+	}
 
+	if (pipeline->Stream)
+		NWL_NodeAttrSetf(node, "Package Count", NAFLG_FMT_NUMERIC, "%ld", pipeline->Count);
+
+out:
+	for (int i = 0; i < DRVSTORE_WINDOW; i++)
+	{
+		free(pipeline->Slots[i].Path);
+		free(pipeline->Slots[i].Data);
+	}
+	if (pipeline->Queued)
+		CloseHandle(pipeline->Queued);
+	if (pipeline->Done)
+		CloseHandle(pipeline->Done);
+	free(pipeline);
 	NWL_DriverStoreClose(hDrvStore);
 	return node;
 }
@@ -0,0 +1,336 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "edid.h"
+
+static const uint8_t EDID_HEADER[NWL_EDID_HEADER_SIZE] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+
+static void
+CopyEdidString(char* dst, const uint8_t* block)
+{
+	// A string descriptor has a 5-byte header, followed by up to 13 bytes of text.
+	size_t len = 13;
+	memcpy(dst, block + 5, 13);
+	while (len > 0 && isspace((unsigned char)dst[len - 1]))
+		len--;
+	dst[len] = '\0';
+}
+
+static const char*
+GetAspectRatio(uint8_t aspectRatio, uint16_t edidVer, uint64_t hRes, uint64_t* vRes)
+{
+	switch (aspectRatio)
+	{
+	case 0:
+		if (edidVer < 0x0103)
+		{
+			*vRes = hRes;
+			return "1:1";
+		}
+		*vRes = (hRes * 10) / 16;
+		return "16:10";
+	case 1:
+		*vRes = (hRes * 3) / 4;
+		return "4:3";
+	case 2:
+		*vRes = (hRes * 4) / 5;
+		return "5:4";
+	case 3:
+		*vRes = (hRes * 9) / 16;
+		return "16:9";
+	}
+	// Should never happen
+	*vRes = 0;
+	return "UNKNOWN";
+}
+
+static void
+ParseDtd(const uint8_t* block, NWL_EDID_DTD* dtd, NWL_EDID* edid)
+{
+	// Pixel clock is in units of 10 kHz.
+	uint32_t pixelClock = (((uint32_t)block[1] << 8) | block[0]) * 10;
+	uint32_t hActive = block[2] + ((block[4] & 0xF0) << 4);
+	uint32_t hBlank = block[3] + ((block[4] & 0x0F) << 8);
+	uint32_t vActive = block[5] + ((block[7] & 0xF0) << 4);
+	uint32_t vBlank = block[6] + ((block[7] & 0x0F) << 8);
+	uint32_t hTotal = hActive + hBlank;
+	uint32_t vTotal = vActive + vBlank;
+
+	memset(dtd, 0, sizeof(NWL_EDID_DTD));
+	if (hTotal == 0 || vTotal == 0)
+	{
+		edid->Errors |= NWL_EDID_ERR_TIMING;
+		return;
+	}
+	dtd->Valid = 1;
+	dtd->PixelClock = pixelClock;
+	dtd->HActive = (uint16_t)hActive;
+	dtd->HBlank = (uint16_t)hBlank;
+	dtd->VActive = (uint16_t)vActive;
+	dtd->VBlank = (uint16_t)vBlank;
+	dtd->HSizeMm = (uint16_t)(block[12] | ((block[14] & 0xF0) << 4));
+	dtd->VSizeMm = (uint16_t)(block[13] | ((block[14] & 0x0F) << 8));
+	dtd->Features = block[17];
+	dtd->Refresh = (pixelClock * 1000.0) / ((uint64_t)hTotal * vTotal);
+
+	if ((uint64_t)hActive * vActive > edid->XRes * edid->YRes)
+	{
+		edid->XRes = hActive;
+		edid->YRes = vActive;
+	}
+	if (edid->Freq < dtd->Refresh)
+		edid->Freq = dtd->Refresh;
+	// The first DTD with a size is the primary one for this information.
+	if (dtd->HSizeMm > 0 && dtd->VSizeMm > 0 && edid->Width == 0 && edid->Height == 0)
+	{
+		edid->Width = dtd->HSizeMm;
+		edid->Height = dtd->VSizeMm;
+	}
+}
+
+static void
+ParseStandardTimings(const uint8_t* base, NWL_EDID* edid)
+{
+	// 8 two-byte entries starting at offset 38.
+	for (int i = 0; i < 8; i++)
+	{
+		NWL_EDID_STD* std = &edid->Std[i];
+		uint8_t b1 = base[38 + i * 2];
+		uint8_t b2 = base[38 + i * 2 + 1];
+		if (b1 == 0x01 && b2 == 0x01)
+			continue;
+		std->Enabled = 1;
+		std->HRes = (31ULL + b1) * 8;
+		std->AspectRatio = GetAspectRatio((b2 >> 6) & 0x03, edid->Ver, std->HRes, &std->VRes);
+		std->Refresh = (b2 & 0x3F) + 60;
+		// DTDs are more precise, only the resolution is taken from here.
+		if (std->HRes * std->VRes > edid->XRes * edid->YRes)
+		{
+			edid->XRes = std->HRes;
+			edid->YRes = std->VRes;
+		}
+	}
+}
+
+static void
+ParseDescriptors(const uint8_t* base, NWL_EDID* edid)
+{
+	// Four 18-byte blocks starting at offset 54.
+	for (int i = 0; i < 4; i++)
+	{
+		const uint8_t* block = base + 54 + i * 18;
+		NWL_EDID_DESC* desc = &edid->Desc[i];
+
+		// A DTD does not start with 0x00 0x00.
+		if (block[0] != 0x00 || block[1] != 0x00)
+		{
+			desc->Tag = 0;
+			ParseDtd(block, &desc->Dtd, edid);
+			continue;
+		}
+		desc->Tag = block[3];
+		switch (block[3])
+		{
+		case 0xFF:
+			CopyEdidString(desc->Text, block);
+			memcpy(edid->Serial, desc->Text, sizeof(edid->Serial));
+			break;
+		case 0xFE:
+			CopyEdidString(desc->Text, block);
+			break;
+		case 0xFC:
+			CopyEdidString(desc->Text, block);
+			memcpy(edid->Name, desc->Text, sizeof(edid->Name));
+			break;
+		case 0xFD:
+			desc->MinVRate = block[5];
+			desc->MaxVRate = block[6];
+			desc->MinHRate = block[7];
+			desc->MaxHRate = block[8];
+			desc->MaxPixelClock = block[9] * 10;
+			break;
+		}
+	}
+}
+
+static void
+ParseCtaExtension(const uint8_t* ext, NWL_EDID_EXT* e, NWL_EDID* edid)
+{
+	e->Revision = ext[1];
+	e->DtdOffset = ext[2];
+	e->Support = ext[3];
+
+	// Offset 0 means no DTDs and no data blocks. Anything else must leave room for the header.
+	if (e->DtdOffset == 0)
+		return;
+	if (e->DtdOffset < 4 || e->DtdOffset > 127)
+	{
+		edid->Errors |= NWL_EDID_ERR_CTA_OFFSET;
+		return;
+	}
+
+	// Data block collection, revision 3 and later.
+	if (e->Revision >= 3)
+	{
+		for (uint32_t i = 4; i < e->DtdOffset; )
+		{
+			NWL_EDID_CTA_BLOCK* db;
+			uint8_t tag = ext[i] >> 5;
+			uint8_t len = ext[i] & 0x1F;
+			if (i + 1 + len > e->DtdOffset)
+			{
+				edid->Errors |= NWL_EDID_ERR_CTA_TRUNCATED;
+				break;
+			}
+			if (e->BlockCount >= NWL_EDID_CTA_BLOCK_MAX)
+				break;
+			db = &e->Blocks[e->BlockCount++];
+			db->Tag = tag;
+			db->Length = len;
+			if (tag == 3 && len >= 3)
+				memcpy(db->Oui, ext + i + 1, 3);
+			else if (tag == 7 && len >= 1)
+				db->ExtTag = ext[i + 1];
+			i += 1 + len;
+		}
+	}
+
+	// Detailed timing descriptors fill the rest, byte 127 is the checksum.
+	for (uint32_t i = e->DtdOffset; i + 18 <= 127 && e->DtdCount < NWL_EDID_CTA_DTD_MAX; i += 18)
+	{
+		if (ext[i] == 0x00 && ext[i + 1] == 0x00)
+			break;
+		ParseDtd(ext + i, &e->Dtds[e->DtdCount++], edid);
+	}
+}
+
+static void
+ParseExtensions(const uint8_t* data, size_t size, NWL_EDID* edid)
+{
+	uint32_t count = edid->ExtDeclared;
+	if (count == 0)
+		return;
+	// Decode whatever is present of a truncated dump.
+	if (size / NWL_EDID_BLOCK_SIZE < (size_t)count + 1)
+	{
+		edid->Errors |= NWL_EDID_ERR_TRUNCATED;
+		count = (uint32_t)(size / NWL_EDID_BLOCK_SIZE) - 1;
+	}
+	if (count == 0)
+		return;
+	edid->Ext = calloc(count, sizeof(NWL_EDID_EXT));
+	if (!edid->Ext)
+		return;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const uint8_t* ext = data + NWL_EDID_BLOCK_SIZE * (i + 1);
+		NWL_EDID_EXT* e = &edid->Ext[i];
+		uint8_t checksum = 0;
+		for (int j = 0; j < NWL_EDID_BLOCK_SIZE; j++)
+			checksum += ext[j];
+		e->Tag = ext[0];
+		e->ChecksumValid = (checksum == 0);
+		edid->ExtCount++;
+		if (e->ChecksumValid && ext[0] == 0x02)
+			ParseCtaExtension(ext, e, edid);
+	}
+}
+
+int NWL_EdidParse(const void* data, size_t size, NWL_EDID* edid)
+{
+	const uint8_t* p = data;
+	uint8_t checksum = 0;
+
+	memset(edid, 0, sizeof(NWL_EDID));
+	// An EDID block must be at least 128 bytes.
+	if (size < NWL_EDID_BLOCK_SIZE)
+	{
+		edid->Errors |= NWL_EDID_ERR_TRUNCATED;
+		return 0;
+	}
+	// The sum of all 128 bytes must be a multiple of 256.
+	for (int i = 0; i < NWL_EDID_BLOCK_SIZE; i++)
+		checksum += p[i];
+	if (checksum != 0)
+	{
+		edid->Errors |= NWL_EDID_ERR_CHECKSUM;
+		return 0;
+	}
+	memcpy(edid->Base, p, NWL_EDID_BLOCK_SIZE);
+
+	edid->Vendor[0] = ((p[8] >> 2) & 0x1F) + 'A' - 1;
+	edid->Vendor[1] = (((p[8] & 0x03) << 3) | ((p[9] >> 5) & 0x07)) + 'A' - 1;
+	edid->Vendor[2] = (p[9] & 0x1F) + 'A' - 1;
+	edid->Vendor[3] = '\0';
+	edid->ProductCode = (uint16_t)((p[11] << 8) | p[10]);
+	edid->SerialNumber = ((uint32_t)p[15] << 24) | ((uint32_t)p[14] << 16) | ((uint32_t)p[13] << 8) | p[12];
+	edid->Week = p[16];
+	edid->Year = p[17] + 1990;
+	edid->VerMajor = p[18];
+	edid->VerMinor = p[19];
+	edid->Ver = (uint16_t)((p[18] << 8) | p[19]);
+	edid->Width = 10ULL * p[21];
+	edid->Height = 10ULL * p[22];
+	edid->ExtDeclared = p[126];
+
+	// Default to the binary serial, a serial number descriptor replaces it.
+	for (int i = 0; i < 8; i++)
+		edid->Serial[i] = "0123456789ABCDEF"[(edid->SerialNumber >> (28 - 4 * i)) & 0x0F];
+	edid->Serial[8] = '\0';
+
+	ParseStandardTimings(p, edid);
+	ParseDescriptors(p, edid);
+	// Extension DTDs may carry the native resolution
+	ParseExtensions(p, size, edid);
+	return 1;
+}
+
+void NWL_EdidFree(NWL_EDID* edid)
+{
+	free(edid->Ext);
+	edid->Ext = NULL;
+	edid->ExtCount = 0;
+}
+
+static const uint8_t*
+FindEdidHeader(const uint8_t* data, const uint8_t* end)
+{
+	while (end - data >= (ptrdiff_t)sizeof(EDID_HEADER))
+	{
+		const uint8_t* p = memchr(data, 0x00, end - data - sizeof(EDID_HEADER) + 1);
+		if (p == NULL)
+			break;
+		if (memcmp(p, EDID_HEADER, sizeof(EDID_HEADER)) == 0)
+			return p;
+		data = p + 1;
+	}
+	return NULL;
+}
+
+int NWL_EdidFind(const void* data, size_t size, size_t* offset, size_t* length)
+{
+	const uint8_t* base = data;
+	const uint8_t* end = base + size;
+	const uint8_t* p;
+	const uint8_t* next;
+	const uint8_t* blobEnd;
+
+	if (*offset >= size)
+		return 0;
+	p = FindEdidHeader(base + *offset, end);
+	if (p == NULL)
+		return 0;
+	next = FindEdidHeader(p + sizeof(EDID_HEADER), end);
+	blobEnd = next ? next : end;
+	if (blobEnd - p >= NWL_EDID_BLOCK_SIZE)
+	{
+		size_t expected = (size_t)NWL_EDID_BLOCK_SIZE * (p[126] + 1);
+		if (expected < (size_t)(blobEnd - p))
+			blobEnd = p + expected;
+	}
+	*offset = (size_t)(p - base);
+	*length = (size_t)(blobEnd - p);
+	return 1;
+}
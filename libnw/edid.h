@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: Unlicense
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// EDID base block and extension decoder.
+// Works on a memory image and has no OS dependency, so dumps can be
+// decoded, fuzzed and benchmarked on any platform.
+
+#define NWL_EDID_BLOCK_SIZE 128
+#define NWL_EDID_HEADER_SIZE 8
+#define NWL_EDID_CTA_BLOCK_MAX 124
+#define NWL_EDID_CTA_DTD_MAX 6
+
+// NWL_EDID.Errors
+#define NWL_EDID_ERR_TRUNCATED      (1U << 0)
+#define NWL_EDID_ERR_CHECKSUM       (1U << 1)
+#define NWL_EDID_ERR_TIMING         (1U << 2)
+#define NWL_EDID_ERR_CTA_OFFSET     (1U << 3)
+#define NWL_EDID_ERR_CTA_TRUNCATED  (1U << 4)
+
+typedef struct
+{
+	int Valid; // zero total size, nothing else is set
+	uint32_t PixelClock; // kHz
+	uint16_t HActive;
+	uint16_t HBlank;
+	uint16_t VActive;
+	uint16_t VBlank;
+	uint16_t HSizeMm;
+	uint16_t VSizeMm;
+	uint8_t Features;
+	double Refresh;
+} NWL_EDID_DTD;
+
+typedef struct
+{
+	uint8_t Tag; // 0 for a detailed timing descriptor
+	NWL_EDID_DTD Dtd;
+	char Text[14]; // 0xFF, 0xFE and 0xFC
+	// 0xFD
+	uint8_t MinVRate;
+	uint8_t MaxVRate;
+	uint8_t MinHRate;
+	uint8_t MaxHRate;
+	uint16_t MaxPixelClock; // MHz
+} NWL_EDID_DESC;
+
+typedef struct
+{
+	int Enabled;
+	const char* AspectRatio;
+	uint64_t HRes;
+	uint64_t VRes;
+	int Refresh;
+} NWL_EDID_STD;
+
+typedef struct
+{
+	uint8_t Tag;
+	uint8_t Length;
+	uint8_t Oui[3]; // vendor-specific, Length >= 3
+	uint8_t ExtTag; // extended, Length >= 1
+} NWL_EDID_CTA_BLOCK;
+
+typedef struct
+{
+	uint8_t Tag;
+	int ChecksumValid;
+	// CTA-861, only when the checksum is valid
+	uint8_t Revision;
+	uint8_t Support; // byte 3
+	uint8_t DtdOffset;
+	uint32_t BlockCount;
+	NWL_EDID_CTA_BLOCK Blocks[NWL_EDID_CTA_BLOCK_MAX];
+	uint32_t DtdCount;
+	NWL_EDID_DTD Dtds[NWL_EDID_CTA_DTD_MAX];
+} NWL_EDID_EXT;
+
+typedef struct
+{
+	uint8_t Base[NWL_EDID_BLOCK_SIZE];
+	uint32_t Errors;
+	char Vendor[4];
+	uint16_t ProductCode;
+	uint32_t SerialNumber;
+	int Week;
+	int Year;
+	uint8_t VerMajor;
+	uint8_t VerMinor;
+	uint16_t Ver;
+	NWL_EDID_STD Std[8];
+	NWL_EDID_DESC Desc[4];
+	uint32_t ExtDeclared;
+	uint32_t ExtCount;
+	NWL_EDID_EXT* Ext;
+	// Summary over every timing
+	uint64_t XRes;
+	uint64_t YRes;
+	double Freq;
+	uint64_t Width; // mm
+	uint64_t Height; // mm
+	char Name[14];
+	char Serial[14];
+} NWL_EDID;
+
+// Decode one EDID. Returns 0 if the base block is truncated or its checksum
+// is wrong, Errors says why. Free with NWL_EdidFree either way.
+int NWL_EdidParse(const void* data, size_t size, NWL_EDID* edid);
+void NWL_EdidFree(NWL_EDID* edid);
+
+// Locate the next EDID of a dump at or after *offset. It ends after its
+// extension blocks, or where the next header begins if it was truncated.
+// Returns 0 when no further header is found.
+int NWL_EdidFind(const void* data, size_t size, size_t* offset, size_t* length);
@@ -144,26 +144,281 @@ fail:
 	return FALSE;
 }
 
-PVARIABLE_NAME
-NWL_EnumerateEfiVar(PULONG pulSize)
+static PVOID
+EnumerateEfiVarAlloc(ULONG InformationClass, PULONG pulSize)
 {
-	PVOID VarNamePtr = NULL;
-	EnumerateEfiVar(SystemEnvironmentNameInformation, NULL, pulSize);
+	PVOID VarPtr = NULL;
+	EnumerateEfiVar(InformationClass, NULL, pulSize);
 	if (*pulSize == 0)
 		goto fail;
-	VarNamePtr = calloc(*pulSize, 1);
-	if (!VarNamePtr)
+	VarPtr = calloc(*pulSize, 1);
+	if (!VarPtr)
 		goto fail;
-	if (!EnumerateEfiVar(SystemEnvironmentNameInformation, VarNamePtr, pulSize))
+	if (!EnumerateEfiVar(InformationClass, VarPtr, pulSize))
 		goto fail;
-	return VarNamePtr;
+	return VarPtr;
 fail:
-	if (VarNamePtr)
-		free(VarNamePtr);
+	if (VarPtr)
+		free(VarPtr);
 	*pulSize = 0;
 	return NULL;
 }
 
+PVARIABLE_NAME
+NWL_EnumerateEfiVar(PULONG pulSize)
+{
+	return EnumerateEfiVarAlloc(SystemEnvironmentNameInformation, pulSize);
+}
+
+static size_t
+EfiVarHash(LPGUID lpGuid, LPCWSTR lpName)
+{
+	// FNV-1a over the GUID, then the name if any.
+	UINT32 h = 2166136261U;
+	const BYTE* p = (const BYTE*)lpGuid;
+	for (size_t i = 0; i < sizeof(GUID); i++)
+	{
+		h ^= p[i];
+		h *= 16777619U;
+	}
+	for (; lpName && *lpName; lpName++)
+	{
+		h ^= (UINT16)*lpName;
+		h *= 16777619U;
+	}
+	return h;
+}
+
+static VOID
+EfiVarsAdd(NWL_EFI_VARS* vars, LPGUID lpGuid, LPCWSTR lpName, DWORD dwAttr, PVOID pData, DWORD dwSize)
+{
+	size_t mask = vars->HashSize - 1;
+	size_t index = vars->Count++;
+	NWL_EFI_VAR* var = &vars->Vars[index];
+	NWL_EFI_GROUP* group = NULL;
+
+	var->Guid = lpGuid;
+	var->Name = lpName;
+	var->Attributes = dwAttr;
+	var->Size = dwSize;
+	var->Data = pData;
+	var->Loaded = (pData != NULL);
+
+	for (size_t pos = EfiVarHash(lpGuid, lpName) & mask; ; pos = (pos + 1) & mask)
+	{
+		if (vars->VarHash[pos] == 0)
+		{
+			vars->VarHash[pos] = index + 1;
+			break;
+		}
+	}
+
+	for (size_t pos = EfiVarHash(lpGuid, NULL) & mask; ; pos = (pos + 1) & mask)
+	{
+		size_t g = vars->GroupHash[pos];
+		if (g == 0)
+		{
+			group = &vars->Groups[vars->GroupCount++];
+			group->Guid = lpGuid;
+			vars->GroupHash[pos] = vars->GroupCount;
+			break;
+		}
+		if (IsEqualGUID(vars->Groups[g - 1].Guid, lpGuid))
+		{
+			group = &vars->Groups[g - 1];
+			break;
+		}
+	}
+	if (group->Last)
+		vars->Vars[group->Last - 1].Next = index + 1;
+	else
+		group->First = index + 1;
+	group->Last = index + 1;
+}
+
+static VOID
+EfiVarsAlloc(NWL_EFI_VARS* vars, size_t count)
+{
+	vars->HashSize = 16;
+	while (vars->HashSize < count * 2)
+		vars->HashSize <<= 1;
+	vars->Vars = calloc(count, sizeof(NWL_EFI_VAR));
+	vars->Groups = calloc(count, sizeof(NWL_EFI_GROUP));
+	vars->VarHash = calloc(vars->HashSize, sizeof(size_t));
+	vars->GroupHash = calloc(vars->HashSize, sizeof(size_t));
+	if (!vars->Vars || !vars->Groups || !vars->VarHash || !vars->GroupHash)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+}
+
+static BOOL
+EfiVarsLoadValues(NWL_EFI_VARS* vars)
+{
+	ULONG ulSize = 0;
+	size_t count = 0;
+	PVARIABLE_NAME_AND_VALUE p;
+	LPBYTE end;
+
+	// Names, attributes and contents of every variable in one call.
+	vars->Buffer = EnumerateEfiVarAlloc(SystemEnvironmentValueInformation, &ulSize);
+	if (!vars->Buffer)
+		return FALSE;
+	end = (LPBYTE)vars->Buffer + ulSize;
+	for (p = vars->Buffer; (LPBYTE)p < end; p = (PVARIABLE_NAME_AND_VALUE)((LPBYTE)p + p->NextEntryOffset))
+	{
+		count++;
+		if (p->NextEntryOffset == 0)
+			break;
+	}
+	EfiVarsAlloc(vars, count);
+	for (p = vars->Buffer; (LPBYTE)p < end; p = (PVARIABLE_NAME_AND_VALUE)((LPBYTE)p + p->NextEntryOffset))
+	{
+		LPBYTE data = (LPBYTE)p + p->ValueOffset;
+		if (data + p->ValueLength > end)
+		{
+			NWL_Debug("UEFI", "Truncated value of %s", NWL_Ucs2ToUtf8(p->Name));
+			break;
+		}
+		EfiVarsAdd(vars, &p->VendorGuid, p->Name, p->Attributes, p->ValueLength ? data : NULL, p->ValueLength);
+		if (p->ValueLength == 0)
+			vars->Vars[vars->Count - 1].Loaded = TRUE;
+		if (p->NextEntryOffset == 0)
+			break;
+	}
+	return TRUE;
+}
+
+static BOOL
+EfiVarsLoadNames(NWL_EFI_VARS* vars)
+{
+	ULONG ulSize = 0;
+	size_t count = 0;
+	PVARIABLE_NAME p;
+	LPBYTE end;
+
+	// Contents are read on demand, sizes still cost one query each.
+	vars->Buffer = NWL_EnumerateEfiVar(&ulSize);
+	if (!vars->Buffer)
+		return FALSE;
+	end = (LPBYTE)vars->Buffer + ulSize;
+	for (p = vars->Buffer; (LPBYTE)p < end; p = (PVARIABLE_NAME)((LPBYTE)p + p->NextEntryOffset))
+	{
+		count++;
+		if (p->NextEntryOffset == 0)
+			break;
+	}
+	EfiVarsAlloc(vars, count);
+	for (p = vars->Buffer; (LPBYTE)p < end; p = (PVARIABLE_NAME)((LPBYTE)p + p->NextEntryOffset))
+	{
+		DWORD dwAttr = 0;
+		DWORD dwSize = NWL_GetEfiVar(p->Name, &p->VendorGuid, NULL, 0, &dwAttr);
+		EfiVarsAdd(vars, &p->VendorGuid, p->Name, dwAttr, NULL, dwSize);
+		if (p->NextEntryOffset == 0)
+			break;
+	}
+	return TRUE;
+}
+
+static VOID
+EfiVarsReset(NWL_EFI_VARS* vars)
+{
+	for (size_t i = 0; i < vars->Count; i++)
+	{
+		if (vars->Vars[i].Owned)
+			free(vars->Vars[i].Data);
+	}
+	free(vars->Buffer);
+	free(vars->Vars);
+	free(vars->Groups);
+	free(vars->VarHash);
+	free(vars->GroupHash);
+	ZeroMemory(vars, sizeof(NWL_EFI_VARS));
+}
+
+NWL_EFI_VARS*
+NWL_GetEfiVars(VOID)
+{
+	NWL_EFI_VARS* vars;
+	if (NWLC->NwEfiVars)
+		return NWLC->NwEfiVars;
+	vars = calloc(1, sizeof(NWL_EFI_VARS));
+	if (!vars)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	NWLC->NwEfiVars = vars;
+	if (!NWLC->NwIsEfi)
+		return vars;
+	if (EfiVarsLoadValues(vars))
+		goto out;
+	EfiVarsReset(vars);
+	NWL_Debug("UEFI", "Value enumeration failed, reading sizes one by one");
+	if (!EfiVarsLoadNames(vars))
+		EfiVarsReset(vars);
+out:
+	NWL_Debug("UEFI", "%zu variables in %zu namespaces", vars->Count, vars->GroupCount);
+	return vars;
+}
+
+NWL_EFI_VAR*
+NWL_FindEfiVar(LPCWSTR lpName, LPGUID lpGuid)
+{
+	NWL_EFI_VARS* vars = NWL_GetEfiVars();
+	size_t mask = vars->HashSize - 1;
+	if (vars->Count == 0)
+		return NULL;
+	if (!lpGuid)
+		lpGuid = &EFI_GV_GUID;
+	for (size_t pos = EfiVarHash(lpGuid, lpName) & mask; vars->VarHash[pos]; pos = (pos + 1) & mask)
+	{
+		NWL_EFI_VAR* var = &vars->Vars[vars->VarHash[pos] - 1];
+		if (IsEqualGUID(var->Guid, lpGuid) && wcscmp(var->Name, lpName) == 0)
+			return var;
+	}
+	return NULL;
+}
+
+const NWL_EFI_GROUP*
+NWL_FindEfiGroup(LPGUID lpGuid)
+{
+	NWL_EFI_VARS* vars = NWL_GetEfiVars();
+	size_t mask = vars->HashSize - 1;
+	if (vars->Count == 0)
+		return NULL;
+	if (!lpGuid)
+		lpGuid = &EFI_GV_GUID;
+	for (size_t pos = EfiVarHash(lpGuid, NULL) & mask; vars->GroupHash[pos]; pos = (pos + 1) & mask)
+	{
+		NWL_EFI_GROUP* group = &vars->Groups[vars->GroupHash[pos] - 1];
+		if (IsEqualGUID(group->Guid, lpGuid))
+			return group;
+	}
+	return NULL;
+}
+
+PVOID
+NWL_GetEfiVarData(NWL_EFI_VAR* pVar)
+{
+	if (!pVar)
+		return NULL;
+	if (!pVar->Loaded)
+	{
+		DWORD dwSize = 0;
+		pVar->Loaded = TRUE;
+		pVar->Data = NWL_GetEfiVarAlloc(pVar->Name, pVar->Guid, &dwSize, NULL);
+		pVar->Size = dwSize;
+		pVar->Owned = (pVar->Data != NULL);
+	}
+	return pVar->Data;
+}
+
+VOID
+NWL_FreeEfiVars(VOID)
+{
+	if (!NWLC->NwEfiVars)
+		return;
+	EfiVarsReset(NWLC->NwEfiVars);
+	free(NWLC->NwEfiVars);
+	NWLC->NwEfiVars = NULL;
+}
+
 static LPCWSTR
 GuidToWcs(GUID* pGuid)
 {
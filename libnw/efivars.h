@@ -377,6 +377,50 @@ typedef struct _VARIABLE_NAME
 	WCHAR Name[ANYSIZE_ARRAY];
 } VARIABLE_NAME, * PVARIABLE_NAME;
 
+typedef struct _VARIABLE_NAME_AND_VALUE
+{
+	ULONG NextEntryOffset;
+	ULONG ValueOffset;
+	ULONG ValueLength;
+	ULONG Attributes;
+	GUID VendorGuid;
+	WCHAR Name[ANYSIZE_ARRAY];
+	//UCHAR Value[ANYSIZE_ARRAY];
+} VARIABLE_NAME_AND_VALUE, * PVARIABLE_NAME_AND_VALUE;
+
+typedef struct _NWL_EFI_VAR
+{
+	LPGUID Guid;
+	LPCWSTR Name;
+	DWORD Attributes;
+	DWORD Size;
+	PVOID Data;
+	BOOL Loaded;
+	BOOL Owned; // Data was read separately and must be freed
+	size_t Next; // index + 1 of the next variable with the same GUID
+} NWL_EFI_VAR;
+
+typedef struct _NWL_EFI_GROUP
+{
+	LPGUID Guid;
+	size_t First; // index + 1
+	size_t Last;
+} NWL_EFI_GROUP;
+
+// One snapshot of the variable store, taken on first use.
+// Hash slots hold index + 1, 0 for an empty slot.
+typedef struct _NWL_EFI_VARS
+{
+	PVOID Buffer;
+	size_t Count;
+	NWL_EFI_VAR* Vars;
+	size_t GroupCount;
+	NWL_EFI_GROUP* Groups;
+	size_t HashSize;
+	size_t* VarHash;
+	size_t* GroupHash;
+} NWL_EFI_VARS;
+
 extern GUID EFI_GV_GUID;
 extern GUID EFI_IMAGE_SECURITY_DATABASE_GUID;
 extern GUID EFI_CERT_SHA256_GUID;
@@ -401,6 +445,12 @@ LIBNW_API DWORD NWL_GetEfiVar(LPCWSTR lpName, LPGUID lpGuid,
 VOID* NWL_GetEfiVarAlloc(LPCWSTR lpName, LPGUID lpGuid,
 	PDWORD pdwSize, PDWORD pdwAttributes);
 LIBNW_API PVARIABLE_NAME NWL_EnumerateEfiVar(PULONG pulSize);
+NWL_EFI_VARS* NWL_GetEfiVars(VOID);
+NWL_EFI_VAR* NWL_FindEfiVar(LPCWSTR lpName, LPGUID lpGuid);
+const NWL_EFI_GROUP* NWL_FindEfiGroup(LPGUID lpGuid);
+PVOID NWL_GetEfiVarData(NWL_EFI_VAR* pVar);
+VOID NWL_FreeEfiVars(VOID);
+VOID NWL_FreeSigDbCache(VOID);
 LIBNW_API BOOL NWL_SetEfiVarEx(LPCWSTR lpName, LPGUID lpGuid,
 	PVOID pBuffer, DWORD nSize, DWORD dwAttributes);
 LIBNW_API BOOL NWL_SetEfiVar(LPCWSTR lpName, LPGUID lpGuid, PVOID pBuffer, DWORD nSize);
@@ -2,53 +2,449 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <wchar.h>
 #include <windows.h>
+#include <pathcch.h>
 
 #include "libnw.h"
 #include "utils.h"
+#include "sfnt.h"
 
-static int CALLBACK
-EnumFontFamCallBack(ENUMLOGFONTW* lpelf, TEXTMETRICW* lptm, DWORD dwFontType, PNODE node)
+#define FONT_REG_KEY L"SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion\\Fonts"
+#define FONT_WORKERS 4
+#define FONT_BATCH 32
+
+#define FONT_CACHE_MAGIC 0x43464E4EU // "NNFC"
+#define FONT_CACHE_VERSION 1
+#define FONT_CACHE_MAX_SIZE (64U * 1024 * 1024)
+
+typedef struct _FONT_FILE
+{
+	LPWSTR Path;
+	LPWSTR RegName;
+	UINT64 Size;
+	UINT64 MTime;
+	UINT32 FaceCount;
+	NWL_SFNT_FACE* Faces;
+	BOOL Valid; // Faces came from the cache or the file
+} FONT_FILE;
+
+typedef struct _FONT_SET
+{
+	FONT_FILE* Files;
+	DWORD Count;
+	DWORD Capacity;
+	// Index + 1 into Files by path, 0 for an empty slot.
+	DWORD* Hash;
+	DWORD HashSize;
+	volatile LONG Next;
+	DWORD* Pending;
+	DWORD PendingCount;
+} FONT_SET;
+
+// On-disk cache: a header, then one record per file followed by its
+// path (PathLen WCHARs, no NUL) and FaceCount NWL_SFNT_FACE.
+typedef struct _FONT_CACHE_HEADER
+{
+	UINT32 Magic;
+	UINT32 Version;
+	UINT32 FaceSize;
+	UINT32 Count;
+} FONT_CACHE_HEADER;
+
+typedef struct _FONT_CACHE_RECORD
+{
+	UINT64 Size;
+	UINT64 MTime;
+	UINT32 FaceCount;
+	UINT32 PathLen;
+} FONT_CACHE_RECORD;
+
+static DWORD
+PathHash(LPCWSTR lpPath, size_t len)
+{
+	UINT32 h = 2166136261U;
+	for (size_t i = 0; i < len; i++)
+	{
+		h ^= towlower(lpPath[i]);
+		h *= 16777619U;
+	}
+	return h;
+}
+
+static FONT_FILE*
+FindFontFile(FONT_SET* set, LPCWSTR lpPath, size_t len)
+{
+	DWORD mask = set->HashSize - 1;
+	for (DWORD pos = PathHash(lpPath, len) & mask; set->Hash[pos]; pos = (pos + 1) & mask)
+	{
+		FONT_FILE* f = &set->Files[set->Hash[pos] - 1];
+		if (wcslen(f->Path) == len && _wcsnicmp(f->Path, lpPath, len) == 0)
+			return f;
+	}
+	return NULL;
+}
+
+static VOID
+RehashFontSet(FONT_SET* set, DWORD dwSize)
+{
+	free(set->Hash);
+	set->HashSize = dwSize;
+	set->Hash = calloc(dwSize, sizeof(DWORD));
+	if (!set->Hash)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	for (DWORD i = 0; i < set->Count; i++)
+	{
+		DWORD mask = dwSize - 1;
+		DWORD pos = PathHash(set->Files[i].Path, wcslen(set->Files[i].Path)) & mask;
+		while (set->Hash[pos])
+			pos = (pos + 1) & mask;
+		set->Hash[pos] = i + 1;
+	}
+}
+
+static VOID
+AddFontFile(FONT_SET* set, LPCWSTR lpPath, LPCWSTR lpName)
+{
+	WIN32_FILE_ATTRIBUTE_DATA attr;
+	FONT_FILE* f;
+
+	if (FindFontFile(set, lpPath, wcslen(lpPath)))
+		return;
+	if (!GetFileAttributesExW(lpPath, GetFileExInfoStandard, &attr))
+		return;
+	if (set->Count >= set->Capacity)
+	{
+		DWORD n = set->Capacity ? set->Capacity * 2 : 256;
+		FONT_FILE* p = realloc(set->Files, n * sizeof(FONT_FILE));
+		if (!p)
+			NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+		set->Files = p;
+		set->Capacity = n;
+	}
+	f = &set->Files[set->Count++];
+	ZeroMemory(f, sizeof(FONT_FILE));
+	f->Path = _wcsdup(lpPath);
+	f->RegName = _wcsdup(lpName);
+	if (!f->Path || !f->RegName)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	f->Size = ((UINT64)attr.nFileSizeHigh << 32) | attr.nFileSizeLow;
+	f->MTime = ((UINT64)attr.ftLastWriteTime.dwHighDateTime << 32) | attr.ftLastWriteTime.dwLowDateTime;
+	if (set->Count * 2 > set->HashSize)
+		RehashFontSet(set, set->HashSize * 2);
+	else
+	{
+		DWORD mask = set->HashSize - 1;
+		DWORD pos = PathHash(f->Path, wcslen(f->Path)) & mask;
+		while (set->Hash[pos])
+			pos = (pos + 1) & mask;
+		set->Hash[pos] = set->Count;
+	}
+}
+
+// Value names are display names, data is a file name relative to the
+// Fonts folder (system fonts) or a full path (per-user fonts).
+static VOID
+EnumRegFonts(FONT_SET* set, HKEY hRoot, LPCWSTR lpFontDir)
+{
+	HKEY hKey;
+	WCHAR szName[MAX_PATH];
+	WCHAR szData[MAX_PATH];
+	WCHAR szPath[MAX_PATH];
+
+	if (RegOpenKeyExW(hRoot, FONT_REG_KEY, 0, KEY_READ, &hKey) != ERROR_SUCCESS)
+		return;
+	for (DWORD i = 0; ; i++)
+	{
+		DWORD dwName = ARRAYSIZE(szName);
+		DWORD dwData = sizeof(szData) - sizeof(WCHAR);
+		DWORD dwType = 0;
+		LSTATUS rc = RegEnumValueW(hKey, i, szName, &dwName, NULL, &dwType, (LPBYTE)szData, &dwData);
+		if (rc == ERROR_NO_MORE_ITEMS)
+			break;
+		if (rc != ERROR_SUCCESS || (dwType != REG_SZ && dwType != REG_EXPAND_SZ))
+			continue;
+		szData[dwData / sizeof(WCHAR)] = L'\0';
+		if (wcschr(szData, L'\\'))
+			ExpandEnvironmentStringsW(szData, szPath, MAX_PATH);
+		else if (swprintf(szPath, MAX_PATH, L"%s\\%s", lpFontDir, szData) < 0)
+			continue;
+		AddFontFile(set, szPath, szName);
+	}
+	RegCloseKey(hKey);
+}
+
+// Returns the number of files whose faces were taken from the cache.
+static DWORD
+LoadFontCache(FONT_SET* set, LPCWSTR lpPath)
+{
+	DWORD dwSize = 0;
+	DWORD dwHits = 0;
+	LPBYTE buf = NWL_LoadCacheFile(lpPath, sizeof(FONT_CACHE_HEADER), FONT_CACHE_MAX_SIZE, &dwSize);
+	LPBYTE p, end;
+	FONT_CACHE_HEADER* hdr = (FONT_CACHE_HEADER*)buf;
+
+	if (!buf)
+		return 0;
+	if (hdr->Magic != FONT_CACHE_MAGIC || hdr->Version != FONT_CACHE_VERSION || hdr->FaceSize != sizeof(NWL_SFNT_FACE))
+		goto out;
+	p = buf + sizeof(FONT_CACHE_HEADER);
+	end = buf + dwSize;
+	for (UINT32 i = 0; i < hdr->Count; i++)
+	{
+		FONT_CACHE_RECORD rec;
+		FONT_FILE* f;
+		size_t len;
+		if ((size_t)(end - p) < sizeof(rec))
+			break;
+		memcpy(&rec, p, sizeof(rec));
+		p += sizeof(rec);
+		if (rec.FaceCount > NWL_SFNT_FACE_MAX || rec.PathLen >= MAX_PATH)
+			break;
+		len = rec.PathLen * sizeof(WCHAR) + rec.FaceCount * sizeof(NWL_SFNT_FACE);
+		if ((size_t)(end - p) < len)
+			break;
+		f = FindFontFile(set, (LPCWSTR)p, rec.PathLen);
+		if (f && !f->Valid && f->Size == rec.Size && f->MTime == rec.MTime)
+		{
+			if (rec.FaceCount)
+			{
+				f->Faces = malloc(rec.FaceCount * sizeof(NWL_SFNT_FACE));
+				if (!f->Faces)
+					NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+				memcpy(f->Faces, p + rec.PathLen * sizeof(WCHAR), rec.FaceCount * sizeof(NWL_SFNT_FACE));
+			}
+			f->FaceCount = rec.FaceCount;
+			f->Valid = TRUE;
+			dwHits++;
+		}
+		p += len;
+	}
+out:
+	free(buf);
+	return dwHits;
+}
+
+static VOID
+SaveFontCache(FONT_SET* set, LPCWSTR lpPath)
+{
+	WCHAR szTemp[MAX_PATH];
+	FONT_CACHE_HEADER hdr = { FONT_CACHE_MAGIC, FONT_CACHE_VERSION, sizeof(NWL_SFNT_FACE), 0 };
+	DWORD dwWritten;
+	BOOL bOk = TRUE;
+	HANDLE hFile;
+
+	if (swprintf(szTemp, MAX_PATH, L"%s.%lu", lpPath, GetCurrentProcessId()) < 0)
+		return;
+	hFile = CreateFileW(szTemp, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return;
+	for (DWORD i = 0; i < set->Count; i++)
+	{
+		if (set->Files[i].Valid)
+			hdr.Count++;
+	}
+	bOk = WriteFile(hFile, &hdr, sizeof(hdr), &dwWritten, NULL);
+	for (DWORD i = 0; bOk && i < set->Count; i++)
+	{
+		FONT_FILE* f = &set->Files[i];
+		FONT_CACHE_RECORD rec = { f->Size, f->MTime, f->FaceCount, (UINT32)wcslen(f->Path) };
+		if (!f->Valid)
+			continue;
+		bOk = WriteFile(hFile, &rec, sizeof(rec), &dwWritten, NULL)
+			&& WriteFile(hFile, f->Path, rec.PathLen * sizeof(WCHAR), &dwWritten, NULL)
+			&& (f->FaceCount == 0 || WriteFile(hFile, f->Faces, f->FaceCount * sizeof(NWL_SFNT_FACE), &dwWritten, NULL));
+	}
+	CloseHandle(hFile);
+	if (!bOk || !MoveFileExW(szTemp, lpPath, MOVEFILE_REPLACE_EXISTING))
+		DeleteFileW(szTemp);
+}
+
+static VOID
+ParseFontFile(FONT_FILE* f)
+{
+	NWL_SFNT_FACE faces[NWL_SFNT_FACE_MAX];
+	HANDLE hMap = NULL;
+	LPVOID pView = NULL;
+	LARGE_INTEGER liSize;
+	HANDLE hFile;
+
+	f->Valid = TRUE;
+	hFile = CreateFileW(f->Path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, 0, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		f->Valid = FALSE;
+		return;
+	}
+	// The file may have changed since it was listed, trust only the open handle.
+	if (!GetFileSizeEx(hFile, &liSize))
+	{
+		f->Valid = FALSE;
+		goto out;
+	}
+	f->Size = (UINT64)liSize.QuadPart;
+	if (f->Size == 0 || f->Size > MAXDWORD)
+		goto out;
+	hMap = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hMap)
+		pView = MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+	if (!pView)
+	{
+		f->Valid = FALSE;
+		goto out;
+	}
+	// Only the table directory and the few tables we read are paged in.
+	__try
+	{
+		f->FaceCount = NWL_SfntParse(pView, (size_t)f->Size, faces, NWL_SFNT_FACE_MAX);
+	}
+	__except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH)
+	{
+		// Truncated underneath us or on a vanished network share.
+		f->FaceCount = 0;
+		f->Valid = FALSE;
+	}
+	UnmapViewOfFile(pView);
+	if (f->FaceCount)
+	{
+		f->Faces = malloc(f->FaceCount * sizeof(NWL_SFNT_FACE));
+		if (!f->Faces)
+			NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+		memcpy(f->Faces, faces, f->FaceCount * sizeof(NWL_SFNT_FACE));
+	}
+out:
+	if (hMap)
+		CloseHandle(hMap);
+	CloseHandle(hFile);
+}
+
+static DWORD WINAPI
+ParseWorker(LPVOID lpParameter)
+{
+	FONT_SET* set = lpParameter;
+	for (;;)
+	{
+		LONG i = InterlockedIncrement(&set->Next) - 1;
+		if (i >= (LONG)set->PendingCount)
+			break;
+		ParseFontFile(&set->Files[set->Pending[i]]);
+	}
+	return 0;
+}
+
+static VOID
+ParseFontFiles(FONT_SET* set)
+{
+	HANDLE hThreads[FONT_WORKERS] = { 0 };
+	DWORD dwThreads = 0;
+	DWORD dwWorkers;
+
+	set->Pending = malloc((set->Count + 1) * sizeof(DWORD));
+	if (!set->Pending)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	for (DWORD i = 0; i < set->Count; i++)
+	{
+		if (!set->Files[i].Valid)
+			set->Pending[set->PendingCount++] = i;
+	}
+	dwWorkers = set->PendingCount / FONT_BATCH;
+	if (dwWorkers > FONT_WORKERS)
+		dwWorkers = FONT_WORKERS;
+	for (DWORD i = 0; i < dwWorkers; i++)
+	{
+		hThreads[dwThreads] = CreateThread(NULL, 0, ParseWorker, set, 0, NULL);
+		if (hThreads[dwThreads])
+			dwThreads++;
+	}
+	ParseWorker(set);
+	if (dwThreads == 0)
+		return;
+	WaitForMultipleObjects(dwThreads, hThreads, TRUE, INFINITE);
+	for (DWORD i = 0; i < dwThreads; i++)
+		CloseHandle(hThreads[i]);
+}
+
+static VOID
+PrintFontFace(PNODE node, FONT_FILE* f, NWL_SFNT_FACE* face)
 {
 	PNODE pFont = NWL_NodeAppendNew(node, "Font", NFLG_TABLE_ROW);
-	NWL_NodeAttrSet(pFont, "Name", NWL_Ucs2ToUtf8(lpelf->elfFullName), 0);
-	NWL_NodeAttrSet(pFont, "Style", NWL_Ucs2ToUtf8(lpelf->elfStyle), 0);
+	NWL_NodeAttrSet(pFont, "Name", face->FullName[0] ? face->FullName : NWL_Ucs2ToUtf8(f->RegName), 0);
+	NWL_NodeAttrSet(pFont, "Family", face->Family, 0);
+	NWL_NodeAttrSet(pFont, "Style", face->Style, 0);
+	NWL_NodeAttrSet(pFont, "Version", face->Version, 0);
+	NWL_NodeAttrSet(pFont, "File", NWL_Ucs2ToUtf8(f->Path), 0);
+	if (f->FaceCount > 1)
+		NWL_NodeAttrSetf(pFont, "Collection Index", NAFLG_FMT_NUMERIC, "%u", face->Index);
 
-	NWL_NodeAttrSetBool(pFont, "TrueType Font", (dwFontType & TRUETYPE_FONTTYPE), 0);
-	NWL_NodeAttrSetBool(pFont, "Raster Font", (dwFontType & RASTER_FONTTYPE), 0);
-	NWL_NodeAttrSetBool(pFont, "Device Font", (dwFontType & DEVICE_FONTTYPE), 0);
+	NWL_NodeAttrSetBool(pFont, "TrueType Font", TRUE, 0);
+	NWL_NodeAttrSetBool(pFont, "PostScript Outlines", face->Cff, 0);
 
-	NWL_NodeAttrSetf(pFont, "Height", NAFLG_FMT_NUMERIC, "%ld", lptm->tmHeight);
-	NWL_NodeAttrSetf(pFont, "Ascent", NAFLG_FMT_NUMERIC, "%ld", lptm->tmAscent);
-	NWL_NodeAttrSetf(pFont, "Descent", NAFLG_FMT_NUMERIC, "%ld", lptm->tmDescent);
-	NWL_NodeAttrSetf(pFont, "MaxCharWidth", NAFLG_FMT_NUMERIC, "%ld", lptm->tmMaxCharWidth);
-	NWL_NodeAttrSetf(pFont, "Weight", NAFLG_FMT_NUMERIC, "%ld", lptm->tmWeight);
-	NWL_NodeAttrSetBool(pFont, "Italic Font", lptm->tmItalic, 0);
-	NWL_NodeAttrSetBool(pFont, "Underlined Font", lptm->tmUnderlined, 0);
-	NWL_NodeAttrSetBool(pFont, "StruckOut Font", lptm->tmStruckOut, 0);
+	NWL_NodeAttrSetf(pFont, "Units Per Em", NAFLG_FMT_NUMERIC, "%u", face->UnitsPerEm);
+	NWL_NodeAttrSetf(pFont, "Height", NAFLG_FMT_NUMERIC, "%u", face->Ascent + face->Descent);
+	NWL_NodeAttrSetf(pFont, "Ascent", NAFLG_FMT_NUMERIC, "%u", face->Ascent);
+	NWL_NodeAttrSetf(pFont, "Descent", NAFLG_FMT_NUMERIC, "%u", face->Descent);
+	NWL_NodeAttrSetf(pFont, "AvgCharWidth", NAFLG_FMT_NUMERIC, "%d", face->AvgCharWidth);
+	NWL_NodeAttrSetf(pFont, "MaxCharWidth", NAFLG_FMT_NUMERIC, "%u", face->MaxAdvance);
+	NWL_NodeAttrSetf(pFont, "Weight", NAFLG_FMT_NUMERIC, "%u", face->Weight);
+	NWL_NodeAttrSetBool(pFont, "Italic Font", face->Italic, 0);
+	NWL_NodeAttrSetBool(pFont, "Underlined Font", face->Underline, 0);
+	NWL_NodeAttrSetBool(pFont, "StruckOut Font", face->Strikeout, 0);
+}
 
-	return 1;
+static VOID
+FreeFontSet(FONT_SET* set)
+{
+	for (DWORD i = 0; i < set->Count; i++)
+	{
+		free(set->Files[i].Path);
+		free(set->Files[i].RegName);
+		free(set->Files[i].Faces);
+	}
+	free(set->Files);
+	free(set->Hash);
+	free(set->Pending);
 }
 
 PNODE NW_Font(BOOL bAppend)
 {
+	FONT_SET set = { 0 };
+	WCHAR szFontDir[MAX_PATH];
+	WCHAR szCache[MAX_PATH];
+	BOOL bCache;
+	DWORD dwHits = 0;
 	PNODE node = NWL_NodeAlloc("Fonts", NFLG_TABLE);
 	if (bAppend)
 		NWL_NodeAppendChild(NWLC->NwRoot, node);
 
-	int (WINAPI * pfnEnumFontFamiliesW)(HDC, LPCWSTR, FONTENUMPROCW, LPARAM) = NULL;
-	HMODULE hGdi32 = LoadLibraryW(L"gdi32.dll");
-	if (hGdi32)
+	RehashFontSet(&set, 1024);
+	if (GetWindowsDirectoryW(szFontDir, MAX_PATH) && SUCCEEDED(PathCchAppend(szFontDir, MAX_PATH, L"Fonts")))
+		EnumRegFonts(&set, HKEY_LOCAL_MACHINE, szFontDir);
+	EnumRegFonts(&set, HKEY_CURRENT_USER, szFontDir);
+
+	bCache = NWL_GetCachePath(szCache, L"fonts.cache");
+	if (bCache)
+		dwHits = LoadFontCache(&set, szCache);
+	NWL_Debug("FONT", "%lu files, %lu cached", set.Count, dwHits);
+	ParseFontFiles(&set);
+	if (bCache && set.PendingCount)
+		SaveFontCache(&set, szCache);
+
+	for (DWORD i = 0; i < set.Count; i++)
 	{
-		*(FARPROC*)&pfnEnumFontFamiliesW = GetProcAddress(hGdi32, "EnumFontFamiliesW");
-		if (pfnEnumFontFamiliesW)
+		FONT_FILE* f = &set.Files[i];
+		if (f->FaceCount == 0)
 		{
-			HDC hDC = GetDC(NULL);
-			pfnEnumFontFamiliesW(hDC, NULL, (FONTENUMPROCW)EnumFontFamCallBack, (LPARAM)node);
-			ReleaseDC(NULL, hDC);
+			// Bitmap and vector .fon files have no sfnt tables.
+			PNODE pFont = NWL_NodeAppendNew(node, "Font", NFLG_TABLE_ROW);
+			NWL_NodeAttrSet(pFont, "Name", NWL_Ucs2ToUtf8(f->RegName), 0);
+			NWL_NodeAttrSet(pFont, "File", NWL_Ucs2ToUtf8(f->Path), 0);
+			NWL_NodeAttrSetBool(pFont, "TrueType Font", FALSE, 0);
+			continue;
 		}
-		FreeLibrary(hGdi32);
+		for (UINT32 j = 0; j < f->FaceCount; j++)
+			PrintFontFace(node, f, &f->Faces[j]);
 	}
 
+	FreeFontSet(&set);
 	return node;
 }
@@ -4,6 +4,7 @@
 #include "utils.h"
 #include "efivars.h"
 #include "network.h"
+#include "devtree.h"
 #include "cpuid.h"
 
 #include "libcpuid.h"
@@ -132,6 +133,9 @@ VOID NW_Print(LPCSTR lpFileName)
 		NWL_ErrExit(ERROR_OPEN_FAILED, "Cannot open file");
 	if (!NWLC->NwFile)
 		return;
+	// USB, audio and device tree share one PnP tree walk
+	if (NWLC->UsbInfo || NWLC->AudioInfo || NWLC->DevTree)
+		NWLC->NwDevTree = NWL_DevTreeCreate();
 	if (NWLC->AcpiInfo)
 		NW_Acpi(TRUE);
 	if (NWLC->CpuInfo)
@@ -178,6 +182,8 @@ VOID NW_Print(LPCSTR lpFileName)
 		NW_Hid(TRUE);
 	if (NWLC->Sensors)
 		NW_Sensors(TRUE);
+	NWL_DevTreeFree(NWLC->NwDevTree);
+	NWLC->NwDevTree = NULL;
 	NW_Libinfo();
 	NW_Export(NWLC->NwRoot, NWLC->NwFile);
 }
@@ -192,6 +198,9 @@ VOID NW_Fini(VOID)
 		free(NWLC->NwRsdt);
 	if (NWLC->NwXsdt)
 		free(NWLC->NwXsdt);
+	NWL_FreeAcpiCache();
+	NWL_FreeEfiVars();
+	NWL_FreeSigDbCache();
 	if (NWLC->NwSmbios)
 		free(NWLC->NwSmbios);
 	if (NWLC->NwSmart)
@@ -210,6 +219,7 @@ VOID NW_Fini(VOID)
 	cpuid_free_raw_data_array(NWLC->NwCpuRaw);
 	free(NWLC->NwCpuRaw);
 	NWL_FreeSensors();
+	NWL_DevTreeFree(NWLC->NwDevTree);
 	NWL_FreeNetAdapters(NWLC->NwNetAdapters);
 	NWLC->NwNetAdapters = NULL;
 	WR0_CloseDriver(NWLC->NwDrv);
@@ -85,6 +85,7 @@ typedef struct _NWLIB_CONTEXT
 	LPCSTR SpdDump;
 	LPCSTR EdidDump;
 	LPCSTR DrvStoreDrive;
+	BOOL DrvStoreStream;
 
 #define NW_NET_ACTIVE (1 << 0)
 #define NW_NET_PHYS   (1 << 1)
@@ -94,6 +95,7 @@ typedef struct _NWLIB_CONTEXT
 #define NW_NET_WLAN   (1 << 5)
 	UINT64 NetFlags;
 	struct _NWLIB_NET_ADAPTER_MAP* NwNetAdapters;
+	UINT64 NwNetGeneration; // bumped when anything but the traffic counters changes
 #define NW_DISK_NO_SMART (1 << 0)
 #define NW_DISK_PHYS     (1 << 1)
 #define NW_DISK_HD       (1 << 2)
@@ -117,6 +119,8 @@ typedef struct _NWLIB_CONTEXT
 	OSVERSIONINFOEXW NwOsInfo;
 	SYSTEM_INFO NwSi;
 	BOOL NwIsEfi;
+	struct _NWL_EFI_VARS* NwEfiVars;
+	struct _NWL_SIGDB_CACHE* NwSigDbCache;
 
 	struct cpu_raw_data_array_t* NwCpuRaw;
 	struct system_id_t* NwCpuid;
@@ -125,6 +129,7 @@ typedef struct _NWLIB_CONTEXT
 	struct ACPI_RSDP_V2* NwRsdp;
 	struct ACPI_RSDT* NwRsdt;
 	struct ACPI_XSDT* NwXsdt;
+	struct _NWL_ACPI_CACHE* NwAcpiCache;
 
 	struct RAW_SMBIOS_DATA* NwSmbios;
 	BOOL NwSmartInit;
@@ -136,9 +141,14 @@ typedef struct _NWLIB_CONTEXT
 
 	struct _NWLIB_GPU_INFO* NwGpu;
 
+	struct _DEVTREE_SNAPSHOT* NwDevTree;
+
 	UINT64 NwSensorFlags;
 
 	LPCSTR DriverName;
+	LPCSTR DriverRecord;
+	LPCSTR DriverReplay;
+	BOOL DriverTiming;
 	struct wr0_drv_t* NwDrv;
 	BOOL NwIsWoW64;
 	UINT CodePage;
@@ -179,6 +189,8 @@ extern PNWLIB_CONTEXT NWLC;
 LIBNW_API VOID NW_Init(PNWLIB_CONTEXT pContext);
 LIBNW_API VOID NW_Export(PNODE node, FILE* file);
 LIBNW_API VOID NW_Print(LPCSTR lpFileName);
+LIBNW_API VOID NW_Serve(LPCSTR lpPipeName);
+LIBNW_API VOID NW_Publish(LPCSTR lpName, DWORD dwInterval);
 LIBNW_API VOID NW_Fini(VOID);
 
 #ifdef noreturn
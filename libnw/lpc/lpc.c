@@ -47,6 +47,7 @@ NWL_InitLpc(struct _NWLIB_MAINBOARD_INFO* board)
 		{
 			if (lpc_drivers[j]->detect(&lpc->io, board, &lpc->slots[i]))
 			{
+				lpc->slots[i].drv = lpc_drivers[j];
 				NWL_Debug("LPC", "Driver %s detected the chip", lpc_drivers[j]->name);
 				break;
 			}
@@ -220,7 +220,7 @@ WlanCipherToStr(DOT11_CIPHER_ALGORITHM cipher)
 }
 
 static void
-GetWlanInfo(NWLIB_NET_ADAPTER* adapter, PIP_ADAPTER_ADDRESSES_XP ipAdapter)
+GetWlanInfo(NWLIB_NET_ADAPTER* adapter, LPCSTR adapterName)
 {
 	DWORD dwBuf;
 	HANDLE hClient = NULL;
@@ -242,7 +242,7 @@ GetWlanInfo(NWLIB_NET_ADAPTER* adapter, PIP_ADAPTER_ADDRESSES_XP ipAdapter)
 	if (!OsWlanOpenHandle || !OsWlanQueryInterface || !OsWlanFreeMemory || !OsWlanCloseHandle)
 		goto end;
 
-	if (NWL_StrToGuid(ipAdapter->AdapterName, &guidIf) != TRUE)
+	if (NWL_StrToGuid(adapterName, &guidIf) != TRUE)
 		goto end;
 
 	if (OsWlanOpenHandle(2, NULL, &dwBuf, &hClient) != ERROR_SUCCESS)
@@ -270,6 +270,66 @@ end:
 		FreeLibrary(hL);
 }
 
+// The adapter map is rebuilt only after an interface, address or route
+// change notification. Other refreshes just read the interface counters.
+static HANDLE m_net_notify[3];
+static BOOL m_net_notify_tried;
+static BOOL m_net_notify_ok;
+static volatile LONG m_net_dirty = 1;
+static UINT64 m_net_addr_flags;
+
+static VOID NETIOAPI_API_
+IpInterfaceChanged(PVOID context, PMIB_IPINTERFACE_ROW row, MIB_NOTIFICATION_TYPE type)
+{
+	InterlockedExchange(&m_net_dirty, 1);
+}
+
+static VOID NETIOAPI_API_
+UnicastAddressChanged(PVOID context, PMIB_UNICASTIPADDRESS_ROW row, MIB_NOTIFICATION_TYPE type)
+{
+	InterlockedExchange(&m_net_dirty, 1);
+}
+
+static VOID NETIOAPI_API_
+RouteChanged(PVOID context, PMIB_IPFORWARD_ROW2 row, MIB_NOTIFICATION_TYPE type)
+{
+	InterlockedExchange(&m_net_dirty, 1);
+}
+
+static void
+NetNotifyStop(void)
+{
+	for (size_t i = 0; i < ARRAYSIZE(m_net_notify); i++)
+	{
+		if (m_net_notify[i])
+			CancelMibChangeNotify2(m_net_notify[i]);
+		m_net_notify[i] = NULL;
+	}
+	m_net_notify_ok = FALSE;
+	m_net_notify_tried = FALSE;
+	m_net_dirty = 1;
+}
+
+static void
+NetNotifyStart(void)
+{
+	if (m_net_notify_tried)
+		return;
+	m_net_notify_tried = TRUE;
+	if (NWLC->NwOsInfo.dwMajorVersion < 6)
+		return;
+	if (NotifyIpInterfaceChange(AF_UNSPEC, IpInterfaceChanged, NULL, FALSE, &m_net_notify[0]) != NO_ERROR ||
+		NotifyUnicastIpAddressChange(AF_UNSPEC, UnicastAddressChanged, NULL, FALSE, &m_net_notify[1]) != NO_ERROR ||
+		NotifyRouteChange2(AF_UNSPEC, RouteChanged, NULL, FALSE, &m_net_notify[2]) != NO_ERROR)
+	{
+		NWL_NodeAppendMultiSz(&NWLC->ErrLog, "Network change notification failed");
+		NetNotifyStop();
+		m_net_notify_tried = TRUE;
+		return;
+	}
+	m_net_notify_ok = TRUE;
+}
+
 static PIP_ADAPTER_ADDRESSES_XP
 GetXpAdaptersAddresses(PVOID* pEnd)
 {
@@ -310,8 +370,8 @@ GetXpAdaptersAddresses(PVOID* pEnd)
 	return (PIP_ADAPTER_ADDRESSES_XP)pAddresses;
 }
 
-NWLIB_NET_ADAPTER_MAP*
-NWL_GetNetAdapters(NWLIB_NET_ADAPTER_MAP* adapters)
+static NWLIB_NET_ADAPTER_MAP*
+NetAdaptersRebuild(NWLIB_NET_ADAPTER_MAP* adapters, ULONG64 nowTicks)
 {
 	PIP_ADAPTER_ADDRESSES_XP pAddresses = NULL;
 	PIP_ADAPTER_ADDRESSES_XP pCurrAddresses = NULL;
@@ -324,14 +384,11 @@ NWL_GetNetAdapters(NWLIB_NET_ADAPTER_MAP* adapters)
 	MIB_IF_ROW2 ifRow;
 	PVOID pMaxAddress = NULL;
 	BOOL bLonghornOrLater = (NWLC->NwOsInfo.dwMajorVersion >= 6);
-	ULONG64 nowTicks = GetTickCount64();
-
-	if (!(NWLC->NetFlags & (NW_NET_IPV4 | NW_NET_IPV6)))
-		NWLC->NetFlags |= NW_NET_IPV4 | NW_NET_IPV6;
 
 	pAddresses = GetXpAdaptersAddresses(&pMaxAddress);
 	if (!pAddresses)
 	{
+		InterlockedExchange(&m_net_dirty, 1);
 		if (adapters)
 		{
 			ptrdiff_t count = shlen(adapters);
@@ -371,6 +428,7 @@ NWL_GetNetAdapters(NWLIB_NET_ADAPTER_MAP* adapters)
 
 		ZeroMemory(&adapter, sizeof(adapter));
 		adapter.Ticks = nowTicks;
+		adapter.IfIndex = pCurrAddresses->IfIndex;
 		adapter.IfType = pCurrAddresses->IfType;
 		adapter.OperStatus = pCurrAddresses->OperStatus;
 		desc = NWL_Ucs2ToUtf8(pCurrAddresses->Description);
@@ -458,7 +516,7 @@ NWL_GetNetAdapters(NWLIB_NET_ADAPTER_MAP* adapters)
 		}
 
 		if (pCurrAddresses->IfType == IF_TYPE_IEEE80211)
-			GetWlanInfo(&adapter, pCurrAddresses);
+			GetWlanInfo(&adapter, adapterName);
 
 		if (prevEntry)
 		{
@@ -505,6 +563,98 @@ next_addr:
 			i++;
 		}
 	}
+	NWLC->NwNetGeneration++;
+	return adapters;
+}
+
+// Refresh traffic counters and the per-interface state that changes
+// without an address or route change. Returns TRUE if anything other
+// than the counters changed.
+static BOOL
+NetAdaptersPoll(NWLIB_NET_ADAPTER_MAP* adapters, ULONG64 nowTicks)
+{
+	BOOL bChanged = FALSE;
+	MIB_IF_ROW2 ifRow;
+	ptrdiff_t count = shlen(adapters);
+
+	for (ptrdiff_t i = 0; i < count; i++)
+	{
+		NWLIB_NET_ADAPTER* adapter = &adapters[i].value;
+		ULONG64 prevTicks = adapter->Ticks;
+
+		adapter->Ticks = nowTicks;
+		adapter->DiffReceived = 0;
+		adapter->DiffSent = 0;
+		if (adapter->IfIndex == 0)
+			continue;
+
+		ZeroMemory(&ifRow, sizeof(ifRow));
+		ifRow.InterfaceIndex = adapter->IfIndex;
+		if (GetIfEntry2(&ifRow) != NO_ERROR)
+			continue;
+
+		adapter->DiffReceived = NetRateFromDiff(ifRow.InOctets, adapter->ReceivedOctets, nowTicks, prevTicks);
+		adapter->DiffSent = NetRateFromDiff(ifRow.OutOctets, adapter->SentOctets, nowTicks, prevTicks);
+		adapter->ReceivedOctets = ifRow.InOctets;
+		adapter->SentOctets = ifRow.OutOctets;
+
+		ULONG64 txSpeed = (ifRow.TransmitLinkSpeed == ~0ULL) ? 0 : ifRow.TransmitLinkSpeed;
+		ULONG64 rxSpeed = (ifRow.ReceiveLinkSpeed == ~0ULL) ? 0 : ifRow.ReceiveLinkSpeed;
+		if (adapter->OperStatus != (DWORD)ifRow.OperStatus ||
+			adapter->TransmitLinkSpeed != txSpeed ||
+			adapter->ReceiveLinkSpeed != rxSpeed ||
+			adapter->Mtu != ifRow.Mtu)
+		{
+			adapter->OperStatus = ifRow.OperStatus;
+			adapter->TransmitLinkSpeed = txSpeed;
+			adapter->ReceiveLinkSpeed = rxSpeed;
+			adapter->Mtu = ifRow.Mtu;
+			bChanged = TRUE;
+		}
+
+		if (adapter->IfType == IF_TYPE_IEEE80211)
+		{
+			NWLIB_NET_ADAPTER wlan;
+			ZeroMemory(&wlan, sizeof(wlan));
+			GetWlanInfo(&wlan, adapters[i].key);
+			if (adapter->WLANState != wlan.WLANState ||
+				adapter->WLANSignalQuality != wlan.WLANSignalQuality ||
+				adapter->WLANAuth != wlan.WLANAuth ||
+				adapter->WLANCipher != wlan.WLANCipher ||
+				strcmp(adapter->WLANProfile, wlan.WLANProfile) != 0)
+			{
+				adapter->WLANState = wlan.WLANState;
+				adapter->WLANSignalQuality = wlan.WLANSignalQuality;
+				adapter->WLANAuth = wlan.WLANAuth;
+				adapter->WLANCipher = wlan.WLANCipher;
+				memcpy(adapter->WLANProfile, wlan.WLANProfile, sizeof(adapter->WLANProfile));
+				bChanged = TRUE;
+			}
+		}
+	}
+	return bChanged;
+}
+
+NWLIB_NET_ADAPTER_MAP*
+NWL_GetNetAdapters(NWLIB_NET_ADAPTER_MAP* adapters)
+{
+	ULONG64 nowTicks = GetTickCount64();
+	UINT64 addrFlags;
+
+	if (!(NWLC->NetFlags & (NW_NET_IPV4 | NW_NET_IPV6)))
+		NWLC->NetFlags |= NW_NET_IPV4 | NW_NET_IPV6;
+	addrFlags = NWLC->NetFlags & (NW_NET_IPV4 | NW_NET_IPV6);
+
+	NetNotifyStart();
+	if (adapters == NULL || !m_net_notify_ok || addrFlags != m_net_addr_flags ||
+		InterlockedExchange(&m_net_dirty, 0))
+	{
+		m_net_addr_flags = addrFlags;
+		return NetAdaptersRebuild(adapters, nowTicks);
+	}
+
+	if (NetAdaptersPoll(adapters, nowTicks))
+		NWLC->NwNetGeneration++;
 	return adapters;
 }
 
@@ -517,6 +667,7 @@ NWL_NetAdaptersCount(NWLIB_NET_ADAPTER_MAP* adapters)
 VOID
 NWL_FreeNetAdapters(NWLIB_NET_ADAPTER_MAP* adapters)
 {
+	NetNotifyStop();
 	ptrdiff_t count = shlen(adapters);
 	for (ptrdiff_t i = 0; i < count; i++)
 	{
@@ -592,17 +743,12 @@ AppendAddressTable(PNODE parent, LPCSTR title, LPCSTR row, const NWLIB_NET_ADDRE
 	}
 }
 
-PNODE NW_Network(BOOL bAppend)
+PNODE
+NWL_NetAdaptersToNode(NWLIB_NET_ADAPTER_MAP* adapters)
 {
-	NWLIB_NET_ADAPTER_MAP* adapters;
 	PNODE node = NWL_NodeAlloc("Network", NFLG_TABLE);
 	BOOL bLonghornOrLater = (NWLC->NwOsInfo.dwMajorVersion >= 6);
 
-	if (bAppend)
-		NWL_NodeAppendChild(NWLC->NwRoot, node);
-
-	NWLC->NwNetAdapters = NWL_GetNetAdapters(NWLC->NwNetAdapters);
-	adapters = NWLC->NwNetAdapters;
 	if (!adapters)
 		return node;
 
@@ -695,3 +841,17 @@ PNODE NW_Network(BOOL bAppend)
 
 	return node;
 }
+
+PNODE NW_Network(BOOL bAppend)
+{
+	PNODE node;
+
+	// DNS servers, anycast and multicast lists have no change notification,
+	// so a full report always re-reads the adapters.
+	InterlockedExchange(&m_net_dirty, 1);
+	NWLC->NwNetAdapters = NWL_GetNetAdapters(NWLC->NwNetAdapters);
+	node = NWL_NetAdaptersToNode(NWLC->NwNetAdapters);
+	if (bAppend)
+		NWL_NodeAppendChild(NWLC->NwRoot, node);
+	return node;
+}
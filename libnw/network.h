@@ -27,6 +27,7 @@ typedef struct _NWLIB_NET_ADAPTER
 {
 	CHAR Description[NWL_NET_DESC_LEN];
 	ULONG64 Ticks;
+	DWORD IfIndex;
 	DWORD IfType;
 	CHAR MACAddress[NWL_NET_MAC_LEN];
 	DWORD OperStatus;
@@ -70,3 +71,5 @@ LIBNW_API NWLIB_NET_ADAPTER_MAP* NWL_GetNetAdapters(NWLIB_NET_ADAPTER_MAP* adapt
 LIBNW_API ptrdiff_t NWL_NetAdaptersCount(NWLIB_NET_ADAPTER_MAP* adapters);
 LIBNW_API VOID NWL_FreeNetAdapters(NWLIB_NET_ADAPTER_MAP* adapters);
 LIBNW_API VOID NWL_GetNetTraffic(NWLIB_NET_TRAFFIC* info, BOOL bit, const NWLIB_NET_ADAPTER_MAP* adapters);
+// Build the "Network" node from the current adapter map without refreshing it.
+LIBNW_API struct _NODE* NWL_NetAdaptersToNode(NWLIB_NET_ADAPTER_MAP* adapters);
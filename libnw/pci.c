@@ -8,6 +8,7 @@
 
 #include "libnw.h"
 #include "utils.h"
+#include "utf.h"
 #include "stb_ds.h"
 
 #pragma comment(lib, "setupapi.lib")
@@ -21,35 +22,6 @@ static const DEVPROPKEY DEVPKEY_PciDevice_MaxLinkSpeed =
 static const DEVPROPKEY DEVPKEY_PciDevice_MaxLinkWidth =
 { { 0x3ab22e31, 0x8264, 0x4b4e, { 0x9a, 0xf5, 0xa8, 0xd2, 0xd8, 0xe3, 0x3e, 0x62 } }, 12 };
 
-static void
-PrintDriverInfo(PNODE pNode, HDEVINFO hInfo, SP_DEVINFO_DATA* spData)
-{
-	FILETIME ft = { 0 };
-	DEVPROPTYPE propType;
-	if (SetupDiGetDevicePropertyW(hInfo, spData, &DEVPKEY_Device_DriverDesc, &propType, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL, 0)
-		&& propType == DEVPROP_TYPE_STRING)
-		NWL_NodeAttrSet(pNode, "Driver", NWL_Ucs2ToUtf8(NWLC->NwBufW), 0);
-	if (SetupDiGetDevicePropertyW(hInfo, spData, &DEVPKEY_Device_DriverVersion, &propType, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL, 0)
-		&& propType == DEVPROP_TYPE_STRING)
-		NWL_NodeAttrSet(pNode, "Driver Version", NWL_Ucs2ToUtf8(NWLC->NwBufW), 0);
-	if (SetupDiGetDevicePropertyW(hInfo, spData, &DEVPKEY_Device_DriverProvider, &propType, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL, 0)
-		&& propType == DEVPROP_TYPE_STRING)
-		NWL_NodeAttrSet(pNode, "Driver Provider", NWL_Ucs2ToUtf8(NWLC->NwBufW), 0);
-	if (SetupDiGetDevicePropertyW(hInfo, spData, &DEVPKEY_Device_DriverDate, &propType, (PBYTE)&ft, sizeof(FILETIME), NULL, 0)
-		&& propType == DEVPROP_TYPE_FILETIME)
-	{
-		SYSTEMTIME st;
-		if (FileTimeToSystemTime(&ft, &st))
-			NWL_NodeAttrSetf(pNode, "Driver Date", 0, "%u-%02u-%02u", st.wYear, st.wMonth, st.wDay);
-	}
-	if (SetupDiGetDevicePropertyW(hInfo, spData, &DEVPKEY_Device_DriverInfPath, &propType, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL, 0)
-		&& propType == DEVPROP_TYPE_STRING)
-		NWL_NodeAttrSet(pNode, "Inf Path", NWL_Ucs2ToUtf8(NWLC->NwBufW), 0);
-	if (SetupDiGetDevicePropertyW(hInfo, spData, &DEVPKEY_Device_DriverInfSection, &propType, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL, 0)
-		&& propType == DEVPROP_TYPE_STRING)
-		NWL_NodeAttrSet(pNode, "Inf Section", NWL_Ucs2ToUtf8(NWLC->NwBufW), 0);
-}
-
 static void
 ConvertPciPath(const char* path, char* buf, size_t bufSize)
 {
@@ -105,71 +77,234 @@ ConvertAcpiPath(const char* path, char* buf, size_t bufSize)
 	}
 }
 
-static void
-PrintLocationPaths(PNODE pNode, HDEVINFO hInfo, SP_DEVINFO_DATA* spData)
+static BOOL
+MatchPciClass(PNWL_ARG_SET pciClasses, const char* hwClass)
 {
-	char convBuf[512];
-	if (!SetupDiGetDeviceRegistryPropertyW(hInfo, spData,
-		SPDRP_LOCATION_PATHS, NULL, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL))
-		return;
-	for (LPCWSTR p = NWLC->NwBufW; p[0]; p += wcslen(p) + 1)
+	if (!pciClasses)
+		return TRUE;
+
+	for (ptrdiff_t i = 0; i < hmlen(pciClasses); i++)
 	{
-		const char* path = NWL_Ucs2ToUtf8(p);
-		if (_strnicmp(path, "PCIROOT(", 8) == 0 || _strnicmp(path, "PCI(", 4) == 0)
-		{
-			NWL_NodeAttrSet(pNode, "PCI Path", path, NAFLG_FMT_NEED_QUOTE);
-			ConvertPciPath(path, convBuf, sizeof(convBuf));
-			NWL_NodeAttrSet(pNode, "UEFI Device Path", convBuf, NAFLG_FMT_NEED_QUOTE);
-		}
-		else if (_strnicmp(path, "ACPI(", 5) == 0)
+		const char* pciClass = pciClasses[i].key.Str;
+		size_t classLen = strnlen_s(pciClass, 6);
+
+		if (_strnicmp(pciClass, hwClass, classLen) == 0)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+#define PCI_RESOLVE_WORKERS 8
+#define PCI_RESOLVE_BATCH 32
+
+enum
+{
+	PCI_STR_DESC = 0,
+	PCI_STR_DRV_DESC,
+	PCI_STR_DRV_VERSION,
+	PCI_STR_DRV_PROVIDER,
+	PCI_STR_DRV_INF_PATH,
+	PCI_STR_DRV_INF_SECTION,
+	PCI_STR_LOCATION,
+	PCI_STR_MFG,
+	PCI_STR_PDO,
+	PCI_STR_MAX
+};
+
+enum
+{
+	PCI_LINK_CUR_SPEED = 0,
+	PCI_LINK_CUR_WIDTH,
+	PCI_LINK_MAX_SPEED,
+	PCI_LINK_MAX_WIDTH,
+	PCI_LINK_MAX
+};
+
+// Raw properties of all matching devices, one array per property.
+typedef struct
+{
+	DWORD Count;
+	DWORD Capacity;
+	WCHAR** HwId;
+	CHAR(*HwClass)[7];
+	CHAR** Str[PCI_STR_MAX];
+	SYSTEMTIME* DrvDate;
+	BOOL* HasDrvDate;
+	ULONG* BusNum;
+	ULONG* DevFunc;
+	UINT32(*Link)[PCI_LINK_MAX];
+	BOOL(*HasLink)[2];
+	WCHAR** LocPaths;
+	// Filled by the resolve phase, devices with identical IDs share nodes.
+	DWORD* Alias;
+	PNODE* IdNode;
+	PNODE* ClassNode;
+	volatile LONG Next;
+	DWORD* Unique;
+	DWORD UniqueCount;
+} PCI_DEV_SET;
+
+// "class|hwid" to the index of the first device with those IDs.
+typedef struct
+{
+	char* key;
+	DWORD value;
+} PCI_ID_MAP;
+
+static BOOL
+GrowPciSet(PCI_DEV_SET* set)
+{
+	DWORD cap = set->Capacity ? set->Capacity * 2 : 64;
+	void* p;
+#define PCI_GROW(field) \
+	do { \
+		p = realloc((void*)set->field, cap * sizeof(*set->field)); \
+		if (!p) return FALSE; \
+		set->field = p; \
+		ZeroMemory((void*)&set->field[set->Capacity], (cap - set->Capacity) * sizeof(*set->field)); \
+	} while (0)
+	PCI_GROW(HwId);
+	PCI_GROW(HwClass);
+	for (int i = 0; i < PCI_STR_MAX; i++)
+		PCI_GROW(Str[i]);
+	PCI_GROW(DrvDate);
+	PCI_GROW(HasDrvDate);
+	PCI_GROW(BusNum);
+	PCI_GROW(DevFunc);
+	PCI_GROW(Link);
+	PCI_GROW(HasLink);
+	PCI_GROW(LocPaths);
+	PCI_GROW(Alias);
+	PCI_GROW(IdNode);
+	PCI_GROW(ClassNode);
+	PCI_GROW(Unique);
+#undef PCI_GROW
+	set->Capacity = cap;
+	return TRUE;
+}
+
+static VOID
+FreePciSet(PCI_DEV_SET* set)
+{
+	for (DWORD i = 0; i < set->Count; i++)
+	{
+		free(set->HwId[i]);
+		for (int j = 0; j < PCI_STR_MAX; j++)
+			free(set->Str[j][i]);
+		free(set->LocPaths[i]);
+		if (set->Alias[i] == i)
 		{
-			NWL_NodeAttrSet(pNode, "ACPI Path", path, NAFLG_FMT_NEED_QUOTE);
-			ConvertAcpiPath(path, convBuf, sizeof(convBuf));
-			NWL_NodeAttrSet(pNode, "ASL Path", convBuf, NAFLG_FMT_NEED_QUOTE);
+			NWL_NodeFree(set->IdNode[i], 1);
+			NWL_NodeFree(set->ClassNode[i], 1);
 		}
 	}
+	free(set->HwId);
+	free(set->HwClass);
+	for (int j = 0; j < PCI_STR_MAX; j++)
+		free(set->Str[j]);
+	free(set->DrvDate);
+	free(set->HasDrvDate);
+	free(set->BusNum);
+	free(set->DevFunc);
+	free(set->Link);
+	free(set->HasLink);
+	free(set->LocPaths);
+	free(set->Alias);
+	free(set->IdNode);
+	free(set->ClassNode);
+	free(set->Unique);
+	ZeroMemory(set, sizeof(PCI_DEV_SET));
 }
 
-static void
-PrintPcieLink(PNODE node, HDEVINFO hInfo, SP_DEVINFO_DATA* spData, LPCSTR name, const DEVPROPKEY* pkeyWidth, const DEVPROPKEY* pkeySpeed)
+static CHAR*
+GetRegString(HDEVINFO hInfo, SP_DEVINFO_DATA* spData, DWORD dwProp)
+{
+	if (!SetupDiGetDeviceRegistryPropertyW(hInfo, spData,
+		dwProp, NULL, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL))
+		return NULL;
+	return NWL_Utf16ToUtf8Dup((const uint16_t*)NWLC->NwBufW, NWL_UTF_NUL, NULL);
+}
+
+static CHAR*
+GetPropString(HDEVINFO hInfo, SP_DEVINFO_DATA* spData, const DEVPROPKEY* pKey)
+{
+	DEVPROPTYPE propType;
+	if (!SetupDiGetDevicePropertyW(hInfo, spData, pKey, &propType, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL, 0)
+		|| propType != DEVPROP_TYPE_STRING)
+		return NULL;
+	return NWL_Utf16ToUtf8Dup((const uint16_t*)NWLC->NwBufW, NWL_UTF_NUL, NULL);
+}
+
+static WCHAR*
+GetRegMultiSz(HDEVINFO hInfo, SP_DEVINFO_DATA* spData, DWORD dwProp)
+{
+	size_t len = 0;
+	WCHAR* p;
+	if (!SetupDiGetDeviceRegistryPropertyW(hInfo, spData,
+		dwProp, NULL, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL))
+		return NULL;
+	while (len < NWINFO_BUFSZ - 1 && NWLC->NwBufW[len])
+		len += wcsnlen_s(&NWLC->NwBufW[len], NWINFO_BUFSZ - len) + 1;
+	p = malloc((len + 1) * sizeof(WCHAR));
+	if (!p)
+		return NULL;
+	memcpy(p, NWLC->NwBufW, len * sizeof(WCHAR));
+	p[len] = L'\0';
+	return p;
+}
+
+static VOID
+GetPcieLink(HDEVINFO hInfo, SP_DEVINFO_DATA* spData, const DEVPROPKEY* pkeyWidth, const DEVPROPKEY* pkeySpeed,
+	UINT32* pSpeed, UINT32* pWidth, BOOL* pValid)
 {
 	DEVPROPTYPE propType = DEVPROP_TYPE_EMPTY;
-	UINT32 linkSpeed = 0;
-	UINT32 linkWidth = 0;
 
-	if (!SetupDiGetDevicePropertyW(hInfo, spData, pkeySpeed,
-		&propType, (PBYTE)&linkSpeed, sizeof(linkSpeed), NULL, 0))
+	*pValid = SetupDiGetDevicePropertyW(hInfo, spData, pkeySpeed,
+		&propType, (PBYTE)pSpeed, sizeof(UINT32), NULL, 0);
+	if (!*pValid)
 		return;
 
 	propType = DEVPROP_TYPE_EMPTY;
 	SetupDiGetDevicePropertyW(hInfo, spData, pkeyWidth,
-		&propType, (PBYTE)&linkWidth, sizeof(linkWidth), NULL, 0);
-
-	if (linkWidth != 0)
-		NWL_NodeAttrSetf(node, name, 0, "PCIe %u.0 x%u", linkSpeed, linkWidth);
-	else
-		NWL_NodeAttrSetf(node, name, 0, "PCIe %u.0", linkSpeed);
+		&propType, (PBYTE)pWidth, sizeof(UINT32), NULL, 0);
 }
 
-static BOOL
-MatchPciClass(PNWL_ARG_SET pciClasses, const char* hwClass)
+// Phase one, everything that needs the device information set.
+static VOID
+GatherPciDevice(PCI_DEV_SET* set, DWORD i, HDEVINFO hInfo, SP_DEVINFO_DATA* spData)
 {
-	if (!pciClasses)
-		return TRUE;
+	FILETIME ft = { 0 };
+	DEVPROPTYPE propType;
 
-	for (ptrdiff_t i = 0; i < hmlen(pciClasses); i++)
-	{
-		const char* pciClass = pciClasses[i].key.Str;
-		size_t classLen = strnlen_s(pciClass, 6);
+	set->Str[PCI_STR_DESC][i] = GetRegString(hInfo, spData, SPDRP_DEVICEDESC);
+	set->Str[PCI_STR_DRV_DESC][i] = GetPropString(hInfo, spData, &DEVPKEY_Device_DriverDesc);
+	set->Str[PCI_STR_DRV_VERSION][i] = GetPropString(hInfo, spData, &DEVPKEY_Device_DriverVersion);
+	set->Str[PCI_STR_DRV_PROVIDER][i] = GetPropString(hInfo, spData, &DEVPKEY_Device_DriverProvider);
+	if (SetupDiGetDevicePropertyW(hInfo, spData, &DEVPKEY_Device_DriverDate, &propType, (PBYTE)&ft, sizeof(FILETIME), NULL, 0)
+		&& propType == DEVPROP_TYPE_FILETIME)
+		set->HasDrvDate[i] = FileTimeToSystemTime(&ft, &set->DrvDate[i]);
+	set->Str[PCI_STR_DRV_INF_PATH][i] = GetPropString(hInfo, spData, &DEVPKEY_Device_DriverInfPath);
+	set->Str[PCI_STR_DRV_INF_SECTION][i] = GetPropString(hInfo, spData, &DEVPKEY_Device_DriverInfSection);
 
-		if (_strnicmp(pciClass, hwClass, classLen) == 0)
-			return TRUE;
-	}
+	SetupDiGetDeviceRegistryPropertyW(hInfo, spData,
+		SPDRP_BUSNUMBER, NULL, (PBYTE)&set->BusNum[i], sizeof(ULONG), NULL);
+	SetupDiGetDeviceRegistryPropertyW(hInfo, spData,
+		SPDRP_ADDRESS, NULL, (PBYTE)&set->DevFunc[i], sizeof(ULONG), NULL);
+	set->Str[PCI_STR_LOCATION][i] = GetRegString(hInfo, spData, SPDRP_LOCATION_INFORMATION);
 
-	return FALSE;
+	GetPcieLink(hInfo, spData, &DEVPKEY_PciDevice_CurrentLinkWidth, &DEVPKEY_PciDevice_CurrentLinkSpeed,
+		&set->Link[i][PCI_LINK_CUR_SPEED], &set->Link[i][PCI_LINK_CUR_WIDTH], &set->HasLink[i][0]);
+	GetPcieLink(hInfo, spData, &DEVPKEY_PciDevice_MaxLinkWidth, &DEVPKEY_PciDevice_MaxLinkSpeed,
+		&set->Link[i][PCI_LINK_MAX_SPEED], &set->Link[i][PCI_LINK_MAX_WIDTH], &set->HasLink[i][1]);
+
+	set->Str[PCI_STR_MFG][i] = GetRegString(hInfo, spData, SPDRP_MFG);
+	set->Str[PCI_STR_PDO][i] = GetRegString(hInfo, spData, SPDRP_PHYSICAL_DEVICE_OBJECT_NAME);
+	set->LocPaths[i] = GetRegMultiSz(hInfo, spData, SPDRP_LOCATION_PATHS);
 }
 
-PNODE NWL_EnumPci(PNODE pNode, PNWL_ARG_SET pciClasses)
+static DWORD
+GatherPciDevices(PCI_DEV_SET* set, PNWL_ARG_SET pciClasses)
 {
 	HDEVINFO hInfo = NULL;
 	DWORD i = 0;
@@ -179,12 +314,12 @@ PNODE NWL_EnumPci(PNODE pNode, PNWL_ARG_SET pciClasses)
 	if (hInfo == INVALID_HANDLE_VALUE)
 	{
 		NWL_NodeAppendMultiSz(&NWLC->ErrLog, "SetupDiGetClassDevs failed");
-		goto fail;
+		return 0;
 	}
 	for (i = 0; SetupDiEnumDeviceInfo(hInfo, i, &spData); i++)
 	{
 		CHAR hwClass[7] = { 0 };
-		PNODE npci;
+		DWORD n = set->Count;
 		if (!SetupDiGetDeviceRegistryPropertyW(hInfo, &spData,
 			SPDRP_HARDWAREID, NULL, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL))
 			continue;
@@ -194,55 +329,202 @@ PNODE NWL_EnumPci(PNODE pNode, PNWL_ARG_SET pciClasses)
 			LPCWSTR s = wcsstr(p, L"&CC_");
 			if (s != NULL)
 			{
-				strncpy_s(hwClass, sizeof(hwClass), NWL_Ucs2ToUtf8(s + 4), _TRUNCATE);
+				NWL_Utf16ToUtf8((const uint16_t*)(s + 4), NWL_UTF_NUL, hwClass, sizeof(hwClass));
 				break;
 			}
 		}
 		if (!MatchPciClass(pciClasses, hwClass))
 			continue;
-		npci = NWL_NodeAppendNew(pNode, "Device", NFLG_TABLE_ROW);
-
-		NWL_NodeAttrSet(npci, "HWID", NWL_Ucs2ToUtf8(NWLC->NwBufW), 0);
-		NWL_ParseHwid(npci, &NWLC->NwPciIds, NWLC->NwBufW, 0);
+		if (n >= set->Capacity && !GrowPciSet(set))
+		{
+			NWL_NodeAppendMultiSz(&NWLC->ErrLog, "Memory allocation failed in "__FUNCTION__);
+			break;
+		}
+		set->HwId[n] = _wcsdup(NWLC->NwBufW);
+		if (!set->HwId[n])
+			continue;
+		memcpy(set->HwClass[n], hwClass, sizeof(hwClass));
+		set->Alias[n] = n;
+		set->Count++;
+		GatherPciDevice(set, n, hInfo, &spData);
+	}
+	SetupDiDestroyDeviceInfoList(hInfo);
+	return set->Count;
+}
 
-		if (SetupDiGetDeviceRegistryPropertyW(hInfo, &spData,
-			SPDRP_DEVICEDESC, NULL, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL))
-			NWL_NodeAttrSet(npci, "Description", NWL_Ucs2ToUtf8(NWLC->NwBufW), 0);
+static VOID
+ResolvePciIds(PCI_DEV_SET* set, DWORD i)
+{
+	set->IdNode[i] = NWL_NodeAlloc("IDS", 0);
+	NWL_ParseHwid(set->IdNode[i], &NWLC->NwPciIds, set->HwId[i], 0);
+	set->ClassNode[i] = NWL_NodeAlloc("IDS", 0);
+	NWL_FindClass(set->ClassNode[i], &NWLC->NwPciIds, set->HwClass[i], 0);
+}
 
-		PrintDriverInfo(npci, hInfo, &spData);
+static DWORD WINAPI
+ResolveWorker(LPVOID lpParameter)
+{
+	PCI_DEV_SET* set = lpParameter;
+	for (;;)
+	{
+		LONG i = InterlockedIncrement(&set->Next) - 1;
+		if (i >= (LONG)set->UniqueCount)
+			break;
+		ResolvePciIds(set, set->Unique[i]);
+	}
+	return 0;
+}
 
-		ULONG busNum = 0, devFunc = 0;
-		SetupDiGetDeviceRegistryPropertyW(hInfo, &spData,
-			SPDRP_BUSNUMBER, NULL, (PBYTE)&busNum, sizeof(busNum), NULL);
-		SetupDiGetDeviceRegistryPropertyW(hInfo, &spData,
-			SPDRP_ADDRESS, NULL, (PBYTE)&devFunc, sizeof(devFunc), NULL);
+// Phase two, pci.ids lookups only touch the detached IDS nodes, so
+// distinct devices can be resolved in parallel.
+static VOID
+ResolvePciDevices(PCI_DEV_SET* set)
+{
+	DWORD i;
+	DWORD dwThreads = 0;
+	HANDLE hThreads[PCI_RESOLVE_WORKERS] = { 0 };
+	DWORD dwWorkers;
+	PCI_ID_MAP* ids = NULL;
 
-		if (SetupDiGetDeviceRegistryPropertyW(hInfo, &spData,
-			SPDRP_LOCATION_INFORMATION, NULL, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL))
-			NWL_NodeAttrSet(npci, "Location", NWL_Ucs2ToUtf8(NWLC->NwBufW), 0);
+	sh_new_arena(ids);
+	for (i = 0; i < set->Count; i++)
+	{
+		ptrdiff_t k;
+		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s|%s", set->HwClass[i], NWL_Ucs2ToUtf8(set->HwId[i]));
+		k = shgeti(ids, NWLC->NwBuf);
+		if (k >= 0)
+			set->Alias[i] = ids[k].value;
 		else
-			NWL_NodeAttrSetf(npci, "Location", NAFLG_FMT_NEED_QUOTE, "Bus %u, Device %u, Function %u",
-				busNum & 0xFF, (devFunc >> 16) & 0x1F, devFunc & 0x07);
-
-		NWL_NodeAttrSetf(npci, "BDF", NAFLG_FMT_NEED_QUOTE, "%02X:%02X.%u", busNum & 0xFF, (devFunc >> 16) & 0x1F, devFunc & 0x07);
-		PrintPcieLink(npci, hInfo, &spData, "PCIe Current Link", &DEVPKEY_PciDevice_CurrentLinkWidth, &DEVPKEY_PciDevice_CurrentLinkSpeed);
-		PrintPcieLink(npci, hInfo, &spData, "PCIe Max Link", &DEVPKEY_PciDevice_MaxLinkWidth, &DEVPKEY_PciDevice_MaxLinkSpeed);
+		{
+			shput(ids, NWLC->NwBuf, i);
+			set->Unique[set->UniqueCount++] = i;
+		}
+	}
+	shfree(ids);
 
-		if (SetupDiGetDeviceRegistryPropertyW(hInfo, &spData,
-			SPDRP_MFG, NULL, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL))
-			NWL_NodeAttrSet(npci, "MFG", NWL_Ucs2ToUtf8(NWLC->NwBufW), 0);
+	dwWorkers = min(set->UniqueCount / PCI_RESOLVE_BATCH, PCI_RESOLVE_WORKERS);
+	for (i = 0; i < dwWorkers; i++)
+	{
+		hThreads[dwThreads] = CreateThread(NULL, 0, ResolveWorker, set, 0, NULL);
+		if (hThreads[dwThreads])
+			dwThreads++;
+	}
+	ResolveWorker(set);
+	if (dwThreads == 0)
+		return;
+	WaitForMultipleObjects(dwThreads, hThreads, TRUE, INFINITE);
+	for (i = 0; i < dwThreads; i++)
+		CloseHandle(hThreads[i]);
+}
 
-		if (SetupDiGetDeviceRegistryPropertyW(hInfo, &spData,
-			SPDRP_PHYSICAL_DEVICE_OBJECT_NAME, NULL, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL))
-			NWL_NodeAttrSet(npci, "PDO", NWL_Ucs2ToUtf8(NWLC->NwBufW), 0);
+static VOID
+CopyAttrs(PNODE dst, PNODE src)
+{
+	INT count = NWL_NodeAttrCount(src);
+	for (INT i = 0; i < count; i++)
+	{
+		PNODE_ATT att = NWL_NodeAttrEnum(src, i);
+		NWL_NodeAttrSet(dst, att->key, att->value, att->flags);
+	}
+}
 
-		NWL_NodeAttrSet(npci, "Class Code", hwClass, 0);
-		NWL_FindClass(npci, &NWLC->NwPciIds, hwClass, 0);
+static VOID
+PrintPcieLink(PNODE node, LPCSTR name, BOOL bValid, UINT32 linkSpeed, UINT32 linkWidth)
+{
+	if (!bValid)
+		return;
+	if (linkWidth != 0)
+		NWL_NodeAttrSetf(node, name, 0, "PCIe %u.0 x%u", linkSpeed, linkWidth);
+	else
+		NWL_NodeAttrSetf(node, name, 0, "PCIe %u.0", linkSpeed);
+}
 
-		PrintLocationPaths(npci, hInfo, &spData);
+static VOID
+PrintLocationPaths(PNODE pNode, LPCWSTR lpPaths)
+{
+	char convBuf[512];
+	if (!lpPaths)
+		return;
+	for (LPCWSTR p = lpPaths; p[0]; p += wcslen(p) + 1)
+	{
+		const char* path = NWL_Ucs2ToUtf8(p);
+		if (_strnicmp(path, "PCIROOT(", 8) == 0 || _strnicmp(path, "PCI(", 4) == 0)
+		{
+			NWL_NodeAttrSet(pNode, "PCI Path", path, NAFLG_FMT_NEED_QUOTE);
+			ConvertPciPath(path, convBuf, sizeof(convBuf));
+			NWL_NodeAttrSet(pNode, "UEFI Device Path", convBuf, NAFLG_FMT_NEED_QUOTE);
+		}
+		else if (_strnicmp(path, "ACPI(", 5) == 0)
+		{
+			NWL_NodeAttrSet(pNode, "ACPI Path", path, NAFLG_FMT_NEED_QUOTE);
+			ConvertAcpiPath(path, convBuf, sizeof(convBuf));
+			NWL_NodeAttrSet(pNode, "ASL Path", convBuf, NAFLG_FMT_NEED_QUOTE);
+		}
 	}
-	SetupDiDestroyDeviceInfoList(hInfo);
+}
+
+static VOID
+EmitPciDevice(PNODE pNode, PCI_DEV_SET* set, DWORD i)
+{
+	DWORD k = set->Alias[i];
+	ULONG busNum = set->BusNum[i];
+	ULONG devFunc = set->DevFunc[i];
+	PNODE npci = NWL_NodeAppendNew(pNode, "Device", NFLG_TABLE_ROW);
+
+	NWL_NodeAttrSet(npci, "HWID", NWL_Ucs2ToUtf8(set->HwId[i]), 0);
+	CopyAttrs(npci, set->IdNode[k]);
+
+	if (set->Str[PCI_STR_DESC][i])
+		NWL_NodeAttrSet(npci, "Description", set->Str[PCI_STR_DESC][i], 0);
+
+	if (set->Str[PCI_STR_DRV_DESC][i])
+		NWL_NodeAttrSet(npci, "Driver", set->Str[PCI_STR_DRV_DESC][i], 0);
+	if (set->Str[PCI_STR_DRV_VERSION][i])
+		NWL_NodeAttrSet(npci, "Driver Version", set->Str[PCI_STR_DRV_VERSION][i], 0);
+	if (set->Str[PCI_STR_DRV_PROVIDER][i])
+		NWL_NodeAttrSet(npci, "Driver Provider", set->Str[PCI_STR_DRV_PROVIDER][i], 0);
+	if (set->HasDrvDate[i])
+		NWL_NodeAttrSetf(npci, "Driver Date", 0, "%u-%02u-%02u",
+			set->DrvDate[i].wYear, set->DrvDate[i].wMonth, set->DrvDate[i].wDay);
+	if (set->Str[PCI_STR_DRV_INF_PATH][i])
+		NWL_NodeAttrSet(npci, "Inf Path", set->Str[PCI_STR_DRV_INF_PATH][i], 0);
+	if (set->Str[PCI_STR_DRV_INF_SECTION][i])
+		NWL_NodeAttrSet(npci, "Inf Section", set->Str[PCI_STR_DRV_INF_SECTION][i], 0);
+
+	if (set->Str[PCI_STR_LOCATION][i])
+		NWL_NodeAttrSet(npci, "Location", set->Str[PCI_STR_LOCATION][i], 0);
+	else
+		NWL_NodeAttrSetf(npci, "Location", NAFLG_FMT_NEED_QUOTE, "Bus %u, Device %u, Function %u",
+			busNum & 0xFF, (devFunc >> 16) & 0x1F, devFunc & 0x07);
+
+	NWL_NodeAttrSetf(npci, "BDF", NAFLG_FMT_NEED_QUOTE, "%02X:%02X.%u", busNum & 0xFF, (devFunc >> 16) & 0x1F, devFunc & 0x07);
+	PrintPcieLink(npci, "PCIe Current Link", set->HasLink[i][0],
+		set->Link[i][PCI_LINK_CUR_SPEED], set->Link[i][PCI_LINK_CUR_WIDTH]);
+	PrintPcieLink(npci, "PCIe Max Link", set->HasLink[i][1],
+		set->Link[i][PCI_LINK_MAX_SPEED], set->Link[i][PCI_LINK_MAX_WIDTH]);
+
+	if (set->Str[PCI_STR_MFG][i])
+		NWL_NodeAttrSet(npci, "MFG", set->Str[PCI_STR_MFG][i], 0);
+	if (set->Str[PCI_STR_PDO][i])
+		NWL_NodeAttrSet(npci, "PDO", set->Str[PCI_STR_PDO][i], 0);
+
+	NWL_NodeAttrSet(npci, "Class Code", set->HwClass[i], 0);
+	CopyAttrs(npci, set->ClassNode[k]);
+
+	PrintLocationPaths(npci, set->LocPaths[i]);
+}
+
+PNODE NWL_EnumPci(PNODE pNode, PNWL_ARG_SET pciClasses)
+{
+	PCI_DEV_SET set = { 0 };
+
+	if (GatherPciDevices(&set, pciClasses) == 0)
+		goto fail;
+	ResolvePciDevices(&set);
+	for (DWORD i = 0; i < set.Count; i++)
+		EmitPciDevice(pNode, &set, i);
 fail:
+	FreePciSet(&set);
 	return pNode;
 }
 
@@ -4,89 +4,243 @@
 #include <string.h>
 #include <windows.h>
 #include <winioctl.h>
+#include <setupapi.h>
+#include <cfgmgr32.h>
 #include "libnw.h"
 #include "utils.h"
 #include "disk.h"
 #include "sensors.h"
 
+#define DISK_RESCAN_INTERVAL (10 * 1000)
+
 struct disk_stats
 {
 	CHAR name[32];
+	DWORD index;
+	HANDLE handle;
+	WCHAR path[512];
+	BOOL present;
 	DISK_PERFORMANCE perf;
 };
 
 static struct
 {
-	PHY_DRIVE_INFO* drives;
 	DWORD count;
 	struct disk_stats* stats;
+	volatile LONG changed;
+	ULONGLONG last_scan;
+	HMODULE cfgmgr;
+	HCMNOTIFICATION notify;
+	CONFIGRET(WINAPI* unregister)(HCMNOTIFICATION);
 } ctx;
 
-static bool disk_init(void)
+typedef struct
 {
-	ctx.count = NWL_GetDriveInfoList(FALSE, FALSE, &ctx.drives);
-	if (ctx.count == 0 || ctx.drives == NULL)
-		return false;
+	DWORD cbSize;
+	WCHAR DevicePath[512];
+} DISK_IF_DETAIL;
 
-	ctx.stats = calloc(ctx.count, sizeof(struct disk_stats));
-	if (ctx.stats == NULL)
-	{
-		NWL_DestoryDriveInfoList(ctx.drives, ctx.count);
-		ZeroMemory(&ctx, sizeof(ctx));
-		return false;
-	}
+static DWORD CALLBACK
+disk_notify(HCMNOTIFICATION hNotify, PVOID Context, CM_NOTIFY_ACTION Action,
+	PCM_NOTIFY_EVENT_DATA EventData, DWORD EventDataSize)
+{
+	(void)hNotify;
+	(void)Context;
+	(void)EventData;
+	(void)EventDataSize;
+	if (Action == CM_NOTIFY_ACTION_DEVICEINTERFACEARRIVAL || Action == CM_NOTIFY_ACTION_DEVICEINTERFACEREMOVAL)
+		InterlockedExchange(&ctx.changed, 1);
+	return ERROR_SUCCESS;
+}
 
-	qsort(ctx.drives, ctx.count, sizeof(PHY_DRIVE_INFO), NWL_CompareDiskId);
+// Interface arrival/removal marks the topology dirty. Without
+// CM_Register_Notification (Windows 7) fall back to a slow rescan timer.
+static void disk_register_notify(void)
+{
+	CONFIGRET(WINAPI * reg)(PCM_NOTIFY_FILTER, PVOID, PCM_NOTIFY_CALLBACK, PHCMNOTIFICATION) = NULL;
+	CM_NOTIFY_FILTER filter = { .cbSize = sizeof(CM_NOTIFY_FILTER) };
 
+	ctx.cfgmgr = LoadLibraryW(L"cfgmgr32.dll");
+	if (ctx.cfgmgr == NULL)
+		return;
+	*(FARPROC*)&reg = GetProcAddress(ctx.cfgmgr, "CM_Register_Notification");
+	*(FARPROC*)&ctx.unregister = GetProcAddress(ctx.cfgmgr, "CM_Unregister_Notification");
+	if (reg == NULL || ctx.unregister == NULL)
+		goto fail;
+	filter.FilterType = CM_NOTIFY_FILTER_TYPE_DEVICEINTERFACE;
+	filter.u.DeviceInterface.ClassGuid = GUID_DEVINTERFACE_DISK;
+	if (reg(&filter, NULL, disk_notify, &ctx.notify) == CR_SUCCESS)
+		return;
+fail:
+	FreeLibrary(ctx.cfgmgr);
+	ctx.cfgmgr = NULL;
+	ctx.notify = NULL;
+	ctx.unregister = NULL;
+}
+
+static struct disk_stats* disk_find(LPCWSTR path)
+{
 	for (DWORD i = 0; i < ctx.count; i++)
 	{
-		struct disk_stats* st = &ctx.stats[i];
-		PHY_DRIVE_INFO* d = &ctx.drives[i];
-		DWORD retsz;
+		if (_wcsicmp(ctx.stats[i].path, path) == 0)
+			return &ctx.stats[i];
+	}
+	return NULL;
+}
 
-		snprintf(st->name, sizeof(st->name), "(%lu) %s", d->Index, NWL_Ucs2ToUtf8(d->HwName));
+static void disk_close(struct disk_stats* st)
+{
+	if (st->handle && st->handle != INVALID_HANDLE_VALUE)
+		CloseHandle(st->handle);
+	st->handle = INVALID_HANDLE_VALUE;
+}
+
+static bool disk_add(HDEVINFO info, SP_DEVINFO_DATA* infoData, LPCWSTR path)
+{
+	struct disk_stats* st;
+	STORAGE_DEVICE_NUMBER sdn;
+	DWORD retsz;
+	BOOL ret;
+	HANDLE hd = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+		NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hd == INVALID_HANDLE_VALUE || hd == NULL)
+		return false;
+	ret = DeviceIoControl(hd, IOCTL_STORAGE_GET_DEVICE_NUMBER,
+		NULL, 0, &sdn, sizeof(STORAGE_DEVICE_NUMBER), &retsz, NULL);
+	CloseHandle(hd);
+	if (!ret)
+		return false;
+
+	st = realloc(ctx.stats, (ctx.count + 1) * sizeof(struct disk_stats));
+	if (st == NULL)
+		return false;
+	ctx.stats = st;
+	st = &ctx.stats[ctx.count];
+	ZeroMemory(st, sizeof(struct disk_stats));
+	wcsncpy_s(st->path, ARRAYSIZE(st->path), path, _TRUNCATE);
+	st->index = sdn.DeviceNumber;
+	st->present = TRUE;
+	if (!SetupDiGetDeviceRegistryPropertyW(info, infoData, SPDRP_FRIENDLYNAME,
+		NULL, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL) &&
+		!SetupDiGetDeviceRegistryPropertyW(info, infoData, SPDRP_DEVICEDESC,
+			NULL, (PBYTE)NWLC->NwBufW, NWINFO_BUFSZB, NULL))
+		NWLC->NwBufW[0] = L'\0';
+	snprintf(st->name, sizeof(st->name), "(%lu) %s", st->index, NWL_Ucs2ToUtf8(NWLC->NwBufW));
+	st->handle = NWL_GetDiskHandleById(FALSE, FALSE, st->index);
+	if (st->handle != INVALID_HANDLE_VALUE)
+		DeviceIoControl(st->handle, IOCTL_DISK_PERFORMANCE,
+			NULL, 0, &st->perf, sizeof(DISK_PERFORMANCE), &retsz, NULL);
+	ctx.count++;
+	return true;
+}
 
-		if (d->Handle == INVALID_HANDLE_VALUE)
+static int __cdecl disk_compare(const void* a, const void* b)
+{
+	const struct disk_stats* da = a;
+	const struct disk_stats* db = b;
+	if (da->index < db->index)
+		return -1;
+	return da->index > db->index ? 1 : 0;
+}
+
+// Only interfaces that appeared are opened, known drives keep their
+// handles and performance baseline. No partition or volume probing.
+static void disk_scan(void)
+{
+	DWORD i, j;
+	BOOL added = FALSE;
+	SP_DEVICE_INTERFACE_DATA ifData = { .cbSize = sizeof(SP_DEVICE_INTERFACE_DATA) };
+	DISK_IF_DETAIL detail = { .cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_W) };
+	SP_DEVINFO_DATA infoData = { .cbSize = sizeof(SP_DEVINFO_DATA) };
+	HDEVINFO info = SetupDiGetClassDevsW(&GUID_DEVINTERFACE_DISK, NULL, NULL, DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
+
+	InterlockedExchange(&ctx.changed, 0);
+	ctx.last_scan = GetTickCount64();
+	if (info == INVALID_HANDLE_VALUE)
+		return;
+
+	for (i = 0; i < ctx.count; i++)
+		ctx.stats[i].present = FALSE;
+
+	for (i = 0; SetupDiEnumDeviceInterfaces(info, NULL, &GUID_DEVINTERFACE_DISK, i, &ifData); i++)
+	{
+		struct disk_stats* st;
+		if (!SetupDiGetDeviceInterfaceDetailW(info, &ifData, (PSP_DEVICE_INTERFACE_DETAIL_DATA_W)&detail,
+			sizeof(DISK_IF_DETAIL), NULL, &infoData))
 			continue;
+		st = disk_find(detail.DevicePath);
+		if (st)
+			st->present = TRUE;
+		else if (disk_add(info, &infoData, detail.DevicePath))
+		{
+			NWL_Debug("DISKIO", "Add %s", ctx.stats[ctx.count - 1].name);
+			added = TRUE;
+		}
+	}
+	SetupDiDestroyDeviceInfoList(info);
 
-		if (!DeviceIoControl(d->Handle, IOCTL_DISK_PERFORMANCE,
-			NULL, 0, &st->perf, sizeof(DISK_PERFORMANCE),
-			&retsz, NULL))
+	for (i = 0, j = 0; i < ctx.count; i++)
+	{
+		if (!ctx.stats[i].present)
+		{
+			NWL_Debug("DISKIO", "Remove %s", ctx.stats[i].name);
+			disk_close(&ctx.stats[i]);
 			continue;
+		}
+		if (i != j)
+			ctx.stats[j] = ctx.stats[i];
+		j++;
 	}
+	ctx.count = j;
+	if (added)
+		qsort(ctx.stats, ctx.count, sizeof(struct disk_stats), disk_compare);
+}
 
+static bool disk_init(void)
+{
+	ZeroMemory(&ctx, sizeof(ctx));
+	disk_register_notify();
+	disk_scan();
+	if (ctx.count == 0)
+	{
+		if (ctx.notify)
+			ctx.unregister(ctx.notify);
+		if (ctx.cfgmgr)
+			FreeLibrary(ctx.cfgmgr);
+		free(ctx.stats);
+		ZeroMemory(&ctx, sizeof(ctx));
+		return false;
+	}
 	return true;
 }
 
 static void disk_fini(void)
 {
-	if (ctx.drives)
-		NWL_DestoryDriveInfoList(ctx.drives, ctx.count);
+	if (ctx.notify)
+		ctx.unregister(ctx.notify);
+	if (ctx.cfgmgr)
+		FreeLibrary(ctx.cfgmgr);
+	for (DWORD i = 0; i < ctx.count; i++)
+		disk_close(&ctx.stats[i]);
 	free(ctx.stats);
 	ZeroMemory(&ctx, sizeof(ctx));
 }
 
 static void disk_get(PNODE node)
 {
-	DWORD current = NWL_GetDriveCount(FALSE);
-	if (current != ctx.count)
-	{
-		disk_fini();
-		if (!disk_init())
-			return;
-	}
+	if (ctx.changed || (ctx.notify == NULL && GetTickCount64() > ctx.last_scan + DISK_RESCAN_INTERVAL))
+		disk_scan();
 
 	for (DWORD i = 0; i < ctx.count; i++)
 	{
 		struct disk_stats* st = &ctx.stats[i];
-		PHY_DRIVE_INFO* d = &ctx.drives[i];
 		DISK_PERFORMANCE perf = { 0 };
 		DWORD retsz;
 		PNODE disk = NWL_NodeAppendNew(node, st->name, NFLG_ATTGROUP | NAFLG_FMT_KEY_QUOTE);
 
-		if (d->Handle == INVALID_HANDLE_VALUE)
+		if (st->handle == INVALID_HANDLE_VALUE)
 			continue;
-		if (!DeviceIoControl(d->Handle, IOCTL_DISK_PERFORMANCE,
+		if (!DeviceIoControl(st->handle, IOCTL_DISK_PERFORMANCE,
 			NULL, 0, &perf, sizeof(DISK_PERFORMANCE),
 			&retsz, NULL))
 			continue;
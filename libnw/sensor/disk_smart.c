@@ -5,9 +5,30 @@
 #include "sensors.h"
 #include "../../libcdi/libcdi.h"
 
+// The handle is shared with NW_Disk and the GUI, so this sensor keeps its
+// own interval and remembers which read of each drive it has seen.
+#define DISK_SMART_INTERVAL (60 * 1000)
+
 struct disk_info
 {
 	CHAR name[32];
+	BOOL valid;
+	ULONGLONG seen; // cdi_get_last_refresh of the cached values
+	INT status;
+	INT life;
+	INT temp;
+	INT temp_alarm;
+	INT wear;
+	INT hours;
+	DWORD count;
+	INT reads;
+	INT writes;
+	BOOL aam;
+	BYTE aam_cur;
+	BYTE aam_rec;
+	BOOL apm;
+	BYTE apm_cur;
+	BYTE apm_rec;
 };
 
 static struct
@@ -17,16 +38,10 @@ static struct
 	struct disk_info* disks;
 } ctx;
 
-static bool disk_init(void)
+static bool disk_load(void)
 {
-	if (NWLC->NwSmart == NULL)
-		return false;
-	if (NWLC->NwSmartInit == FALSE)
-	{
-		NWL_Debug("SMART", "Init");
-		cdi_init_smart(NWLC->NwSmart, NWLC->NwSmartFlags);
-		NWLC->NwSmartInit = TRUE;
-	}
+	free(ctx.disks);
+	ctx.disks = NULL;
 	ctx.count = cdi_get_disk_count(NWLC->NwSmart);
 	NWL_Debug("SMART", "Found %d disks.", ctx.count);
 	if (ctx.count > 0)
@@ -50,67 +65,128 @@ static bool disk_init(void)
 	return true;
 }
 
+static bool disk_init(void)
+{
+	if (NWLC->NwSmart == NULL)
+		return false;
+	if (NWLC->NwSmartInit == FALSE)
+	{
+		NWL_Debug("SMART", "Init");
+		cdi_init_smart(NWLC->NwSmart, NWLC->NwSmartFlags);
+		NWLC->NwSmartInit = TRUE;
+	}
+	return disk_load();
+}
+
 static void disk_fini(void)
 {
 	free(ctx.disks);
 	ZeroMemory(&ctx, sizeof(ctx));
 }
 
+static void disk_read(INT i, struct disk_info* d)
+{
+	d->status = cdi_get_int(NWLC->NwSmart, i, CDI_INT_DISK_STATUS);
+	d->life = cdi_get_int(NWLC->NwSmart, i, CDI_INT_LIFE);
+	d->temp = cdi_get_int(NWLC->NwSmart, i, CDI_INT_TEMPERATURE);
+	d->temp_alarm = cdi_get_int(NWLC->NwSmart, i, CDI_INT_TEMPERATURE_ALARM);
+	d->wear = cdi_get_int(NWLC->NwSmart, i, CDI_INT_WEAR_LEVELING_COUNT);
+	d->hours = cdi_get_int(NWLC->NwSmart, i, CDI_INT_POWER_ON_HOURS);
+	d->count = cdi_get_dword(NWLC->NwSmart, i, CDI_DWORD_POWER_ON_COUNT);
+	d->reads = cdi_get_int(NWLC->NwSmart, i, CDI_INT_HOST_READS);
+	d->writes = cdi_get_int(NWLC->NwSmart, i, CDI_INT_HOST_WRITES);
+	d->aam = cdi_get_bool(NWLC->NwSmart, i, CDI_BOOL_AAM);
+	if (d->aam)
+	{
+		d->aam_cur = cdi_get_current_aam(NWLC->NwSmart, i);
+		d->aam_rec = cdi_get_recommend_aam(NWLC->NwSmart, i);
+	}
+	d->apm = cdi_get_bool(NWLC->NwSmart, i, CDI_BOOL_APM);
+	if (d->apm)
+	{
+		d->apm_cur = cdi_get_current_apm(NWLC->NwSmart, i);
+		d->apm_rec = cdi_get_recommend_apm(NWLC->NwSmart, i);
+	}
+	d->valid = TRUE;
+}
+
+static void disk_get_changed(PNODE disk, INT i)
+{
+	DWORD mask = cdi_get_changed_attrs(NWLC->NwSmart, i);
+	PNODE changed;
+	if (mask == 0)
+		return;
+	changed = NWL_NodeAppendNew(disk, "Changed Attributes", NFLG_ATTGROUP);
+	for (INT j = 0; j < 32; j++)
+	{
+		CHAR key[4];
+		WCHAR* str;
+		if (!(mask & (1UL << j)))
+			continue;
+		snprintf(key, sizeof(key), "%02X", cdi_get_smart_id(NWLC->NwSmart, i, j));
+		str = cdi_get_smart_value(NWLC->NwSmart, i, j, FALSE);
+		NWL_NodeAttrSet(changed, key, NWL_Ucs2ToUtf8(str), 0);
+		cdi_free_string(str);
+	}
+}
+
 static void disk_get(PNODE node)
 {
-	BOOL need_update = FALSE;
-	ULONGLONG ticks = GetTickCount64();
-	INT count = cdi_get_disk_count(NWLC->NwSmart);
-	if (count != ctx.count || ticks > ctx.ticks + 1000 * 60)
+	BOOL force = FALSE;
+	if (cdi_get_disk_count(NWLC->NwSmart) != ctx.count)
 	{
-		need_update = TRUE;
-		ctx.ticks = ticks;
-		ctx.count = count;
+		force = TRUE;
+		if (!disk_load())
+			return;
 	}
+	ctx.ticks = GetTickCount64();
 	NWL_NodeAttrSetf(node, "Last Update", NAFLG_FMT_NUMERIC, "%llu", ctx.ticks);
 	for (INT i = 0; i < ctx.count; i++)
 	{
-		if (need_update)
-			cdi_update_smart(NWLC->NwSmart, i);
 		struct disk_info* d = &ctx.disks[i];
 		PNODE disk = NWL_NodeAppendNew(node, d->name, NFLG_ATTGROUP | NAFLG_FMT_KEY_QUOTE);
-		INT n;
-		DWORD dw;
-		n = cdi_get_int(NWLC->NwSmart, i, CDI_INT_DISK_STATUS);
-		NWL_NodeAttrSet(disk, "Status", cdi_get_health_status(n), 0);
-		n = cdi_get_int(NWLC->NwSmart, i, CDI_INT_LIFE);
-		if (n >= 0)
-			NWL_NodeAttrSetf(disk, "Life", NAFLG_FMT_NUMERIC, "%d", n);
-		n = cdi_get_int(NWLC->NwSmart, i, CDI_INT_TEMPERATURE);
-		if (n >= 0)
-			NWL_NodeAttrSetf(disk, "Temperature", NAFLG_FMT_NUMERIC, "%.0f", NWL_GetTemperature((float)n));
-		n = cdi_get_int(NWLC->NwSmart, i, CDI_INT_TEMPERATURE_ALARM);
-		if (n >= 0)
-			NWL_NodeAttrSetf(disk, "Alarm Temperature", NAFLG_FMT_NUMERIC, "%.0f", NWL_GetTemperature((float)n));
-		n = cdi_get_int(NWLC->NwSmart, i, CDI_INT_WEAR_LEVELING_COUNT);
-		if (n >= 0)
-			NWL_NodeAttrSetf(disk, "Wear Leveling Count", NAFLG_FMT_NUMERIC, "%d", n);
-		n = cdi_get_int(NWLC->NwSmart, i, CDI_INT_POWER_ON_HOURS);
-		if (n >= 0)
-			NWL_NodeAttrSetf(disk, "Power on Hours", NAFLG_FMT_NUMERIC, "%d", n);
-		dw = cdi_get_dword(NWLC->NwSmart, i, CDI_DWORD_POWER_ON_COUNT);
-		NWL_NodeAttrSetf(disk, "Power on Count", NAFLG_FMT_NUMERIC, "%lu", dw);
-		n = cdi_get_int(NWLC->NwSmart, i, CDI_INT_HOST_READS);
-		if (n >= 0)
-			NWL_NodeAttrSetf(disk, "Total Host Reads GB", NAFLG_FMT_NUMERIC, "%d", n);
-		n = cdi_get_int(NWLC->NwSmart, i, CDI_INT_HOST_WRITES);
-		if (n >= 0)
-			NWL_NodeAttrSetf(disk, "Total Host Writes GB", NAFLG_FMT_NUMERIC, "%d", n);
-		if (cdi_get_bool(NWLC->NwSmart, i, CDI_BOOL_AAM))
+		// Drives are only read once the interval expired, standby drives are left alone.
+		INT status = cdi_refresh_disk(NWLC->NwSmart, i, DISK_SMART_INTERVAL, force);
+		ULONGLONG last = cdi_get_last_refresh(NWLC->NwSmart, i);
+		// Another caller may have read the drive since, so compare against
+		// the read this sensor saw last rather than the shared status.
+		BOOL fresh = !d->valid || last != d->seen;
+		if (fresh)
+		{
+			disk_read(i, d);
+			d->seen = last;
+		}
+		NWL_NodeAttrSet(disk, "Status", cdi_get_health_status(d->status), 0);
+		if (status == CDI_REFRESH_STANDBY)
+			NWL_NodeAttrSet(disk, "Standby", "Yes", 0);
+		NWL_NodeAttrSetf(disk, "Last Update", NAFLG_FMT_NUMERIC, "%llu", last);
+		if (d->life >= 0)
+			NWL_NodeAttrSetf(disk, "Life", NAFLG_FMT_NUMERIC, "%d", d->life);
+		if (d->temp >= 0)
+			NWL_NodeAttrSetf(disk, "Temperature", NAFLG_FMT_NUMERIC, "%.0f", NWL_GetTemperature((float)d->temp));
+		if (d->temp_alarm >= 0)
+			NWL_NodeAttrSetf(disk, "Alarm Temperature", NAFLG_FMT_NUMERIC, "%.0f", NWL_GetTemperature((float)d->temp_alarm));
+		if (d->wear >= 0)
+			NWL_NodeAttrSetf(disk, "Wear Leveling Count", NAFLG_FMT_NUMERIC, "%d", d->wear);
+		if (d->hours >= 0)
+			NWL_NodeAttrSetf(disk, "Power on Hours", NAFLG_FMT_NUMERIC, "%d", d->hours);
+		NWL_NodeAttrSetf(disk, "Power on Count", NAFLG_FMT_NUMERIC, "%lu", d->count);
+		if (d->reads >= 0)
+			NWL_NodeAttrSetf(disk, "Total Host Reads GB", NAFLG_FMT_NUMERIC, "%d", d->reads);
+		if (d->writes >= 0)
+			NWL_NodeAttrSetf(disk, "Total Host Writes GB", NAFLG_FMT_NUMERIC, "%d", d->writes);
+		if (d->aam)
 		{
-			NWL_NodeAttrSetf(disk, "Current AAM", NAFLG_FMT_NUMERIC, "%u", cdi_get_current_aam(NWLC->NwSmart, i));
-			NWL_NodeAttrSetf(disk, "Recommended AAM", NAFLG_FMT_NUMERIC, "%u", cdi_get_recommend_aam(NWLC->NwSmart, i));
+			NWL_NodeAttrSetf(disk, "Current AAM", NAFLG_FMT_NUMERIC, "%u", d->aam_cur);
+			NWL_NodeAttrSetf(disk, "Recommended AAM", NAFLG_FMT_NUMERIC, "%u", d->aam_rec);
 		}
-		if (cdi_get_bool(NWLC->NwSmart, i, CDI_BOOL_APM))
+		if (d->apm)
 		{
-			NWL_NodeAttrSetf(disk, "Current APM", NAFLG_FMT_NUMERIC, "%u", cdi_get_current_apm(NWLC->NwSmart, i));
-			NWL_NodeAttrSetf(disk, "Recommended APM", NAFLG_FMT_NUMERIC, "%u", cdi_get_recommend_apm(NWLC->NwSmart, i));
+			NWL_NodeAttrSetf(disk, "Current APM", NAFLG_FMT_NUMERIC, "%u", d->apm_cur);
+			NWL_NodeAttrSetf(disk, "Recommended APM", NAFLG_FMT_NUMERIC, "%u", d->apm_rec);
 		}
+		if (fresh)
+			disk_get_changed(disk, i);
 	}
 }
 
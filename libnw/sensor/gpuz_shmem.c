@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: Unlicense
 
+#include <stdlib.h>
+
 #include "libnw.h"
 #include "utils.h"
 #include "sensors.h"
@@ -36,12 +38,21 @@ typedef struct
 #pragma pack(pop)
 
 #define GPUZSHM "GPUZ"
+#define GPUZ_SNAPSHOT_RETRY 4
+
+// UTF-8 key of one slot, converted when the slot's key changes.
+typedef struct
+{
+	WCHAR wkey[GPUZ_STR_LEN];
+	CHAR key[GPUZ_STR_LEN];
+} GPUZ_LABEL;
 
 static struct
 {
 	struct wr0_shmem_t shmem;
-	GPUZ_SH_MEM* data;
-	CHAR key[GPUZ_STR_LEN];
+	volatile GPUZ_SH_MEM* data;
+	GPUZ_SH_MEM* snap;
+	GPUZ_LABEL* labels; // data[] then sensors[]
 } ctx;
 
 static bool gpuz_init(void)
@@ -51,6 +62,10 @@ static bool gpuz_init(void)
 	if (ctx.shmem.size < sizeof(GPUZ_SH_MEM))
 		goto fail;
 	ctx.data = ctx.shmem.addr;
+	ctx.snap = malloc(sizeof(GPUZ_SH_MEM));
+	ctx.labels = calloc(2 * GPUZ_MAX_RECORDS, sizeof(GPUZ_LABEL));
+	if (!ctx.snap || !ctx.labels)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
 	return true;
 fail:
 	WR0_CloseShMem(&ctx.shmem);
@@ -61,26 +76,64 @@ fail:
 static void gpuz_fini(void)
 {
 	WR0_CloseShMem(&ctx.shmem);
+	free(ctx.snap);
+	free(ctx.labels);
 	ZeroMemory(&ctx, sizeof(ctx));
 }
 
+// Copy the mapping while GPU-Z is not writing it, and accept the copy only
+// if it stayed idle and lastUpdate did not move.
+static bool gpuz_snapshot(void)
+{
+	for (int retry = 0; retry < GPUZ_SNAPSHOT_RETRY; retry++)
+	{
+		if (ctx.data->busy)
+		{
+			Sleep(0);
+			continue;
+		}
+		UINT32 last = ctx.data->lastUpdate;
+		MemoryBarrier();
+		CopyMemory(ctx.snap, (const void*)ctx.data, sizeof(GPUZ_SH_MEM));
+		MemoryBarrier();
+		if (!ctx.data->busy && ctx.data->lastUpdate == last)
+			return true;
+	}
+	NWL_Debug(GPUZSHM, "Snapshot busy");
+	return false;
+}
+
+static LPCSTR gpuz_label(size_t index, const WCHAR* wkey)
+{
+	GPUZ_LABEL* label = &ctx.labels[index];
+	if (wcsncmp(label->wkey, wkey, GPUZ_STR_LEN) != 0)
+	{
+		wcsncpy_s(label->wkey, GPUZ_STR_LEN, wkey, _TRUNCATE);
+		strncpy_s(label->key, GPUZ_STR_LEN, NWL_Ucs2ToUtf8(label->wkey), _TRUNCATE);
+	}
+	return label->key;
+}
+
 static void gpuz_get(PNODE node)
 {
+	if (!gpuz_snapshot())
+		return;
 	for (size_t i = 0; i < GPUZ_MAX_RECORDS; i++)
 	{
-		GPUZ_RECORD* r = &ctx.data->data[i];
+		GPUZ_RECORD* r = &ctx.snap->data[i];
 		if (r->key[0] == L'\0')
 			continue;
-		strncpy_s(ctx.key, GPUZ_STR_LEN, NWL_Ucs2ToUtf8(r->key), _TRUNCATE);
-		NWL_NodeAttrSet(node, ctx.key, NWL_Ucs2ToUtf8(r->value), NAFLG_FMT_KEY_QUOTE);
+		r->key[GPUZ_STR_LEN - 1] = L'\0';
+		r->value[GPUZ_STR_LEN - 1] = L'\0';
+		NWL_NodeAttrSet(node, gpuz_label(i, r->key), NWL_Ucs2ToUtf8(r->value), NAFLG_FMT_KEY_QUOTE);
 	}
 	for (size_t i = 0; i < GPUZ_MAX_RECORDS; i++)
 	{
-		GPUZ_SENSOR_RECORD* r = &ctx.data->sensors[i];
+		GPUZ_SENSOR_RECORD* r = &ctx.snap->sensors[i];
 		if (r->name[0] == L'\0')
 			continue;
-		strncpy_s(ctx.key, GPUZ_STR_LEN, NWL_Ucs2ToUtf8(r->name), _TRUNCATE);
-		NWL_NodeAttrSetf(node, ctx.key, NAFLG_FMT_KEY_QUOTE | NAFLG_FMT_NUMERIC, "%.2f", r->value);
+		r->name[GPUZ_STR_LEN - 1] = L'\0';
+		NWL_NodeAttrSetf(node, gpuz_label(GPUZ_MAX_RECORDS + i, r->name), NAFLG_FMT_KEY_QUOTE | NAFLG_FMT_NUMERIC, "%.2f", r->value);
 	}
 }
 
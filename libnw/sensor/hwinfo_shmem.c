@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: Unlicense
 
+#include <stdlib.h>
+
 #include "libnw.h"
 #include "utils.h"
 #include "sensors.h"
@@ -79,21 +81,75 @@ typedef struct _HWiNFO_SENSORS_SHARED_MEM2
 
 #pragma pack()
 
+#define HWiNFO_SIGNATURE_ACTIVE 0x53695748 // "HWiS"
+#define HWiNFO_SNAPSHOT_RETRY 4
+#define HWiNFO_MUTEX_TIMEOUT 10
+
+#define HWiNFO_SENSOR_MIN_SIZE offsetof(HWiNFO_SENSORS_SENSOR_ELEMENT, utfSensorNameUser)
+#define HWiNFO_READING_MIN_SIZE offsetof(HWiNFO_SENSORS_READING_ELEMENT, utfLabelUser)
+
+// Section geometry, from dwOffsetOfSensorSection to dwNumReadingElements.
+typedef struct
+{
+	DWORD SensorOffset;
+	DWORD SensorSize;
+	DWORD SensorCount;
+	DWORD ReadingOffset;
+	DWORD ReadingSize;
+	DWORD ReadingCount;
+} HWiNFO_LAYOUT;
+
+typedef struct
+{
+	DWORD id;
+	DWORD inst;
+} HWiNFO_SENSOR_KEY;
+
+typedef struct
+{
+	DWORD index; // dwSensorIndex as mapped
+	DWORD id; // dwReadingID as mapped
+	DWORD sensor; // index into ctx.names, MAXDWORD if out of range
+	CHAR label[HWiNFO_SENSORS_STRING_LEN2];
+} HWiNFO_LABEL;
+
 static struct
 {
 	struct wr0_shmem_t shmem;
-	PHWiNFO_SENSORS_SHARED_MEM2 hdr;
-	PHWiNFO_SENSORS_SENSOR_ELEMENT sensors;
-	PHWiNFO_SENSORS_READING_ELEMENT readings;
+	HANDLE mutex;
+	// Private copy of the mapping, refreshed by one memcpy per poll.
+	PUINT8 buf;
+	SIZE_T buf_size;
+	HWiNFO_LAYOUT layout;
+	// Names and labels resolved once per layout and set of IDs.
+	HWiNFO_LAYOUT mapped;
+	HWiNFO_SENSOR_KEY* keys;
+	CHAR (*names)[HWiNFO_SENSORS_STRING_LEN2];
+	HWiNFO_LABEL* labels;
+	PNODE* parents;
 } ctx;
 
+static void hwinfo_free_map(void)
+{
+	free(ctx.keys);
+	free(ctx.names);
+	free(ctx.labels);
+	free(ctx.parents);
+	ctx.keys = NULL;
+	ctx.names = NULL;
+	ctx.labels = NULL;
+	ctx.parents = NULL;
+	ZeroMemory(&ctx.mapped, sizeof(HWiNFO_LAYOUT));
+}
+
 static bool hwinfo_init(void)
 {
 	if (WR0_OpenShMem(&ctx.shmem, HWiNFO_SENSORS_MAP_FILE_NAME2))
 		goto fail;
 	if (ctx.shmem.size < sizeof(HWiNFO_SENSORS_SHARED_MEM2))
 		goto fail;
-	ctx.hdr = ctx.shmem.addr;
+	// HWiNFO holds this mutex while it rewrites the mapping. Optional.
+	ctx.mutex = OpenMutexW(SYNCHRONIZE, FALSE, HWiNFO_SENSORS_SM2_MUTEX);
 	return true;
 fail:
 	WR0_CloseShMem(&ctx.shmem);
@@ -104,27 +160,144 @@ fail:
 static void hwinfo_fini(void)
 {
 	WR0_CloseShMem(&ctx.shmem);
+	if (ctx.mutex)
+		CloseHandle(ctx.mutex);
+	free(ctx.buf);
+	hwinfo_free_map();
 	ZeroMemory(&ctx, sizeof(ctx));
 }
 
-static void hwinfo_get(PNODE node)
+static bool hwinfo_check_layout(const HWiNFO_LAYOUT* layout, SIZE_T* end)
 {
-	ctx.sensors = (PHWiNFO_SENSORS_SENSOR_ELEMENT)((PUINT8)ctx.shmem.addr + ctx.hdr->dwOffsetOfSensorSection);
-	ctx.readings = (PHWiNFO_SENSORS_READING_ELEMENT)((PUINT8)ctx.shmem.addr + ctx.hdr->dwOffsetOfReadingSection);
+	ULONGLONG sensor_end = (ULONGLONG)layout->SensorOffset + (ULONGLONG)layout->SensorSize * layout->SensorCount;
+	ULONGLONG reading_end = (ULONGLONG)layout->ReadingOffset + (ULONGLONG)layout->ReadingSize * layout->ReadingCount;
+	if (layout->SensorCount && layout->SensorSize < HWiNFO_SENSOR_MIN_SIZE)
+		return false;
+	if (layout->ReadingCount && layout->ReadingSize < HWiNFO_READING_MIN_SIZE)
+		return false;
+	if (reading_end < sensor_end)
+		reading_end = sensor_end;
+	if (reading_end < sizeof(HWiNFO_SENSORS_SHARED_MEM2))
+		reading_end = sizeof(HWiNFO_SENSORS_SHARED_MEM2);
+	if (reading_end > ctx.shmem.size)
+		return false;
+	*end = (SIZE_T)reading_end;
+	return true;
+}
 
-	for (DWORD i = 0; i < ctx.hdr->dwNumSensorElements; i++)
+// Copy the whole mapping in one go and accept it only if the poll time and
+// geometry did not move while copying.
+static bool hwinfo_snapshot(void)
+{
+	volatile HWiNFO_SENSORS_SHARED_MEM2* live = ctx.shmem.addr;
+	for (int retry = 0; retry < HWiNFO_SNAPSHOT_RETRY; retry++)
 	{
-		PHWiNFO_SENSORS_SENSOR_ELEMENT sensor = &ctx.sensors[i];
-		NWL_NodeAppendNew(node, sensor->szSensorNameOrig, NFLG_ATTGROUP | NAFLG_FMT_KEY_QUOTE);
+		HWiNFO_LAYOUT layout;
+		SIZE_T end;
+		bool locked = false;
+		if (live->dwSignature != HWiNFO_SIGNATURE_ACTIVE)
+			return false;
+		__time64_t poll_time = live->poll_time;
+		MemoryBarrier();
+		CopyMemory(&layout, (const void*)&live->dwOffsetOfSensorSection, sizeof(HWiNFO_LAYOUT));
+		if (!hwinfo_check_layout(&layout, &end))
+			return false;
+		if (end > ctx.buf_size)
+		{
+			PUINT8 buf = realloc(ctx.buf, end);
+			if (buf == NULL)
+				NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+			ctx.buf = buf;
+			ctx.buf_size = end;
+		}
+		if (ctx.mutex)
+			locked = WaitForSingleObject(ctx.mutex, HWiNFO_MUTEX_TIMEOUT) == WAIT_OBJECT_0;
+		CopyMemory(ctx.buf, (const void*)live, end);
+		if (locked)
+			ReleaseMutex(ctx.mutex);
+		MemoryBarrier();
+		if (live->poll_time != poll_time)
+			continue;
+		if (memcmp(&layout, &((PHWiNFO_SENSORS_SHARED_MEM2)ctx.buf)->dwOffsetOfSensorSection, sizeof(HWiNFO_LAYOUT)) != 0)
+			continue;
+		ctx.layout = layout;
+		return true;
 	}
-	for (DWORD i = 0; i < ctx.hdr->dwNumReadingElements; i++)
+	NWL_Debug("HWiNFO", "Snapshot busy");
+	return false;
+}
+
+// HWiNFO may add, remove or reorder sensors without changing the geometry,
+// so the IDs of every entry are checked against the cached map on each poll.
+static bool hwinfo_is_mapped(void)
+{
+	if (!ctx.names || memcmp(&ctx.mapped, &ctx.layout, sizeof(HWiNFO_LAYOUT)) != 0)
+		return false;
+	for (DWORD i = 0; i < ctx.layout.SensorCount; i++)
+	{
+		PHWiNFO_SENSORS_SENSOR_ELEMENT sensor = (PHWiNFO_SENSORS_SENSOR_ELEMENT)
+			(ctx.buf + ctx.layout.SensorOffset + (SIZE_T)i * ctx.layout.SensorSize);
+		if (sensor->dwSensorID != ctx.keys[i].id || sensor->dwSensorInst != ctx.keys[i].inst)
+			return false;
+	}
+	for (DWORD i = 0; i < ctx.layout.ReadingCount; i++)
+	{
+		PHWiNFO_SENSORS_READING_ELEMENT reading = (PHWiNFO_SENSORS_READING_ELEMENT)
+			(ctx.buf + ctx.layout.ReadingOffset + (SIZE_T)i * ctx.layout.ReadingSize);
+		if (reading->dwReadingID != ctx.labels[i].id || reading->dwSensorIndex != ctx.labels[i].index)
+			return false;
+	}
+	return true;
+}
+
+static void hwinfo_map(void)
+{
+	if (hwinfo_is_mapped())
+		return;
+	hwinfo_free_map();
+	ctx.keys = calloc(ctx.layout.SensorCount + 1, sizeof(HWiNFO_SENSOR_KEY));
+	ctx.names = calloc(ctx.layout.SensorCount + 1, sizeof(*ctx.names));
+	ctx.parents = calloc(ctx.layout.SensorCount + 1, sizeof(PNODE));
+	ctx.labels = calloc(ctx.layout.ReadingCount + 1, sizeof(HWiNFO_LABEL));
+	if (!ctx.keys || !ctx.names || !ctx.parents || !ctx.labels)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	for (DWORD i = 0; i < ctx.layout.SensorCount; i++)
+	{
+		PHWiNFO_SENSORS_SENSOR_ELEMENT sensor = (PHWiNFO_SENSORS_SENSOR_ELEMENT)
+			(ctx.buf + ctx.layout.SensorOffset + (SIZE_T)i * ctx.layout.SensorSize);
+		ctx.keys[i].id = sensor->dwSensorID;
+		ctx.keys[i].inst = sensor->dwSensorInst;
+		strncpy_s(ctx.names[i], HWiNFO_SENSORS_STRING_LEN2, sensor->szSensorNameOrig, _TRUNCATE);
+	}
+	for (DWORD i = 0; i < ctx.layout.ReadingCount; i++)
+	{
+		PHWiNFO_SENSORS_READING_ELEMENT reading = (PHWiNFO_SENSORS_READING_ELEMENT)
+			(ctx.buf + ctx.layout.ReadingOffset + (SIZE_T)i * ctx.layout.ReadingSize);
+		ctx.labels[i].index = reading->dwSensorIndex;
+		ctx.labels[i].id = reading->dwReadingID;
+		ctx.labels[i].sensor = reading->dwSensorIndex < ctx.layout.SensorCount ? reading->dwSensorIndex : MAXDWORD;
+		strncpy_s(ctx.labels[i].label, HWiNFO_SENSORS_STRING_LEN2, reading->szLabelOrig, _TRUNCATE);
+	}
+	ctx.mapped = ctx.layout;
+	NWL_Debug("HWiNFO", "Mapped %lu sensors, %lu readings", ctx.layout.SensorCount, ctx.layout.ReadingCount);
+}
+
+static void hwinfo_get(PNODE node)
+{
+	if (!hwinfo_snapshot())
+		return;
+	hwinfo_map();
+
+	for (DWORD i = 0; i < ctx.layout.SensorCount; i++)
+		ctx.parents[i] = NWL_NodeAppendNew(node, ctx.names[i], NFLG_ATTGROUP | NAFLG_FMT_KEY_QUOTE);
+	for (DWORD i = 0; i < ctx.layout.ReadingCount; i++)
 	{
-		PHWiNFO_SENSORS_READING_ELEMENT reading = &ctx.readings[i];
-		PHWiNFO_SENSORS_SENSOR_ELEMENT sensor = &ctx.sensors[reading->dwSensorIndex];
-		PNODE key = NWL_NodeEnumChild(node, reading->dwSensorIndex);
-		if (strcmp(sensor->szSensorNameOrig, key->name) != 0)
+		HWiNFO_LABEL* label = &ctx.labels[i];
+		if (label->sensor == MAXDWORD)
 			continue;
-		NWL_NodeAttrSetf(key, reading->szLabelOrig, NAFLG_FMT_KEY_QUOTE | NAFLG_FMT_NUMERIC, "%.2f", reading->Value);
+		PHWiNFO_SENSORS_READING_ELEMENT reading = (PHWiNFO_SENSORS_READING_ELEMENT)
+			(ctx.buf + ctx.layout.ReadingOffset + (SIZE_T)i * ctx.layout.ReadingSize);
+		NWL_NodeAttrSetf(ctx.parents[label->sensor], label->label, NAFLG_FMT_KEY_QUOTE | NAFLG_FMT_NUMERIC, "%.2f", reading->Value);
 	}
 }
 
@@ -5,14 +5,43 @@
 #include "sensors.h"
 #include "../liblhm/lhm.h"
 #include <pathcch.h>
+#include <math.h>
 
+typedef struct
+{
+	LPSTR key;
+	LPSTR hardware;
+} LHM_HW;
+
+typedef struct
+{
+	size_t hw;
+	LPSTR type;
+} LHM_GROUP;
+
+typedef struct
+{
+	size_t group;
+	LPSTR name;
+} LHM_ITEM;
+
+// UTF-8 copy of the liblhm sensor table, rebuilt only when its generation changes.
+// Item i reads slot i of values.
 static struct
 {
 	HMODULE dll;
-	LhmSensorInfo* lhm;
+	uint32_t generation;
 	size_t count;
+	size_t hw_count;
+	size_t group_count;
+	LHM_HW* hw;
+	LHM_GROUP* groups;
+	LHM_ITEM* items;
+	float* values;
+	PNODE* nodes; // hw_count + group_count, per poll
 	bool (__stdcall * fn_init)(void);
-	bool (__stdcall * fn_enum)(const LhmSensorInfo** sensors, size_t* out_count);
+	bool (__stdcall * fn_table)(const LhmSensorMeta** sensors, size_t* out_count, uint32_t* out_generation);
+	bool (__stdcall * fn_read)(float* values, size_t count, uint32_t* out_generation);
 	void (__stdcall * fn_fini)(void);
 } ctx;
 
@@ -37,8 +66,11 @@ static bool lhm_init(void)
 	*(FARPROC*)&ctx.fn_init = GetProcAddress(ctx.dll, "LhmInitialize");
 	if (!ctx.fn_init)
 		goto fail;
-	*(FARPROC*)&ctx.fn_enum = GetProcAddress(ctx.dll, "LhmEnumerateSensors");
-	if (!ctx.fn_enum)
+	*(FARPROC*)&ctx.fn_table = GetProcAddress(ctx.dll, "LhmGetSensorTable");
+	if (!ctx.fn_table)
+		goto fail;
+	*(FARPROC*)&ctx.fn_read = GetProcAddress(ctx.dll, "LhmReadValues");
+	if (!ctx.fn_read)
 		goto fail;
 	*(FARPROC*)&ctx.fn_fini = GetProcAddress(ctx.dll, "LhmShutdown");
 	if (!ctx.fn_fini)
@@ -59,14 +91,49 @@ fail:
 	return false;
 }
 
+static void lhm_free_table(void)
+{
+	for (size_t i = 0; i < ctx.hw_count; i++)
+	{
+		free(ctx.hw[i].key);
+		free(ctx.hw[i].hardware);
+	}
+	for (size_t i = 0; i < ctx.group_count; i++)
+		free(ctx.groups[i].type);
+	for (size_t i = 0; i < ctx.count; i++)
+		free(ctx.items[i].name);
+	free(ctx.hw);
+	free(ctx.groups);
+	free(ctx.items);
+	free(ctx.values);
+	free(ctx.nodes);
+	ctx.hw = NULL;
+	ctx.groups = NULL;
+	ctx.items = NULL;
+	ctx.values = NULL;
+	ctx.nodes = NULL;
+	ctx.count = 0;
+	ctx.hw_count = 0;
+	ctx.group_count = 0;
+}
+
 static void lhm_fini(void)
 {
+	lhm_free_table();
 	ctx.fn_fini();
 	FreeLibrary(ctx.dll);
 	ZeroMemory(&ctx, sizeof(ctx));
 }
 
-static LPCSTR lhm_get_key_name(LhmSensorInfo* p)
+static LPSTR lhm_strdup(LPCWSTR str)
+{
+	LPSTR p = _strdup(NWL_Ucs2ToUtf8(str));
+	if (!p)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	return p;
+}
+
+static LPSTR lhm_get_key_name(const LhmSensorMeta* p)
 {
 	WCHAR id[LHM_STR_MAX];
 	wcscpy_s(id, LHM_STR_MAX, p->id);
@@ -77,31 +144,105 @@ static LPCSTR lhm_get_key_name(LhmSensorInfo* p)
 			break;
 		*p = L'\0';
 	}
-	return NWL_Ucs2ToUtf8(id);
+	return lhm_strdup(id);
+}
+
+static size_t lhm_add_hw(const LhmSensorMeta* p)
+{
+	LPSTR key = lhm_get_key_name(p);
+	for (size_t i = 0; i < ctx.hw_count; i++)
+	{
+		if (strcmp(ctx.hw[i].key, key) == 0)
+		{
+			free(key);
+			return i;
+		}
+	}
+	ctx.hw[ctx.hw_count].key = key;
+	ctx.hw[ctx.hw_count].hardware = lhm_strdup(p->hardware);
+	return ctx.hw_count++;
+}
+
+static size_t lhm_add_group(size_t hw, const LhmSensorMeta* p)
+{
+	LPCSTR type = NWL_Ucs2ToUtf8(p->type);
+	for (size_t i = 0; i < ctx.group_count; i++)
+	{
+		if (ctx.groups[i].hw == hw && strcmp(ctx.groups[i].type, type) == 0)
+			return i;
+	}
+	ctx.groups[ctx.group_count].hw = hw;
+	ctx.groups[ctx.group_count].type = lhm_strdup(p->type);
+	return ctx.group_count++;
+}
+
+static bool lhm_load_table(void)
+{
+	const LhmSensorMeta* meta = NULL;
+	size_t count = 0;
+
+	lhm_free_table();
+	if (!ctx.fn_table(&meta, &count, &ctx.generation))
+	{
+		// Make the next poll ask for the table again.
+		ctx.generation = LHM_GENERATION_NONE;
+		return false;
+	}
+	NWL_Debug("LHM", "Sensor table generation %u, %zu objects", ctx.generation, count);
+	if (count == 0)
+		return true;
+
+	ctx.hw = calloc(count, sizeof(LHM_HW));
+	ctx.groups = calloc(count, sizeof(LHM_GROUP));
+	ctx.items = calloc(count, sizeof(LHM_ITEM));
+	ctx.values = calloc(count, sizeof(float));
+	ctx.nodes = calloc(2 * count, sizeof(PNODE));
+	if (!ctx.hw || !ctx.groups || !ctx.items || !ctx.values || !ctx.nodes)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+
+	// Group lookups happen here once instead of by name on every poll.
+	for (size_t i = 0; i < count; i++)
+	{
+		size_t hw = lhm_add_hw(&meta[i]);
+		ctx.items[i].group = lhm_add_group(hw, &meta[i]);
+		ctx.items[i].name = lhm_strdup(meta[i].name);
+		ctx.count++;
+	}
+	return true;
 }
 
 static void lhm_get(PNODE node)
 {
-	if (!ctx.fn_enum(&ctx.lhm, &ctx.count))
+	uint32_t generation;
+	if (!ctx.fn_read(ctx.values, ctx.count, &generation))
 		return;
-	NWL_Debug("LHM", "%zu objects", ctx.count);
+	if (generation == LHM_GENERATION_NONE || generation != ctx.generation)
+	{
+		if (!lhm_load_table())
+			return;
+		if (!ctx.fn_read(ctx.values, ctx.count, &generation) || generation != ctx.generation)
+			return;
+	}
+
+	PNODE* hw_nodes = ctx.nodes;
+	PNODE* group_nodes = ctx.nodes + ctx.hw_count;
+	ZeroMemory(ctx.nodes, (ctx.hw_count + ctx.group_count) * sizeof(PNODE));
 	for (size_t i = 0; i < ctx.count; i++)
 	{
-		LhmSensorInfo* p = &ctx.lhm[i];
-		LPCSTR hw = lhm_get_key_name(p);
-		PNODE key = NWL_NodeGetChild(node, hw);
-		if (key == NULL)
-		{
-			key = NWL_NodeAppendNew(node, hw, NFLG_ATTGROUP | NAFLG_FMT_KEY_QUOTE);
-			NWL_NodeAttrSet(key, "Hardware", NWL_Ucs2ToUtf8(p->hardware), NAFLG_FMT_NEED_QUOTE | NAFLG_FMT_KEY_QUOTE);
-		}
-		LPCSTR st = NWL_Ucs2ToUtf8(p->type);
-		PNODE subkey = NWL_NodeGetChild(key, st);
-		if (subkey == NULL)
+		if (isnan(ctx.values[i]))
+			continue;
+		LHM_ITEM* p = &ctx.items[i];
+		LHM_GROUP* g = &ctx.groups[p->group];
+		if (group_nodes[p->group] == NULL)
 		{
-			subkey = NWL_NodeAppendNew(key, st, NFLG_ATTGROUP | NAFLG_FMT_KEY_QUOTE);
+			if (hw_nodes[g->hw] == NULL)
+			{
+				hw_nodes[g->hw] = NWL_NodeAppendNew(node, ctx.hw[g->hw].key, NFLG_ATTGROUP | NAFLG_FMT_KEY_QUOTE);
+				NWL_NodeAttrSet(hw_nodes[g->hw], "Hardware", ctx.hw[g->hw].hardware, NAFLG_FMT_NEED_QUOTE | NAFLG_FMT_KEY_QUOTE);
+			}
+			group_nodes[p->group] = NWL_NodeAppendNew(hw_nodes[g->hw], g->type, NFLG_ATTGROUP | NAFLG_FMT_KEY_QUOTE);
 		}
-		NWL_NodeAttrSetf(subkey, NWL_Ucs2ToUtf8(p->name), NAFLG_FMT_NUMERIC | NAFLG_FMT_KEY_QUOTE, "%.2f", p->value);
+		NWL_NodeAttrSetf(group_nodes[p->group], p->name, NAFLG_FMT_NUMERIC | NAFLG_FMT_KEY_QUOTE, "%.2f", ctx.values[i]);
 	}
 }
 
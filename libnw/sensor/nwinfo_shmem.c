@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <windows.h>
+
+#include "libnw.h"
+#include "utils.h"
+#include "sensors.h"
+#include "nwinfo_shmem.h"
+
+#define NWSHM_CAPACITY 1024
+
+static struct
+{
+	HANDLE file;
+	NWSHM_HEADER* hdr;
+	NWSHM_ENTRY* entries;
+	// Readings are flattened here first so the odd-sequence window
+	// covers a single copy rather than the node walk.
+	NWSHM_ENTRY* staging;
+	UINT32 count;
+	CHAR path[NWSHM_PATH_LEN];
+} ctx;
+
+static volatile LONG m_stop;
+
+BOOL NWL_ShmPublisherOpen(LPCSTR lpName)
+{
+	DWORD size = sizeof(NWSHM_HEADER) + NWSHM_CAPACITY * sizeof(NWSHM_ENTRY);
+
+	if (ctx.hdr)
+		return TRUE;
+	if (lpName == NULL || lpName[0] == '\0')
+		lpName = NWSHM_NAME_DEFAULT_A;
+	ctx.file = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, size, lpName);
+	if (!ctx.file)
+		goto fail;
+	if (GetLastError() == ERROR_ALREADY_EXISTS)
+	{
+		NWL_Debug("SHM", "%s is owned by another publisher", lpName);
+		goto fail;
+	}
+	ctx.hdr = MapViewOfFile(ctx.file, FILE_MAP_WRITE, 0, 0, size);
+	if (!ctx.hdr)
+		goto fail;
+	ctx.staging = calloc(NWSHM_CAPACITY, sizeof(NWSHM_ENTRY));
+	if (!ctx.staging)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+
+	// The mapping starts zeroed, so readers see Count 0 until the first update.
+	ctx.hdr->HeaderSize = sizeof(NWSHM_HEADER);
+	ctx.hdr->EntrySize = sizeof(NWSHM_ENTRY);
+	ctx.hdr->Capacity = NWSHM_CAPACITY;
+	ctx.hdr->WriterPid = GetCurrentProcessId();
+	ctx.hdr->Version = NWSHM_VERSION;
+	ctx.entries = (NWSHM_ENTRY*)((BYTE*)ctx.hdr + sizeof(NWSHM_HEADER));
+	MemoryBarrier();
+	ctx.hdr->Magic = NWSHM_MAGIC;
+	NWL_Debug("SHM", "Publishing %u entries to %s", NWSHM_CAPACITY, lpName);
+	return TRUE;
+fail:
+	NWL_ShmPublisherClose();
+	return FALSE;
+}
+
+VOID NWL_ShmPublisherClose(VOID)
+{
+	if (ctx.hdr)
+		UnmapViewOfFile(ctx.hdr);
+	if (ctx.file)
+		CloseHandle(ctx.file);
+	free(ctx.staging);
+	ZeroMemory(&ctx, sizeof(ctx));
+}
+
+static void
+StageNode(PNODE node, int len)
+{
+	int count = NWL_NodeAttrCount(node);
+	for (int i = 0; i < count && ctx.count < NWSHM_CAPACITY; i++)
+	{
+		PNODE_ATT att = NWL_NodeAttrEnum(node, i);
+		char* end;
+		if (!att || !(att->flags & NAFLG_FMT_NUMERIC))
+			continue;
+		double value = strtod(att->value, &end);
+		if (end == att->value)
+			continue;
+		NWSHM_ENTRY* e = &ctx.staging[ctx.count];
+		if (snprintf(e->Path, NWSHM_PATH_LEN, "%s/%s", ctx.path, att->key) >= NWSHM_PATH_LEN)
+		{
+			NWL_Debug("SHM", "Path too long %s/%s", ctx.path, att->key);
+			continue;
+		}
+		e->Key = NWSHM_Key(e->Path);
+		e->Value = value;
+		ctx.count++;
+	}
+
+	count = NWL_NodeChildCount(node);
+	for (int i = 0; i < count; i++)
+	{
+		PNODE child = NWL_NodeEnumChild(node, i);
+		int n = snprintf(ctx.path + len, NWSHM_PATH_LEN - len, "/%s", child->name);
+		if (n < 0 || len + n >= NWSHM_PATH_LEN)
+			continue;
+		StageNode(child, len + n);
+	}
+	ctx.path[len] = '\0';
+}
+
+VOID NWL_ShmPublish(PNODE sensors)
+{
+	FILETIME ft;
+
+	if (!ctx.hdr || !sensors)
+		return;
+	ctx.count = 0;
+	int count = NWL_NodeChildCount(sensors);
+	for (int i = 0; i < count; i++)
+	{
+		PNODE child = NWL_NodeEnumChild(sensors, i);
+		int n = snprintf(ctx.path, NWSHM_PATH_LEN, "%s", child->name);
+		if (n < 0 || n >= NWSHM_PATH_LEN)
+			continue;
+		StageNode(child, n);
+	}
+	GetSystemTimeAsFileTime(&ft);
+
+	InterlockedIncrement64(&ctx.hdr->Sequence);
+	memcpy(ctx.entries, ctx.staging, ctx.count * sizeof(NWSHM_ENTRY));
+	ctx.hdr->Count = ctx.count;
+	ctx.hdr->Timestamp = ((UINT64)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+	InterlockedIncrement64(&ctx.hdr->Sequence);
+}
+
+static BOOL WINAPI
+PublishCtrlHandler(DWORD dwCtrlType)
+{
+	UNREFERENCED_PARAMETER(dwCtrlType);
+	InterlockedExchange(&m_stop, 1);
+	return TRUE;
+}
+
+VOID NW_Publish(LPCSTR lpName, DWORD dwInterval)
+{
+	if (!NWL_ShmPublisherOpen(lpName))
+		NWL_ErrExit(ERROR_OPEN_FAILED, "Cannot create shared memory");
+	SetConsoleCtrlHandler(PublishCtrlHandler, TRUE);
+	NWL_InitSensors(NWLC->NwSensorFlags);
+	while (!m_stop)
+	{
+		PNODE node = NW_Sensors(FALSE);
+		NWL_ShmPublish(node);
+		NWL_NodeFree(node, 1);
+		Sleep(dwInterval);
+	}
+	SetConsoleCtrlHandler(PublishCtrlHandler, FALSE);
+	NWL_ShmPublisherClose();
+}
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: Unlicense
+#pragma once
+
+// Layout of the shared memory published by "nwinfo --publish".
+// It depends on nothing but the CRT and Windows headers so other programs
+// can copy it as is.
+//
+// The writer bumps Sequence to an odd value, rewrites the entries and bumps
+// it again. A reader copies the entries it wants and accepts the copy only
+// if Sequence was even and unchanged around it.
+
+#include <windows.h>
+#include <string.h>
+
+#define NWSHM_NAME_DEFAULT_A "NWinfoSensors"
+#define NWSHM_NAME_DEFAULT L"NWinfoSensors"
+#define NWSHM_MAGIC 0x4D53574EU // "NWSM"
+#define NWSHM_VERSION 1
+#define NWSHM_PATH_LEN 116
+#define NWSHM_READ_RETRY 64
+
+#pragma pack(push, 8)
+typedef struct
+{
+	UINT32 Magic;
+	UINT16 Version;
+	UINT16 HeaderSize;
+	UINT32 EntrySize;
+	UINT32 Capacity;
+	volatile LONG64 Sequence;
+	UINT32 Count;
+	UINT32 WriterPid;
+	UINT64 Timestamp; // FILETIME (UTC) of the last update
+	UINT64 Reserved[3];
+} NWSHM_HEADER;
+
+typedef struct
+{
+	// UTF-8, '/' separated: provider, groups, then the reading name,
+	// e.g. "CPU/Intel Core i7-8550U/Core Temperature".
+	CHAR Path[NWSHM_PATH_LEN];
+	UINT32 Key; // FNV-1a of Path
+	double Value;
+} NWSHM_ENTRY;
+#pragma pack(pop)
+
+#define NWSHM_ENTRIES(hdr) ((const volatile NWSHM_ENTRY*)((const BYTE*)(hdr) + (hdr)->HeaderSize))
+
+typedef struct
+{
+	HANDLE File;
+	const volatile NWSHM_HEADER* Header;
+} NWSHM_READER;
+
+static inline UINT32
+NWSHM_Key(LPCSTR lpPath)
+{
+	UINT32 h = 2166136261U;
+	for (; *lpPath; lpPath++)
+	{
+		h ^= (UCHAR)*lpPath;
+		h *= 16777619U;
+	}
+	return h;
+}
+
+static inline BOOL
+NWSHM_Open(NWSHM_READER* reader, LPCWSTR lpName)
+{
+	ZeroMemory(reader, sizeof(NWSHM_READER));
+	reader->File = OpenFileMappingW(FILE_MAP_READ, FALSE, lpName ? lpName : NWSHM_NAME_DEFAULT);
+	if (!reader->File)
+		return FALSE;
+	reader->Header = MapViewOfFile(reader->File, FILE_MAP_READ, 0, 0, 0);
+	if (!reader->Header
+		|| reader->Header->Magic != NWSHM_MAGIC
+		|| reader->Header->Version != NWSHM_VERSION
+		|| reader->Header->EntrySize != sizeof(NWSHM_ENTRY))
+	{
+		if (reader->Header)
+			UnmapViewOfFile((LPCVOID)reader->Header);
+		CloseHandle(reader->File);
+		ZeroMemory(reader, sizeof(NWSHM_READER));
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static inline VOID
+NWSHM_Close(NWSHM_READER* reader)
+{
+	if (reader->Header)
+		UnmapViewOfFile((LPCVOID)reader->Header);
+	if (reader->File)
+		CloseHandle(reader->File);
+	ZeroMemory(reader, sizeof(NWSHM_READER));
+}
+
+// Copy up to dwMax entries into pEntries. Returns the number copied,
+// or -1 if the writer kept the segment busy for NWSHM_READ_RETRY tries.
+// pRetries, if set, receives the number of discarded attempts.
+static inline INT
+NWSHM_ReadEx(const NWSHM_READER* reader, NWSHM_ENTRY* pEntries, DWORD dwMax, UINT64* pTimestamp, PINT pRetries)
+{
+	const volatile NWSHM_HEADER* hdr = reader->Header;
+	for (int retry = 0; retry < NWSHM_READ_RETRY; retry++)
+	{
+		LONG64 seq = hdr->Sequence;
+		if (pRetries)
+			*pRetries = retry;
+		if (seq & 1)
+		{
+			YieldProcessor();
+			continue;
+		}
+		MemoryBarrier();
+		DWORD count = hdr->Count;
+		if (count > hdr->Capacity)
+			count = hdr->Capacity;
+		if (count > dwMax)
+			count = dwMax;
+		CopyMemory(pEntries, (const void*)NWSHM_ENTRIES(hdr), count * sizeof(NWSHM_ENTRY));
+		if (pTimestamp)
+			*pTimestamp = hdr->Timestamp;
+		MemoryBarrier();
+		if (hdr->Sequence == seq)
+			return (INT)count;
+	}
+	if (pRetries)
+		*pRetries = NWSHM_READ_RETRY;
+	return -1;
+}
+
+static inline INT
+NWSHM_Read(const NWSHM_READER* reader, NWSHM_ENTRY* pEntries, DWORD dwMax, UINT64* pTimestamp)
+{
+	return NWSHM_ReadEx(reader, pEntries, dwMax, pTimestamp, NULL);
+}
+
+// Read a single value by path. Returns FALSE if it is missing or busy.
+static inline BOOL
+NWSHM_ReadValue(const NWSHM_READER* reader, LPCSTR lpPath, double* pValue)
+{
+	const volatile NWSHM_HEADER* hdr = reader->Header;
+	const volatile NWSHM_ENTRY* entries = NWSHM_ENTRIES(hdr);
+	UINT32 key = NWSHM_Key(lpPath);
+	for (int retry = 0; retry < NWSHM_READ_RETRY; retry++)
+	{
+		BOOL found = FALSE;
+		double value = 0.0;
+		LONG64 seq = hdr->Sequence;
+		if (seq & 1)
+		{
+			YieldProcessor();
+			continue;
+		}
+		MemoryBarrier();
+		DWORD count = hdr->Count;
+		if (count > hdr->Capacity)
+			count = hdr->Capacity;
+		for (DWORD i = 0; i < count; i++)
+		{
+			if (entries[i].Key == key
+				&& strncmp((const char*)entries[i].Path, lpPath, NWSHM_PATH_LEN) == 0)
+			{
+				value = entries[i].Value;
+				found = TRUE;
+				break;
+			}
+		}
+		MemoryBarrier();
+		if (hdr->Sequence == seq)
+		{
+			if (found)
+				*pValue = value;
+			return found;
+		}
+	}
+	return FALSE;
+}
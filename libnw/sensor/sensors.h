@@ -28,7 +28,12 @@ typedef struct
 #define NWL_SENSOR_DISK     (1 << 9)
 #define NWL_SENSOR_INTEL      (1 << 10)
 #define NWL_SENSOR_ZEN      (1 << 11)
+#define NWL_SENSOR_SIO      (1 << 12)
 
 void NWL_InitSensors(uint64_t flags);
 void NWL_FreeSensors(void);
 PNODE NWL_GetSensors(PNODE parent);
+
+BOOL NWL_ShmPublisherOpen(LPCSTR lpName);
+VOID NWL_ShmPublish(PNODE sensors);
+VOID NWL_ShmPublisherClose(VOID);
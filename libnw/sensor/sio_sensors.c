@@ -0,0 +1,461 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdlib.h>
+
+#include "libnw.h"
+#include "utils.h"
+#include "sensors.h"
+#include "ioctl.h"
+#include "lpcio.h"
+#include "chip_ids.h"
+#include "lpc/lpc.h"
+
+// Super I/O hardware monitor readers.
+// Register layouts follow the chip datasheets and LibreHardwareMonitor.
+
+#define SIO_ADDR_OFFSET 0x05
+#define SIO_DATA_OFFSET 0x06
+#define SIO_BANK_SELECT 0x4E
+#define SIO_REG_MAX 48
+
+enum SIO_KIND
+{
+	SIO_VOLT = 0,
+	SIO_TEMP,       // signed byte, optional half degree in aux bit 7
+	SIO_FAN_ITE,    // 16-bit count, reg = low, aux = high
+	SIO_FAN_NCT,    // 16-bit RPM, reg = high, aux = low
+	SIO_FAN_FINTEK, // 16-bit count, reg = high, aux = low
+};
+
+typedef struct
+{
+	uint8_t kind;
+	uint16_t reg;   // bank << 8 | offset
+	uint16_t aux;   // second register, 0 if unused
+	float gain;     // volts per LSB for SIO_VOLT
+	const char* label;
+} SIO_REG;
+
+typedef struct
+{
+	enum CHIP_ID chip;
+	const char* name;
+	uint16_t base;
+	bool banked;
+	bool ite;       // ITE reports 0 for open temperature inputs
+	size_t count;
+	SIO_REG regs[SIO_REG_MAX];
+	// Raw values of the last poll, same order as regs.
+	uint8_t raw[SIO_REG_MAX];
+	uint8_t raw_aux[SIO_REG_MAX];
+} SIO_CHIP;
+
+static struct
+{
+	NWLIB_MAINBOARD_INFO board;
+	PNWLIB_LPC lpc;
+	size_t count;
+	SIO_CHIP chips[LPCIO_SLOT_MAX];
+} ctx;
+
+static void
+sio_add(SIO_CHIP* c, uint8_t kind, uint16_t reg, uint16_t aux, float gain, const char* label)
+{
+	if (c->count >= SIO_REG_MAX)
+		return;
+	c->regs[c->count++] = (SIO_REG){ .kind = kind, .reg = reg, .aux = aux, .gain = gain, .label = label };
+}
+
+static const char* sio_volt_label[] =
+{
+	"Voltage #1", "Voltage #2", "Voltage #3", "Voltage #4", "Voltage #5",
+	"Voltage #6", "Voltage #7", "Voltage #8", "Voltage #9", "Voltage #10",
+	"Voltage #11", "Voltage #12", "Voltage #13", "Voltage #14", "Voltage #15",
+};
+
+static const char* sio_temp_label[] =
+{
+	"Temperature #1", "Temperature #2", "Temperature #3", "Temperature #4",
+	"Temperature #5", "Temperature #6", "Temperature #7",
+};
+
+static const char* sio_fan_label[] =
+{
+	"Fan #1", "Fan #2", "Fan #3", "Fan #4", "Fan #5", "Fan #6", "Fan #7",
+};
+
+static bool
+sio_map_ite(SIO_CHIP* c)
+{
+	float gain;
+	int fans = 5;
+
+	switch (c->chip)
+	{
+	case CHIP_IT8705F:
+		// 8-bit fan counters with divisors, voltages and temperatures only
+		fans = 0;
+		gain = 0.016f;
+		break;
+	case CHIP_IT8712F:
+	case CHIP_IT8716F:
+	case CHIP_IT8718F:
+	case CHIP_IT8720F:
+	case CHIP_IT8726F:
+		fans = 3;
+		gain = 0.016f;
+		break;
+	case CHIP_IT8613E:
+	case CHIP_IT8620E:
+	case CHIP_IT8628E:
+	case CHIP_IT8631E:
+	case CHIP_IT8686E:
+	case CHIP_IT8688E:
+	case CHIP_IT8689E:
+	case CHIP_IT8696E:
+	case CHIP_IT8721F:
+	case CHIP_IT8728F:
+	case CHIP_IT8771E:
+	case CHIP_IT8772E:
+		gain = 0.012f;
+		break;
+	case CHIP_IT8625E:
+	case CHIP_IT8655E:
+	case CHIP_IT8665E:
+	case CHIP_IT8792E:
+	case CHIP_IT87952E:
+		gain = 0.0109f;
+		break;
+	default:
+		// Older parts and anything not confirmed to use the 12 mV ADC
+		gain = 0.016f;
+		break;
+	}
+	c->ite = true;
+	for (uint16_t i = 0; i < 9; i++)
+		sio_add(c, SIO_VOLT, 0x20 + i, 0, gain, sio_volt_label[i]);
+	for (uint16_t i = 0; i < 3; i++)
+		sio_add(c, SIO_TEMP, 0x29 + i, 0, 0, sio_temp_label[i]);
+	static const uint16_t fan_lo[] = { 0x0D, 0x0E, 0x0F, 0x80, 0x82 };
+	static const uint16_t fan_hi[] = { 0x18, 0x19, 0x1A, 0x81, 0x83 };
+	for (int i = 0; i < fans; i++)
+		sio_add(c, SIO_FAN_ITE, fan_lo[i], fan_hi[i], 0, sio_fan_label[i]);
+	return true;
+}
+
+static bool
+sio_map_nuvoton(SIO_CHIP* c)
+{
+	int fans;
+
+	switch (c->chip)
+	{
+	case CHIP_NCT6779D:
+		fans = 5;
+		break;
+	case CHIP_NCT6791D:
+	case CHIP_NCT6792D:
+	case CHIP_NCT6792DA:
+	case CHIP_NCT6793D:
+	case CHIP_NCT6795D:
+		fans = 6;
+		break;
+	case CHIP_NCT6796D:
+	case CHIP_NCT6796DR:
+	case CHIP_NCT6796DS:
+	case CHIP_NCT6797D:
+	case CHIP_NCT6798D:
+	case CHIP_NCT6799D:
+	case CHIP_NCT6701D:
+	case CHIP_NCT5585D:
+		fans = 7;
+		break;
+	default:
+		// NCT610x and NCT668x expose the monitor through a different interface.
+		return false;
+	}
+	c->banked = true;
+	// AVCC, +3.3V, +3V standby and VBAT sit behind an internal 1/2 divider.
+	for (uint16_t i = 0; i < 15; i++)
+	{
+		const char* label = sio_volt_label[i];
+		float gain = 0.008f;
+		switch (i)
+		{
+		case 0: label = "Vcore"; break;
+		case 2: label = "AVCC"; gain = 0.016f; break;
+		case 3: label = "+3.3V"; gain = 0.016f; break;
+		case 7: label = "+3V Standby"; gain = 0.016f; break;
+		case 8: label = "VBat"; gain = 0.016f; break;
+		}
+		sio_add(c, SIO_VOLT, 0x480 + i, 0, gain, label);
+	}
+	static const uint16_t temp_reg[] = { 0x027, 0x073, 0x075, 0x077, 0x079, 0x07B, 0x150 };
+	static const uint16_t temp_half[] = { 0x000, 0x074, 0x076, 0x078, 0x07A, 0x07C, 0x151 };
+	for (size_t i = 0; i < ARRAYSIZE(temp_reg); i++)
+		sio_add(c, SIO_TEMP, temp_reg[i], temp_half[i], 0, sio_temp_label[i]);
+	for (uint16_t i = 0; i < fans; i++)
+		sio_add(c, SIO_FAN_NCT, 0x4C0 + 2 * i, 0x4C1 + 2 * i, 0, sio_fan_label[i]);
+	return true;
+}
+
+static bool
+sio_map_winbond(SIO_CHIP* c)
+{
+	float gain = 0.008f;
+	int fans = 0;
+
+	switch (c->chip)
+	{
+	case CHIP_W83627HF:
+	case CHIP_W83627THF:
+	case CHIP_W83687THF:
+		gain = 0.016f;
+		break;
+	case CHIP_W83627EHF:
+	case CHIP_W83627DHG:
+	case CHIP_W83627DHGP:
+	case CHIP_W83667HG:
+	case CHIP_W83667HGB:
+		break;
+	case CHIP_NCT6771F:
+		fans = 4;
+		break;
+	case CHIP_NCT6776F:
+		fans = 5;
+		break;
+	default:
+		return false;
+	}
+	c->banked = true;
+	// Winbond fan counters need per-fan divisors and are left out.
+	// NCT6771F/NCT6776F keep the Winbond voltage and temperature layout
+	// but also report fan speeds directly in RPM in bank 6.
+	for (uint16_t i = 0; i < 7; i++)
+		sio_add(c, SIO_VOLT, 0x20 + i, 0, gain, i == 0 ? "Vcore" : sio_volt_label[i]);
+	sio_add(c, SIO_TEMP, 0x027, 0, 0, sio_temp_label[0]);
+	sio_add(c, SIO_TEMP, 0x150, 0x151, 0, sio_temp_label[1]);
+	sio_add(c, SIO_TEMP, 0x250, 0x251, 0, sio_temp_label[2]);
+	for (uint16_t i = 0; i < fans; i++)
+		sio_add(c, SIO_FAN_NCT, 0x656 + 2 * i, 0x657 + 2 * i, 0, sio_fan_label[i]);
+	return true;
+}
+
+static bool
+sio_map_fintek(SIO_CHIP* c)
+{
+	int fans = 3;
+
+	switch (c->chip)
+	{
+	case CHIP_F71858:
+		// Different temperature encoding, voltages only
+		for (uint16_t i = 0; i < 3; i++)
+			sio_add(c, SIO_VOLT, 0x20 + i, 0, 0.008f, sio_volt_label[i]);
+		return true;
+	case CHIP_F71882:
+		fans = 4;
+		break;
+	case CHIP_F71808E:
+	case CHIP_F71862:
+	case CHIP_F71869:
+	case CHIP_F71869A: // also F71811
+	case CHIP_F71878AD:
+	case CHIP_F71889AD:
+	case CHIP_F71889ED:
+	case CHIP_F71889F:
+		break;
+	default:
+		return false;
+	}
+	// VCC3V, VSB3V and VBAT sit behind an internal 1/2 divider.
+	for (uint16_t i = 0; i < 9; i++)
+	{
+		const char* label = sio_volt_label[i];
+		float gain = 0.008f;
+		switch (i)
+		{
+		case 0: label = "+3.3V"; gain = 0.016f; break;
+		case 1: label = "Vcore"; break;
+		case 7: label = "+3V Standby"; gain = 0.016f; break;
+		case 8: label = "VBat"; gain = 0.016f; break;
+		}
+		sio_add(c, SIO_VOLT, 0x20 + i, 0, gain, label);
+	}
+	for (uint16_t i = 0; i < 3; i++)
+		sio_add(c, SIO_TEMP, 0x72 + 2 * i, 0, 0, sio_temp_label[i]);
+	for (uint16_t i = 0; i < fans; i++)
+		sio_add(c, SIO_FAN_FINTEK, 0xA0 + 0x10 * i, 0xA1 + 0x10 * i, 0, sio_fan_label[i]);
+	return true;
+}
+
+static bool
+sio_map(SIO_CHIP* c, const NWLIB_LPC_SLOT* slot)
+{
+	ZeroMemory(c, sizeof(SIO_CHIP));
+	c->chip = slot->chip;
+	c->name = slot->name;
+	c->base = slot->address;
+	if (slot->drv == NULL || c->base == 0)
+		return false;
+	if (strcmp(slot->drv->name, "ITE") == 0)
+		return sio_map_ite(c);
+	if (c->chip == CHIP_NCT6771F || c->chip == CHIP_NCT6776F)
+		return sio_map_winbond(c);
+	if (strcmp(slot->drv->name, "Nuvoton") == 0)
+		return sio_map_nuvoton(c);
+	if (strcmp(slot->drv->name, "Winbond") == 0)
+		return sio_map_winbond(c);
+	if (strcmp(slot->drv->name, "Fintek") == 0)
+		return sio_map_fintek(c);
+	return false;
+}
+
+static inline void
+sio_bank(SIO_CHIP* c, uint8_t bank)
+{
+	plpcio io = &ctx.lpc->io;
+	lpcio_pio_outb(io, c->base + SIO_ADDR_OFFSET, SIO_BANK_SELECT);
+	lpcio_pio_outb(io, c->base + SIO_DATA_OFFSET, bank);
+}
+
+static inline uint8_t
+sio_read(SIO_CHIP* c, uint16_t reg, uint8_t* bank)
+{
+	uint8_t value = 0xFF;
+	plpcio io = &ctx.lpc->io;
+	if (c->banked && (reg >> 8) != *bank)
+	{
+		*bank = (uint8_t)(reg >> 8);
+		sio_bank(c, *bank);
+	}
+	lpcio_pio_outb(io, c->base + SIO_ADDR_OFFSET, (uint8_t)reg);
+	lpcio_pio_inb(io, c->base + SIO_DATA_OFFSET, &value);
+	return value;
+}
+
+// Read every mapped register of every chip under one ISA bus lock.
+static bool
+sio_poll(void)
+{
+	if (!WR0_WaitIsaBus(100))
+		return false;
+	for (size_t i = 0; i < ctx.count; i++)
+	{
+		SIO_CHIP* c = &ctx.chips[i];
+		uint8_t bank = 0xFF;
+		for (size_t j = 0; j < c->count; j++)
+		{
+			c->raw[j] = sio_read(c, c->regs[j].reg, &bank);
+			if (c->regs[j].aux)
+				c->raw_aux[j] = sio_read(c, c->regs[j].aux, &bank);
+		}
+		// Leave bank 0 selected as the BIOS expects.
+		if (c->banked && bank != 0)
+			sio_bank(c, 0);
+	}
+	WR0_ReleaseIsaBus();
+	return true;
+}
+
+static bool sio_init(void)
+{
+	if (!NWLC->NwDrv)
+		return false;
+	if (!NWL_GetMainboardInfo(&ctx.board))
+		goto fail;
+	ctx.lpc = NWL_InitLpc(&ctx.board);
+	if (!ctx.lpc)
+		goto fail;
+	for (enum LPCIO_CHIP_SLOT i = 0; i < LPCIO_SLOT_MAX; i++)
+	{
+		if (ctx.lpc->slots[i].chip == CHIP_UNKNOWN)
+			continue;
+		if (sio_map(&ctx.chips[ctx.count], &ctx.lpc->slots[i]))
+		{
+			NWL_Debug("SIO", "%s at 0x%04X, %zu registers", ctx.chips[ctx.count].name,
+				ctx.chips[ctx.count].base, ctx.chips[ctx.count].count);
+			ctx.count++;
+		}
+		else
+			NWL_Debug("SIO", "%s not supported", ctx.lpc->slots[i].name);
+	}
+	if (ctx.count == 0)
+		goto fail;
+	return true;
+fail:
+	NWL_FreeLpc(ctx.lpc);
+	ZeroMemory(&ctx, sizeof(ctx));
+	return false;
+}
+
+static void sio_fini(void)
+{
+	NWL_FreeLpc(ctx.lpc);
+	ZeroMemory(&ctx, sizeof(ctx));
+}
+
+static void sio_get(PNODE node)
+{
+	if (!sio_poll())
+		return;
+	for (size_t i = 0; i < ctx.count; i++)
+	{
+		SIO_CHIP* c = &ctx.chips[i];
+		PNODE chip = NWL_NodeAppendNew(node, c->name, NFLG_ATTGROUP | NAFLG_FMT_KEY_QUOTE);
+		for (size_t j = 0; j < c->count; j++)
+		{
+			SIO_REG* r = &c->regs[j];
+			uint8_t lo = c->raw[j];
+			uint8_t hi = c->raw_aux[j];
+			switch (r->kind)
+			{
+			case SIO_VOLT:
+				if (lo == 0 || lo == 0xFF)
+					break;
+				NWL_NodeAttrSetf(chip, r->label, NAFLG_FMT_NUMERIC, "%.3f", lo * r->gain);
+				break;
+			case SIO_TEMP:
+			{
+				int8_t t = (int8_t)lo;
+				if (t == -128 || t == 127 || (c->ite && t <= 0))
+					break;
+				float value = t + ((r->aux && (hi & 0x80)) ? 0.5f : 0.0f);
+				NWL_NodeAttrSetf(chip, r->label, NAFLG_FMT_NUMERIC, "%.1f", NWL_GetTemperature(value));
+				break;
+			}
+			case SIO_FAN_ITE:
+			{
+				uint16_t count = lo | (hi << 8);
+				if (count > 0x3F && count < 0xFFFF)
+					NWL_NodeAttrSetf(chip, r->label, NAFLG_FMT_NUMERIC, "%.0f", 1.35e6f / (count * 2));
+				break;
+			}
+			case SIO_FAN_NCT:
+			{
+				// reg holds the high byte
+				uint16_t rpm = (lo << 8) | hi;
+				if (rpm != 0xFFFF)
+					NWL_NodeAttrSetf(chip, r->label, NAFLG_FMT_NUMERIC, "%u", rpm);
+				break;
+			}
+			case SIO_FAN_FINTEK:
+			{
+				uint16_t count = (lo << 8) | hi;
+				if (count > 0 && count < 0x0FFF)
+					NWL_NodeAttrSetf(chip, r->label, NAFLG_FMT_NUMERIC, "%.0f", 1.5e6f / count);
+				break;
+			}
+			}
+		}
+	}
+}
+
+sensor_t sensor_sio =
+{
+	.name = "SIO",
+	.flag = NWL_SENSOR_SIO,
+	.init = sio_init,
+	.get = sio_get,
+	.fini = sio_fini,
+};
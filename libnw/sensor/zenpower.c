@@ -71,32 +71,6 @@ static struct
 	uint8_t ccd_temp_limit;
 	uint8_t zen_gen;
 	float temp_offset;
-	float stapm_limit;
-	float stapm_value;
-	float fast_limit;
-	float fast_value;
-	float slow_limit;
-	float slow_value;
-	float apu_slow_limit;
-	float apu_slow_value;
-	float vrm_current;
-	float vrm_current_value;
-	float vrmsoc_current;
-	float vrmsoc_current_value;
-	float gfx_temperature;
-	float gfx_volt;
-	float gfx_clk;
-	float psi0_current;
-	float psi0soc_current;
-	float fclk;
-	float uclk;
-	float mclk;
-	float soc_volt;
-	float cldo_vddp;
-	float l3_clk;
-	float l3_vddm;
-	float l3_temperature;
-	float socket_power;
 } ctx;
 
 static inline bool thm_is_valid_tccd(uint32_t thm)
@@ -378,58 +352,66 @@ static inline float thm_to_tccd(uint32_t thm)
 	return (0.125f * (thm & ZEN_CCD_TEMP_MASK) - 49.0f);
 }
 
-static inline void
-get_smu_value(PNODE node, const char* name, ry_err_t(*func)(ry_handle_t*, float*), float* value)
+static const struct
 {
-	float data = 0.0f;
-	ry_err_t err = func(ctx.smu, &data);
-	if (err == RYZEN_SMU_OK)
-		value = &data;
-	else if (*value == 0.0f)
-		return;
-	NWL_NodeAttrSetf(node, name, NAFLG_FMT_NUMERIC, "%.3f", *value);
-}
-
-static inline void
-get_smu_temp(PNODE node, const char* name, ry_err_t(*func)(ry_handle_t*, float*), float* value)
-{
-	float data = 0.0f;
-	ry_err_t err = func(ctx.smu, &data);
-	if (err == RYZEN_SMU_OK)
-		value = &data;
-	else if (*value == 0.0f)
-		return;
-	NWL_NodeAttrSetf(node, name, NAFLG_FMT_NUMERIC, "%.3f", NWL_GetTemperature(*value));
-}
-
-static inline void
-get_smu_value_core(PNODE node, const char* name, ry_err_t(*func)(ry_handle_t*, uint32_t, float*))
+	const char* name;
+	ry_pm_metric_t metric;
+	bool temp;
+	bool per_core;
+} smu_metrics[] =
 {
-	for (uint32_t i = 0; i < ctx.num_cores; i++)
-	{
-		float data = 0.0f;
-		ry_err_t err = func(ctx.smu, i, &data);
-		if (err == RYZEN_SMU_OK)
-		{
-			char buf[64];
-			snprintf(buf, sizeof(buf), "%s %u", name, i);
-			NWL_NodeAttrSetf(node, buf, NAFLG_FMT_NUMERIC, "%.3f", data);
-		}
-	}
-}
+	{ "STAPM Limit", RY_PM_STAPM_LIMIT, false, false },
+	{ "STAPM Value", RY_PM_STAPM_VALUE, false, false },
+	{ "Fast Limit", RY_PM_FAST_LIMIT, false, false },
+	{ "Fast Value", RY_PM_FAST_VALUE, false, false },
+	{ "Slow Limit", RY_PM_SLOW_LIMIT, false, false },
+	{ "Slow Value", RY_PM_SLOW_VALUE, false, false },
+	{ "APU Slow Limit", RY_PM_APU_SLOW_LIMIT, false, false },
+	{ "APU Slow Value", RY_PM_APU_SLOW_VALUE, false, false },
+	{ "VRM Current", RY_PM_VRM_CURRENT, false, false },
+	{ "VRM Current Value", RY_PM_VRM_CURRENT_VALUE, false, false },
+	{ "VRM SoC Current", RY_PM_VRMSOC_CURRENT, false, false },
+	{ "VRM SoC Current Value", RY_PM_VRMSOC_CURRENT_VALUE, false, false },
+	{ "GFX Temperature", RY_PM_GFX_TEMPERATURE, true, false },
+	{ "GFX Voltage", RY_PM_GFX_VOLT, false, false },
+	{ "GFX Clock", RY_PM_GFX_CLK, false, false },
+	{ "PSI0 Current", RY_PM_PSI0_CURRENT, false, false },
+	{ "PSI0 SoC Current", RY_PM_PSI0SOC_CURRENT, false, false },
+	{ "Fabric Clock", RY_PM_FCLK, false, false },
+	{ "Uncore Clock", RY_PM_UCLK, false, false },
+	{ "Memory Clock", RY_PM_MCLK, false, false },
+	{ "SoC Voltage", RY_PM_SOC_VOLT, false, false },
+	{ "CLDO VDDP", RY_PM_CLDO_VDDP, false, false },
+	{ "L3 Clock", RY_PM_L3_CLK, false, false },
+	{ "L3 VDDM", RY_PM_L3_VDDM, false, false },
+	{ "L3 Temperature", RY_PM_L3_TEMPERATURE, true, false },
+	{ "Socket Power", RY_PM_SOCKET_POWER, false, false },
+	{ "Core Temperature", RY_PM_CORE_TEMPERATURE, true, true },
+	{ "Core Power", RY_PM_CORE_POWER, false, true },
+	{ "Core Voltage", RY_PM_CORE_VOLT, false, true },
+	{ "Core Clock", RY_PM_CORE_CLK, false, true },
+};
 
-static inline void
-get_smu_temp_core(PNODE node, const char* name, ry_err_t(*func)(ry_handle_t*, uint32_t, float*))
+static void get_smu_values(PNODE node)
 {
-	for (uint32_t i = 0; i < ctx.num_cores; i++)
+	char buf[64];
+	for (size_t i = 0; i < ARRAYSIZE(smu_metrics); i++)
 	{
-		float data = 0.0f;
-		ry_err_t err = func(ctx.smu, i, &data);
-		if (err == RYZEN_SMU_OK)
+		uint32_t count = smu_metrics[i].per_core ? ctx.num_cores : 1;
+		for (uint32_t j = 0; j < count; j++)
 		{
-			char buf[64];
-			snprintf(buf, sizeof(buf), "%s %u", name, i);
-			NWL_NodeAttrSetf(node, buf, NAFLG_FMT_NUMERIC, "%.3f", NWL_GetTemperature(data));
+			float data = 0.0f;
+			if (ryzen_smu_get_pm_metric(ctx.smu, smu_metrics[i].metric, j, &data) != RYZEN_SMU_OK)
+				break;
+			if (smu_metrics[i].temp)
+				data = NWL_GetTemperature(data);
+			if (smu_metrics[i].per_core)
+			{
+				snprintf(buf, sizeof(buf), "%s %u", smu_metrics[i].name, j);
+				NWL_NodeAttrSetf(node, buf, NAFLG_FMT_NUMERIC, "%.3f", data);
+			}
+			else
+				NWL_NodeAttrSetf(node, smu_metrics[i].name, NAFLG_FMT_NUMERIC, "%.3f", data);
 		}
 	}
 }
@@ -472,37 +454,7 @@ static void smn_get(PNODE node)
 	if (ctx.smu)
 	{
 		ryzen_smu_update_pm_table(ctx.smu);
-
-		get_smu_value(node, "STAPM Limit", ryzen_smu_get_stapm_limit, &ctx.stapm_limit);
-		get_smu_value(node, "STAPM Value", ryzen_smu_get_stapm_value, &ctx.stapm_value);
-		get_smu_value(node, "Fast Limit", ryzen_smu_get_fast_limit, &ctx.fast_limit);
-		get_smu_value(node, "Fast Value", ryzen_smu_get_fast_value, &ctx.fast_value);
-		get_smu_value(node, "Slow Limit", ryzen_smu_get_slow_limit, &ctx.slow_limit);
-		get_smu_value(node, "Slow Value", ryzen_smu_get_slow_value, &ctx.slow_value);
-		get_smu_value(node, "APU Slow Limit", ryzen_smu_get_apu_slow_limit, &ctx.apu_slow_limit);
-		get_smu_value(node, "APU Slow Value", ryzen_smu_get_apu_slow_value, &ctx.apu_slow_value);
-		get_smu_value(node, "VRM Current", ryzen_smu_get_vrm_current, &ctx.vrm_current);
-		get_smu_value(node, "VRM Current Value", ryzen_smu_get_vrm_current_value, &ctx.vrm_current_value);
-		get_smu_value(node, "VRM SoC Current", ryzen_smu_get_vrmsoc_current, &ctx.vrmsoc_current);
-		get_smu_value(node, "VRM SoC Current Value", ryzen_smu_get_vrmsoc_current_value, &ctx.vrmsoc_current_value);
-		get_smu_temp(node, "GFX Temperature", ryzen_smu_get_gfx_temperature, &ctx.gfx_temperature);
-		get_smu_value(node, "GFX Voltage", ryzen_smu_get_gfx_volt, &ctx.gfx_volt);
-		get_smu_value(node, "GFX Clock", ryzen_smu_get_gfx_clk, &ctx.gfx_clk);
-		get_smu_value(node, "PSI0 Current", ryzen_smu_get_psi0_current, &ctx.psi0_current);
-		get_smu_value(node, "PSI0 SoC Current", ryzen_smu_get_psi0soc_current, &ctx.psi0soc_current);
-		get_smu_value(node, "Fabric Clock", ryzen_smu_get_fclk, &ctx.fclk);
-		get_smu_value(node, "Uncore Clock", ryzen_smu_get_uclk, &ctx.uclk);
-		get_smu_value(node, "Memory Clock", ryzen_smu_get_mclk, &ctx.mclk);
-		get_smu_value(node, "SoC Voltage", ryzen_smu_get_soc_volt, &ctx.soc_volt);
-		get_smu_value(node, "CLDO VDDP", ryzen_smu_get_cldo_vddp, &ctx.cldo_vddp);
-		get_smu_value(node, "L3 Clock", ryzen_smu_get_l3_clk, &ctx.l3_clk);
-		get_smu_value(node, "L3 VDDM", ryzen_smu_get_l3_vddm, &ctx.l3_vddm);
-		get_smu_temp(node, "L3 Temperature", ryzen_smu_get_l3_temperature, &ctx.l3_temperature);
-		get_smu_value(node, "Socket Power", ryzen_smu_get_socket_power, &ctx.socket_power);
-		get_smu_temp_core(node, "Core Temperature", ryzen_smu_get_core_temperature);
-		get_smu_value_core(node, "Core Power", ryzen_smu_get_core_power);
-		get_smu_value_core(node, "Core Voltage", ryzen_smu_get_core_volt);
-		get_smu_value_core(node, "Core Clock", ryzen_smu_get_core_clk);
+		get_smu_values(node);
 	}
 
 	WR0_ReleasePciBus();
@@ -20,6 +20,7 @@ extern sensor_t sensor_net;
 extern sensor_t sensor_imc;
 extern sensor_t sensor_intel;
 extern sensor_t sensor_zen;
+extern sensor_t sensor_sio;
 
 static sensor_t* sensor_list[] =
 {
@@ -35,6 +36,7 @@ static sensor_t* sensor_list[] =
 	&sensor_imc,
 	&sensor_intel,
 	&sensor_zen,
+	&sensor_sio,
 };
 
 static bool sensor_initialized = false;
@@ -0,0 +1,374 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <io.h>
+#include <fcntl.h>
+#include <windows.h>
+
+#include "libnw.h"
+#include "utils.h"
+
+#define NW_SERVE_PIPE_PREFIX "\\\\.\\pipe\\"
+#define NW_SERVE_REQ_MAX 1024
+#define NW_SERVE_BUF_SIZE 65536
+// A client that connects but stalls is dropped after this many milliseconds.
+#define NW_SERVE_IO_TIMEOUT 5000
+
+// Sections that never change while the process is alive have a TTL of 0.
+// Everything else is collected again once its TTL has expired.
+typedef struct _NW_SERVE_SECTION
+{
+	LPCSTR Name;
+	PNODE (*Collect)(BOOL bAppend);
+	ULONGLONG Ttl;
+	PNODE Node;
+	ULONGLONG Stamp;
+	BOOL Selected;
+} NW_SERVE_SECTION;
+
+static NW_SERVE_SECTION m_sections[] =
+{
+	{ "acpi", NW_Acpi, 0 },
+	{ "cpu", NW_Cpuid, 0 },
+	{ "disk", NW_Disk, 60 * 1000 },
+	{ "display", NW_Edid, 0 },
+	{ "net", NW_Network, 5 * 1000 },
+	{ "board", NW_Mainboard, 0 },
+	{ "pci", NW_Pci, 0 },
+	{ "smbios", NW_Smbios, 0 },
+	{ "sys", NW_System, 5 * 1000 },
+	{ "usb", NW_Usb, 60 * 1000 },
+	{ "spd", NW_Spd, 0 },
+	{ "battery", NW_Battery, 30 * 1000 },
+	{ "uefi", NW_Uefi, 0 },
+	{ "shares", NW_NetShare, 60 * 1000 },
+	{ "audio", NW_Audio, 60 * 1000 },
+	{ "public-ip", NW_PublicIp, 10 * 60 * 1000 },
+	{ "product-policy", NW_ProductPolicy, 0 },
+	{ "gpu", NW_Gpu, 2 * 1000 },
+	{ "font", NW_Font, 0 },
+	{ "device", NW_DevTree, 60 * 1000 },
+	{ "drv-store", NW_DrvStore, 0 },
+	{ "hid", NW_Hid, 60 * 1000 },
+	{ "sensors", NW_Sensors, 1000 },
+};
+
+static NW_SERVE_SECTION*
+FindSection(LPCSTR lpName)
+{
+	for (size_t i = 0; i < ARRAYSIZE(m_sections); i++)
+	{
+		if (_stricmp(m_sections[i].Name, lpName) == 0)
+			return &m_sections[i];
+	}
+	return NULL;
+}
+
+static BOOL
+ParseFormat(LPCSTR lpName)
+{
+	if (_stricmp(lpName, "YAML") == 0)
+		NWLC->NwFormat = FORMAT_YAML;
+	else if (_stricmp(lpName, "JSON") == 0)
+		NWLC->NwFormat = FORMAT_JSON;
+	else if (_stricmp(lpName, "LUA") == 0)
+		NWLC->NwFormat = FORMAT_LUA;
+	else if (_stricmp(lpName, "TREE") == 0)
+		NWLC->NwFormat = FORMAT_TREE;
+	else if (_stricmp(lpName, "HTML") == 0)
+		NWLC->NwFormat = FORMAT_HTML;
+	else
+		return FALSE;
+	return TRUE;
+}
+
+// Request line: whitespace separated tokens, leading "--" optional.
+// "format=FMT" or a bare format name selects the reply format,
+// "refresh" ignores the cache, "quit" stops the service,
+// everything else names a section as on the command line.
+// Unknown tokens are reported in the reply's error log, so a request
+// made only of them still gets a reply.
+static BOOL
+ParseRequest(LPSTR lpLine, BOOL* pRefresh, BOOL* pQuit)
+{
+	BOOL bAny = FALSE;
+	LPSTR ctx = NULL;
+	LPSTR token = strtok_s(lpLine, " \t\r\n", &ctx);
+
+	for (size_t i = 0; i < ARRAYSIZE(m_sections); i++)
+		m_sections[i].Selected = FALSE;
+	*pRefresh = FALSE;
+	*pQuit = FALSE;
+
+	for (; token; token = strtok_s(NULL, " \t\r\n", &ctx))
+	{
+		NW_SERVE_SECTION* section;
+		if (token[0] == '-' && token[1] == '-')
+			token += 2;
+		if (_strnicmp(token, "format=", 7) == 0)
+			ParseFormat(token + 7);
+		else if (ParseFormat(token))
+			continue;
+		else if (_stricmp(token, "refresh") == 0)
+			*pRefresh = TRUE;
+		else if (_stricmp(token, "quit") == 0)
+			*pQuit = TRUE;
+		else if ((section = FindSection(token)) != NULL)
+		{
+			section->Selected = TRUE;
+			bAny = TRUE;
+		}
+		else
+		{
+			snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "Unknown request token %s", token);
+			NWL_NodeAppendMultiSz(&NWLC->ErrLog, NWLC->NwBuf);
+			NWL_Debug("SERVE", "%s", NWLC->NwBuf);
+			bAny = TRUE;
+		}
+	}
+	return bAny;
+}
+
+static VOID
+CollectSection(NW_SERVE_SECTION* section, BOOL bRefresh)
+{
+	ULONGLONG now = GetTickCount64();
+	if (section->Node && !bRefresh)
+	{
+		if (section->Ttl == 0 || now - section->Stamp < section->Ttl)
+			return;
+	}
+	NWL_Debug("SERVE", "Collect %s", section->Name);
+	if (section->Node)
+		NWL_NodeFree(section->Node, 1);
+	section->Node = section->Collect(FALSE);
+	section->Stamp = now;
+}
+
+// Finish an overlapped pipe operation, giving up after dwTimeout.
+static BOOL
+WaitPipeIo(HANDLE hPipe, OVERLAPPED* ov, BOOL bOk, DWORD dwTimeout, DWORD* pdwBytes)
+{
+	if (!bOk && GetLastError() != ERROR_IO_PENDING)
+		return FALSE;
+	if (WaitForSingleObject(ov->hEvent, dwTimeout) != WAIT_OBJECT_0)
+	{
+		CancelIo(hPipe);
+		// The OVERLAPPED must stay valid until the cancelled operation completes.
+		GetOverlappedResult(hPipe, ov, pdwBytes, TRUE);
+		return FALSE;
+	}
+	return GetOverlappedResult(hPipe, ov, pdwBytes, FALSE);
+}
+
+static BOOL
+ConnectPipe(HANDLE hPipe, OVERLAPPED* ov)
+{
+	DWORD dwBytes;
+	if (ConnectNamedPipe(hPipe, ov))
+		return TRUE;
+	switch (GetLastError())
+	{
+	case ERROR_PIPE_CONNECTED:
+		return TRUE;
+	case ERROR_IO_PENDING:
+		// Waiting for the next client has no time limit.
+		return GetOverlappedResult(hPipe, ov, &dwBytes, TRUE);
+	}
+	return FALSE;
+}
+
+// The pipe is overlapped, which the CRT cannot write to, so the reply
+// is rendered into a temporary file and copied to the pipe afterwards.
+static FILE*
+OpenReplyStream(VOID)
+{
+	WCHAR szDir[MAX_PATH];
+	WCHAR szPath[MAX_PATH];
+	HANDLE hFile;
+	int fd;
+	FILE* fp;
+
+	if (!GetTempPathW(MAX_PATH, szDir) || !GetTempFileNameW(szDir, L"nws", 0, szPath))
+		return NULL;
+	hFile = CreateFileW(szPath, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		DeleteFileW(szPath);
+		return NULL;
+	}
+	fd = _open_osfhandle((intptr_t)hFile, _O_RDWR | _O_BINARY);
+	if (fd == -1)
+	{
+		CloseHandle(hFile);
+		return NULL;
+	}
+	fp = _fdopen(fd, "w+b");
+	if (fp == NULL)
+	{
+		_close(fd);
+		return NULL;
+	}
+	setvbuf(fp, NULL, _IOFBF, NW_SERVE_BUF_SIZE);
+	return fp;
+}
+
+static DWORD WINAPI
+FlushPipeThread(LPVOID lpParameter)
+{
+	return FlushFileBuffers((HANDLE)lpParameter) ? 0 : 1;
+}
+
+// FlushFileBuffers waits for the client to read everything and has no timeout,
+// so it runs on its own thread and is cancelled if the client stalls.
+// The handle is overlapped, so the flush is cancelled through the handle.
+static VOID
+FlushPipe(HANDLE hPipe)
+{
+	HANDLE hThread = CreateThread(NULL, 0, FlushPipeThread, hPipe, 0, NULL);
+	if (hThread == NULL)
+		return;
+	if (WaitForSingleObject(hThread, NW_SERVE_IO_TIMEOUT) != WAIT_OBJECT_0)
+	{
+		NWL_Debug("SERVE", "Client stopped reading, dropping it");
+		CancelIoEx(hPipe, NULL);
+		WaitForSingleObject(hThread, INFINITE);
+	}
+	CloseHandle(hThread);
+}
+
+static BOOL
+SendReply(HANDLE hPipe, OVERLAPPED* ov, FILE* fp, LPBYTE lpBuf)
+{
+	size_t len;
+	fflush(fp);
+	rewind(fp);
+	while ((len = fread(lpBuf, 1, NW_SERVE_BUF_SIZE, fp)) > 0)
+	{
+		DWORD dwWritten = 0;
+		BOOL bOk = WriteFile(hPipe, lpBuf, (DWORD)len, NULL, ov);
+		if (!WaitPipeIo(hPipe, ov, bOk, NW_SERVE_IO_TIMEOUT, &dwWritten) || dwWritten != len)
+		{
+			NWL_Debug("SERVE", "Reply write timed out or failed");
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+static VOID
+ServeReply(FILE* fp, BOOL bRefresh)
+{
+	PNODE root = NWLC->NwRoot;
+	PNODE reply = NWL_NodeAlloc("NWinfo", 0);
+
+	// Cached section nodes are borrowed by the reply root and handed back
+	// before it is freed, so the export path sees the usual tree.
+	NWLC->NwRoot = reply;
+	for (size_t i = 0; i < ARRAYSIZE(m_sections); i++)
+	{
+		if (!m_sections[i].Selected)
+			continue;
+		CollectSection(&m_sections[i], bRefresh);
+		if (m_sections[i].Node)
+			NWL_NodeAppendChild(reply, m_sections[i].Node);
+	}
+	NW_Libinfo();
+	NW_Export(reply, fp);
+	for (size_t i = 0; i < ARRAYSIZE(m_sections); i++)
+	{
+		if (m_sections[i].Selected && m_sections[i].Node)
+			m_sections[i].Node->parent = NULL;
+	}
+	NWL_NodeFree(reply, 0);
+	NWLC->NwRoot = root;
+}
+
+static LPSTR
+CopyMultiSz(LPCSTR lpMulti)
+{
+	size_t len = 0;
+	LPSTR copy;
+	if (lpMulti == NULL)
+		return NULL;
+	while (lpMulti[len])
+		len += strlen(lpMulti + len) + 1;
+	copy = malloc(len + 1);
+	if (copy == NULL)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	memcpy(copy, lpMulti, len + 1);
+	return copy;
+}
+
+VOID NW_Serve(LPCSTR lpPipeName)
+{
+	CHAR szPath[MAX_PATH];
+	CHAR szReq[NW_SERVE_REQ_MAX];
+	LPSTR lpErrLog = CopyMultiSz(NWLC->ErrLog);
+	int nFormat = NWLC->NwFormat;
+	BOOL bQuit = FALSE;
+	OVERLAPPED ov = { 0 };
+	LPBYTE lpBuf = malloc(NW_SERVE_BUF_SIZE);
+
+	if (lpBuf == NULL)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	ov.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+	if (ov.hEvent == NULL)
+		NWL_ErrExit(ERROR_OPEN_FAILED, "Cannot create event");
+
+	if (lpPipeName == NULL || lpPipeName[0] == '\0')
+		lpPipeName = "nwinfo";
+	snprintf(szPath, sizeof(szPath), "%s%s", NW_SERVE_PIPE_PREFIX, lpPipeName);
+	NWL_Debug("SERVE", "Listening on %s", szPath);
+
+	while (!bQuit)
+	{
+		DWORD dwRead = 0;
+		BOOL bRefresh = FALSE;
+		BOOL bOk;
+		FILE* fp;
+		HANDLE hPipe = CreateNamedPipeA(szPath, PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED,
+			PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+			1, NW_SERVE_BUF_SIZE, NW_SERVE_REQ_MAX, 0, NULL);
+		if (hPipe == INVALID_HANDLE_VALUE)
+			NWL_ErrExit(ERROR_OPEN_FAILED, "Cannot create pipe");
+
+		if (!ConnectPipe(hPipe, &ov))
+			goto next;
+		bOk = ReadFile(hPipe, szReq, sizeof(szReq) - 1, NULL, &ov);
+		if (!WaitPipeIo(hPipe, &ov, bOk, NW_SERVE_IO_TIMEOUT, &dwRead) || dwRead == 0)
+		{
+			NWL_Debug("SERVE", "No request, dropping client");
+			goto next;
+		}
+		szReq[dwRead] = '\0';
+		NWLC->NwFormat = nFormat;
+		// Start from the startup warnings so every reply carries the same list.
+		free(NWLC->ErrLog);
+		NWLC->ErrLog = CopyMultiSz(lpErrLog);
+		if (!ParseRequest(szReq, &bRefresh, &bQuit))
+			goto next;
+
+		fp = OpenReplyStream();
+		if (fp == NULL)
+			goto next;
+		ServeReply(fp, bRefresh);
+		if (SendReply(hPipe, &ov, fp, lpBuf))
+			FlushPipe(hPipe);
+		fclose(fp);
+	next:
+		DisconnectNamedPipe(hPipe);
+		CloseHandle(hPipe);
+	}
+
+	for (size_t i = 0; i < ARRAYSIZE(m_sections); i++)
+	{
+		NWL_NodeFree(m_sections[i].Node, 1);
+		m_sections[i].Node = NULL;
+	}
+	CloseHandle(ov.hEvent);
+	free(lpBuf);
+	free(lpErrLog);
+}
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <string.h>
+#include "sfnt.h"
+
+#define SFNT_TAG(a, b, c, d) (((uint32_t)(a) << 24) | ((uint32_t)(b) << 16) | ((uint32_t)(c) << 8) | (uint32_t)(d))
+
+#define SFNT_NAME_FAMILY 1
+#define SFNT_NAME_STYLE 2
+#define SFNT_NAME_FULL 4
+#define SFNT_NAME_VERSION 5
+#define SFNT_NAME_TYPO_FAMILY 16
+#define SFNT_NAME_TYPO_STYLE 17
+#define SFNT_NAME_MAX 18
+
+typedef struct
+{
+	const uint8_t* Base;
+	size_t Size;
+} SFNT_BUF;
+
+typedef struct
+{
+	const uint8_t* Ptr;
+	uint32_t Len;
+} SFNT_TABLE;
+
+static uint16_t
+GetBe16(const uint8_t* p)
+{
+	return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t
+GetBe32(const uint8_t* p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static int
+FindTable(const SFNT_BUF* buf, uint32_t offset, uint32_t tag, SFNT_TABLE* table)
+{
+	uint16_t count;
+	if (offset > buf->Size || buf->Size - offset < 12)
+		return 0;
+	count = GetBe16(buf->Base + offset + 4);
+	if ((buf->Size - offset - 12) / 16 < count)
+		return 0;
+	for (uint16_t i = 0; i < count; i++)
+	{
+		const uint8_t* rec = buf->Base + offset + 12 + i * 16;
+		uint32_t start, len;
+		if (GetBe32(rec) != tag)
+			continue;
+		start = GetBe32(rec + 8);
+		len = GetBe32(rec + 12);
+		if (start > buf->Size || len > buf->Size - start)
+			return 0;
+		table->Ptr = buf->Base + start;
+		table->Len = len;
+		return 1;
+	}
+	return 0;
+}
+
+// Append one code point to a NUL terminated UTF-8 buffer, never splitting it.
+static void
+PutUtf8(char* dst, size_t* len, uint32_t cp)
+{
+	char u[4];
+	size_t n;
+	if (cp == 0)
+		return;
+	if (cp < 0x80)
+	{
+		u[0] = (char)cp;
+		n = 1;
+	}
+	else if (cp < 0x800)
+	{
+		u[0] = (char)(0xC0 | (cp >> 6));
+		u[1] = (char)(0x80 | (cp & 0x3F));
+		n = 2;
+	}
+	else if (cp < 0x10000)
+	{
+		u[0] = (char)(0xE0 | (cp >> 12));
+		u[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+		u[2] = (char)(0x80 | (cp & 0x3F));
+		n = 3;
+	}
+	else
+	{
+		u[0] = (char)(0xF0 | (cp >> 18));
+		u[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+		u[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+		u[3] = (char)(0x80 | (cp & 0x3F));
+		n = 4;
+	}
+	if (*len + n >= NWL_SFNT_STR_MAX)
+		return;
+	memcpy(dst + *len, u, n);
+	*len += n;
+	dst[*len] = '\0';
+}
+
+static void
+CopyName(char* dst, const uint8_t* p, uint16_t len, int utf16)
+{
+	size_t out = 0;
+	dst[0] = '\0';
+	if (!utf16)
+	{
+		// Mac Roman, the ASCII half is all that matters for font names.
+		for (uint16_t i = 0; i < len; i++)
+			PutUtf8(dst, &out, p[i] < 0x80 ? p[i] : '?');
+		return;
+	}
+	for (uint16_t i = 0; i + 1 < len; i += 2)
+	{
+		uint32_t cp = GetBe16(p + i);
+		if (cp >= 0xD800 && cp < 0xDC00 && i + 3 < len)
+		{
+			uint32_t lo = GetBe16(p + i + 2);
+			if (lo >= 0xDC00 && lo < 0xE000)
+			{
+				cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+				i += 2;
+			}
+		}
+		PutUtf8(dst, &out, cp);
+	}
+}
+
+// Windows English names first, then any Windows or Unicode name, then Mac Roman.
+static int
+NameScore(uint16_t platform, uint16_t encoding, uint16_t language)
+{
+	switch (platform)
+	{
+	case 3:
+		if (encoding != 0 && encoding != 1 && encoding != 10)
+			return 0;
+		return language == 0x0409 ? 4 : 3;
+	case 0:
+		return 2;
+	case 1:
+		return (encoding == 0 && language == 0) ? 1 : 0;
+	}
+	return 0;
+}
+
+static void
+ParseNames(const SFNT_TABLE* name, NWL_SFNT_FACE* face)
+{
+	char names[SFNT_NAME_MAX][NWL_SFNT_STR_MAX] = { 0 };
+	int score[SFNT_NAME_MAX] = { 0 };
+	uint16_t count, storage;
+
+	if (name->Len < 6)
+		return;
+	count = GetBe16(name->Ptr + 2);
+	storage = GetBe16(name->Ptr + 4);
+	if ((name->Len - 6) / 12 < count)
+		count = (uint16_t)((name->Len - 6) / 12);
+	for (uint16_t i = 0; i < count; i++)
+	{
+		const uint8_t* rec = name->Ptr + 6 + i * 12;
+		uint16_t platform = GetBe16(rec);
+		uint16_t id = GetBe16(rec + 6);
+		uint16_t len = GetBe16(rec + 8);
+		uint32_t off = (uint32_t)storage + GetBe16(rec + 10);
+		int s;
+		if (id >= SFNT_NAME_MAX || off > name->Len || len > name->Len - off)
+			continue;
+		s = NameScore(platform, GetBe16(rec + 2), GetBe16(rec + 4));
+		if (s <= score[id])
+			continue;
+		score[id] = s;
+		CopyName(names[id], name->Ptr + off, len, platform != 1);
+	}
+
+	memcpy(face->Family, names[names[SFNT_NAME_TYPO_FAMILY][0] ? SFNT_NAME_TYPO_FAMILY : SFNT_NAME_FAMILY], NWL_SFNT_STR_MAX);
+	memcpy(face->Style, names[names[SFNT_NAME_TYPO_STYLE][0] ? SFNT_NAME_TYPO_STYLE : SFNT_NAME_STYLE], NWL_SFNT_STR_MAX);
+	memcpy(face->FullName, names[SFNT_NAME_FULL], NWL_SFNT_STR_MAX);
+	memcpy(face->Version, names[SFNT_NAME_VERSION], NWL_SFNT_STR_MAX);
+}
+
+static int
+ParseFace(const SFNT_BUF* buf, uint32_t offset, NWL_SFNT_FACE* face)
+{
+	SFNT_TABLE t;
+	uint32_t version;
+
+	if (offset > buf->Size || buf->Size - offset < 12)
+		return 0;
+	version = GetBe32(buf->Base + offset);
+	if (version != 0x00010000 && version != SFNT_TAG('O', 'T', 'T', 'O') && version != SFNT_TAG('t', 'r', 'u', 'e'))
+		return 0;
+	memset(face, 0, sizeof(NWL_SFNT_FACE));
+	face->Cff = (version == SFNT_TAG('O', 'T', 'T', 'O'));
+
+	if (FindTable(buf, offset, SFNT_TAG('n', 'a', 'm', 'e'), &t))
+		ParseNames(&t, face);
+	if (FindTable(buf, offset, SFNT_TAG('h', 'e', 'a', 'd'), &t) && t.Len >= 20)
+		face->UnitsPerEm = GetBe16(t.Ptr + 18);
+	if (FindTable(buf, offset, SFNT_TAG('h', 'h', 'e', 'a'), &t) && t.Len >= 12)
+		face->MaxAdvance = GetBe16(t.Ptr + 10);
+	if (FindTable(buf, offset, SFNT_TAG('O', 'S', '/', '2'), &t) && t.Len >= 78)
+	{
+		uint16_t selection = GetBe16(t.Ptr + 62);
+		face->AvgCharWidth = (int16_t)GetBe16(t.Ptr + 2);
+		face->Weight = GetBe16(t.Ptr + 4);
+		face->Italic = (selection & (1 << 0)) ? 1 : 0;
+		face->Underline = (selection & (1 << 1)) ? 1 : 0;
+		face->Strikeout = (selection & (1 << 4)) ? 1 : 0;
+		face->Ascent = GetBe16(t.Ptr + 74);
+		face->Descent = GetBe16(t.Ptr + 76);
+	}
+	return 1;
+}
+
+uint32_t
+NWL_SfntParse(const void* data, size_t size, NWL_SFNT_FACE* faces, uint32_t max)
+{
+	SFNT_BUF buf = { data, size };
+	uint32_t count = 0;
+
+	if (size < 12 || max == 0)
+		return 0;
+	if (GetBe32(buf.Base) != SFNT_TAG('t', 't', 'c', 'f'))
+		return ParseFace(&buf, 0, &faces[0]) ? 1 : 0;
+
+	uint32_t fonts = GetBe32(buf.Base + 8);
+	if ((size - 12) / 4 < fonts)
+		return 0;
+	for (uint32_t i = 0; i < fonts && count < max; i++)
+	{
+		if (ParseFace(&buf, GetBe32(buf.Base + 12 + i * 4), &faces[count]))
+		{
+			faces[count].Index = i;
+			count++;
+		}
+	}
+	return count;
+}
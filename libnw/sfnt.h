@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: Unlicense
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// TrueType / OpenType 'name', 'OS/2', 'head' and 'hhea' reader.
+// Works on a memory image of the file and has no OS dependency.
+
+#define NWL_SFNT_STR_MAX 96
+#define NWL_SFNT_FACE_MAX 64
+
+// Fixed size so it can be written to the font cache as is.
+typedef struct
+{
+	char Family[NWL_SFNT_STR_MAX];
+	char Style[NWL_SFNT_STR_MAX];
+	char FullName[NWL_SFNT_STR_MAX];
+	char Version[NWL_SFNT_STR_MAX];
+	uint32_t Index; // face index in a collection
+	uint16_t Weight;
+	uint16_t UnitsPerEm;
+	uint16_t Ascent;
+	uint16_t Descent;
+	int16_t AvgCharWidth;
+	uint16_t MaxAdvance;
+	uint8_t Cff; // PostScript outlines
+	uint8_t Italic;
+	uint8_t Underline;
+	uint8_t Strikeout;
+} NWL_SFNT_FACE;
+
+// Parse up to max faces. Returns 0 if the data is not a TrueType or
+// OpenType font or collection.
+uint32_t NWL_SfntParse(const void* data, size_t size, NWL_SFNT_FACE* faces, uint32_t max);
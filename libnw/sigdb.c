@@ -0,0 +1,631 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sigdb.h"
+
+#define SIGDB_LIST_HEADER_SIZE 28 // EFI_SIGNATURE_LIST without the signature header
+#define SIGDB_OWNER_SIZE 16
+
+static const NWL_SIGDB_GUID SigDbX509Guid =
+{ 0xA5C059A1U, 0x94E4, 0x4AA7, { 0x87, 0xB5, 0xAB, 0x15, 0x5C, 0x2B, 0xF0, 0x72 } };
+
+/* SHA-256 */
+
+typedef struct
+{
+	uint32_t State[8];
+	uint64_t Length;
+	uint8_t Block[64];
+	size_t Used;
+} SHA256_CTX;
+
+static const uint32_t Sha256K[64] =
+{
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define ROR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void
+Sha256Block(SHA256_CTX* ctx, const uint8_t* p)
+{
+	uint32_t w[64];
+	uint32_t a, b, c, d, e, f, g, h;
+	int i;
+
+	for (i = 0; i < 16; i++)
+		w[i] = ((uint32_t)p[i * 4] << 24) | ((uint32_t)p[i * 4 + 1] << 16)
+			| ((uint32_t)p[i * 4 + 2] << 8) | p[i * 4 + 3];
+	for (; i < 64; i++)
+	{
+		uint32_t s0 = ROR32(w[i - 15], 7) ^ ROR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+		uint32_t s1 = ROR32(w[i - 2], 17) ^ ROR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+		w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+	}
+
+	a = ctx->State[0]; b = ctx->State[1]; c = ctx->State[2]; d = ctx->State[3];
+	e = ctx->State[4]; f = ctx->State[5]; g = ctx->State[6]; h = ctx->State[7];
+	for (i = 0; i < 64; i++)
+	{
+		uint32_t t1 = h + (ROR32(e, 6) ^ ROR32(e, 11) ^ ROR32(e, 25)) + ((e & f) ^ (~e & g)) + Sha256K[i] + w[i];
+		uint32_t t2 = (ROR32(a, 2) ^ ROR32(a, 13) ^ ROR32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+		h = g; g = f; f = e; e = d + t1;
+		d = c; c = b; b = a; a = t1 + t2;
+	}
+	ctx->State[0] += a; ctx->State[1] += b; ctx->State[2] += c; ctx->State[3] += d;
+	ctx->State[4] += e; ctx->State[5] += f; ctx->State[6] += g; ctx->State[7] += h;
+}
+
+void
+NWL_Sha256(const void* data, size_t size, uint8_t hash[NWL_SHA256_SIZE])
+{
+	static const uint32_t iv[8] =
+	{
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+	};
+	SHA256_CTX ctx;
+	const uint8_t* p = data;
+
+	memcpy(ctx.State, iv, sizeof(iv));
+	ctx.Length = (uint64_t)size * 8;
+	for (; size >= 64; p += 64, size -= 64)
+		Sha256Block(&ctx, p);
+	memcpy(ctx.Block, p, size);
+	ctx.Used = size;
+	ctx.Block[ctx.Used++] = 0x80;
+	if (ctx.Used > 56)
+	{
+		memset(ctx.Block + ctx.Used, 0, 64 - ctx.Used);
+		Sha256Block(&ctx, ctx.Block);
+		ctx.Used = 0;
+	}
+	memset(ctx.Block + ctx.Used, 0, 56 - ctx.Used);
+	for (int i = 0; i < 8; i++)
+		ctx.Block[56 + i] = (uint8_t)(ctx.Length >> (56 - i * 8));
+	Sha256Block(&ctx, ctx.Block);
+	for (int i = 0; i < 8; i++)
+	{
+		hash[i * 4] = (uint8_t)(ctx.State[i] >> 24);
+		hash[i * 4 + 1] = (uint8_t)(ctx.State[i] >> 16);
+		hash[i * 4 + 2] = (uint8_t)(ctx.State[i] >> 8);
+		hash[i * 4 + 3] = (uint8_t)ctx.State[i];
+	}
+}
+
+/* EFI_SIGNATURE_LIST */
+
+static uint32_t
+GetLe32(const uint8_t* p)
+{
+	return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void
+GetGuid(NWL_SIGDB_GUID* guid, const uint8_t* p)
+{
+	guid->Data1 = GetLe32(p);
+	guid->Data2 = (uint16_t)(p[4] | (p[5] << 8));
+	guid->Data3 = (uint16_t)(p[6] | (p[7] << 8));
+	memcpy(guid->Data4, p + 8, 8);
+}
+
+static NWL_SIGDB_ENTRY*
+SigDbAddEntry(NWL_SIGDB* db, uint32_t* capacity)
+{
+	if (db->Count >= *capacity)
+	{
+		uint32_t n = *capacity ? *capacity * 2 : 64;
+		NWL_SIGDB_ENTRY* p = realloc(db->Entries, n * sizeof(NWL_SIGDB_ENTRY));
+		if (!p)
+			return NULL;
+		db->Entries = p;
+		*capacity = n;
+	}
+	NWL_SIGDB_ENTRY* entry = &db->Entries[db->Count++];
+	memset(entry, 0, sizeof(NWL_SIGDB_ENTRY));
+	return entry;
+}
+
+NWL_SIGDB*
+NWL_SigDbDecode(const void* data, uint32_t size)
+{
+	uint32_t capacity = 0;
+	uint32_t offset = 0;
+	NWL_SIGDB* db = calloc(1, sizeof(NWL_SIGDB));
+	if (!db)
+		return NULL;
+	db->Blob = malloc(size ? size : 1);
+	if (!db->Blob)
+		goto fail;
+	memcpy(db->Blob, data, size);
+	db->Size = size;
+	NWL_Sha256(db->Blob, size, db->Hash);
+
+	while (offset < size)
+	{
+		const uint8_t* list = db->Blob + offset;
+		uint32_t remaining = size - offset;
+		uint32_t list_size, header_size, signature_size;
+		uint32_t entry_offset, list_end;
+		uint32_t entry_index = 0;
+
+		if (remaining < SIGDB_LIST_HEADER_SIZE)
+		{
+			db->Error = "Truncated signature list";
+			break;
+		}
+		list_size = GetLe32(list + 16);
+		header_size = GetLe32(list + 20);
+		signature_size = GetLe32(list + 24);
+		if (list_size < SIGDB_LIST_HEADER_SIZE || list_size > remaining ||
+			header_size > list_size - SIGDB_LIST_HEADER_SIZE ||
+			signature_size <= SIGDB_OWNER_SIZE)
+		{
+			db->Error = "Invalid signature list";
+			break;
+		}
+
+		entry_offset = offset + SIGDB_LIST_HEADER_SIZE + header_size;
+		list_end = offset + list_size;
+		while (signature_size <= list_end - entry_offset)
+		{
+			NWL_SIGDB_ENTRY* entry = SigDbAddEntry(db, &capacity);
+			if (!entry)
+				goto fail;
+			entry->List = db->ListCount;
+			entry->Index = entry_index++;
+			GetGuid(&entry->Type, list);
+			GetGuid(&entry->Owner, db->Blob + entry_offset);
+			entry->Data = db->Blob + entry_offset + SIGDB_OWNER_SIZE;
+			entry->DataSize = signature_size - SIGDB_OWNER_SIZE;
+			entry_offset += signature_size;
+		}
+		if (entry_offset != list_end)
+		{
+			db->Error = "Truncated signature entry";
+			break;
+		}
+		offset += list_size;
+		db->ListCount++;
+	}
+	return db;
+fail:
+	NWL_SigDbFree(db);
+	return NULL;
+}
+
+int
+NWL_SigDbIsX509(const NWL_SIGDB_ENTRY* entry)
+{
+	return memcmp(&entry->Type, &SigDbX509Guid, sizeof(NWL_SIGDB_GUID)) == 0;
+}
+
+/* DER */
+
+typedef struct
+{
+	const uint8_t* Ptr;
+	size_t Len;
+} DER;
+
+#define DER_INTEGER 0x02
+#define DER_OID 0x06
+#define DER_UTF8_STRING 0x0C
+#define DER_NUMERIC_STRING 0x12
+#define DER_PRINTABLE_STRING 0x13
+#define DER_T61_STRING 0x14
+#define DER_IA5_STRING 0x16
+#define DER_VISIBLE_STRING 0x1A
+#define DER_UNIVERSAL_STRING 0x1C
+#define DER_BMP_STRING 0x1E
+#define DER_SEQUENCE 0x30
+#define DER_SET 0x31
+#define DER_CONTEXT_0 0xA0
+
+// Read one TLV from in, put its contents in out.
+static int
+DerRead(DER* in, uint8_t* tag, DER* out)
+{
+	size_t len;
+	size_t hdr = 2;
+	if (in->Len < 2)
+		return 0;
+	*tag = in->Ptr[0];
+	len = in->Ptr[1];
+	if (len & 0x80)
+	{
+		size_t n = len & 0x7F;
+		if (n == 0 || n > 4 || in->Len < 2 + n)
+			return 0;
+		len = 0;
+		for (size_t i = 0; i < n; i++)
+			len = (len << 8) | in->Ptr[2 + i];
+		hdr += n;
+	}
+	if (len > in->Len - hdr)
+		return 0;
+	out->Ptr = in->Ptr + hdr;
+	out->Len = len;
+	in->Ptr += hdr + len;
+	in->Len -= hdr + len;
+	return 1;
+}
+
+static int
+DerExpect(DER* in, uint8_t tag, DER* out)
+{
+	uint8_t t;
+	return DerRead(in, &t, out) && t == tag;
+}
+
+typedef struct
+{
+	char* Buf;
+	size_t Len;
+	size_t Size;
+	int Failed;
+} STR_BUF;
+
+static void
+StrPutN(STR_BUF* s, const char* p, size_t n)
+{
+	if (s->Failed)
+		return;
+	if (s->Len + n + 1 > s->Size)
+	{
+		size_t size = s->Size ? s->Size : 64;
+		while (s->Len + n + 1 > size)
+			size *= 2;
+		char* buf = realloc(s->Buf, size);
+		if (!buf)
+		{
+			s->Failed = 1;
+			return;
+		}
+		s->Buf = buf;
+		s->Size = size;
+	}
+	memcpy(s->Buf + s->Len, p, n);
+	s->Len += n;
+	s->Buf[s->Len] = '\0';
+}
+
+static void
+StrPut(STR_BUF* s, const char* p)
+{
+	StrPutN(s, p, strlen(p));
+}
+
+static void
+StrPutCodePoint(STR_BUF* s, uint32_t cp)
+{
+	char u[4];
+	if (cp < 0x80)
+	{
+		u[0] = (char)cp;
+		StrPutN(s, u, 1);
+	}
+	else if (cp < 0x800)
+	{
+		u[0] = (char)(0xC0 | (cp >> 6));
+		u[1] = (char)(0x80 | (cp & 0x3F));
+		StrPutN(s, u, 2);
+	}
+	else if (cp < 0x10000)
+	{
+		u[0] = (char)(0xE0 | (cp >> 12));
+		u[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+		u[2] = (char)(0x80 | (cp & 0x3F));
+		StrPutN(s, u, 3);
+	}
+	else if (cp < 0x110000)
+	{
+		u[0] = (char)(0xF0 | (cp >> 18));
+		u[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+		u[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+		u[3] = (char)(0x80 | (cp & 0x3F));
+		StrPutN(s, u, 4);
+	}
+}
+
+static char*
+StrDetach(STR_BUF* s)
+{
+	if (s->Failed || !s->Buf)
+	{
+		free(s->Buf);
+		return NULL;
+	}
+	return s->Buf;
+}
+
+// Decode a directory string value to UTF-8.
+static void
+StrPutValue(STR_BUF* s, uint8_t tag, const DER* v)
+{
+	static const char hex[] = "0123456789ABCDEF";
+	size_t i;
+	switch (tag)
+	{
+	case DER_UTF8_STRING:
+	case DER_NUMERIC_STRING:
+	case DER_PRINTABLE_STRING:
+	case DER_IA5_STRING:
+	case DER_VISIBLE_STRING:
+		StrPutN(s, (const char*)v->Ptr, v->Len);
+		break;
+	case DER_T61_STRING:
+		for (i = 0; i < v->Len; i++)
+			StrPutCodePoint(s, v->Ptr[i]);
+		break;
+	case DER_BMP_STRING:
+		for (i = 0; i + 1 < v->Len; i += 2)
+		{
+			uint32_t cp = ((uint32_t)v->Ptr[i] << 8) | v->Ptr[i + 1];
+			if (cp >= 0xD800 && cp < 0xDC00 && i + 3 < v->Len)
+			{
+				uint32_t lo = ((uint32_t)v->Ptr[i + 2] << 8) | v->Ptr[i + 3];
+				if (lo >= 0xDC00 && lo < 0xE000)
+				{
+					cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+					i += 2;
+				}
+			}
+			StrPutCodePoint(s, cp);
+		}
+		break;
+	case DER_UNIVERSAL_STRING:
+		for (i = 0; i + 3 < v->Len; i += 4)
+			StrPutCodePoint(s, ((uint32_t)v->Ptr[i] << 24) | ((uint32_t)v->Ptr[i + 1] << 16)
+				| ((uint32_t)v->Ptr[i + 2] << 8) | v->Ptr[i + 3]);
+		break;
+	default:
+		StrPut(s, "#");
+		for (i = 0; i < v->Len; i++)
+		{
+			char h[2] = { hex[v->Ptr[i] >> 4], hex[v->Ptr[i] & 0x0F] };
+			StrPutN(s, h, 2);
+		}
+		break;
+	}
+}
+
+typedef struct
+{
+	const char* Label;
+	uint8_t Len;
+	uint8_t Oid[10];
+} X500_ATTR;
+
+// Labels used by CertNameToStr with CERT_X500_NAME_STR.
+static const X500_ATTR X500Attrs[] =
+{
+	{ "CN", 3, { 0x55, 0x04, 0x03 } },
+	{ "SN", 3, { 0x55, 0x04, 0x04 } },
+	{ "SERIALNUMBER", 3, { 0x55, 0x04, 0x05 } },
+	{ "C", 3, { 0x55, 0x04, 0x06 } },
+	{ "L", 3, { 0x55, 0x04, 0x07 } },
+	{ "S", 3, { 0x55, 0x04, 0x08 } },
+	{ "STREET", 3, { 0x55, 0x04, 0x09 } },
+	{ "O", 3, { 0x55, 0x04, 0x0A } },
+	{ "OU", 3, { 0x55, 0x04, 0x0B } },
+	{ "T", 3, { 0x55, 0x04, 0x0C } },
+	{ "G", 3, { 0x55, 0x04, 0x2A } },
+	{ "I", 3, { 0x55, 0x04, 0x2B } },
+	{ "E", 9, { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x09, 0x01 } },
+	{ "DC", 10, { 0x09, 0x92, 0x26, 0x89, 0x93, 0xF2, 0x2C, 0x64, 0x01, 0x19 } },
+};
+
+static const char*
+X500Label(const DER* oid)
+{
+	for (size_t i = 0; i < sizeof(X500Attrs) / sizeof(X500Attrs[0]); i++)
+	{
+		if (oid->Len == X500Attrs[i].Len && memcmp(oid->Ptr, X500Attrs[i].Oid, oid->Len) == 0)
+			return X500Attrs[i].Label;
+	}
+	return NULL;
+}
+
+static void
+StrPutOid(STR_BUF* s, const DER* oid)
+{
+	char tmp[24];
+	uint64_t v = 0;
+	int first = 1;
+	for (size_t i = 0; i < oid->Len; i++)
+	{
+		v = (v << 7) | (oid->Ptr[i] & 0x7F);
+		if (oid->Ptr[i] & 0x80)
+			continue;
+		if (first)
+		{
+			unsigned arc = v < 40 ? 0 : (v < 80 ? 1 : 2);
+			snprintf(tmp, sizeof(tmp), "%u.%llu", arc, (unsigned long long)(v - arc * 40));
+			first = 0;
+		}
+		else
+			snprintf(tmp, sizeof(tmp), ".%llu", (unsigned long long)v);
+		StrPut(s, tmp);
+		v = 0;
+	}
+}
+
+static int
+NeedQuote(const char* p, size_t len)
+{
+	if (len == 0)
+		return 1;
+	if (p[0] == ' ' || p[len - 1] == ' ')
+		return 1;
+	for (size_t i = 0; i < len; i++)
+	{
+		if (strchr(",+=\"\n<>#;", p[i]))
+			return 1;
+	}
+	return 0;
+}
+
+static void
+StrPutAttr(STR_BUF* s, const DER* oid, uint8_t tag, const DER* value)
+{
+	STR_BUF v = { 0 };
+	const char* label = X500Label(oid);
+	if (label)
+		StrPut(s, label);
+	else
+	{
+		StrPut(s, "OID.");
+		StrPutOid(s, oid);
+	}
+	StrPut(s, "=");
+	StrPutValue(&v, tag, value);
+	if (v.Failed)
+	{
+		s->Failed = 1;
+		return;
+	}
+	if (v.Buf && !NeedQuote(v.Buf, v.Len))
+		StrPutN(s, v.Buf, v.Len);
+	else
+	{
+		StrPut(s, "\"");
+		for (size_t i = 0; i < v.Len; i++)
+		{
+			if (v.Buf[i] == '"')
+				StrPut(s, "\"");
+			StrPutN(s, &v.Buf[i], 1);
+		}
+		StrPut(s, "\"");
+	}
+	free(v.Buf);
+}
+
+#define X500_MAX_RDN 64
+
+// X.500 string of a Name, most specific RDN first, as
+// CertNameToStr(CERT_X500_NAME_STR | CERT_NAME_STR_REVERSE_FLAG) does.
+static char*
+NameToStr(const DER* name)
+{
+	DER rdns[X500_MAX_RDN];
+	size_t count = 0;
+	DER in = *name;
+	STR_BUF s = { 0 };
+
+	while (in.Len && count < X500_MAX_RDN)
+	{
+		if (!DerExpect(&in, DER_SET, &rdns[count]))
+			break;
+		count++;
+	}
+	while (count--)
+	{
+		DER set = rdns[count];
+		int first = 1;
+		while (set.Len)
+		{
+			DER atv, oid, value;
+			uint8_t tag;
+			if (!DerExpect(&set, DER_SEQUENCE, &atv) || !DerExpect(&atv, DER_OID, &oid) || !DerRead(&atv, &tag, &value))
+				break;
+			if (!first)
+				StrPut(&s, " + ");
+			StrPutAttr(&s, &oid, tag, &value);
+			first = 0;
+		}
+		if (count)
+			StrPut(&s, ", ");
+	}
+	return StrDetach(&s);
+}
+
+static int
+FindAttr(const DER* name, const char* label, uint8_t* tag, DER* value)
+{
+	DER in = *name;
+	DER set;
+	while (DerExpect(&in, DER_SET, &set))
+	{
+		DER atv, oid;
+		while (DerExpect(&set, DER_SEQUENCE, &atv) && DerExpect(&atv, DER_OID, &oid))
+		{
+			const char* l = X500Label(&oid);
+			if (!DerRead(&atv, tag, value))
+				break;
+			if (label == NULL || (l && strcmp(l, label) == 0))
+				return 1;
+		}
+	}
+	return 0;
+}
+
+// Simple display name, as CertGetNameString(CERT_NAME_SIMPLE_DISPLAY_TYPE)
+// picks it from the subject.
+static char*
+DisplayName(const DER* name)
+{
+	static const char* labels[] = { "CN", "OU", "O", "E", NULL };
+	STR_BUF s = { 0 };
+	uint8_t tag;
+	DER value;
+	for (size_t i = 0; i < sizeof(labels) / sizeof(labels[0]); i++)
+	{
+		if (FindAttr(name, labels[i], &tag, &value))
+		{
+			StrPutValue(&s, tag, &value);
+			return StrDetach(&s);
+		}
+	}
+	return NULL;
+}
+
+void
+NWL_SigDbParseCert(NWL_SIGDB_ENTRY* entry)
+{
+	DER in = { entry->Data, entry->DataSize };
+	DER cert, tbs, field, issuer, subject;
+	uint8_t tag;
+
+	if (!DerExpect(&in, DER_SEQUENCE, &cert) || !DerExpect(&cert, DER_SEQUENCE, &tbs))
+		return;
+	// version [0] EXPLICIT is optional
+	if (tbs.Len && tbs.Ptr[0] == DER_CONTEXT_0 && !DerRead(&tbs, &tag, &field))
+		return;
+	if (!DerExpect(&tbs, DER_INTEGER, &field) // serialNumber
+		|| !DerExpect(&tbs, DER_SEQUENCE, &field) // signature
+		|| !DerExpect(&tbs, DER_SEQUENCE, &issuer)
+		|| !DerExpect(&tbs, DER_SEQUENCE, &field) // validity
+		|| !DerExpect(&tbs, DER_SEQUENCE, &subject))
+		return;
+
+	entry->CertValid = 1;
+	entry->Name = DisplayName(&subject);
+	entry->Subject = NameToStr(&subject);
+	entry->Issuer = NameToStr(&issuer);
+}
+
+void
+NWL_SigDbFree(NWL_SIGDB* db)
+{
+	if (!db)
+		return;
+	for (uint32_t i = 0; i < db->Count; i++)
+	{
+		free(db->Entries[i].Name);
+		free(db->Entries[i].Subject);
+		free(db->Entries[i].Issuer);
+	}
+	free(db->Entries);
+	free(db->Blob);
+	free(db);
+}
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: Unlicense
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// EFI_SIGNATURE_LIST and X.509 decoding without any OS crypto API,
+// so captured variable contents can be checked on any platform.
+
+#define NWL_SHA256_SIZE 32
+
+// Same layout as GUID / EFI_GUID.
+typedef struct
+{
+	uint32_t Data1;
+	uint16_t Data2;
+	uint16_t Data3;
+	uint8_t Data4[8];
+} NWL_SIGDB_GUID;
+
+typedef struct
+{
+	uint32_t List;
+	uint32_t Index;
+	NWL_SIGDB_GUID Type;
+	NWL_SIGDB_GUID Owner;
+	const uint8_t* Data; // points into NWL_SIGDB.Blob
+	uint32_t DataSize;
+	// Set by NWL_SigDbParseCert
+	int CertValid;
+	char* Name;
+	char* Subject;
+	char* Issuer;
+} NWL_SIGDB_ENTRY;
+
+typedef struct
+{
+	uint8_t Hash[NWL_SHA256_SIZE]; // SHA-256 of Blob
+	uint8_t* Blob;
+	uint32_t Size;
+	uint32_t ListCount;
+	uint32_t Count;
+	NWL_SIGDB_ENTRY* Entries;
+	const char* Error; // why decoding stopped early, NULL if it did not
+} NWL_SIGDB;
+
+void NWL_Sha256(const void* data, size_t size, uint8_t hash[NWL_SHA256_SIZE]);
+
+// Split the variable contents into signatures. Certificates are not parsed.
+// Returns NULL only when out of memory.
+NWL_SIGDB* NWL_SigDbDecode(const void* data, uint32_t size);
+int NWL_SigDbIsX509(const NWL_SIGDB_ENTRY* entry);
+// Fill the certificate fields of one X.509 entry. Entries are independent,
+// so different entries can be parsed on different threads.
+void NWL_SigDbParseCert(NWL_SIGDB_ENTRY* entry);
+void NWL_SigDbFree(NWL_SIGDB* db);
@@ -2,7 +2,6 @@
 
 #include <windows.h>
 #include <winbase.h>
-#include <wincrypt.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -11,11 +10,49 @@
 #include "libnw.h"
 #include "utils.h"
 #include "efivars.h"
+#include "sigdb.h"
 
-typedef DWORD(WINAPI* PFN_CERT_GET_NAME_STRING_W)(PCCERT_CONTEXT, DWORD, DWORD, void*, LPWSTR, DWORD);
-typedef DWORD(WINAPI* PFN_CERT_NAME_TO_STR_W)(DWORD, PCERT_NAME_BLOB, DWORD, LPWSTR, DWORD);
-typedef PCCERT_CONTEXT(WINAPI* PFN_CERT_CREATE_CERTIFICATE_CONTEXT)(DWORD, const BYTE*, DWORD);
-typedef BOOL(WINAPI* PFN_CERT_FREE_CERTIFICATE_CONTEXT)(PCCERT_CONTEXT);
+#define SIGDB_PARSE_WORKERS 4
+#define SIGDB_PARSE_BATCH 8
+#define SIGDB_CACHE_MAX 16
+
+#define SIGDB_DISK_MAGIC 0x44534E4EU // "NNSD"
+#define SIGDB_DISK_VERSION 1
+#define SIGDB_DISK_MAX_SIZE (16U * 1024 * 1024)
+#define SIGDB_DISK_MAX_RECORDS 32
+
+#define SIGDB_DISK_CERT_VALID 0x01
+#define SIGDB_DISK_HAS_NAME 0x02
+#define SIGDB_DISK_HAS_SUBJECT 0x04
+#define SIGDB_DISK_HAS_ISSUER 0x08
+
+// Decoded signature databases keyed by the SHA-256 of their contents.
+typedef struct _NWL_SIGDB_CACHE
+{
+	size_t Count;
+	NWL_SIGDB* Db[SIGDB_CACHE_MAX];
+	// Contents of sigdb.cache, loaded on the first miss.
+	BOOL DiskLoaded;
+	BOOL DiskDirty;
+	PBYTE Disk;
+	DWORD DiskSize;
+} NWL_SIGDB_CACHE;
+
+typedef struct _SIGDB_DISK_HEADER
+{
+	UINT32 Magic;
+	UINT32 Version;
+	UINT32 Count;
+} SIGDB_DISK_HEADER;
+
+// Followed by Size bytes, one flags byte per entry and then
+// the NUL terminated strings the flags say are present.
+typedef struct _SIGDB_DISK_RECORD
+{
+	UINT8 Hash[NWL_SHA256_SIZE];
+	UINT32 EntryCount;
+	UINT32 Size;
+} SIGDB_DISK_RECORD;
 
 static void PrintBootEnv(PNODE node)
 {
@@ -33,12 +70,37 @@ static void PrintBootEnv(PNODE node)
 	NWL_NodeAttrSetf(node, "Boot Flags", 0, "0x%016llX", BootInfo.BootFlags);
 }
 
+// Private copy of a variable from the inventory.
+// Goes to the firmware only if the store could not be enumerated.
+static PVOID GetEfiVarAlloc(LPCWSTR name, LPGUID guid, PDWORD size, PDWORD attributes)
+{
+	NWL_EFI_VAR* var;
+	PVOID data;
+	if (NWL_GetEfiVars()->Count == 0)
+		return NWL_GetEfiVarAlloc(name, guid, size, attributes);
+	*size = 0;
+	var = NWL_FindEfiVar(name, guid);
+	if (!NWL_GetEfiVarData(var) || var->Size == 0)
+		return NULL;
+	data = malloc(var->Size);
+	if (!data)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	memcpy(data, var->Data, var->Size);
+	*size = var->Size;
+	if (attributes)
+		*attributes = var->Attributes;
+	return data;
+}
+
 static BOOL GetEfiGlobalVar(LPCWSTR name, LPVOID var, DWORD size)
 {
-	DWORD ret;
+	DWORD ret = 0;
+	PVOID data = GetEfiVarAlloc(name, NULL, &ret, NULL);
 	ZeroMemory(var, size);
-	ret = NWL_GetEfiVar(name, NULL, var, size, NULL);
-	return (GetLastError() == ERROR_SUCCESS) && (ret == size);
+	if (data && ret == size)
+		memcpy(var, data, size);
+	free(data);
+	return (ret == size);
 }
 
 static void PrintSecureBoot(PNODE node)
@@ -130,114 +192,341 @@ static const SECURE_BOOT_SIGNATURE_INFO* SecureBootGetSignatureInfo(const GUID*
 	return &SecureBootUnknownSignatureInfo;
 }
 
-static WCHAR* AllocCertDisplayName(HMODULE crypt32, PCCERT_CONTEXT cert)
+typedef struct _SIGDB_PARSE_CTX
 {
-	WCHAR* str;
-	PFN_CERT_GET_NAME_STRING_W pfnCertGetNameStringW = NULL;
+	NWL_SIGDB* Db;
+	volatile LONG Next;
+} SIGDB_PARSE_CTX;
 
-	*(FARPROC*)&pfnCertGetNameStringW = GetProcAddress(crypt32, "CertGetNameStringW");
-	if (!pfnCertGetNameStringW)
-		return NULL;
-	DWORD size = pfnCertGetNameStringW(cert, CERT_NAME_SIMPLE_DISPLAY_TYPE, 0, NULL, NULL, 0);
-	if (size <= 1)
-		return NULL;
-	str = calloc(size, sizeof(WCHAR));
-	if (!str)
-		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in "__FUNCTION__);
-	if (!pfnCertGetNameStringW(cert, CERT_NAME_SIMPLE_DISPLAY_TYPE, 0, NULL, str, size))
+static DWORD WINAPI
+SigDbParseWorker(LPVOID lpParameter)
+{
+	SIGDB_PARSE_CTX* ctx = lpParameter;
+	for (;;)
 	{
-		free(str);
-		return NULL;
+		LONG i = InterlockedIncrement(&ctx->Next) - 1;
+		if (i >= (LONG)ctx->Db->Count)
+			break;
+		if (NWL_SigDbIsX509(&ctx->Db->Entries[i]))
+			NWL_SigDbParseCert(&ctx->Db->Entries[i]);
 	}
-	return str;
+	return 0;
+}
+
+// Certificates are independent, so large databases are parsed in parallel.
+static void ParseSigDbCerts(NWL_SIGDB* db)
+{
+	SIGDB_PARSE_CTX ctx = { db, 0 };
+	HANDLE hThreads[SIGDB_PARSE_WORKERS] = { 0 };
+	DWORD dwThreads = 0;
+	DWORD dwWorkers;
+	DWORD dwCerts = 0;
+
+	for (UINT32 i = 0; i < db->Count; i++)
+	{
+		if (NWL_SigDbIsX509(&db->Entries[i]))
+			dwCerts++;
+	}
+	dwWorkers = dwCerts / SIGDB_PARSE_BATCH;
+	if (dwWorkers > SIGDB_PARSE_WORKERS)
+		dwWorkers = SIGDB_PARSE_WORKERS;
+	for (DWORD i = 0; i < dwWorkers; i++)
+	{
+		hThreads[dwThreads] = CreateThread(NULL, 0, SigDbParseWorker, &ctx, 0, NULL);
+		if (hThreads[dwThreads])
+			dwThreads++;
+	}
+	SigDbParseWorker(&ctx);
+	if (dwThreads == 0)
+		return;
+	WaitForMultipleObjects(dwThreads, hThreads, TRUE, INFINITE);
+	for (DWORD i = 0; i < dwThreads; i++)
+		CloseHandle(hThreads[i]);
 }
 
-static WCHAR* AllocCertNameString(HMODULE crypt32, PCERT_NAME_BLOB name)
+// Walk the records of the loaded sigdb.cache, returns the payload of the next one.
+static const BYTE* NextSigDbRecord(NWL_SIGDB_CACHE* cache, DWORD* offset, SIGDB_DISK_RECORD* rec)
 {
-	WCHAR* str;
-	PFN_CERT_NAME_TO_STR_W pfnCertNameToStrW = NULL;
+	const BYTE* p;
+	if (cache->DiskSize - *offset < sizeof(SIGDB_DISK_RECORD))
+		return NULL;
+	memcpy(rec, cache->Disk + *offset, sizeof(SIGDB_DISK_RECORD));
+	p = cache->Disk + *offset + sizeof(SIGDB_DISK_RECORD);
+	if (rec->Size > cache->DiskSize - *offset - sizeof(SIGDB_DISK_RECORD))
+		return NULL;
+	*offset += sizeof(SIGDB_DISK_RECORD) + rec->Size;
+	return p;
+}
 
-	*(FARPROC*)&pfnCertNameToStrW = GetProcAddress(crypt32, "CertNameToStrW");
-	if (!pfnCertNameToStrW)
+static LPCSTR GetSigDbString(const BYTE** p, const BYTE* end)
+{
+	const BYTE* s = *p;
+	const BYTE* nul = memchr(s, 0, end - s);
+	if (!nul)
 		return NULL;
-	DWORD size = pfnCertNameToStrW(X509_ASN_ENCODING, name,
-		CERT_X500_NAME_STR | CERT_NAME_STR_REVERSE_FLAG, NULL, 0);
-	if (size <= 1)
+	*p = nul + 1;
+	return (LPCSTR)s;
+}
+
+static char* DupSigDbString(const BYTE** p, const BYTE* end, BYTE flags, BYTE bit)
+{
+	char* str;
+	if (!(flags & bit))
 		return NULL;
-	str = calloc(size, sizeof(WCHAR));
+	str = _strdup(GetSigDbString(p, end));
 	if (!str)
-		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in "__FUNCTION__);
-	if (!pfnCertNameToStrW(X509_ASN_ENCODING, name,
-		CERT_X500_NAME_STR | CERT_NAME_STR_REVERSE_FLAG, str, size))
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	return str;
+}
+
+// Fill the certificate fields from a record written by an earlier run.
+// The record is checked in full first so a damaged one leaves db untouched.
+static BOOL ApplySigDbRecord(NWL_SIGDB* db, const SIGDB_DISK_RECORD* rec, const BYTE* data)
+{
+	const BYTE* end = data + rec->Size;
+	const BYTE* p;
+
+	if (rec->EntryCount != db->Count || rec->Size < db->Count)
+		return FALSE;
+	p = data + db->Count;
+	for (UINT32 i = 0; i < db->Count; i++)
 	{
-		free(str);
-		return NULL;
+		BYTE flags = data[i];
+		if ((flags & SIGDB_DISK_HAS_NAME) && !GetSigDbString(&p, end))
+			return FALSE;
+		if ((flags & SIGDB_DISK_HAS_SUBJECT) && !GetSigDbString(&p, end))
+			return FALSE;
+		if ((flags & SIGDB_DISK_HAS_ISSUER) && !GetSigDbString(&p, end))
+			return FALSE;
 	}
-	return str;
+	p = data + db->Count;
+	for (UINT32 i = 0; i < db->Count; i++)
+	{
+		NWL_SIGDB_ENTRY* entry = &db->Entries[i];
+		BYTE flags = data[i];
+		entry->CertValid = (flags & SIGDB_DISK_CERT_VALID) ? 1 : 0;
+		entry->Name = DupSigDbString(&p, end, flags, SIGDB_DISK_HAS_NAME);
+		entry->Subject = DupSigDbString(&p, end, flags, SIGDB_DISK_HAS_SUBJECT);
+		entry->Issuer = DupSigDbString(&p, end, flags, SIGDB_DISK_HAS_ISSUER);
+	}
+	return TRUE;
 }
 
-static void PrintX509Certificate(PNODE node, const UINT8* data, DWORD size)
+static VOID LoadSigDbDisk(NWL_SIGDB_CACHE* cache)
 {
-	HMODULE crypt32;
-	PCCERT_CONTEXT cert;
-	PFN_CERT_CREATE_CERTIFICATE_CONTEXT pfnCertCreateCertificateContext = NULL;
-	PFN_CERT_FREE_CERTIFICATE_CONTEXT pfnCertFreeCertificateContext = NULL;
+	WCHAR szPath[MAX_PATH];
+	SIGDB_DISK_HEADER* hdr;
 
-	crypt32 = LoadLibraryW(L"crypt32.dll");
-	if (!crypt32)
+	if (cache->DiskLoaded)
+		return;
+	cache->DiskLoaded = TRUE;
+	if (!NWL_GetCachePath(szPath, L"sigdb.cache"))
 		return;
-	*(FARPROC*)&pfnCertCreateCertificateContext = GetProcAddress(crypt32, "CertCreateCertificateContext");
-	*(FARPROC*)&pfnCertFreeCertificateContext = GetProcAddress(crypt32, "CertFreeCertificateContext");
-	if (!pfnCertCreateCertificateContext || !pfnCertFreeCertificateContext)
+	cache->Disk = NWL_LoadCacheFile(szPath, sizeof(SIGDB_DISK_HEADER), SIGDB_DISK_MAX_SIZE, &cache->DiskSize);
+	hdr = (SIGDB_DISK_HEADER*)cache->Disk;
+	if (hdr && (hdr->Magic != SIGDB_DISK_MAGIC || hdr->Version != SIGDB_DISK_VERSION))
+	{
+		free(cache->Disk);
+		cache->Disk = NULL;
+	}
+}
+
+static BOOL LoadSigDbFromDisk(NWL_SIGDB_CACHE* cache, NWL_SIGDB* db)
+{
+	SIGDB_DISK_RECORD rec;
+	const BYTE* data;
+	DWORD offset = sizeof(SIGDB_DISK_HEADER);
+
+	LoadSigDbDisk(cache);
+	if (!cache->Disk)
+		return FALSE;
+	while ((data = NextSigDbRecord(cache, &offset, &rec)) != NULL)
 	{
-		FreeLibrary(crypt32);
+		if (memcmp(rec.Hash, db->Hash, sizeof(rec.Hash)) == 0)
+			return ApplySigDbRecord(db, &rec, data);
+	}
+	return FALSE;
+}
+
+static BOOL WriteSigDbString(HANDLE hFile, const char* str)
+{
+	DWORD dwWritten;
+	return WriteFile(hFile, str, (DWORD)strlen(str) + 1, &dwWritten, NULL);
+}
+
+static BOOL WriteSigDbRecord(HANDLE hFile, const NWL_SIGDB* db)
+{
+	SIGDB_DISK_RECORD rec;
+	DWORD dwWritten;
+	BYTE* flags;
+	BOOL bOk;
+
+	memcpy(rec.Hash, db->Hash, sizeof(rec.Hash));
+	rec.EntryCount = db->Count;
+	rec.Size = db->Count;
+	flags = calloc(db->Count ? db->Count : 1, 1);
+	if (!flags)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	for (UINT32 i = 0; i < db->Count; i++)
+	{
+		const NWL_SIGDB_ENTRY* entry = &db->Entries[i];
+		if (entry->CertValid)
+			flags[i] |= SIGDB_DISK_CERT_VALID;
+		if (entry->Name)
+		{
+			flags[i] |= SIGDB_DISK_HAS_NAME;
+			rec.Size += (UINT32)strlen(entry->Name) + 1;
+		}
+		if (entry->Subject)
+		{
+			flags[i] |= SIGDB_DISK_HAS_SUBJECT;
+			rec.Size += (UINT32)strlen(entry->Subject) + 1;
+		}
+		if (entry->Issuer)
+		{
+			flags[i] |= SIGDB_DISK_HAS_ISSUER;
+			rec.Size += (UINT32)strlen(entry->Issuer) + 1;
+		}
+	}
+	bOk = WriteFile(hFile, &rec, sizeof(rec), &dwWritten, NULL)
+		&& (db->Count == 0 || WriteFile(hFile, flags, db->Count, &dwWritten, NULL));
+	for (UINT32 i = 0; bOk && i < db->Count; i++)
+	{
+		const NWL_SIGDB_ENTRY* entry = &db->Entries[i];
+		bOk = (!entry->Name || WriteSigDbString(hFile, entry->Name))
+			&& (!entry->Subject || WriteSigDbString(hFile, entry->Subject))
+			&& (!entry->Issuer || WriteSigDbString(hFile, entry->Issuer));
+	}
+	free(flags);
+	return bOk;
+}
+
+// Databases seen in this run go first, then records of earlier runs
+// that are not in memory, so a key rotation does not drop the old entry at once.
+static VOID SaveSigDbToDisk(NWL_SIGDB_CACHE* cache)
+{
+	WCHAR szPath[MAX_PATH];
+	WCHAR szTemp[MAX_PATH];
+	SIGDB_DISK_HEADER hdr = { SIGDB_DISK_MAGIC, SIGDB_DISK_VERSION, 0 };
+	SIGDB_DISK_RECORD rec;
+	const BYTE* data;
+	DWORD offset = sizeof(SIGDB_DISK_HEADER);
+	DWORD dwWritten;
+	BOOL bOk;
+	HANDLE hFile;
+
+	LoadSigDbDisk(cache);
+	cache->DiskDirty = FALSE;
+	if (!NWL_GetCachePath(szPath, L"sigdb.cache")
+		|| swprintf(szTemp, MAX_PATH, L"%s.%lu", szPath, GetCurrentProcessId()) < 0)
+		return;
+	hFile = CreateFileW(szTemp, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
 		return;
+	bOk = WriteFile(hFile, &hdr, sizeof(hdr), &dwWritten, NULL);
+	for (size_t i = 0; bOk && i < cache->Count; i++)
+	{
+		bOk = WriteSigDbRecord(hFile, cache->Db[i]);
+		hdr.Count++;
+	}
+	while (bOk && cache->Disk && hdr.Count < SIGDB_DISK_MAX_RECORDS
+		&& (data = NextSigDbRecord(cache, &offset, &rec)) != NULL)
+	{
+		BOOL bSeen = FALSE;
+		for (size_t i = 0; i < cache->Count && !bSeen; i++)
+			bSeen = memcmp(cache->Db[i]->Hash, rec.Hash, sizeof(rec.Hash)) == 0;
+		if (bSeen)
+			continue;
+		bOk = WriteFile(hFile, &rec, sizeof(rec), &dwWritten, NULL)
+			&& (rec.Size == 0 || WriteFile(hFile, data, rec.Size, &dwWritten, NULL));
+		hdr.Count++;
 	}
-	cert = pfnCertCreateCertificateContext(X509_ASN_ENCODING, data, size);
-	if (!cert)
+	if (bOk && SetFilePointer(hFile, 0, NULL, FILE_BEGIN) == 0)
+		bOk = WriteFile(hFile, &hdr, sizeof(hdr), &dwWritten, NULL);
+	CloseHandle(hFile);
+	if (!bOk || !MoveFileExW(szTemp, szPath, MOVEFILE_REPLACE_EXISTING))
 	{
-		FreeLibrary(crypt32);
+		DeleteFileW(szTemp);
 		return;
 	}
+	// Re-read on the next save so records written now are kept.
+	free(cache->Disk);
+	cache->Disk = NULL;
+	cache->DiskLoaded = FALSE;
+}
 
-	NWL_NodeAttrSetf(node, "Certificate Size", NAFLG_FMT_NUMERIC, "%lu", size);
+static NWL_SIGDB* GetSigDb(LPCWSTR name, const void* data, DWORD size)
+{
+	NWL_SIGDB_CACHE* cache = NWLC->NwSigDbCache;
+	UINT8 hash[NWL_SHA256_SIZE];
+	NWL_SIGDB* db;
 
-	WCHAR* name = AllocCertDisplayName(crypt32, cert);
-	if (name)
+	if (!cache)
+	{
+		cache = calloc(1, sizeof(NWL_SIGDB_CACHE));
+		if (!cache)
+			NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+		NWLC->NwSigDbCache = cache;
+	}
+	NWL_Sha256(data, size, hash);
+	for (size_t i = 0; i < cache->Count; i++)
 	{
-		NWL_NodeAttrSet(node, "Name", NWL_Ucs2ToUtf8(name), 0);
-		free(name);
+		if (memcmp(cache->Db[i]->Hash, hash, sizeof(hash)) == 0)
+			return cache->Db[i];
 	}
-	WCHAR* subject = AllocCertNameString(crypt32, &cert->pCertInfo->Subject);
-	if (subject)
+
+	db = NWL_SigDbDecode(data, size);
+	if (!db)
+		NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
+	if (db->Error)
+		NWL_Debug("UEFI", "%s in %s", db->Error, NWL_Ucs2ToUtf8(name));
+	// The blob is hashed, so certificate fields from an earlier run still apply.
+	if (!LoadSigDbFromDisk(cache, db))
 	{
-		NWL_NodeAttrSet(node, "Subject", NWL_Ucs2ToUtf8(subject), 0);
-		free(subject);
+		ParseSigDbCerts(db);
+		cache->DiskDirty = TRUE;
 	}
-	WCHAR* issuer = AllocCertNameString(crypt32, &cert->pCertInfo->Issuer);
-	if (issuer)
+
+	if (cache->Count >= SIGDB_CACHE_MAX)
 	{
-		NWL_NodeAttrSet(node, "Issuer", NWL_Ucs2ToUtf8(issuer), 0);
-		free(issuer);
+		if (cache->DiskDirty)
+			SaveSigDbToDisk(cache);
+		NWL_SigDbFree(cache->Db[0]);
+		memmove(&cache->Db[0], &cache->Db[1], (SIGDB_CACHE_MAX - 1) * sizeof(NWL_SIGDB*));
+		cache->Count--;
 	}
-	pfnCertFreeCertificateContext(cert);
-	FreeLibrary(crypt32);
+	cache->Db[cache->Count++] = db;
+	return db;
+}
+
+VOID NWL_FreeSigDbCache(VOID)
+{
+	NWL_SIGDB_CACHE* cache = NWLC->NwSigDbCache;
+	if (!cache)
+		return;
+	if (cache->DiskDirty)
+		SaveSigDbToDisk(cache);
+	for (size_t i = 0; i < cache->Count; i++)
+		NWL_SigDbFree(cache->Db[i]);
+	free(cache->Disk);
+	free(cache);
+	NWLC->NwSigDbCache = NULL;
 }
 
 static DWORD PrintSecureBootDatabase(PNODE root, LPCWSTR name, LPGUID guid)
 {
 	DWORD attributes = 0;
 	DWORD size = 0;
-	DWORD offset = 0;
-	DWORD list_index = 0;
-	DWORD signature_count = 0;
 	PBYTE data;
+	NWL_SIGDB* db;
 	PNODE var_node;
 	PNODE sig_node;
 
-	data = NWL_GetEfiVarAlloc(name, guid, &size, &attributes);
+	data = GetEfiVarAlloc(name, guid, &size, &attributes);
 	if (!data)
 		return 0;
+	db = GetSigDb(name, data, size);
+	free(data);
 
 	var_node = NWL_NodeAppendNew(root, NWL_Ucs2ToUtf8(name), 0);
 	NWL_NodeAttrSet(var_node, "Namespace", NWL_WinGuidToStr(TRUE, guid), NAFLG_FMT_GUID);
@@ -245,93 +534,58 @@ static DWORD PrintSecureBootDatabase(PNODE root, LPCWSTR name, LPGUID guid)
 	NWL_NodeAttrSetf(var_node, "Size", NAFLG_FMT_NUMERIC, "%lu", size);
 	sig_node = NWL_NodeAppendNew(var_node, "Signatures", NFLG_TABLE);
 
-	while (offset < size)
+	for (UINT32 i = 0; i < db->Count; i++)
 	{
-		EFI_SIGNATURE_LIST* list;
-		DWORD list_header_size = (DWORD)sizeof(EFI_SIGNATURE_LIST);
-		DWORD remaining = size - offset;
-		DWORD list_size;
-		DWORD signature_size;
-		DWORD entry_offset;
-		DWORD list_end;
-		DWORD entry_index = 0;
-
-		if (remaining < list_header_size)
+		const NWL_SIGDB_ENTRY* entry = &db->Entries[i];
+		GUID* type = (GUID*)&entry->Type;
+		const SECURE_BOOT_SIGNATURE_INFO* info = SecureBootGetSignatureInfo(type);
+		PNODE row = NWL_NodeAppendNew(sig_node, "Signature", NFLG_TABLE_ROW);
+
+		NWL_NodeAttrSetf(row, "List", NAFLG_FMT_NUMERIC, "%u", entry->List);
+		NWL_NodeAttrSetf(row, "Index", NAFLG_FMT_NUMERIC, "%u", entry->Index);
+		NWL_NodeAttrSet(row, "Type", info->Name, 0);
+		NWL_NodeAttrSet(row, "Type GUID", NWL_WinGuidToStr(TRUE, type), NAFLG_FMT_GUID);
+		NWL_NodeAttrSet(row, "Owner", NWL_WinGuidToStr(TRUE, (GUID*)&entry->Owner), NAFLG_FMT_GUID);
+		if (info->HashAlgorithm)
+			NWL_NodeAttrSet(row, "Hash Algorithm", info->HashAlgorithm, 0);
+		switch (info->Format)
 		{
-			NWL_Debug("UEFI", "Truncated signature list in %s", NWL_Ucs2ToUtf8(name));
+		case SECURE_BOOT_SIGNATURE_IMAGE_HASH:
+			if (entry->DataSize == info->DataSize)
+				NWL_NodeAttrSet(row, "Image Hash", GetHexString(entry->Data, entry->DataSize), 0);
 			break;
-		}
-
-		list = (EFI_SIGNATURE_LIST*)(data + offset);
-		list_size = list->SignatureListSize;
-		signature_size = list->SignatureSize;
-		if (list_size < list_header_size || list_size > remaining ||
-			list->SignatureHeaderSize > list_size - list_header_size ||
-			signature_size <= (DWORD)sizeof(GUID))
-		{
-			NWL_Debug("UEFI", "Invalid signature list in %s", NWL_Ucs2ToUtf8(name));
+		case SECURE_BOOT_SIGNATURE_X509_CERTIFICATE:
+			if (!entry->CertValid)
+				break;
+			NWL_NodeAttrSetf(row, "Certificate Size", NAFLG_FMT_NUMERIC, "%u", entry->DataSize);
+			if (entry->Name)
+				NWL_NodeAttrSet(row, "Name", entry->Name, 0);
+			if (entry->Subject)
+				NWL_NodeAttrSet(row, "Subject", entry->Subject, 0);
+			if (entry->Issuer)
+				NWL_NodeAttrSet(row, "Issuer", entry->Issuer, 0);
 			break;
-		}
-
-		entry_offset = offset + list_header_size + list->SignatureHeaderSize;
-		list_end = offset + list_size;
-		while (signature_size <= list_end - entry_offset)
-		{
-			EFI_SIGNATURE_DATA* signature = (EFI_SIGNATURE_DATA*)(data + entry_offset);
-			DWORD signature_data_size = signature_size - (DWORD)sizeof(GUID);
-			PNODE row = NWL_NodeAppendNew(sig_node, "Signature", NFLG_TABLE_ROW);
-			const SECURE_BOOT_SIGNATURE_INFO* info = SecureBootGetSignatureInfo(&list->SignatureType);
-
-			NWL_NodeAttrSetf(row, "List", NAFLG_FMT_NUMERIC, "%lu", list_index);
-			NWL_NodeAttrSetf(row, "Index", NAFLG_FMT_NUMERIC, "%lu", entry_index);
-			NWL_NodeAttrSet(row, "Type", info->Name, 0);
-			NWL_NodeAttrSet(row, "Type GUID", NWL_WinGuidToStr(TRUE, &list->SignatureType), NAFLG_FMT_GUID);
-			NWL_NodeAttrSet(row, "Owner", NWL_WinGuidToStr(TRUE, &signature->SignatureOwner), NAFLG_FMT_GUID);
-			if (info->HashAlgorithm)
-				NWL_NodeAttrSet(row, "Hash Algorithm", info->HashAlgorithm, 0);
-			switch (info->Format)
+		case SECURE_BOOT_SIGNATURE_X509_HASH:
+			if (entry->DataSize == info->DataSize)
 			{
-			case SECURE_BOOT_SIGNATURE_IMAGE_HASH:
-				if (signature_data_size == info->DataSize)
-					NWL_NodeAttrSet(row, "Image Hash", GetHexString(signature->SignatureData, signature_data_size), 0);
-				break;
-			case SECURE_BOOT_SIGNATURE_X509_CERTIFICATE:
-				PrintX509Certificate(row, signature->SignatureData, signature_data_size);
-				break;
-			case SECURE_BOOT_SIGNATURE_X509_HASH:
-				if (signature_data_size == info->DataSize)
-				{
-					const EFI_TIME* time = (const EFI_TIME*)(signature->SignatureData + info->TimeOffset);
-					NWL_NodeAttrSet(row, "Hash Algorithm", info->HashAlgorithm, 0);
-					NWL_NodeAttrSet(row, "Certificate Hash", GetHexString(signature->SignatureData + info->HashOffset, info->HashSize), 0);
-					if (time->Year != 0 && time->Month != 0 && time->Day != 0)
-						NWL_NodeAttrSetf(row, "Revocation Time", 0, "%04u-%02u-%02u %02u:%02u:%02u",
-							time->Year, time->Month, time->Day, time->Hour, time->Minute, time->Second);
-				}
-				break;
-			case SECURE_BOOT_SIGNATURE_DATA:
-			default:
-				break;
+				const EFI_TIME* time = (const EFI_TIME*)(entry->Data + info->TimeOffset);
+				NWL_NodeAttrSet(row, "Hash Algorithm", info->HashAlgorithm, 0);
+				NWL_NodeAttrSet(row, "Certificate Hash", GetHexString(entry->Data + info->HashOffset, info->HashSize), 0);
+				if (time->Year != 0 && time->Month != 0 && time->Day != 0)
+					NWL_NodeAttrSetf(row, "Revocation Time", 0, "%04u-%02u-%02u %02u:%02u:%02u",
+						time->Year, time->Month, time->Day, time->Hour, time->Minute, time->Second);
 			}
-			NWL_NodeAttrSetf(row, "Data Size", NAFLG_FMT_NUMERIC, "%lu", signature_data_size);
-
-			signature_count++;
-			entry_index++;
-			entry_offset += signature_size;
-		}
-		if (entry_offset != list_end)
-		{
-			NWL_Debug("UEFI", "Truncated signature entry in %s", NWL_Ucs2ToUtf8(name));
+			break;
+		case SECURE_BOOT_SIGNATURE_DATA:
+		default:
 			break;
 		}
-		offset += list_size;
-		list_index++;
+		NWL_NodeAttrSetf(row, "Data Size", NAFLG_FMT_NUMERIC, "%u", entry->DataSize);
 	}
 
-	NWL_NodeAttrSetf(var_node, "List Count", NAFLG_FMT_NUMERIC, "%lu", list_index);
-	NWL_NodeAttrSetf(var_node, "Signature Count", NAFLG_FMT_NUMERIC, "%lu", signature_count);
-	free(data);
-	return signature_count;
+	NWL_NodeAttrSetf(var_node, "List Count", NAFLG_FMT_NUMERIC, "%u", db->ListCount);
+	NWL_NodeAttrSetf(var_node, "Signature Count", NAFLG_FMT_NUMERIC, "%u", db->Count);
+	return db->Count;
 }
 
 static void PrintSecureBootSignatures(PNODE node)
@@ -406,7 +660,7 @@ static void PrintBootInfo(PNODE node)
 	NWL_NodeAttrSetf(node, "Boot Current", 0, "%04X", Var);
 	GetEfiGlobalVar(L"BootNext", &Var, sizeof(UINT16));
 	NWL_NodeAttrSetf(node, "Boot Next", 0, "%04X", Var);
-	BootOrder = NWL_GetEfiVarAlloc(L"BootOrder", NULL, &BootOrderSize, NULL);
+	BootOrder = GetEfiVarAlloc(L"BootOrder", NULL, &BootOrderSize, NULL);
 	if (!BootOrder)
 		goto out;
 	for (i = 0; i < BootOrderSize / sizeof(UINT16); i++)
@@ -508,86 +762,64 @@ IsBootEntry(LPCWSTR prefix, LPCWSTR name)
 	return TRUE;
 }
 
-static void PrintEfiBootMenu(void* ctx, LPGUID guid, WCHAR* name)
+static void PrintEfiBootMenu(BOOT_MENU_CTX* nodes, NWL_EFI_VAR* var)
 {
-	BOOT_MENU_CTX* nodes = (BOOT_MENU_CTX*)ctx;
-	DWORD size = 0;
 	PNODE cur = NULL;
-	if (memcmp(guid, &EFI_GV_GUID, sizeof(GUID)) != 0)
-		return;
-	if (IsBootEntry(L"Boot", name))
+	if (IsBootEntry(L"Boot", var->Name))
 	{
-		EFI_LOAD_OPTION* option = NWL_GetEfiVarAlloc(name, guid, &size, NULL);
+		EFI_LOAD_OPTION* option = NWL_GetEfiVarData(var);
 		if (!option)
 			return;
-		cur = NWL_NodeAppendNew(nodes->nb, NWL_Ucs2ToUtf8(name), NFLG_ATTGROUP);
-		PrintLoadOption(cur, option, size);
-		free(option);
+		cur = NWL_NodeAppendNew(nodes->nb, NWL_Ucs2ToUtf8(var->Name), NFLG_ATTGROUP);
+		PrintLoadOption(cur, option, var->Size);
 	}
-	else if (IsBootEntry(L"Driver", name))
+	else if (IsBootEntry(L"Driver", var->Name))
 	{
-		EFI_LOAD_OPTION* option = NWL_GetEfiVarAlloc(name, guid, &size, NULL);
+		EFI_LOAD_OPTION* option = NWL_GetEfiVarData(var);
 		if (!option)
 			return;
-		cur = NWL_NodeAppendNew(nodes->nd, NWL_Ucs2ToUtf8(name), NFLG_ATTGROUP);
-		PrintLoadOption(cur, option, size);
-		free(option);
+		cur = NWL_NodeAppendNew(nodes->nd, NWL_Ucs2ToUtf8(var->Name), NFLG_ATTGROUP);
+		PrintLoadOption(cur, option, var->Size);
 	}
-	else if (IsBootEntry(L"Key", name))
+	else if (IsBootEntry(L"Key", var->Name))
 	{
-		EFI_KEY_OPTION* option = NWL_GetEfiVarAlloc(name, guid, &size, NULL);
+		EFI_KEY_OPTION* option = NWL_GetEfiVarData(var);
 		if (!option)
 			return;
-		cur = NWL_NodeAppendNew(nodes->nk, NWL_Ucs2ToUtf8(name), NFLG_ATTGROUP);
-		PrintKeyOption(cur, option, size);
-		free(option);
+		cur = NWL_NodeAppendNew(nodes->nk, NWL_Ucs2ToUtf8(var->Name), NFLG_ATTGROUP);
+		PrintKeyOption(cur, option, var->Size);
 	}
 }
 
-static void PrintEfiVarAndSize(void* ctx, LPGUID guid, WCHAR* name)
-{
-	PNODE node = (PNODE)ctx;
-	DWORD VarSize = 0;
-	LPCSTR lpszGuid = NWL_WinGuidToStr(TRUE, guid);
-	PNODE ng = NWL_NodeGetChild(node, lpszGuid);
-	if (!ng)
-		ng = NWL_NodeAppendNew(node, lpszGuid, NFLG_TABLE_ROW);
-	VarSize = NWL_GetEfiVar(name, guid, NULL, 0, NULL);
-	NWL_NodeAttrSetf(ng, NWL_Ucs2ToUtf8(name), NAFLG_FMT_NUMERIC, "%lu", VarSize);
-}
-
-static void EnumEfiVars(void* ctx, void (*func)(void* ctx, LPGUID guid, WCHAR* name))
-{
-	PVARIABLE_NAME VarNamePtr = NULL;
-	PVARIABLE_NAME p;
-	ULONG VarNameSize = 0;
-	VarNamePtr = NWL_EnumerateEfiVar(&VarNameSize);
-	if (!VarNamePtr || VarNameSize == 0)
-		return;
-	for (p = VarNamePtr;
-		((LPBYTE)p < (LPBYTE)VarNamePtr + VarNameSize);
-		p = (PVARIABLE_NAME)((LPBYTE)p + p->NextEntryOffset))
-	{
-		func(ctx, &p->VendorGuid, p->Name);
-		if (p->NextEntryOffset == 0)
-			break;
-	}
-	free(VarNamePtr);
-}
-
 static void PrintXXXX(PNODE node)
 {
 	BOOT_MENU_CTX ctx = { 0 };
+	NWL_EFI_VARS* vars = NWL_GetEfiVars();
+	const NWL_EFI_GROUP* group = NWL_FindEfiGroup(&EFI_GV_GUID);
 	ctx.nb = NWL_NodeAppendNew(node, "Boot Menu", 0);
 	ctx.nd = NWL_NodeAppendNew(node, "Driver Menu", 0);
 	ctx.nk = NWL_NodeAppendNew(node, "Hot Keys", 0);
-	EnumEfiVars(&ctx, PrintEfiBootMenu);
+	if (!group)
+		return;
+	// Only the global variable namespace can hold boot options.
+	for (size_t i = group->First; i; i = vars->Vars[i - 1].Next)
+		PrintEfiBootMenu(&ctx, &vars->Vars[i - 1]);
 }
 
 static void PrintEfiVars(PNODE node)
 {
 	PNODE nv = NWL_NodeAppendNew(node, "Variables", NFLG_TABLE);
-	EnumEfiVars(nv, PrintEfiVarAndSize);
+	NWL_EFI_VARS* vars = NWL_GetEfiVars();
+	for (size_t g = 0; g < vars->GroupCount; g++)
+	{
+		const NWL_EFI_GROUP* group = &vars->Groups[g];
+		PNODE ng = NWL_NodeAppendNew(nv, NWL_WinGuidToStr(TRUE, group->Guid), NFLG_TABLE_ROW);
+		for (size_t i = group->First; i; i = vars->Vars[i - 1].Next)
+		{
+			NWL_EFI_VAR* var = &vars->Vars[i - 1];
+			NWL_NodeAttrSetf(ng, NWL_Ucs2ToUtf8(var->Name), NAFLG_FMT_NUMERIC, "%lu", var->Size);
+		}
+	}
 }
 
 PNODE NW_Uefi(BOOL bAppend)
@@ -278,26 +278,19 @@ SetUsbConnectionInfo(PNODE node, DEVINST parentDevInst, ULONG ulPort)
 	CloseHandle(hubHandle);
 }
 
-static void SetUsbDiskName(PNODE node, DEVINST usbDevInst, LPCSTR service)
+static void SetUsbDiskName(PNODE node, const DEVTREE_SNAPSHOT* tree, DWORD index, LPCSTR service)
 {
-	CHAR buf[DEVTREE_MAX_STR_LEN];
 	// Check if the service is USBSTOR or UASPStor
 	if (_stricmp(service, "USBSTOR") != 0 && _stricmp(service, "UASPStor") != 0)
 		return;
 
-	DEVINST childDevice;
-	for (CONFIGRET cr = CM_Get_Child(&childDevice, usbDevInst, 0);
-		cr == CR_SUCCESS;
-		cr = CM_Get_Sibling(&childDevice, childDevice, 0))
+	for (DWORD i = index + 1; i < tree->Entries[index].End; i++)
 	{
-		if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, childDevice, &DEVPKEY_Device_Class))
-		{
-			if (_stricmp(buf, "DiskDrive") == 0)
-			{
-				NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, childDevice, &DEVPKEY_NAME);
-				NWL_NodeAttrSet(node, "Disk", buf, 0);
-			}
-		}
+		const DEVTREE_ENTRY* child = &tree->Entries[i];
+		if (child->Parent != index || !child->Class)
+			continue;
+		if (_stricmp(child->Class, "DiskDrive") == 0)
+			NWL_NodeAttrSet(node, "Disk", child->Name, 0);
 	}
 }
 
@@ -338,35 +331,37 @@ ParseHwClass(PNODE nd, PNWLIB_IDS ids, LPCWSTR compId)
 #define INVALID_USB_PORT 0xFFFFFFFF
 
 static void CALLBACK
-GetDeviceInfoUsb(PNODE node, void* data, DEVINST devInst, DEVINST parentDevInst, LPCSTR hwIds)
+GetDeviceInfoUsb(PNODE node, void* data, const DEVTREE_SNAPSHOT* tree, DWORD index)
 {
+	const DEVTREE_ENTRY* dev = &tree->Entries[index];
+	DEVINST parentDevInst = dev->Parent != DEVTREE_NONE ? tree->Entries[dev->Parent].DevInst : 0;
 	ULONG port = INVALID_USB_PORT;
-	CHAR buf[DEVTREE_MAX_STR_LEN];
+	LPCSTR str;
 	PNWLIB_IDS ids = (PNWLIB_IDS)data;
 	PNODE_ATT srv = NULL;
 
-	NWL_NodeAttrSet(node, "HWID", hwIds, 0);
+	NWL_NodeAttrSet(node, "HWID", dev->HwId, 0);
 
-	NWL_ParseHwid(node, ids, NWL_Utf8ToUcs2(hwIds), 1);
+	NWL_ParseHwid(node, ids, NWL_Utf8ToUcs2(dev->HwId), 1);
 
 	// Parse hardware class if available
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_CompatibleIds))
-		ParseHwClass(node, ids, NWL_Utf8ToUcs2(buf));
+	if ((str = NWL_DevTreeGetProp(tree, index, DEVTREE_PROP_COMPATIBLE_IDS)) != NULL)
+		ParseHwClass(node, ids, NWL_Utf8ToUcs2(str));
 
 	// Get and print device name using DEVPKEY_NAME
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_NAME))
-		NWL_NodeAttrSet(node, "Name", buf, 0);
+	if (dev->Name)
+		NWL_NodeAttrSet(node, "Name", dev->Name, 0);
 
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_Service))
-		srv = NWL_NodeAttrSet(node, "Service", buf, 0);
+	if ((str = NWL_DevTreeGetProp(tree, index, DEVTREE_PROP_SERVICE)) != NULL)
+		srv = NWL_NodeAttrSet(node, "Service", str, 0);
 
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_LocationInfo))
-		NWL_NodeAttrSet(node, "Location", buf, 0);
+	if ((str = NWL_DevTreeGetProp(tree, index, DEVTREE_PROP_LOCATION)) != NULL)
+		NWL_NodeAttrSet(node, "Location", str, 0);
 
-	if (NWL_SetDevPropString(buf, DEVTREE_MAX_STR_LEN, devInst, &DEVPKEY_Device_LocationPaths))
+	if ((str = NWL_DevTreeGetProp(tree, index, DEVTREE_PROP_LOCATION_PATHS)) != NULL)
 	{
-		NWL_NodeAttrSet(node, "Location Paths", buf, 0);
-		UsbParsePortFromLocationPaths(buf, &port);
+		NWL_NodeAttrSet(node, "Location Paths", str, 0);
+		UsbParsePortFromLocationPaths(str, &port);
 	}
 
 	if (port != INVALID_USB_PORT)
@@ -376,34 +371,28 @@ GetDeviceInfoUsb(PNODE node, void* data, DEVINST devInst, DEVINST parentDevInst,
 		return;
 
 	// Check if it's a Mass Storage Device and get disk name
-	SetUsbDiskName(node, devInst, srv->value);
+	SetUsbDiskName(node, tree, index, srv->value);
 }
 
 PNODE NW_Usb(BOOL bAppend)
 {
-	DEVINST devRoot;
-	CONFIGRET cr;
 	DEVTREE_ENUM_CTX ctx =
 	{
 		.filter = "USB\\",
-		.filterLen = 4, // Length of "USB\\"
 		.data = &NWLC->NwUsbIds,
 		.hub = "USB Hub",
 		.GetDeviceInfo = GetDeviceInfoUsb,
 	};
+	DEVTREE_SNAPSHOT* tree;
 	PNODE node = NWL_NodeAlloc("USB", NFLG_TABLE);
 	if (bAppend)
 		NWL_NodeAppendChild(NWLC->NwRoot, node);
 
-	cr = CM_Locate_DevNodeW(&devRoot, NULL, CM_LOCATE_DEVNODE_NORMAL);
-	if (cr != CR_SUCCESS)
-	{
-		NWL_NodeAppendMultiSz(&NWLC->ErrLog, "CM_Locate_DevNodeW failed");
-		goto fail;
-	}
-
-	NWL_EnumerateDevices(node, &ctx, devRoot, 0);
+	tree = NWL_DevTreeAcquire();
+	ctx.tree = tree;
+	NWL_EnumerateDevices(node, &ctx, 0);
+	NWL_EnumerateDevicesEnd(&ctx);
+	NWL_DevTreeRelease(tree);
 
-fail:
 	return node;
 }
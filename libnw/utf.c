@@ -0,0 +1,352 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdlib.h>
+#include <string.h>
+#include "utf.h"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define NWL_UTF_SSE2
+#endif
+
+#define UTF_REPLACEMENT 0xFFFDU
+
+static size_t
+Utf16StrLen(const uint16_t* src)
+{
+	size_t len = 0;
+	while (src[len])
+		len++;
+	return len;
+}
+
+#ifdef NWL_UTF_SSE2
+// Number of leading UTF-16 code units below 0x80, in blocks of 8.
+static inline size_t
+Utf16AsciiPrefix(const uint16_t* src, size_t len)
+{
+	size_t i = 0;
+	const __m128i mask = _mm_set1_epi16((short)0xFF80);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 8 <= len; i += 8)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, mask), zero)) != 0xFFFF)
+			break;
+	}
+	return i;
+}
+
+// Number of leading UTF-8 bytes below 0x80, in blocks of 16.
+static inline size_t
+Utf8AsciiPrefix(const char* src, size_t len)
+{
+	size_t i = 0;
+	for (; i + 16 <= len; i += 16)
+	{
+		if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(src + i))) != 0)
+			break;
+	}
+	return i;
+}
+#endif
+
+// Decode one UTF-16 code point, returns the number of code units consumed.
+static inline size_t
+Utf16Decode(const uint16_t* src, size_t len, uint32_t* cp)
+{
+	uint32_t c = src[0];
+	if (c < 0xD800 || c > 0xDFFF)
+	{
+		*cp = c;
+		return 1;
+	}
+	if (c <= 0xDBFF && len > 1 && src[1] >= 0xDC00 && src[1] <= 0xDFFF)
+	{
+		*cp = 0x10000 + ((c - 0xD800) << 10) + (src[1] - 0xDC00U);
+		return 2;
+	}
+	*cp = UTF_REPLACEMENT;
+	return 1;
+}
+
+// Decode one UTF-8 code point, returns the number of bytes consumed.
+// Overlong forms, surrogates and truncated sequences yield U+FFFD.
+static inline size_t
+Utf8Decode(const unsigned char* src, size_t len, uint32_t* cp)
+{
+	uint32_t c = src[0];
+	uint32_t min;
+	size_t need;
+	size_t k;
+
+	if (c < 0x80)
+	{
+		*cp = c;
+		return 1;
+	}
+	if (c < 0xC2)
+		goto fail;
+	else if (c < 0xE0)
+	{
+		need = 1;
+		min = 0x80;
+		c &= 0x1F;
+	}
+	else if (c < 0xF0)
+	{
+		need = 2;
+		min = 0x800;
+		c &= 0x0F;
+	}
+	else if (c < 0xF5)
+	{
+		need = 3;
+		min = 0x10000;
+		c &= 0x07;
+	}
+	else
+		goto fail;
+
+	for (k = 1; k <= need; k++)
+	{
+		if (k >= len || (src[k] & 0xC0) != 0x80)
+		{
+			*cp = UTF_REPLACEMENT;
+			return k;
+		}
+		c = (c << 6) | (src[k] & 0x3FU);
+	}
+	if (c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF))
+		c = UTF_REPLACEMENT;
+	*cp = c;
+	return need + 1;
+fail:
+	*cp = UTF_REPLACEMENT;
+	return 1;
+}
+
+static inline size_t
+Utf8Width(uint32_t cp)
+{
+	if (cp < 0x80)
+		return 1;
+	if (cp < 0x800)
+		return 2;
+	if (cp < 0x10000)
+		return 3;
+	return 4;
+}
+
+size_t
+NWL_Utf16ToUtf8Len(const uint16_t* src, size_t srclen)
+{
+	size_t i = 0;
+	size_t len = 0;
+
+	if (src == NULL)
+		return 0;
+	if (srclen == NWL_UTF_NUL)
+		srclen = Utf16StrLen(src);
+	while (i < srclen)
+	{
+		uint32_t cp;
+#ifdef NWL_UTF_SSE2
+		size_t ascii = Utf16AsciiPrefix(src + i, srclen - i);
+		i += ascii;
+		len += ascii;
+		if (i >= srclen)
+			break;
+#endif
+		i += Utf16Decode(src + i, srclen - i, &cp);
+		len += Utf8Width(cp);
+	}
+	return len;
+}
+
+size_t
+NWL_Utf8ToUtf16Len(const char* src, size_t srclen)
+{
+	size_t i = 0;
+	size_t len = 0;
+
+	if (src == NULL)
+		return 0;
+	if (srclen == NWL_UTF_NUL)
+		srclen = strlen(src);
+	while (i < srclen)
+	{
+		uint32_t cp;
+#ifdef NWL_UTF_SSE2
+		size_t ascii = Utf8AsciiPrefix(src + i, srclen - i);
+		i += ascii;
+		len += ascii;
+		if (i >= srclen)
+			break;
+#endif
+		i += Utf8Decode((const unsigned char*)src + i, srclen - i, &cp);
+		len += cp >= 0x10000 ? 2 : 1;
+	}
+	return len;
+}
+
+size_t
+NWL_Utf16ToUtf8(const uint16_t* src, size_t srclen, char* dst, size_t dstlen)
+{
+	size_t i = 0;
+	size_t j = 0;
+
+	if (dst == NULL || dstlen == 0)
+		return 0;
+	if (src == NULL)
+		goto out;
+	if (srclen == NWL_UTF_NUL)
+		srclen = Utf16StrLen(src);
+	dstlen--;
+
+	while (i < srclen)
+	{
+		uint32_t cp;
+		size_t n;
+#ifdef NWL_UTF_SSE2
+		const __m128i mask = _mm_set1_epi16((short)0xFF80);
+		const __m128i zero = _mm_setzero_si128();
+		while (i + 8 <= srclen && j + 8 <= dstlen)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, mask), zero)) != 0xFFFF)
+				break;
+			_mm_storel_epi64((__m128i*)(dst + j), _mm_packus_epi16(v, v));
+			i += 8;
+			j += 8;
+		}
+		if (i >= srclen)
+			break;
+#endif
+		if (src[i] < 0x80)
+		{
+			if (j >= dstlen)
+				break;
+			dst[j++] = (char)src[i++];
+			continue;
+		}
+		n = Utf16Decode(src + i, srclen - i, &cp);
+		if (j + Utf8Width(cp) > dstlen)
+			break;
+		if (cp < 0x800)
+		{
+			dst[j++] = (char)(0xC0 | (cp >> 6));
+		}
+		else if (cp < 0x10000)
+		{
+			dst[j++] = (char)(0xE0 | (cp >> 12));
+			dst[j++] = (char)(0x80 | ((cp >> 6) & 0x3F));
+		}
+		else
+		{
+			dst[j++] = (char)(0xF0 | (cp >> 18));
+			dst[j++] = (char)(0x80 | ((cp >> 12) & 0x3F));
+			dst[j++] = (char)(0x80 | ((cp >> 6) & 0x3F));
+		}
+		dst[j++] = (char)(0x80 | (cp & 0x3F));
+		i += n;
+	}
+out:
+	dst[j] = '\0';
+	return j;
+}
+
+size_t
+NWL_Utf8ToUtf16(const char* src, size_t srclen, uint16_t* dst, size_t dstlen)
+{
+	size_t i = 0;
+	size_t j = 0;
+
+	if (dst == NULL || dstlen == 0)
+		return 0;
+	if (src == NULL)
+		goto out;
+	if (srclen == NWL_UTF_NUL)
+		srclen = strlen(src);
+	dstlen--;
+
+	while (i < srclen)
+	{
+		uint32_t cp;
+		size_t n;
+#ifdef NWL_UTF_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		while (i + 16 <= srclen && j + 16 <= dstlen)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+			if (_mm_movemask_epi8(v) != 0)
+				break;
+			_mm_storeu_si128((__m128i*)(dst + j), _mm_unpacklo_epi8(v, zero));
+			_mm_storeu_si128((__m128i*)(dst + j + 8), _mm_unpackhi_epi8(v, zero));
+			i += 16;
+			j += 16;
+		}
+		if (i >= srclen)
+			break;
+#endif
+		n = Utf8Decode((const unsigned char*)src + i, srclen - i, &cp);
+		if (cp >= 0x10000)
+		{
+			if (j + 2 > dstlen)
+				break;
+			cp -= 0x10000;
+			dst[j++] = (uint16_t)(0xD800 | (cp >> 10));
+			dst[j++] = (uint16_t)(0xDC00 | (cp & 0x3FF));
+		}
+		else
+		{
+			if (j >= dstlen)
+				break;
+			dst[j++] = (uint16_t)cp;
+		}
+		i += n;
+	}
+out:
+	dst[j] = 0;
+	return j;
+}
+
+char*
+NWL_Utf16ToUtf8Dup(const uint16_t* src, size_t srclen, size_t* outlen)
+{
+	char* dst;
+	size_t len;
+
+	if (src == NULL)
+		return NULL;
+	if (srclen == NWL_UTF_NUL)
+		srclen = Utf16StrLen(src);
+	len = NWL_Utf16ToUtf8Len(src, srclen);
+	dst = (char*)malloc(len + 1);
+	if (dst == NULL)
+		return NULL;
+	len = NWL_Utf16ToUtf8(src, srclen, dst, len + 1);
+	if (outlen)
+		*outlen = len;
+	return dst;
+}
+
+uint16_t*
+NWL_Utf8ToUtf16Dup(const char* src, size_t srclen, size_t* outlen)
+{
+	uint16_t* dst;
+	size_t len;
+
+	if (src == NULL)
+		return NULL;
+	if (srclen == NWL_UTF_NUL)
+		srclen = strlen(src);
+	len = NWL_Utf8ToUtf16Len(src, srclen);
+	dst = (uint16_t*)malloc((len + 1) * sizeof(uint16_t));
+	if (dst == NULL)
+		return NULL;
+	len = NWL_Utf8ToUtf16(src, srclen, dst, len + 1);
+	if (outlen)
+		*outlen = len;
+	return dst;
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: Unlicense
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define NWL_UTF_NUL ((size_t)-1)
+
+// Returns the number of code units (excluding the terminator) needed to
+// convert src. Pass NWL_UTF_NUL as srclen for NUL-terminated input.
+size_t
+NWL_Utf16ToUtf8Len(const uint16_t* src, size_t srclen);
+
+size_t
+NWL_Utf8ToUtf16Len(const char* src, size_t srclen);
+
+// Convert into dst (dstlen code units including room for the terminator).
+// Output is always NUL-terminated and never split inside a code point.
+// Unpaired surrogates and malformed UTF-8 are replaced with U+FFFD.
+// Returns the number of code units written, excluding the terminator.
+size_t
+NWL_Utf16ToUtf8(const uint16_t* src, size_t srclen, char* dst, size_t dstlen);
+
+size_t
+NWL_Utf8ToUtf16(const char* src, size_t srclen, uint16_t* dst, size_t dstlen);
+
+// Allocate with malloc, free with free.
+char*
+NWL_Utf16ToUtf8Dup(const uint16_t* src, size_t srclen, size_t* outlen);
+
+uint16_t*
+NWL_Utf8ToUtf16Dup(const char* src, size_t srclen, size_t* outlen);
@@ -5,12 +5,14 @@
 #include <string.h>
 #include <windows.h>
 #include <winioctl.h>
+#include <pathcch.h>
 #include "libnw.h"
 #include "utils.h"
 #include "smbios.h"
 #include "acpi.h"
 #include "libcpuid.h"
 #include "ioctl.h"
+#include "utf.h"
 
 #if defined(_MSC_VER)
 #define NWL_TLS __declspec(thread)
@@ -446,19 +448,168 @@ PVOID NWL_GetAcpiByAddr(DWORD_PTR Addr, DWORD TableId)
 
 	memcpy(ret, &tmp, sizeof(tmp));
 
-	for (size_t i = 0; i < tmp.hdr.Length - sizeof(DESC_HEADER); i++)
+	// The header is a multiple of 4 bytes, keep reading dwords and finish with bytes.
+	for (size_t i = sizeof(DESC_HEADER); i < tmp.hdr.Length; )
 	{
-		uint8_t val;
-		if (WR0_RdMmIo(NWLC->NwDrv, Addr + sizeof(DESC_HEADER) + i, &val, sizeof(val)) != 0)
+		uint32_t len = (tmp.hdr.Length - i >= sizeof(uint32_t)) ? sizeof(uint32_t) : sizeof(uint8_t);
+		uint32_t val = 0;
+		if (WR0_RdMmIo(NWLC->NwDrv, Addr + i, &val, len) != 0)
 		{
 			free(ret);
 			return NULL;
 		}
-		memcpy(((uint8_t*)ret) + sizeof(DESC_HEADER) + i, &val, sizeof(val));
+		memcpy(((uint8_t*)ret) + i, &val, len);
+		i += len;
 	}
 	return ret;
 }
 
+typedef struct _NWL_ACPI_ENTRY
+{
+	UINT32 Signature;
+	UINT32 Instance;
+	DWORD_PTR Addr; // 0 for tables from the firmware table API
+	BOOL Loaded;
+	DESC_HEADER* Table; // NULL if loading failed
+} NWL_ACPI_ENTRY;
+
+typedef struct _NWL_ACPI_CACHE
+{
+	// Entries [0, Indexed) follow the XSDT/RSDT order, later ones are
+	// tables the root table did not list.
+	size_t Indexed;
+	size_t Count;
+	size_t Capacity;
+	NWL_ACPI_ENTRY* Entries;
+} NWL_ACPI_CACHE;
+
+static NWL_ACPI_ENTRY*
+AcpiCacheAdd(NWL_ACPI_CACHE* cache, UINT32 sig, DWORD_PTR addr)
+{
+	if (cache->Count >= cache->Capacity)
+	{
+		size_t capacity = cache->Capacity ? cache->Capacity * 2 : 32;
+		NWL_ACPI_ENTRY* p = realloc(cache->Entries, capacity * sizeof(NWL_ACPI_ENTRY));
+		if (!p)
+			return NULL;
+		cache->Entries = p;
+		cache->Capacity = capacity;
+	}
+	NWL_ACPI_ENTRY* e = &cache->Entries[cache->Count];
+	ZeroMemory(e, sizeof(NWL_ACPI_ENTRY));
+	e->Signature = sig;
+	e->Addr = addr;
+	for (size_t i = 0; i < cache->Count; i++)
+	{
+		if (cache->Entries[i].Signature == sig)
+			e->Instance++;
+	}
+	cache->Count++;
+	return e;
+}
+
+static VOID
+AcpiCacheIndexEntry(NWL_ACPI_CACHE* cache, DWORD_PTR addr)
+{
+	union
+	{
+		DESC_HEADER hdr;
+		uint32_t raw[sizeof(DESC_HEADER) / sizeof(uint32_t)];
+	} tmp;
+	if (!addr)
+		return;
+	// Only the signature is needed here, the body is read on first use.
+	if (WR0_RdMmIo(NWLC->NwDrv, addr, &tmp.raw[0], sizeof(uint32_t)) != 0 || tmp.raw[0] == 0)
+		return;
+	AcpiCacheAdd(cache, ACPI_SIG(tmp.hdr.Signature[0], tmp.hdr.Signature[1], tmp.hdr.Signature[2], tmp.hdr.Signature[3]), addr);
+}
+
+static NWL_ACPI_CACHE*
+AcpiCacheGet(VOID)
+{
+	UINT32 i, count;
+	if (NWLC->NwAcpiCache)
+		return NWLC->NwAcpiCache;
+
+	NWL_ACPI_CACHE* cache = calloc(1, sizeof(NWL_ACPI_CACHE));
+	if (!cache)
+		return NULL;
+	NWLC->NwAcpiCache = cache;
+
+	if (NWLC->NwRsdp == NULL)
+		NWLC->NwRsdp = NWL_GetRsdp();
+	if (NWLC->NwRsdt == NULL)
+		NWLC->NwRsdt = NWL_GetRsdt();
+	if (NWLC->NwXsdt == NULL)
+		NWLC->NwXsdt = NWL_GetXsdt();
+
+	if (NWLC->NwXsdt)
+	{
+		count = (NWLC->NwXsdt->Header.Length - sizeof(DESC_HEADER)) / sizeof(NWLC->NwXsdt->Entry[0]);
+		for (i = 0; i < count; i++)
+			AcpiCacheIndexEntry(cache, (DWORD_PTR)NWLC->NwXsdt->Entry[i]);
+	}
+	else if (NWLC->NwRsdt)
+	{
+		count = (NWLC->NwRsdt->Header.Length - sizeof(DESC_HEADER)) / sizeof(NWLC->NwRsdt->Entry[0]);
+		for (i = 0; i < count; i++)
+			AcpiCacheIndexEntry(cache, (DWORD_PTR)NWLC->NwRsdt->Entry[i]);
+	}
+	cache->Indexed = cache->Count;
+	return cache;
+}
+
+UINT32 NWL_EnumAcpiTable(UINT32 Index, UINT32* Instance)
+{
+	NWL_ACPI_CACHE* cache = AcpiCacheGet();
+	if (!cache || Index >= cache->Indexed)
+		return 0;
+	if (Instance)
+		*Instance = cache->Entries[Index].Instance;
+	return cache->Entries[Index].Signature;
+}
+
+DESC_HEADER* NWL_GetAcpiTable(UINT32 Signature, UINT32 Instance)
+{
+	NWL_ACPI_CACHE* cache = AcpiCacheGet();
+	if (!cache)
+		return NULL;
+	for (size_t i = 0; i < cache->Count; i++)
+	{
+		NWL_ACPI_ENTRY* e = &cache->Entries[i];
+		if (e->Signature != Signature || e->Instance != Instance)
+			continue;
+		if (!e->Loaded)
+		{
+			e->Table = NWL_GetAcpiByAddr(e->Addr, Signature);
+			e->Loaded = TRUE;
+		}
+		return e->Table;
+	}
+	// Not listed by the root table, or physical memory is not readable.
+	// The firmware table API only returns the first instance.
+	if (Instance != 0)
+		return NULL;
+	NWL_ACPI_ENTRY* e = AcpiCacheAdd(cache, Signature, 0);
+	if (!e)
+		return NULL;
+	e->Table = NWL_GetSysAcpi(Signature);
+	e->Loaded = TRUE;
+	return e->Table;
+}
+
+VOID NWL_FreeAcpiCache(VOID)
+{
+	NWL_ACPI_CACHE* cache = NWLC->NwAcpiCache;
+	if (!cache)
+		return;
+	for (size_t i = 0; i < cache->Count; i++)
+		free(cache->Entries[i].Table);
+	free(cache->Entries);
+	free(cache);
+	NWLC->NwAcpiCache = NULL;
+}
+
 UINT8
 NWL_AcpiChecksum(VOID* base, UINT size)
 {
@@ -655,7 +806,7 @@ PBYTE NWL_LoadDump(LPCSTR pPath, DWORD minSize, DWORD* outSize)
 	BOOL bRet = ReadFile(hFile, buf, dwSize, &bytesRead, NULL);
 	if (bRet == FALSE || bytesRead < minSize)
 	{
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s read error", NWLC->EdidDump);
+		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s read error", pPath);
 		NWL_NodeAppendMultiSz(&NWLC->ErrLog, NWLC->NwBuf);
 		bytesRead = 0;
 		free(buf);
@@ -670,6 +821,44 @@ out:
 	return buf;
 }
 
+// Per-user file under %LOCALAPPDATA%\NWinfo for results that outlive a run.
+BOOL NWL_GetCachePath(LPWSTR lpPath, LPCWSTR lpName)
+{
+	DWORD n = GetEnvironmentVariableW(L"LOCALAPPDATA", lpPath, MAX_PATH);
+	if (n == 0 || n >= MAX_PATH)
+		return FALSE;
+	if (FAILED(PathCchAppend(lpPath, MAX_PATH, L"NWinfo")))
+		return FALSE;
+	CreateDirectoryW(lpPath, NULL);
+	return SUCCEEDED(PathCchAppend(lpPath, MAX_PATH, lpName));
+}
+
+// Unlike NWL_LoadDump a missing or odd sized cache is not an error.
+PVOID NWL_LoadCacheFile(LPCWSTR lpPath, DWORD dwMinSize, DWORD dwMaxSize, PDWORD pdwSize)
+{
+	LARGE_INTEGER li;
+	PVOID buf = NULL;
+	DWORD dwRead = 0;
+	HANDLE hFile = CreateFileW(lpPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return NULL;
+	if (!GetFileSizeEx(hFile, &li) || li.QuadPart < (LONGLONG)dwMinSize || li.QuadPart > (LONGLONG)dwMaxSize)
+		goto out;
+	buf = malloc((size_t)li.QuadPart);
+	if (!buf)
+		goto out;
+	if (!ReadFile(hFile, buf, (DWORD)li.QuadPart, &dwRead, NULL) || dwRead != (DWORD)li.QuadPart)
+	{
+		free(buf);
+		buf = NULL;
+		goto out;
+	}
+	*pdwSize = dwRead;
+out:
+	CloseHandle(hFile);
+	return buf;
+}
+
 #define SECPERMIN 60
 #define SECPERHOUR (60*SECPERMIN)
 #define SECPERDAY (24*SECPERHOUR)
@@ -731,76 +920,25 @@ NWL_FreeConvBuffers(VOID)
 LPCSTR
 NWL_Ucs2ToUtf8(LPCWSTR src)
 {
-	size_t i;
-	CHAR* p;
-
 	if (!Utf8Buf)
 	{
 		Utf8Buf = (CHAR*)malloc(NWINFO_BUFSZ + 1);
 		if (!Utf8Buf)
 			NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
 	}
-	p = Utf8Buf;
-	for (i = 0; i < NWINFO_BUFSZ / 3; i++)
-	{
-		if (src[i] == 0x0000)
-			break;
-		else if (src[i] <= 0x007F)
-			*p++ = (CHAR)src[i];
-		else if (src[i] <= 0x07FF)
-		{
-			*p++ = (src[i] >> 6) | 0xC0;
-			*p++ = (src[i] & 0x3F) | 0x80;
-		}
-		else if (src[i] >= 0xD800 && src[i] <= 0xDFFF)
-		{
-			*p++ = 0;
-			break;
-		}
-		else
-		{
-			*p++ = (src[i] >> 12) | 0xE0;
-			*p++ = ((src[i] >> 6) & 0x3F) | 0x80;
-			*p++ = (src[i] & 0x3F) | 0x80;
-		}
-	}
-	*p = '\0';
+	NWL_Utf16ToUtf8((const uint16_t*)src, NWL_UTF_NUL, Utf8Buf, NWINFO_BUFSZ + 1);
 	return Utf8Buf;
 }
 
 LPCWSTR
 NWL_Utf8ToUcs2(LPCSTR src)
 {
-	size_t i;
-	size_t j = 0;
-	WCHAR *p;
-
 	if (!Ucs2Buf)
 	{
 		Ucs2Buf = (WCHAR*)malloc(sizeof(WCHAR) * (NWINFO_BUFSZ + 1));
 		if (!Ucs2Buf)
 			NWL_ErrExit(ERROR_OUTOFMEMORY, "Failed to allocate memory in " __FUNCTION__);
 	}
-	p = Ucs2Buf;
-	for (i = 0; src[i] != '\0' && j < NWINFO_BUFSZ; )
-	{
-		if ((src[i] & 0x80) == 0)
-		{
-			p[j++] = (WCHAR)src[i++];
-		}
-		else if ((src[i] & 0xE0) == 0xC0)
-		{
-			p[j++] = (WCHAR)((0x1FU & src[i]) << 6) | (0x3FU & src[i + 1]);
-			i += 2;
-		}
-		else if ((src[i] & 0xF0) == 0xE0)
-		{
-			p[j++] = (WCHAR)((0x0FU & src[i]) << 12) | ((0x3FU & src[i + 1]) << 6) | (0x3FU & src[i + 2]);
-			i += 3;
-		}
-		else
-			break;
-	}
-	p[j] = L'\0';
+	NWL_Utf8ToUtf16(src, NWL_UTF_NUL, (uint16_t*)Ucs2Buf, NWINFO_BUFSZ + 1);
 	return Ucs2Buf;
 }
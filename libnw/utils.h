@@ -32,6 +32,11 @@ LIBNW_API struct ACPI_RSDT* NWL_GetRsdt(VOID);
 LIBNW_API struct ACPI_XSDT* NWL_GetXsdt(VOID);
 LIBNW_API PVOID NWL_GetSysAcpi(DWORD TableId);
 LIBNW_API PVOID NWL_GetAcpiByAddr(DWORD_PTR Addr, DWORD TableId);
+// Cached ACPI tables, loaded on first use and owned by the context. Do not free.
+LIBNW_API struct DESC_HEADER* NWL_GetAcpiTable(UINT32 Signature, UINT32 Instance);
+// Signature of the Index-th table listed by the XSDT/RSDT, 0 past the end.
+LIBNW_API UINT32 NWL_EnumAcpiTable(UINT32 Index, UINT32* Instance);
+VOID NWL_FreeAcpiCache(VOID);
 
 LIBNW_API UINT8 NWL_AcpiChecksum(VOID* base, UINT size);
 INT NWL_GetRegDwordValue(HKEY Key, LPCWSTR SubKey, LPCWSTR ValueName, DWORD* pValue);
@@ -41,6 +46,8 @@ LPCSTR NWL_GuidToStr(UCHAR Guid[16]);
 LPCSTR NWL_WinGuidToStr(BOOL bBracket, GUID* pGuid);
 BOOL NWL_StrToGuid(const CHAR* cchText, GUID* pGuid);
 PBYTE NWL_LoadDump(LPCSTR pPath, DWORD minSize, DWORD* outSize);
+BOOL NWL_GetCachePath(LPWSTR lpPath, LPCWSTR lpName);
+PVOID NWL_LoadCacheFile(LPCWSTR lpPath, DWORD dwMinSize, DWORD dwMaxSize, PDWORD pdwSize);
 #if 0
 LIBNW_API HMONITOR NWL_GetMonitorFromName(LPCWSTR lpDevice);
 #endif
@@ -301,6 +301,9 @@ GpStatus WINGDIPAPI
 GdipSetClipRectI(GpGraphics* graphics, INT x, INT y,
 	INT width, INT height, CombineMode combineMode);
 
+GpStatus WINGDIPAPI
+GdipResetClip(GpGraphics* graphics);
+
 GpStatus WINGDIPAPI
 GdipDrawLineI(GpGraphics* graphics, GpPen* pen, INT x1, INT y1,
 	INT x2, INT y2);
@@ -390,6 +393,18 @@ struct GdipFont
 	GpFont* handle;
 };
 
+struct nk_gdip_box
+{
+	int x0, y0, x1, y1;
+};
+
+/* What one command looked like when the last frame was presented. */
+struct nk_gdip_damage
+{
+	nk_hash hash;
+	struct nk_gdip_box box;
+};
+
 static struct
 {
 	ULONG_PTR token;
@@ -402,6 +417,16 @@ static struct
 	GpSolidFill* brush;
 	GpStringFormat* format;
 
+	/* damage tracking, prev is the frame currently in the bitmap */
+	struct nk_gdip_damage* prev;
+	struct nk_gdip_damage* cur;
+	int prev_count;
+	int capacity;
+	struct nk_color clear;
+	int full;
+	int clip;
+	struct nk_gdip_box damage;
+
 	struct nk_context ctx;
 } gdip;
 
@@ -414,6 +439,9 @@ static void
 nk_gdip_scissor(float x, float y, float w, float h)
 {
 	GdipSetClipRectI(gdip.memory, (INT)x, (INT)y, (INT)(w + 1), (INT)(h + 1), CombineModeReplace);
+	if (gdip.clip)
+		GdipSetClipRectI(gdip.memory, gdip.damage.x0, gdip.damage.y0,
+			gdip.damage.x1 - gdip.damage.x0, gdip.damage.y1 - gdip.damage.y0, CombineModeIntersect);
 }
 
 static void
@@ -817,6 +845,7 @@ nk_gdip_handle_event(HWND wnd, UINT msg, WPARAM wparam, LPARAM lparam)
 			GdipCreateFromHWND(wnd, &gdip.window);
 			GdipCreateBitmapFromGraphics(width, height, gdip.window, &gdip.bitmap);
 			GdipGetImageGraphicsContext(gdip.bitmap, &gdip.memory);
+			gdip.full = 1;
 		}
 		break;
 
@@ -1122,6 +1151,11 @@ nk_gdip_shutdown(void)
 	GdipDeleteStringFormat(gdip.format);
 	GdiplusShutdown(gdip.token);
 
+	free(gdip.prev);
+	free(gdip.cur);
+	gdip.prev = gdip.cur = NULL;
+	gdip.prev_count = gdip.capacity = 0;
+
 	nk_free(&gdip.ctx);
 }
 
@@ -1261,11 +1295,296 @@ nk_gdip_render_gui(enum nk_anti_aliasing AA)
 	nk_clear(&gdip.ctx);
 }
 
+#define NK_GDIP_PAYLOAD(type, last) \
+	(NK_OFFSETOF(type, last) + sizeof(((type*)0)->last) - sizeof(struct nk_command))
+
+static void
+nk_gdip_box_points(struct nk_gdip_box* box, const struct nk_vec2i* pnts, int count)
+{
+	box->x0 = box->x1 = pnts[0].x;
+	box->y0 = box->y1 = pnts[0].y;
+	for (int i = 1; i < count; i++)
+	{
+		box->x0 = NK_MIN(box->x0, pnts[i].x);
+		box->y0 = NK_MIN(box->y0, pnts[i].y);
+		box->x1 = NK_MAX(box->x1, pnts[i].x);
+		box->y1 = NK_MAX(box->y1, pnts[i].y);
+	}
+}
+
+static void
+nk_gdip_box_rect(struct nk_gdip_box* box, short x, short y, unsigned short w, unsigned short h)
+{
+	box->x0 = x;
+	box->y0 = y;
+	box->x1 = x + w;
+	box->y1 = y + h;
+}
+
+/* Hash the command payload (not the header, whose offsets shift whenever an
+ * earlier command changes size) and compute the pixels it may touch. */
+static nk_hash
+nk_gdip_command_damage(const struct nk_command* cmd, struct nk_gdip_box* box)
+{
+	nk_size len = 0;
+	int pad = 2;
+
+	box->x0 = box->y0 = box->x1 = box->y1 = 0;
+	switch (cmd->type)
+	{
+	case NK_COMMAND_SCISSOR:
+	{
+		const struct nk_command_scissor* s = (const struct nk_command_scissor*)cmd;
+		len = NK_GDIP_PAYLOAD(struct nk_command_scissor, h);
+		nk_gdip_box_rect(box, s->x, s->y, s->w, s->h);
+	}
+		break;
+	case NK_COMMAND_LINE:
+	{
+		const struct nk_command_line* l = (const struct nk_command_line*)cmd;
+		struct nk_vec2i p[2] = { l->begin, l->end };
+		len = NK_GDIP_PAYLOAD(struct nk_command_line, color);
+		nk_gdip_box_points(box, p, 2);
+		pad += l->line_thickness;
+	}
+		break;
+	case NK_COMMAND_RECT:
+	{
+		const struct nk_command_rect* r = (const struct nk_command_rect*)cmd;
+		len = NK_GDIP_PAYLOAD(struct nk_command_rect, color);
+		nk_gdip_box_rect(box, r->x, r->y, r->w, r->h);
+		pad += r->line_thickness;
+	}
+		break;
+	case NK_COMMAND_RECT_FILLED:
+	{
+		const struct nk_command_rect_filled* r = (const struct nk_command_rect_filled*)cmd;
+		len = NK_GDIP_PAYLOAD(struct nk_command_rect_filled, color);
+		nk_gdip_box_rect(box, r->x, r->y, r->w, r->h);
+	}
+		break;
+	case NK_COMMAND_RECT_MULTI_COLOR:
+	{
+		const struct nk_command_rect_multi_color* r = (const struct nk_command_rect_multi_color*)cmd;
+		len = NK_GDIP_PAYLOAD(struct nk_command_rect_multi_color, bottom);
+		nk_gdip_box_rect(box, r->x, r->y, r->w, r->h);
+	}
+		break;
+	case NK_COMMAND_CIRCLE:
+	{
+		const struct nk_command_circle* c = (const struct nk_command_circle*)cmd;
+		len = NK_GDIP_PAYLOAD(struct nk_command_circle, color);
+		nk_gdip_box_rect(box, c->x, c->y, c->w, c->h);
+		pad += c->line_thickness;
+	}
+		break;
+	case NK_COMMAND_CIRCLE_FILLED:
+	{
+		const struct nk_command_circle_filled* c = (const struct nk_command_circle_filled*)cmd;
+		len = NK_GDIP_PAYLOAD(struct nk_command_circle_filled, color);
+		nk_gdip_box_rect(box, c->x, c->y, c->w, c->h);
+	}
+		break;
+	case NK_COMMAND_ARC:
+	{
+		const struct nk_command_arc* a = (const struct nk_command_arc*)cmd;
+		len = NK_GDIP_PAYLOAD(struct nk_command_arc, color);
+		nk_gdip_box_rect(box, a->cx - a->r, a->cy - a->r, 2 * a->r, 2 * a->r);
+		pad += a->line_thickness;
+	}
+		break;
+	case NK_COMMAND_ARC_FILLED:
+	{
+		const struct nk_command_arc_filled* a = (const struct nk_command_arc_filled*)cmd;
+		len = NK_GDIP_PAYLOAD(struct nk_command_arc_filled, color);
+		nk_gdip_box_rect(box, a->cx - a->r, a->cy - a->r, 2 * a->r, 2 * a->r);
+	}
+		break;
+	case NK_COMMAND_TRIANGLE:
+	{
+		const struct nk_command_triangle* t = (const struct nk_command_triangle*)cmd;
+		struct nk_vec2i p[3] = { t->a, t->b, t->c };
+		len = NK_GDIP_PAYLOAD(struct nk_command_triangle, color);
+		nk_gdip_box_points(box, p, 3);
+		pad += t->line_thickness;
+	}
+		break;
+	case NK_COMMAND_TRIANGLE_FILLED:
+	{
+		const struct nk_command_triangle_filled* t = (const struct nk_command_triangle_filled*)cmd;
+		struct nk_vec2i p[3] = { t->a, t->b, t->c };
+		len = NK_GDIP_PAYLOAD(struct nk_command_triangle_filled, color);
+		nk_gdip_box_points(box, p, 3);
+	}
+		break;
+	case NK_COMMAND_POLYGON:
+	{
+		const struct nk_command_polygon* p = (const struct nk_command_polygon*)cmd;
+		len = NK_OFFSETOF(struct nk_command_polygon, points) + p->point_count * sizeof(struct nk_vec2i) - sizeof(struct nk_command);
+		if (p->point_count)
+			nk_gdip_box_points(box, p->points, p->point_count);
+		pad += p->line_thickness;
+	}
+		break;
+	case NK_COMMAND_POLYGON_FILLED:
+	{
+		const struct nk_command_polygon_filled* p = (const struct nk_command_polygon_filled*)cmd;
+		len = NK_OFFSETOF(struct nk_command_polygon_filled, points) + p->point_count * sizeof(struct nk_vec2i) - sizeof(struct nk_command);
+		if (p->point_count)
+			nk_gdip_box_points(box, p->points, p->point_count);
+	}
+		break;
+	case NK_COMMAND_POLYLINE:
+	{
+		const struct nk_command_polyline* p = (const struct nk_command_polyline*)cmd;
+		len = NK_OFFSETOF(struct nk_command_polyline, points) + p->point_count * sizeof(struct nk_vec2i) - sizeof(struct nk_command);
+		if (p->point_count)
+			nk_gdip_box_points(box, p->points, p->point_count);
+		pad += p->line_thickness;
+	}
+		break;
+	case NK_COMMAND_TEXT:
+	{
+		const struct nk_command_text* t = (const struct nk_command_text*)cmd;
+		len = NK_OFFSETOF(struct nk_command_text, string) + t->length - sizeof(struct nk_command);
+		nk_gdip_box_rect(box, t->x, t->y, t->w, t->h);
+	}
+		break;
+	case NK_COMMAND_CURVE:
+	{
+		const struct nk_command_curve* q = (const struct nk_command_curve*)cmd;
+		struct nk_vec2i p[4] = { q->begin, q->ctrl[0], q->ctrl[1], q->end };
+		len = NK_GDIP_PAYLOAD(struct nk_command_curve, color);
+		nk_gdip_box_points(box, p, 4);
+		pad += q->line_thickness;
+	}
+		break;
+	case NK_COMMAND_IMAGE:
+	{
+		const struct nk_command_image* i = (const struct nk_command_image*)cmd;
+		len = NK_GDIP_PAYLOAD(struct nk_command_image, col);
+		nk_gdip_box_rect(box, i->x, i->y, i->w, i->h);
+	}
+		break;
+	case NK_COMMAND_NOP:
+	default:
+		break;
+	}
+	box->x0 -= pad;
+	box->y0 -= pad;
+	box->x1 += pad;
+	box->y1 += pad;
+	return nk_murmur_hash((const char*)cmd + sizeof(struct nk_command), (int)len, (nk_hash)cmd->type);
+}
+
+static void
+nk_gdip_unify(struct nk_gdip_box* dst, const struct nk_gdip_box* src)
+{
+	if (dst->x1 <= dst->x0 || dst->y1 <= dst->y0)
+	{
+		*dst = *src;
+		return;
+	}
+	dst->x0 = NK_MIN(dst->x0, src->x0);
+	dst->y0 = NK_MIN(dst->y0, src->y0);
+	dst->x1 = NK_MAX(dst->x1, src->x1);
+	dst->y1 = NK_MAX(dst->y1, src->y1);
+}
+
+enum nk_gdip_present
+{
+	NK_GDIP_PRESENT_NONE,
+	NK_GDIP_PRESENT_DAMAGE,
+	NK_GDIP_PRESENT_FULL,
+};
+
+/* Compare the queued commands with the frame in the bitmap. */
+static enum nk_gdip_present
+nk_gdip_diff(struct nk_color clear)
+{
+	const struct nk_command* cmd;
+	enum nk_gdip_present ret = NK_GDIP_PRESENT_NONE;
+	int count = 0;
+
+	gdip.damage.x0 = gdip.damage.y0 = gdip.damage.x1 = gdip.damage.y1 = 0;
+	nk_foreach(cmd, &gdip.ctx)
+	{
+		struct nk_gdip_damage* d;
+		if (count >= gdip.capacity)
+		{
+			int capacity = gdip.capacity ? gdip.capacity * 2 : 1024;
+			struct nk_gdip_damage* prev = realloc(gdip.prev, capacity * sizeof(struct nk_gdip_damage));
+			if (prev)
+				gdip.prev = prev;
+			struct nk_gdip_damage* cur = realloc(gdip.cur, capacity * sizeof(struct nk_gdip_damage));
+			if (cur)
+				gdip.cur = cur;
+			if (!prev || !cur)
+			{
+				gdip.prev_count = 0;
+				gdip.full = 1;
+				return NK_GDIP_PRESENT_FULL;
+			}
+			gdip.capacity = capacity;
+		}
+		d = &gdip.cur[count];
+		d->hash = nk_gdip_command_damage(cmd, &d->box);
+		if (ret != NK_GDIP_PRESENT_FULL && count < gdip.prev_count && d->hash != gdip.prev[count].hash)
+		{
+			/* A scissor change moves the clip of every command after it. */
+			if (cmd->type == NK_COMMAND_SCISSOR)
+				ret = NK_GDIP_PRESENT_FULL;
+			else
+			{
+				nk_gdip_unify(&gdip.damage, &d->box);
+				nk_gdip_unify(&gdip.damage, &gdip.prev[count].box);
+				ret = NK_GDIP_PRESENT_DAMAGE;
+			}
+		}
+		count++;
+	}
+
+	if (gdip.full || count != gdip.prev_count || memcmp(&clear, &gdip.clear, sizeof(clear)) != 0)
+		ret = NK_GDIP_PRESENT_FULL;
+
+	struct nk_gdip_damage* tmp = gdip.prev;
+	gdip.prev = gdip.cur;
+	gdip.cur = tmp;
+	gdip.prev_count = count;
+	gdip.clear = clear;
+	gdip.full = 0;
+	return ret;
+}
+
 NK_API void
 nk_gdip_render(enum nk_anti_aliasing AA, struct nk_color clear)
 {
-	nk_gdip_clear(clear);
-	nk_gdip_render_gui(AA);
+	struct nk_gdip_box* d = &gdip.damage;
+
+	switch (nk_gdip_diff(clear))
+	{
+	case NK_GDIP_PRESENT_NONE:
+		/* Nothing visible changed, the bitmap and the window are current. */
+		nk_clear(&gdip.ctx);
+		return;
+	case NK_GDIP_PRESENT_DAMAGE:
+		GdipSetClipRectI(gdip.memory, d->x0, d->y0, d->x1 - d->x0, d->y1 - d->y0, CombineModeReplace);
+		nk_gdip_clear(clear);
+		gdip.clip = 1;
+		nk_gdip_prerender_gui(AA);
+		gdip.clip = 0;
+		GdipResetClip(gdip.memory);
+		GdipSetClipRectI(gdip.window, d->x0, d->y0, d->x1 - d->x0, d->y1 - d->y0, CombineModeReplace);
+		nk_gdip_blit(gdip.window);
+		GdipResetClip(gdip.window);
+		nk_clear(&gdip.ctx);
+		return;
+	case NK_GDIP_PRESENT_FULL:
+	default:
+		nk_gdip_clear(clear);
+		nk_gdip_render_gui(AA);
+		return;
+	}
 }
 
 NK_API GdipFont*
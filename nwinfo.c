@@ -71,6 +71,11 @@ enum
 	NW_OPT_DEBUG,
 	NW_OPT_HIDE_SENSITIVE,
 	NW_OPT_DRIVER,
+	NW_OPT_DRIVER_RECORD,
+	NW_OPT_DRIVER_REPLAY,
+	NW_OPT_DRIVER_TIMING,
+	NW_OPT_SERVE,
+	NW_OPT_PUBLISH,
 	NW_OPT_SYS,
 	NW_OPT_CPU,
 	NW_OPT_NET,
@@ -93,6 +98,7 @@ enum
 	NW_OPT_FONT,
 	NW_OPT_DEVICE,
 	NW_OPT_DRV_STORE,
+	NW_OPT_DRV_STREAM,
 	NW_OPT_HID,
 	NW_OPT_SENSORS,
 };
@@ -110,6 +116,11 @@ static struct optparse_option nwOptions[] =
 	{ "debug", 'd', OPTPARSE_NONE},
 	{ "hide-sensitive", 'i', OPTPARSE_NONE},
 	{ "driver", 's', OPTPARSE_REQUIRED},
+	{ "driver-record", 0, OPTPARSE_REQUIRED},
+	{ "driver-replay", 0, OPTPARSE_REQUIRED},
+	{ "driver-timing", 0, OPTPARSE_NONE},
+	{ "serve", 0, OPTPARSE_OPTIONAL},
+	{ "publish", 0, OPTPARSE_OPTIONAL},
 	{ "sys", 0, OPTPARSE_NONE },
 	{ "cpu", 0, OPTPARSE_OPTIONAL },
 	{ "net", 0, OPTPARSE_OPTIONAL },
@@ -132,6 +143,7 @@ static struct optparse_option nwOptions[] =
 	{ "font", 0, OPTPARSE_NONE },
 	{ "device", 0, OPTPARSE_OPTIONAL },
 	{ "drv-store", 0, OPTPARSE_OPTIONAL },
+	{ "drv-stream", 0, OPTPARSE_NONE },
 	{ "hid", 0, OPTPARSE_NONE },
 	{ "sensors", 0, OPTPARSE_OPTIONAL },
 	{ 0, 0, 0 },
@@ -159,6 +171,20 @@ static void nwinfo_help(void)
 		"  --debug          Print debug info to stdout.\n"
 		"  --hide-sensitive Hide sensitive data (MAC & S/N).\n"
 		"  --driver=NAME    Specify the driver name.\n"
+		"  --driver-record=FILE\n"
+		"                   Record all driver requests to FILE.\n"
+		"  --driver-replay=FILE\n"
+		"                   Answer driver requests from a recorded FILE.\n"
+		"  --driver-timing  Emulate recorded driver latency during replay.\n"
+		"  --serve[=NAME]   Stay resident and answer queries on the named pipe\n"
+		"                   '\\\\.\\pipe\\NAME' (default 'nwinfo').\n"
+		"                   A query is one line of section options,\n"
+		"                   e.g. '--smbios --sensors --format=json'.\n"
+		"                   Static sections are cached, others expire.\n"
+		"  --publish[=NAME] Stay resident and publish sensor readings every\n"
+		"                   second to the shared memory NAME\n"
+		"                   (default 'NWinfoSensors').\n"
+		"                   Use '--sensors=SRC,..' to choose the providers.\n"
 		"  --sys            Print system info.\n"
 		"  --cpu[=FILE]     Print CPUID info.\n"
 		"    FILE           Specify the file name of the CPUID dump.\n"
@@ -206,6 +232,8 @@ static void nwinfo_help(void)
 		"                   'NOCSMI' and 'CSMIRAID'.\n"
 		"  --display[=FILE] Print EDID info.\n"
 		"    FILE           Specify the file name of the EDID dump.\n"
+		"                   The dump may hold several EDIDs back to back,\n"
+		"                   or FILE may be a directory of dumps.\n"
 		"  --pci[=CLASS,..] Print PCI info.\n"
 		"                   CLASS specifies the class codes of PCI devices,\n"
 		"                   e.g. '0c05' or '03,0c05'.\n"
@@ -230,10 +258,15 @@ static void nwinfo_help(void)
 		"  --device[=TYPE]  Print device tree.\n"
 		"                   TYPE specifies the type of the devices,\n"
 		"                   e.g. 'ACPI', 'SWD', 'PCI' or 'USB'.\n"
+		"                   Multiple hardware ID prefixes are separated by commas,\n"
+		"                   e.g. 'PCI\\VEN_10DE,USB\\VID_046D'.\n"
 		"  --drv-store[=OFFLINE_PATH]\n"
 		"                   Print Windows driver store info.\n"
 		"                   OFFLINE_PATH specifies the path of the offline system,\n"
 		"                   e.g. 'D:\\' or 'E:\\Backup'.\n"
+		"  --drv-stream     Print driver store packages as they are read,\n"
+		"                   one document per package ahead of the report.\n"
+		"                   Implies '--drv-store'. Requires YAML or JSON format.\n"
 		"  --hid            Print Human Interface Devices (HID) info.\n"
 		"  --sensors[=SRC,..]\n"
 		"                   Print sensors.\n"
@@ -241,7 +274,7 @@ static void nwinfo_help(void)
 		"                   Available providers are:\n"
 		"                   'LHM', 'HWINFO', 'GPU-Z',\n"
 		"                   'CPU', 'DIMM', 'GPU', 'SMART',\n"
-		"                   'DISK', 'NET', 'IMC', 'INTEL' and 'ZEN'.\n");
+		"                   'DISK', 'NET', 'IMC', 'INTEL', 'ZEN' and 'SIO'.\n");
 }
 
 typedef struct _NW_ARG_FILTER
@@ -347,6 +380,10 @@ int main(int argc, char* argv[])
 
 	BOOL bSetCodePage = FALSE;
 	LPCSTR lpFileName = NULL;
+	LPCSTR lpPipeName = NULL;
+	LPCSTR lpShmName = NULL;
+	BOOL bServe = FALSE;
+	BOOL bPublish = FALSE;
 	ZeroMemory(&nwContext, sizeof(NWLIB_CONTEXT));
 	nwContext.NwFormat = FORMAT_YAML;
 	nwContext.HumanSize = FALSE;
@@ -401,6 +438,14 @@ int main(int argc, char* argv[])
 		case NW_OPT_OUTPUT:
 			lpFileName = options.optarg;
 			break;
+		case NW_OPT_SERVE:
+			bServe = TRUE;
+			lpPipeName = options.optarg;
+			break;
+		case NW_OPT_PUBLISH:
+			bPublish = TRUE;
+			lpShmName = options.optarg;
+			break;
 		case NW_OPT_HUMAN:
 			nwContext.HumanSize = TRUE;
 			break;
@@ -417,6 +462,15 @@ int main(int argc, char* argv[])
 		case NW_OPT_DRIVER:
 			nwContext.DriverName = options.optarg;
 			break;
+		case NW_OPT_DRIVER_RECORD:
+			nwContext.DriverRecord = options.optarg;
+			break;
+		case NW_OPT_DRIVER_REPLAY:
+			nwContext.DriverReplay = options.optarg;
+			break;
+		case NW_OPT_DRIVER_TIMING:
+			nwContext.DriverTiming = TRUE;
+			break;
 		case NW_OPT_SYS:
 			nwContext.SysInfo = TRUE;
 			break;
@@ -571,6 +625,10 @@ int main(int argc, char* argv[])
 				nwContext.DrvStoreDrive = options.optarg;
 			nwContext.DrvStore = TRUE;
 			break;
+		case NW_OPT_DRV_STREAM:
+			nwContext.DrvStoreStream = TRUE;
+			nwContext.DrvStore = TRUE;
+			break;
 		case NW_OPT_HID:
 			nwContext.HidInfo = TRUE;
 			break;
@@ -590,6 +648,7 @@ int main(int argc, char* argv[])
 				{"IMC", NWL_SENSOR_IMC},
 				{"INTEL", NWL_SENSOR_INTEL},
 				{"ZEN", NWL_SENSOR_ZEN},
+				{"SIO", NWL_SENSOR_SIO},
 			};
 			nwinfo_get_opts(options.optarg, &nwContext.NwSensorFlags, ARRAYSIZE(filter), filter, NULL);
 			nwContext.Sensors = TRUE;
@@ -606,16 +665,28 @@ int main(int argc, char* argv[])
 		}
 	}
 
+	if (nwContext.DrvStoreStream &&
+		nwContext.NwFormat != FORMAT_YAML && nwContext.NwFormat != FORMAT_JSON)
+	{
+		fprintf(stderr, "Error: --drv-stream requires YAML or JSON format\n");
+		return 1;
+	}
+
 	if (bSetCodePage == FALSE)
 	{
-		if (lpFileName)
+		if (lpFileName || bServe)
 			nwContext.CodePage = CP_UTF8;
 		else
 			nwContext.CodePage = CP_ACP;
 	}
 	(void)CoInitializeEx(0, COINIT_APARTMENTTHREADED);
 	NW_Init(&nwContext);
-	NW_Print(lpFileName);
+	if (bServe)
+		NW_Serve(lpPipeName);
+	else if (bPublish)
+		NW_Publish(lpShmName, 1000);
+	else
+		NW_Print(lpFileName);
 	if (nwContext.NetGuid)
 		free(nwContext.NetGuid);
 	if (nwContext.DiskPath)
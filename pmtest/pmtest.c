@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ryzen_pm.h"
+
+static const char* metric_name[RY_PM_COUNT] =
+{
+	[RY_PM_STAPM_LIMIT] = "STAPM Limit",
+	[RY_PM_STAPM_VALUE] = "STAPM Value",
+	[RY_PM_FAST_LIMIT] = "Fast Limit",
+	[RY_PM_FAST_VALUE] = "Fast Value",
+	[RY_PM_SLOW_LIMIT] = "Slow Limit",
+	[RY_PM_SLOW_VALUE] = "Slow Value",
+	[RY_PM_APU_SLOW_LIMIT] = "APU Slow Limit",
+	[RY_PM_APU_SLOW_VALUE] = "APU Slow Value",
+	[RY_PM_VRM_CURRENT] = "VRM Current",
+	[RY_PM_VRM_CURRENT_VALUE] = "VRM Current Value",
+	[RY_PM_VRMSOC_CURRENT] = "VRM SoC Current",
+	[RY_PM_VRMSOC_CURRENT_VALUE] = "VRM SoC Current Value",
+	[RY_PM_CORE_TEMPERATURE] = "Core Temperature",
+	[RY_PM_CORE_VOLT] = "Core Voltage",
+	[RY_PM_CORE_CLK] = "Core Clock",
+	[RY_PM_CORE_POWER] = "Core Power",
+	[RY_PM_GFX_TEMPERATURE] = "GFX Temperature",
+	[RY_PM_GFX_VOLT] = "GFX Voltage",
+	[RY_PM_GFX_CLK] = "GFX Clock",
+	[RY_PM_FCLK] = "FCLK",
+	[RY_PM_UCLK] = "UCLK",
+	[RY_PM_MCLK] = "MCLK",
+	[RY_PM_SOC_VOLT] = "SoC Voltage",
+	[RY_PM_CLDO_VDDP] = "CLDO VDDP",
+	[RY_PM_PSI0_CURRENT] = "PSI0 Current",
+	[RY_PM_PSI0SOC_CURRENT] = "PSI0 SoC Current",
+	[RY_PM_L3_CLK] = "L3 Clock",
+	[RY_PM_L3_VDDM] = "L3 VDDM",
+	[RY_PM_L3_TEMPERATURE] = "L3 Temperature",
+	[RY_PM_SOCKET_POWER] = "Socket Power",
+};
+
+// Resolves the layout for a captured table and extracts every metric,
+// the same way ryzen_smu_init and ryzen_smu_update_pm_table do.
+static void
+ReplayTable(uint32_t version, const uint8_t* table, size_t size, int verbose)
+{
+	ry_pm_layout_t layout;
+	float values[RY_PM_COUNT][SMU_MAX_CORE];
+
+	ry_resolve_pm_layout(&layout, version, size);
+	ry_extract_pm_values(&layout, table, values);
+	if (!verbose)
+		return;
+	printf("Version %08X, %zu bytes, %zu bytes used\n", version, size, layout.used);
+	for (size_t i = 0; i < RY_PM_COUNT; i++)
+	{
+		printf("%-22s", metric_name[i]);
+		if (!layout.count[i])
+		{
+			printf(" -\n");
+			continue;
+		}
+		printf(" @0x%03X", layout.offset[i]);
+		for (uint8_t j = 0; j < layout.count[i]; j++)
+			printf(" %.2f", values[i][j]);
+		printf("\n");
+	}
+}
+
+#ifdef PM_FUZZER
+// Input: little endian table version followed by the table image.
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	uint32_t version;
+	uint8_t* table;
+
+	if (size < sizeof(version))
+		return 0;
+	memcpy(&version, data, sizeof(version));
+	size -= sizeof(version);
+	// Exact-size copy so any read past the table trips ASan
+	table = malloc(size ? size : 1);
+	if (!table)
+		return 0;
+	memcpy(table, data + sizeof(version), size);
+	ReplayTable(version, table, size, 0);
+	free(table);
+	return 0;
+}
+#else
+static uint8_t*
+LoadFile(const char* path, size_t* size)
+{
+	uint8_t* data = NULL;
+	long len;
+	FILE* fp = fopen(path, "rb");
+	if (!fp)
+		return NULL;
+	if (fseek(fp, 0, SEEK_END) != 0 || (len = ftell(fp)) <= 0 || fseek(fp, 0, SEEK_SET) != 0)
+		goto out;
+	data = malloc((size_t)len);
+	if (!data)
+		goto out;
+	if (fread(data, 1, (size_t)len, fp) != (size_t)len)
+	{
+		free(data);
+		data = NULL;
+		goto out;
+	}
+	*size = (size_t)len;
+out:
+	fclose(fp);
+	return data;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t size = 0;
+	long iterations = 100000;
+	uint32_t version;
+	uint8_t* data;
+	struct timespec t0, t1;
+
+	if (argc < 3)
+	{
+		fprintf(stderr, "Usage: %s VERSION PM_TABLE_FILE [ITERATIONS]\n", argv[0]);
+		return 1;
+	}
+	version = (uint32_t)strtoul(argv[1], NULL, 16);
+	if (argc > 3)
+		iterations = strtol(argv[3], NULL, 0);
+	if (iterations < 0)
+		iterations = 0;
+
+	data = LoadFile(argv[2], &size);
+	if (!data)
+	{
+		fprintf(stderr, "Failed to load %s\n", argv[2]);
+		return 1;
+	}
+	if (size > SMU_TABLE_MAX_SIZE)
+		size = SMU_TABLE_MAX_SIZE;
+
+	ReplayTable(version, data, size, 1);
+
+	if (iterations)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (long i = 0; i < iterations; i++)
+			ReplayTable(version, data, size, 0);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+
+		double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+		printf("%ld iterations: %.1f ns/table\n", iterations, ns / iterations);
+	}
+
+	free(data);
+	return 0;
+}
+#endif
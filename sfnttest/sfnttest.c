@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sfnt.h"
+
+static NWL_SFNT_FACE faces[NWL_SFNT_FACE_MAX];
+
+static uint32_t
+ParseFont(const uint8_t* data, size_t size, int verbose)
+{
+	uint32_t count = NWL_SfntParse(data, size, faces, NWL_SFNT_FACE_MAX);
+	if (!verbose)
+		return count;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const NWL_SFNT_FACE* f = &faces[i];
+		printf("Face %u: \"%s\" \"%s\" \"%s\" \"%s\"\n",
+			f->Index, f->Family, f->Style, f->FullName, f->Version);
+		printf("\t%s, weight %u, %u units/em, ascent %u, descent %u, avg width %d, max advance %u%s%s%s\n",
+			f->Cff ? "CFF" : "TrueType", f->Weight, f->UnitsPerEm, f->Ascent, f->Descent,
+			f->AvgCharWidth, f->MaxAdvance,
+			f->Italic ? ", italic" : "", f->Underline ? ", underline" : "", f->Strikeout ? ", strikeout" : "");
+	}
+	return count;
+}
+
+#ifdef SFNT_FUZZER
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	ParseFont(data, size, 0);
+	return 0;
+}
+#else
+static uint8_t*
+LoadFile(const char* path, size_t* size)
+{
+	uint8_t* data = NULL;
+	long len;
+	FILE* fp = fopen(path, "rb");
+	if (!fp)
+		return NULL;
+	if (fseek(fp, 0, SEEK_END) != 0 || (len = ftell(fp)) <= 0 || fseek(fp, 0, SEEK_SET) != 0)
+		goto out;
+	data = malloc((size_t)len);
+	if (!data)
+		goto out;
+	if (fread(data, 1, (size_t)len, fp) != (size_t)len)
+	{
+		free(data);
+		data = NULL;
+		goto out;
+	}
+	*size = (size_t)len;
+out:
+	fclose(fp);
+	return data;
+}
+
+int main(int argc, char* argv[])
+{
+	long iterations = 100000;
+	int first = 1;
+	int ret = 0;
+	struct timespec t0, t1;
+
+	if (argc > 2 && strcmp(argv[1], "-n") == 0)
+	{
+		iterations = strtol(argv[2], NULL, 0);
+		first = 3;
+	}
+	if (iterations < 0)
+		iterations = 0;
+	if (first >= argc)
+	{
+		fprintf(stderr, "Usage: %s [-n ITERATIONS] FONT_FILE...\n", argv[0]);
+		return 1;
+	}
+
+	for (int i = first; i < argc; i++)
+	{
+		size_t size = 0;
+		uint8_t* data = LoadFile(argv[i], &size);
+		if (!data)
+		{
+			fprintf(stderr, "Failed to load %s\n", argv[i]);
+			ret = 1;
+			continue;
+		}
+
+		printf("%s\n", argv[i]);
+		uint32_t count = ParseFont(data, size, 1);
+
+		if (iterations)
+		{
+			clock_gettime(CLOCK_MONOTONIC, &t0);
+			for (long j = 0; j < iterations; j++)
+				ParseFont(data, size, 0);
+			clock_gettime(CLOCK_MONOTONIC, &t1);
+
+			double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+			printf("%zu bytes, %u face(s), %ld iterations: %.1f ns/file\n",
+				size, count, iterations, ns / iterations);
+		}
+		free(data);
+	}
+	return ret;
+}
+#endif
@@ -0,0 +1,333 @@
+// SPDX-License-Identifier: Unlicense
+
+// Reader/writer contention test for the "nwinfo --publish" shared memory.
+//
+// Without -n a private segment is created and a writer thread publishes to it
+// the same way NWL_ShmPublish does. Every publish stores one generation number
+// in all entries, so a reader that accepts a mixed copy has seen a torn read.
+// With -n the readers attach to a running "nwinfo --publish" instead.
+//
+// Readers call NWSHM_ReadEx in a loop and report the retry rate, the number of
+// reads that gave up after NWSHM_READ_RETRY tries, and the read latency.
+
+#define VC_EXTRALEAN
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../libnw/sensor/nwinfo_shmem.h"
+
+#define SHMTEST_BUCKETS 32
+#define SHMTEST_MAX_ENTRIES 1024
+
+typedef struct
+{
+	HANDLE thread;
+	NWSHM_READER reader;
+	NWSHM_ENTRY* entries;
+	DWORD capacity;
+	ULONGLONG reads;
+	ULONGLONG retries;
+	ULONGLONG busy;
+	ULONGLONG torn;
+	ULONGLONG max_ns;
+	double total_ns;
+	ULONGLONG hist[SHMTEST_BUCKETS];
+} READER_CTX;
+
+static struct
+{
+	WCHAR name[MAX_PATH];
+	BOOL live;
+	DWORD readers;
+	DWORD seconds;
+	DWORD interval; // microseconds between publishes, 0 to publish back to back
+	DWORD count;
+	HANDLE file;
+	NWSHM_HEADER* hdr;
+	ULONGLONG publishes;
+	LARGE_INTEGER freq;
+	volatile LONG stop;
+} ctx;
+
+static VOID
+SpinWait(DWORD us)
+{
+	LARGE_INTEGER t0, t1;
+	if (us == 0)
+		return;
+	if (us >= 2000)
+	{
+		Sleep(us / 1000);
+		return;
+	}
+	QueryPerformanceCounter(&t0);
+	do
+	{
+		YieldProcessor();
+		QueryPerformanceCounter(&t1);
+	} while ((ULONGLONG)(t1.QuadPart - t0.QuadPart) * 1000000ULL < (ULONGLONG)ctx.freq.QuadPart * us);
+}
+
+static DWORD WINAPI
+WriterThread(LPVOID lpParam)
+{
+	NWSHM_ENTRY* entries = (NWSHM_ENTRY*)((BYTE*)ctx.hdr + ctx.hdr->HeaderSize);
+	NWSHM_ENTRY* staging = lpParam;
+	FILETIME ft;
+
+	while (!ctx.stop)
+	{
+		double gen = (double)++ctx.publishes;
+		for (DWORD i = 0; i < ctx.count; i++)
+			staging[i].Value = gen;
+		GetSystemTimeAsFileTime(&ft);
+
+		InterlockedIncrement64(&ctx.hdr->Sequence);
+		memcpy(entries, staging, ctx.count * sizeof(NWSHM_ENTRY));
+		ctx.hdr->Count = ctx.count;
+		ctx.hdr->Timestamp = ((UINT64)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+		InterlockedIncrement64(&ctx.hdr->Sequence);
+
+		SpinWait(ctx.interval);
+	}
+	return 0;
+}
+
+static DWORD WINAPI
+ReaderThread(LPVOID lpParam)
+{
+	READER_CTX* rd = lpParam;
+	LARGE_INTEGER t0, t1;
+
+	while (!ctx.stop)
+	{
+		INT retries = 0;
+		QueryPerformanceCounter(&t0);
+		INT count = NWSHM_ReadEx(&rd->reader, rd->entries, rd->capacity, NULL, &retries);
+		QueryPerformanceCounter(&t1);
+
+		ULONGLONG ns = (ULONGLONG)(t1.QuadPart - t0.QuadPart) * 1000000000ULL / ctx.freq.QuadPart;
+		DWORD bucket = 0;
+		while (bucket < SHMTEST_BUCKETS - 1 && (1ULL << (bucket + 1)) <= ns)
+			bucket++;
+		rd->hist[bucket]++;
+		rd->total_ns += (double)ns;
+		if (ns > rd->max_ns)
+			rd->max_ns = ns;
+		rd->reads++;
+		rd->retries += retries;
+		if (count < 0)
+		{
+			rd->busy++;
+			continue;
+		}
+		if (ctx.live)
+			continue;
+		for (INT i = 1; i < count; i++)
+		{
+			if (rd->entries[i].Value != rd->entries[0].Value)
+			{
+				rd->torn++;
+				break;
+			}
+		}
+	}
+	return 0;
+}
+
+static BOOL
+CreateSegment(NWSHM_ENTRY** pStaging)
+{
+	DWORD size = sizeof(NWSHM_HEADER) + ctx.count * sizeof(NWSHM_ENTRY);
+	NWSHM_ENTRY* staging;
+
+	swprintf(ctx.name, MAX_PATH, L"%ls.shmtest.%lu", NWSHM_NAME_DEFAULT, GetCurrentProcessId());
+	ctx.file = CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, size, ctx.name);
+	if (!ctx.file)
+		return FALSE;
+	ctx.hdr = MapViewOfFile(ctx.file, FILE_MAP_WRITE, 0, 0, size);
+	if (!ctx.hdr)
+		return FALSE;
+	staging = calloc(ctx.count, sizeof(NWSHM_ENTRY));
+	if (!staging)
+		return FALSE;
+	for (DWORD i = 0; i < ctx.count; i++)
+	{
+		snprintf(staging[i].Path, NWSHM_PATH_LEN, "TEST/Group %lu/Reading %lu", i / 16, i);
+		staging[i].Key = NWSHM_Key(staging[i].Path);
+	}
+
+	ctx.hdr->HeaderSize = sizeof(NWSHM_HEADER);
+	ctx.hdr->EntrySize = sizeof(NWSHM_ENTRY);
+	ctx.hdr->Capacity = ctx.count;
+	ctx.hdr->WriterPid = GetCurrentProcessId();
+	ctx.hdr->Version = NWSHM_VERSION;
+	MemoryBarrier();
+	ctx.hdr->Magic = NWSHM_MAGIC;
+	*pStaging = staging;
+	return TRUE;
+}
+
+static ULONGLONG
+Percentile(const ULONGLONG* hist, ULONGLONG total, double p)
+{
+	ULONGLONG want = (ULONGLONG)(total * p);
+	ULONGLONG seen = 0;
+	for (DWORD i = 0; i < SHMTEST_BUCKETS; i++)
+	{
+		seen += hist[i];
+		if (seen > want)
+			return 1ULL << (i + 1);
+	}
+	return 1ULL << SHMTEST_BUCKETS;
+}
+
+static VOID
+Usage(LPCSTR prog)
+{
+	printf("Usage: %s [-n NAME] [-r READERS] [-t SECONDS] [-i INTERVAL_US] [-e ENTRIES]\n", prog);
+	printf("  -n NAME         attach to a running \"nwinfo --publish\" segment\n");
+	printf("  -r READERS      reader threads (default 4)\n");
+	printf("  -t SECONDS      test duration (default 5)\n");
+	printf("  -i INTERVAL_US  private writer: delay between publishes (default 0)\n");
+	printf("  -e ENTRIES      private writer: entries per publish (default 256)\n");
+}
+
+int main(int argc, char* argv[])
+{
+	NWSHM_ENTRY* staging = NULL;
+	HANDLE writer = NULL;
+	READER_CTX* rds = NULL;
+	READER_CTX sum = { 0 };
+	int ret = 1;
+
+	ctx.readers = 4;
+	ctx.seconds = 5;
+	ctx.count = 256;
+	for (int i = 1; i < argc; i++)
+	{
+		if (i + 1 >= argc || argv[i][0] != '-')
+		{
+			Usage(argv[0]);
+			return 1;
+		}
+		switch (argv[i][1])
+		{
+		case 'n':
+			swprintf(ctx.name, MAX_PATH, L"%hs", argv[++i]);
+			ctx.live = TRUE;
+			break;
+		case 'r': ctx.readers = strtoul(argv[++i], NULL, 0); break;
+		case 't': ctx.seconds = strtoul(argv[++i], NULL, 0); break;
+		case 'i': ctx.interval = strtoul(argv[++i], NULL, 0); break;
+		case 'e': ctx.count = strtoul(argv[++i], NULL, 0); break;
+		default:
+			Usage(argv[0]);
+			return 1;
+		}
+	}
+	if (ctx.readers == 0)
+		ctx.readers = 1;
+	if (ctx.count == 0 || ctx.count > SHMTEST_MAX_ENTRIES)
+		ctx.count = SHMTEST_MAX_ENTRIES;
+	QueryPerformanceFrequency(&ctx.freq);
+
+	if (!ctx.live && !CreateSegment(&staging))
+	{
+		fprintf(stderr, "Cannot create shared memory (%lu)\n", GetLastError());
+		goto out;
+	}
+
+	rds = calloc(ctx.readers, sizeof(READER_CTX));
+	if (!rds)
+		goto out;
+	for (DWORD i = 0; i < ctx.readers; i++)
+	{
+		if (!NWSHM_Open(&rds[i].reader, ctx.name))
+		{
+			fprintf(stderr, "Cannot open %ls\n", ctx.name);
+			goto out;
+		}
+		rds[i].capacity = rds[i].reader.Header->Capacity;
+		rds[i].entries = calloc(rds[i].capacity ? rds[i].capacity : 1, sizeof(NWSHM_ENTRY));
+		if (!rds[i].entries)
+			goto out;
+	}
+
+	printf("%ls: %s writer, %lu reader(s), %lu s", ctx.name,
+		ctx.live ? "external" : "private", ctx.readers, ctx.seconds);
+	if (!ctx.live)
+		printf(", %lu entries, %lu us interval", ctx.count, ctx.interval);
+	printf("\n");
+
+	if (!ctx.live)
+		writer = CreateThread(NULL, 0, WriterThread, staging, 0, NULL);
+	for (DWORD i = 0; i < ctx.readers; i++)
+		rds[i].thread = CreateThread(NULL, 0, ReaderThread, &rds[i], 0, NULL);
+	Sleep(ctx.seconds * 1000);
+	InterlockedExchange(&ctx.stop, 1);
+	for (DWORD i = 0; i < ctx.readers; i++)
+	{
+		if (!rds[i].thread)
+			continue;
+		WaitForSingleObject(rds[i].thread, INFINITE);
+		CloseHandle(rds[i].thread);
+	}
+	if (writer)
+	{
+		WaitForSingleObject(writer, INFINITE);
+		CloseHandle(writer);
+	}
+
+	for (DWORD i = 0; i < ctx.readers; i++)
+	{
+		sum.reads += rds[i].reads;
+		sum.retries += rds[i].retries;
+		sum.busy += rds[i].busy;
+		sum.torn += rds[i].torn;
+		sum.total_ns += rds[i].total_ns;
+		if (rds[i].max_ns > sum.max_ns)
+			sum.max_ns = rds[i].max_ns;
+		for (DWORD j = 0; j < SHMTEST_BUCKETS; j++)
+			sum.hist[j] += rds[i].hist[j];
+	}
+	if (sum.reads == 0)
+	{
+		fprintf(stderr, "No reads completed\n");
+		goto out;
+	}
+
+	if (!ctx.live)
+		printf("Publishes: %llu (%.0f/s)\n", ctx.publishes, (double)ctx.publishes / ctx.seconds);
+	printf("Reads: %llu (%.0f/s)\n", sum.reads, (double)sum.reads / ctx.seconds);
+	printf("Retries: %llu (%.4f per read)\n", sum.retries, (double)sum.retries / sum.reads);
+	printf("Gave up: %llu (%.4f%%)\n", sum.busy, 100.0 * sum.busy / sum.reads);
+	if (!ctx.live)
+		printf("Torn: %llu\n", sum.torn);
+	printf("Latency: avg %.0f ns, p50 <%llu ns, p99 <%llu ns, p99.9 <%llu ns, max %llu ns\n",
+		sum.total_ns / sum.reads,
+		Percentile(sum.hist, sum.reads, 0.50),
+		Percentile(sum.hist, sum.reads, 0.99),
+		Percentile(sum.hist, sum.reads, 0.999),
+		sum.max_ns);
+	ret = sum.torn ? 2 : 0;
+
+out:
+	if (rds)
+	{
+		for (DWORD i = 0; i < ctx.readers; i++)
+		{
+			NWSHM_Close(&rds[i].reader);
+			free(rds[i].entries);
+		}
+		free(rds);
+	}
+	free(staging);
+	if (ctx.hdr)
+		UnmapViewOfFile(ctx.hdr);
+	if (ctx.file)
+		CloseHandle(ctx.file);
+	return ret;
+}
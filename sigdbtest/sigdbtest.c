@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sigdb.h"
+
+static void
+PrintHex(const uint8_t* p, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		printf("%02x", p[i]);
+}
+
+static void
+PrintGuid(const NWL_SIGDB_GUID* g)
+{
+	printf("%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+		g->Data1, g->Data2, g->Data3, g->Data4[0], g->Data4[1],
+		g->Data4[2], g->Data4[3], g->Data4[4], g->Data4[5], g->Data4[6], g->Data4[7]);
+}
+
+// Decodes a db/dbx image and parses every certificate in it, the same way
+// the UEFI variable decoder does.
+static uint32_t
+DecodeDb(const uint8_t* data, uint32_t size, int verbose)
+{
+	uint32_t count;
+	NWL_SIGDB* db = NWL_SigDbDecode(data, size);
+	if (!db)
+		return 0;
+	for (uint32_t i = 0; i < db->Count; i++)
+	{
+		if (NWL_SigDbIsX509(&db->Entries[i]))
+			NWL_SigDbParseCert(&db->Entries[i]);
+	}
+	count = db->Count;
+	if (!verbose)
+		goto out;
+
+	printf("SHA-256 ");
+	PrintHex(db->Hash, NWL_SHA256_SIZE);
+	printf("\n%u list(s), %u signature(s)\n", db->ListCount, db->Count);
+	for (uint32_t i = 0; i < db->Count; i++)
+	{
+		const NWL_SIGDB_ENTRY* e = &db->Entries[i];
+		printf("[%u.%u] type ", e->List, e->Index);
+		PrintGuid(&e->Type);
+		printf(" owner ");
+		PrintGuid(&e->Owner);
+		printf(" %u bytes\n", e->DataSize);
+		if (NWL_SigDbIsX509(e))
+		{
+			if (!e->CertValid)
+			{
+				printf("\tinvalid certificate\n");
+				continue;
+			}
+			printf("\tName: %s\n", e->Name ? e->Name : "");
+			printf("\tSubject: %s\n", e->Subject ? e->Subject : "");
+			printf("\tIssuer: %s\n", e->Issuer ? e->Issuer : "");
+		}
+		else
+		{
+			printf("\t");
+			PrintHex(e->Data, e->DataSize);
+			printf("\n");
+		}
+	}
+	if (db->Error)
+		printf("Error: %s\n", db->Error);
+out:
+	NWL_SigDbFree(db);
+	return count;
+}
+
+#ifdef SIGDB_FUZZER
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	if (size > UINT32_MAX)
+		return 0;
+	DecodeDb(data, (uint32_t)size, 0);
+	return 0;
+}
+#else
+// FIPS 180-2 and NIST CAVP short message vectors.
+static const struct
+{
+	const char* msg;
+	size_t repeat;
+	const char* digest;
+} Sha256Kat[] =
+{
+	{ "", 1, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+	{ "abc", 1, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+	{ "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1,
+		"248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+	{ "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 1,
+		"cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1" },
+	{ "a", 1000000, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" },
+};
+
+static int
+RunKat(void)
+{
+	int failed = 0;
+	for (size_t i = 0; i < sizeof(Sha256Kat) / sizeof(Sha256Kat[0]); i++)
+	{
+		uint8_t hash[NWL_SHA256_SIZE];
+		char hex[NWL_SHA256_SIZE * 2 + 1];
+		size_t len = strlen(Sha256Kat[i].msg);
+		size_t size = len * Sha256Kat[i].repeat;
+		uint8_t* msg = malloc(size ? size : 1);
+		if (!msg)
+			return 1;
+		for (size_t j = 0; j < Sha256Kat[i].repeat; j++)
+			memcpy(msg + j * len, Sha256Kat[i].msg, len);
+		NWL_Sha256(msg, size, hash);
+		free(msg);
+		for (size_t j = 0; j < NWL_SHA256_SIZE; j++)
+			snprintf(hex + j * 2, 3, "%02x", hash[j]);
+		if (strcmp(hex, Sha256Kat[i].digest) != 0)
+		{
+			printf("SHA-256 KAT %zu failed: %s\n", i, hex);
+			failed++;
+		}
+	}
+	printf("SHA-256 KAT: %zu vector(s), %d failed\n", sizeof(Sha256Kat) / sizeof(Sha256Kat[0]), failed);
+	return failed ? 1 : 0;
+}
+
+static uint8_t*
+LoadFile(const char* path, size_t* size)
+{
+	uint8_t* data = NULL;
+	long len;
+	FILE* fp = fopen(path, "rb");
+	if (!fp)
+		return NULL;
+	if (fseek(fp, 0, SEEK_END) != 0 || (len = ftell(fp)) <= 0 || fseek(fp, 0, SEEK_SET) != 0)
+		goto out;
+	data = malloc((size_t)len);
+	if (!data)
+		goto out;
+	if (fread(data, 1, (size_t)len, fp) != (size_t)len)
+	{
+		free(data);
+		data = NULL;
+		goto out;
+	}
+	*size = (size_t)len;
+out:
+	fclose(fp);
+	return data;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t size = 0;
+	long iterations = 10000;
+	uint8_t* data;
+	struct timespec t0, t1;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: %s --kat\n       %s SIGDB_FILE [ITERATIONS]\n", argv[0], argv[0]);
+		return 1;
+	}
+	if (strcmp(argv[1], "--kat") == 0)
+		return RunKat();
+	if (argc > 2)
+		iterations = strtol(argv[2], NULL, 0);
+	if (iterations < 0)
+		iterations = 0;
+
+	data = LoadFile(argv[1], &size);
+	if (!data || size > UINT32_MAX)
+	{
+		fprintf(stderr, "Failed to load %s\n", argv[1]);
+		free(data);
+		return 1;
+	}
+
+	uint32_t count = DecodeDb(data, (uint32_t)size, 1);
+
+	if (iterations)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (long i = 0; i < iterations; i++)
+			DecodeDb(data, (uint32_t)size, 0);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+
+		double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+		printf("%zu bytes, %u signature(s), %ld iterations: %.1f ns/db, %.1f MB/s\n",
+			size, count, iterations, ns / iterations, (double)size * iterations / ns * 1e3);
+	}
+
+	free(data);
+	return 0;
+}
+#endif
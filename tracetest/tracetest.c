@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "tracefmt.h"
+
+// Same order as get_pio_mod in trace.c, channel WR0_CHAN_PIO + i.
+static const char* pio_name[] =
+{
+	"AMDFamily0F", "AMDFamily10", "AMDFamily17", "IntelMSR", "ZhaoxinMSR",
+	"RyzenSMU", "SmbusI801", "SmbusPIIX4", "LpcIO", "IntelMCHBAR",
+};
+
+static const char* drv_name[] = { "None", "WinRing0", "HwIO", "CPU-Z 1.62", "PawnIO" };
+
+#define PIO_FN_NAME_LEN 32
+#define GROUP_MAX 256
+
+typedef struct
+{
+	uint32_t chan;
+	uint32_t code;
+	char fn[PIO_FN_NAME_LEN + 1];
+	size_t count;
+	size_t failed;
+	uint64_t total_ns;
+	uint64_t max_ns;
+} GROUP;
+
+static GROUP groups[GROUP_MAX];
+static size_t group_count;
+
+static const char*
+ChanName(uint32_t chan)
+{
+	if (chan == WR0_CHAN_DRV)
+		return "DRV";
+	if (chan - WR0_CHAN_PIO < sizeof(pio_name) / sizeof(pio_name[0]))
+		return pio_name[chan - WR0_CHAN_PIO];
+	return "?";
+}
+
+// PawnIO requests start with the function name.
+static void
+GetFnName(const wr0_trace_entry_t* e, char* fn)
+{
+	fn[0] = '\0';
+	if (e->rec->chan == WR0_CHAN_DRV || e->rec->in_size < PIO_FN_NAME_LEN)
+		return;
+	memcpy(fn, e->in, PIO_FN_NAME_LEN);
+	fn[PIO_FN_NAME_LEN] = '\0';
+}
+
+static void
+AddGroup(const wr0_trace_entry_t* e)
+{
+	char fn[PIO_FN_NAME_LEN + 1];
+	GROUP* g = NULL;
+
+	GetFnName(e, fn);
+	for (size_t i = 0; i < group_count; i++)
+	{
+		if (groups[i].chan == e->rec->chan && groups[i].code == e->rec->code && strcmp(groups[i].fn, fn) == 0)
+		{
+			g = &groups[i];
+			break;
+		}
+	}
+	if (!g)
+	{
+		if (group_count >= GROUP_MAX)
+			return;
+		g = &groups[group_count++];
+		g->chan = e->rec->chan;
+		g->code = e->rec->code;
+		memcpy(g->fn, fn, sizeof(g->fn));
+	}
+	g->count++;
+	if (!e->rec->result)
+		g->failed++;
+	g->total_ns += e->rec->elapsed_ns;
+	if (e->rec->elapsed_ns > g->max_ns)
+		g->max_ns = e->rec->elapsed_ns;
+}
+
+static void
+DumpEntry(size_t i, const wr0_trace_entry_t* e)
+{
+	char fn[PIO_FN_NAME_LEN + 1];
+	GetFnName(e, fn);
+	printf("#%zu %s %08X%s%s in@%u out@%u ret@%u %s %llu ns\n", i, ChanName(e->rec->chan), e->rec->code,
+		fn[0] ? " " : "", fn, e->rec->in_size, e->rec->out_size, e->rec->ret_size,
+		e->rec->result ? "OK" : "FAIL", (unsigned long long)e->rec->elapsed_ns);
+}
+
+// Feeds every recorded request back through the matcher in recorded order,
+// as a replaying WR0_IoControl would. Returns the number of requests that
+// did not resolve to their own record.
+static size_t
+Replay(wr0_trace_log_t* log)
+{
+	size_t bad = 0;
+	log->cursor = 0;
+	for (size_t i = 0; i < log->count; i++)
+	{
+		const wr0_trace_entry_t* e = &log->entries[i];
+		const wr0_trace_entry_t* r = wr0_trace_find(log, e->rec->chan, e->rec->code,
+			e->in, e->rec->in_size, e->rec->out_size);
+		if (r != e)
+			bad++;
+	}
+	return bad;
+}
+
+#ifdef TRACE_FUZZER
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	wr0_trace_log_t log;
+	uint8_t* copy = malloc(size ? size : 1);
+	if (!copy)
+		return 0;
+	memcpy(copy, data, size);
+	if (wr0_trace_parse(&log, copy, size) == 0)
+	{
+		for (size_t i = 0; i < log.count; i++)
+		{
+			char fn[PIO_FN_NAME_LEN + 1];
+			GetFnName(&log.entries[i], fn);
+		}
+		Replay(&log);
+	}
+	wr0_trace_free(&log);
+	return 0;
+}
+#else
+int main(int argc, char* argv[])
+{
+	wr0_trace_log_t log;
+	long iterations = 1000;
+	int dump = 0;
+	int arg = 1;
+	FILE* fp;
+	struct timespec t0, t1;
+	uint64_t recorded_ns = 0;
+
+	if (arg < argc && strcmp(argv[arg], "-d") == 0)
+	{
+		dump = 1;
+		arg++;
+	}
+	if (arg >= argc)
+	{
+		fprintf(stderr, "Usage: %s [-d] TRACE_FILE [ITERATIONS]\n", argv[0]);
+		return 1;
+	}
+	if (arg + 1 < argc)
+		iterations = strtol(argv[arg + 1], NULL, 0);
+	if (iterations < 0)
+		iterations = 0;
+
+	fp = fopen(argv[arg], "rb");
+	if (!fp)
+	{
+		fprintf(stderr, "Failed to open %s\n", argv[arg]);
+		return 1;
+	}
+	if (wr0_trace_load(&log, fp) != 0)
+	{
+		fclose(fp);
+		wr0_trace_free(&log);
+		fprintf(stderr, "Invalid trace %s\n", argv[arg]);
+		return 1;
+	}
+	fclose(fp);
+
+	printf("Driver %s, PawnIO modules 0x%X, %zu record(s), %zu bytes\n",
+		log.hdr.type < sizeof(drv_name) / sizeof(drv_name[0]) ? drv_name[log.hdr.type] : "?",
+		log.hdr.pio_mask, log.count, log.size);
+	for (size_t i = 0; i < log.count; i++)
+	{
+		if (dump)
+			DumpEntry(i, &log.entries[i]);
+		AddGroup(&log.entries[i]);
+		recorded_ns += log.entries[i].rec->elapsed_ns;
+	}
+	for (size_t i = 0; i < group_count; i++)
+	{
+		const GROUP* g = &groups[i];
+		printf("%-12s %08X %-24s %6zu call(s) %4zu failed, avg %llu ns, max %llu ns\n",
+			ChanName(g->chan), g->code, g->fn, g->count, g->failed,
+			(unsigned long long)(g->total_ns / g->count), (unsigned long long)g->max_ns);
+	}
+	printf("Recorded driver time %llu ns\n", (unsigned long long)recorded_ns);
+
+	size_t bad = Replay(&log);
+	printf("Replay: %zu mismatch(es), %zu miss(es)\n", bad, log.misses);
+
+	if (iterations && log.count)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (long i = 0; i < iterations; i++)
+			Replay(&log);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+
+		double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+		printf("%ld iterations: %.1f ns/trace, %.1f ns/lookup\n",
+			iterations, ns / iterations, ns / iterations / log.count);
+	}
+
+	wr0_trace_free(&log);
+	return bad ? 2 : 0;
+}
+#endif
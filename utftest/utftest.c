@@ -0,0 +1,352 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "utf.h"
+
+static int failed;
+
+#define CHECK(cond, ...) \
+	do \
+	{ \
+		if (!(cond)) \
+		{ \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			failed++; \
+		} \
+	} while (0)
+
+// Reference encoders, one code point at a time.
+static size_t
+RefUtf8(uint32_t cp, char* p)
+{
+	if (cp < 0x80)
+	{
+		p[0] = (char)cp;
+		return 1;
+	}
+	if (cp < 0x800)
+	{
+		p[0] = (char)(0xC0 | (cp >> 6));
+		p[1] = (char)(0x80 | (cp & 0x3F));
+		return 2;
+	}
+	if (cp < 0x10000)
+	{
+		p[0] = (char)(0xE0 | (cp >> 12));
+		p[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+		p[2] = (char)(0x80 | (cp & 0x3F));
+		return 3;
+	}
+	p[0] = (char)(0xF0 | (cp >> 18));
+	p[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+	p[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+	p[3] = (char)(0x80 | (cp & 0x3F));
+	return 4;
+}
+
+static size_t
+RefUtf16(uint32_t cp, uint16_t* p)
+{
+	if (cp < 0x10000)
+	{
+		p[0] = (uint16_t)cp;
+		return 1;
+	}
+	cp -= 0x10000;
+	p[0] = (uint16_t)(0xD800 | (cp >> 10));
+	p[1] = (uint16_t)(0xDC00 | (cp & 0x3FF));
+	return 2;
+}
+
+// Every scalar value, in runs long enough to cross the SIMD block sizes.
+static void
+TestAllCodePoints(void)
+{
+	enum { RUN = 64 };
+	char u8[RUN * 4 + 1], b8[RUN * 4 + 1];
+	uint16_t u16[RUN * 2 + 1], b16[RUN * 2 + 1];
+	uint32_t cp = 1;
+
+	while (cp <= 0x10FFFF)
+	{
+		size_t n8 = 0, n16 = 0;
+		for (int k = 0; k < RUN && cp <= 0x10FFFF; cp++)
+		{
+			if (cp >= 0xD800 && cp <= 0xDFFF)
+				continue;
+			n8 += RefUtf8(cp, u8 + n8);
+			n16 += RefUtf16(cp, u16 + n16);
+			k++;
+		}
+		u8[n8] = '\0';
+		u16[n16] = 0;
+
+		CHECK(NWL_Utf16ToUtf8Len(u16, n16) == n8, "16->8 length near U+%X", cp);
+		CHECK(NWL_Utf8ToUtf16Len(u8, n8) == n16, "8->16 length near U+%X", cp);
+		size_t r8 = NWL_Utf16ToUtf8(u16, NWL_UTF_NUL, b8, sizeof(b8));
+		CHECK(r8 == n8 && memcmp(b8, u8, n8 + 1) == 0, "16->8 near U+%X", cp);
+		size_t r16 = NWL_Utf8ToUtf16(u8, NWL_UTF_NUL, b16, sizeof(b16) / sizeof(b16[0]));
+		CHECK(r16 == n16 && memcmp(b16, u16, (n16 + 1) * sizeof(uint16_t)) == 0, "8->16 near U+%X", cp);
+	}
+}
+
+// ASCII runs of every length up to a few SIMD blocks, followed by a
+// non-ASCII code point, so the block loops hand over at every offset.
+static void
+TestAsciiBoundaries(void)
+{
+	static const uint32_t tail[] = { 0xE9, 0x20AC, 0x1F600 };
+	for (size_t t = 0; t < sizeof(tail) / sizeof(tail[0]); t++)
+	{
+		for (size_t len = 0; len < 50; len++)
+		{
+			char u8[64], b8[64];
+			uint16_t u16[64], b16[64];
+			size_t n8 = 0, n16 = 0;
+			for (size_t i = 0; i < len; i++)
+			{
+				u8[n8++] = (char)('a' + i % 26);
+				u16[n16++] = (uint16_t)('a' + i % 26);
+			}
+			n8 += RefUtf8(tail[t], u8 + n8);
+			n16 += RefUtf16(tail[t], u16 + n16);
+			u8[n8++] = '!';
+			u16[n16++] = '!';
+
+			CHECK(NWL_Utf16ToUtf8(u16, n16, b8, sizeof(b8)) == n8 && memcmp(b8, u8, n8) == 0 && b8[n8] == '\0',
+				"16->8 after %zu ASCII", len);
+			CHECK(NWL_Utf8ToUtf16(u8, n8, b16, 64) == n16 && memcmp(b16, u16, n16 * 2) == 0 && b16[n16] == 0,
+				"8->16 after %zu ASCII", len);
+		}
+	}
+}
+
+static const struct
+{
+	const char* in;
+	uint16_t out[8];
+} Utf8Invalid[] =
+{
+	{ "\xC0\x80", { 0xFFFD, 0xFFFD } }, // overlong NUL
+	{ "\xE0\x80\xAF", { 0xFFFD } }, // overlong '/', one replacement for the sequence
+	{ "\xED\xA0\x80", { 0xFFFD } }, // encoded surrogate
+	{ "\xF4\x90\x80\x80", { 0xFFFD } }, // above U+10FFFF
+	{ "\xF5\x80", { 0xFFFD, 0xFFFD } },
+	{ "\xE2\x82", { 0xFFFD } }, // truncated
+	{ "\xE2\x82x", { 0xFFFD, 'x' } },
+	{ "\x80x\xBF", { 0xFFFD, 'x', 0xFFFD } }, // stray continuations
+	{ "a\xF0\x9F\x98", { 'a', 0xFFFD } },
+};
+
+static const struct
+{
+	uint16_t in[4];
+	const char* out;
+} Utf16Invalid[] =
+{
+	{ { 0xD800, 'a' }, "\xEF\xBF\xBD" "a" }, // lone high surrogate
+	{ { 0xDC00, 0xD800 }, "\xEF\xBF\xBD\xEF\xBF\xBD" }, // reversed pair
+	{ { 'a', 0xDBFF }, "a\xEF\xBF\xBD" }, // high surrogate at the end
+};
+
+static size_t
+Utf16Len(const uint16_t* p)
+{
+	size_t n = 0;
+	while (p[n])
+		n++;
+	return n;
+}
+
+static void
+TestInvalid(void)
+{
+	for (size_t i = 0; i < sizeof(Utf8Invalid) / sizeof(Utf8Invalid[0]); i++)
+	{
+		uint16_t out[16];
+		size_t want = Utf16Len(Utf8Invalid[i].out);
+		size_t n = NWL_Utf8ToUtf16(Utf8Invalid[i].in, NWL_UTF_NUL, out, 16);
+		CHECK(n == want && memcmp(out, Utf8Invalid[i].out, n * 2) == 0, "invalid UTF-8 #%zu", i);
+		CHECK(NWL_Utf8ToUtf16Len(Utf8Invalid[i].in, NWL_UTF_NUL) == want, "invalid UTF-8 #%zu length", i);
+	}
+	for (size_t i = 0; i < sizeof(Utf16Invalid) / sizeof(Utf16Invalid[0]); i++)
+	{
+		char out[16];
+		size_t want = strlen(Utf16Invalid[i].out);
+		size_t n = NWL_Utf16ToUtf8(Utf16Invalid[i].in, NWL_UTF_NUL, out, sizeof(out));
+		CHECK(n == want && strcmp(out, Utf16Invalid[i].out) == 0, "invalid UTF-16 #%zu", i);
+		CHECK(NWL_Utf16ToUtf8Len(Utf16Invalid[i].in, NWL_UTF_NUL) == want, "invalid UTF-16 #%zu length", i);
+	}
+}
+
+// Every destination size must give a NUL terminated prefix that ends on a
+// code point boundary.
+static void
+TestTruncation(void)
+{
+	static const char u8[] = "0123456789abcdef\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80xyz0123456789abcdef";
+	uint16_t u16[64];
+	size_t n16 = NWL_Utf8ToUtf16(u8, NWL_UTF_NUL, u16, 64);
+	size_t n8 = sizeof(u8) - 1;
+
+	for (size_t size = 1; size <= n8 + 1; size++)
+	{
+		char out[64];
+		memset(out, 0x55, sizeof(out));
+		size_t n = NWL_Utf16ToUtf8(u16, n16, out, size);
+		CHECK(n < size && out[n] == '\0' && memcmp(out, u8, n) == 0, "16->8 into %zu", size);
+		CHECK(n == n8 || (u8[n] & 0xC0) != 0x80, "16->8 into %zu splits a code point", size);
+		CHECK(out[size] == 0x55, "16->8 into %zu overruns", size);
+	}
+	for (size_t size = 1; size <= n16 + 1; size++)
+	{
+		uint16_t out[64];
+		memset(out, 0x55, sizeof(out));
+		size_t n = NWL_Utf8ToUtf16(u8, n8, out, size);
+		CHECK(n < size && out[n] == 0 && memcmp(out, u16, n * 2) == 0, "8->16 into %zu", size);
+		CHECK(n == n16 || (u16[n] & 0xFC00) != 0xDC00, "8->16 into %zu splits a pair", size);
+		CHECK(out[size] == 0x5555, "8->16 into %zu overruns", size);
+	}
+}
+
+static void
+TestDup(void)
+{
+	static const char u8[] = "NWinfo \xE2\x80\x94 \xE7\xA1\xAC\xE4\xBB\xB6\xE4\xBF\xA1\xE6\x81\xAF \xF0\x9F\x96\xA5";
+	size_t n16 = 0, n8 = 0;
+	uint16_t* w = NWL_Utf8ToUtf16Dup(u8, NWL_UTF_NUL, &n16);
+	CHECK(w && n16 == NWL_Utf8ToUtf16Len(u8, NWL_UTF_NUL), "Utf8ToUtf16Dup");
+	char* s = w ? NWL_Utf16ToUtf8Dup(w, NWL_UTF_NUL, &n8) : NULL;
+	CHECK(s && n8 == sizeof(u8) - 1 && strcmp(s, u8) == 0, "Utf16ToUtf8Dup round trip");
+	free(s);
+	free(w);
+	CHECK(NWL_Utf8ToUtf16Dup(NULL, 0, NULL) == NULL && NWL_Utf16ToUtf8Dup(NULL, 0, NULL) == NULL, "Dup NULL");
+}
+
+static int
+RunTests(void)
+{
+	TestAllCodePoints();
+	TestAsciiBoundaries();
+	TestInvalid();
+	TestTruncation();
+	TestDup();
+	printf("UTF round trip: %d failure(s)\n", failed);
+	return failed ? 1 : 0;
+}
+
+#ifdef UTF_FUZZER
+// Converting to UTF-16 and back must be stable after the first pass,
+// since every malformed sequence has become U+FFFD.
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	size_t n16, n8, m16;
+	uint16_t* w = NWL_Utf8ToUtf16Dup((const char*)data, size, &n16);
+	if (!w)
+		return 0;
+	char* s = NWL_Utf16ToUtf8Dup(w, n16, &n8);
+	uint16_t* w2 = s ? NWL_Utf8ToUtf16Dup(s, n8, &m16) : NULL;
+	if (w2 && (m16 != n16 || memcmp(w, w2, n16 * sizeof(uint16_t)) != 0))
+		abort();
+	free(w2);
+	free(s);
+	free(w);
+
+	// The same bytes read as UTF-16
+	w = malloc((size / 2 + 1) * sizeof(uint16_t));
+	if (!w)
+		return 0;
+	memcpy(w, data, size / 2 * sizeof(uint16_t));
+	s = NWL_Utf16ToUtf8Dup(w, size / 2, &n8);
+	if (s && n8 != NWL_Utf16ToUtf8Len(w, size / 2))
+		abort();
+	free(s);
+	free(w);
+	return 0;
+}
+#else
+static uint8_t*
+LoadFile(const char* path, size_t* size)
+{
+	uint8_t* data = NULL;
+	long len;
+	FILE* fp = fopen(path, "rb");
+	if (!fp)
+		return NULL;
+	if (fseek(fp, 0, SEEK_END) != 0 || (len = ftell(fp)) <= 0 || fseek(fp, 0, SEEK_SET) != 0)
+		goto out;
+	data = malloc((size_t)len);
+	if (!data)
+		goto out;
+	if (fread(data, 1, (size_t)len, fp) != (size_t)len)
+	{
+		free(data);
+		data = NULL;
+		goto out;
+	}
+	*size = (size_t)len;
+out:
+	fclose(fp);
+	return data;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t size = 0;
+	long iterations = 10000;
+	char* data;
+	struct timespec t0, t1;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: %s --check\n       %s UTF8_FILE [ITERATIONS]\n", argv[0], argv[0]);
+		return 1;
+	}
+	if (strcmp(argv[1], "--check") == 0)
+		return RunTests();
+	if (argc > 2)
+		iterations = strtol(argv[2], NULL, 0);
+	if (iterations <= 0)
+		iterations = 1;
+
+	data = (char*)LoadFile(argv[1], &size);
+	if (!data)
+	{
+		fprintf(stderr, "Failed to load %s\n", argv[1]);
+		return 1;
+	}
+
+	size_t n16 = NWL_Utf8ToUtf16Len(data, size);
+	uint16_t* w = malloc((n16 + 1) * sizeof(uint16_t));
+	char* s = malloc(size * 3 + 1);
+	if (!w || !s)
+		return 1;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (long i = 0; i < iterations; i++)
+		NWL_Utf8ToUtf16(data, size, w, n16 + 1);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+	printf("UTF-8 -> UTF-16: %zu bytes -> %zu units, %.1f MB/s\n",
+		size, n16, (double)size * iterations / ns * 1e3);
+
+	size_t n8 = NWL_Utf16ToUtf8Len(w, n16);
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (long i = 0; i < iterations; i++)
+		NWL_Utf16ToUtf8(w, n16, s, n8 + 1);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+	printf("UTF-16 -> UTF-8: %zu units -> %zu bytes, %.1f MB/s\n",
+		n16, n8, (double)n16 * sizeof(uint16_t) * iterations / ns * 1e3);
+
+	free(s);
+	free(w);
+	free(data);
+	return 0;
+}
+#endif